@@ -10,7 +10,7 @@ fn greet(name: &str) -> String {
 }
 
 #[tauri::command]
-fn derive_key(pin: String, salt: Vec<u8>) -> Result<Vec<u8>, String> {
+fn derive_key(pin: String, params: KdfParams) -> Result<Vec<u8>, String> {
     use argon2::Argon2;
     use zeroize::Zeroizing;
 
@@ -19,71 +19,173 @@ fn derive_key(pin: String, salt: Vec<u8>) -> Result<Vec<u8>, String> {
     // ...
     let mut output = [0u8; 32];
     let mut output = Zeroizing::new(output);
-    let salt_bytes = salt.as_slice();
     
-    // We'll use the low-level API for direct output
+    // Same parameters the device calibrated at setup, so both sides derive
+    // the same key from the PIN
     let context = argon2::Argon2::new(
         argon2::Algorithm::Argon2id,
         argon2::Version::V0x13,
-        argon2::Params::new(2048, 3, 1, Some(32)).map_err(|e| e.to_string())?,
+        argon2::Params::new(params.m_cost, params.t_cost, params.lanes, Some(32))
+            .map_err(|e| e.to_string())?,
     );
     
-    context.hash_password_into(pin.as_bytes(), salt_bytes, &mut *output).map_err(|e| e.to_string())?;
+    context.hash_password_into(pin.as_bytes(), &params.salt, &mut *output).map_err(|e| e.to_string())?;
     
     Ok(output.to_vec())
 }
 
 #[tauri::command]
 async fn send_command(msg_type: u8, payload: Vec<u8>) -> Result<Vec<u8>, String> {
+    let mut responses = send_commands(vec![(msg_type, payload)]).await?;
+    Ok(responses.remove(0))
+}
+
+/// Sends several requests over one connection, pipelined (see
+/// `protocol::exchange`), and returns their responses in the same order
+#[tauri::command]
+async fn send_commands(requests: Vec<(u8, Vec<u8>)>) -> Result<Vec<Vec<u8>>, String> {
+    protocol::exchange(&mut open_port()?, &requests, rand::random())
+}
+
+/// The device's serial port, for one exchange or several in a row. Bulk
+/// commands keep it open across their round trips.
+fn open_port() -> Result<Box<dyn serialport::SerialPort>, String> {
     let transport = usb::find_vaultkey_device().ok_or("Device not found")?;
     
     match transport {
         usb::DeviceTransport::Serial(port_name) => {
-            let mut port = serialport::new(port_name, 115_200)
+            // Device-mode unlock/setup send Progress frames until the real
+            // response, so the timeout is between frames, not per request
+            serialport::new(port_name, 115_200)
                 .timeout(std::time::Duration::from_millis(1000))
                 .open()
-                .map_err(|e| e.to_string())?;
-
-            let msg = protocol::VkMessage {
-                version: 1,
-                msg_type,
-                payload,
-                id: Some(rand::random()),
-            };
-
-            let cbor = msg.to_cbor().map_err(|e| e.to_string())?;
-            port.write_all(&cbor).map_err(|e| e.to_string())?;
-
-            let mut res_buf = [0u8; 256];
-            let len = port.read(&mut res_buf).map_err(|e| e.to_string())?;
-            
-            let res_msg = protocol::VkMessage::from_cbor(&res_buf[..len]).map_err(|e| e.to_string())?;
-            Ok(res_msg.payload)
+                .map_err(|e| e.to_string())
         }
         usb::DeviceTransport::Hid(_) => Err("HID transport not yet fully implemented for commands".to_string()),
     }
 }
 
-#[tauri::command]
-async fn get_security_status() -> Result<(u32, bool), String> {
-    // VK_MSG_GET_SECURITY_REQ = 16
-    let response = send_command(16, vec![]).await?;
+/// Argon2id parameters persisted on the device (see GET_SECURITY response)
+#[derive(Debug, Clone, PartialEq, serde::Serialize, serde::Deserialize)]
+pub struct KdfParams {
+    pub t_cost: u32,
+    pub m_cost: u32,
+    pub lanes: u32,
+    pub salt: Vec<u8>,
+}
+
+/// Argon2id cost used when the host runs the memory-hard half of the KDF
+/// (RFC 9106 second recommended option: 64 MiB, 3 passes, 4 lanes)
+const HOST_KDF_T_COST: u32 = 3;
+const HOST_KDF_M_COST: u32 = 64 * 1024;
+const HOST_KDF_LANES: u32 = 4;
+
+/// vault_kdf_mode_t on the device
+const KDF_MODE_DEVICE: u8 = 0;
+const KDF_MODE_HOST: u8 = 1;
+
+#[derive(Debug, Clone, PartialEq)]
+pub struct SecurityStatus {
+    pub fail_count: u32,
+    pub is_locked: bool,
+    pub kdf: Option<KdfParams>,
+    pub kdf_mode: u8,
+    pub is_setup: bool,
+}
+
+/// [Fails:4][Locked:1][TCost:4][MCost:4][Lanes:4][Salt:16][Mode:1][Setup:1],
+/// little-endian
+pub(crate) fn parse_security_status(response: &[u8]) -> Result<SecurityStatus, String> {
     if response.len() < 5 {
         return Err("Invalid security status response".to_string());
     }
     
     let mut fail_count_bytes = [0u8; 4];
     fail_count_bytes.copy_from_slice(&response[0..4]);
-    let fail_count = u32::from_ne_bytes(fail_count_bytes);
+    let fail_count = u32::from_le_bytes(fail_count_bytes);
     let is_locked = response[4] != 0;
+
+    // Older firmware stops after the lock flag
+    let kdf = if response.len() >= 33 {
+        let word = |at: usize| u32::from_le_bytes(response[at..at + 4].try_into().unwrap());
+        Some(KdfParams {
+            t_cost: word(5),
+            m_cost: word(9),
+            lanes: word(13),
+            salt: response[17..33].to_vec(),
+        })
+    } else {
+        None
+    };
+    let (kdf_mode, is_setup) = if response.len() >= 35 {
+        (response[33], response[34] != 0)
+    } else {
+        (KDF_MODE_DEVICE, true)
+    };
     
-    Ok((fail_count, is_locked))
+    Ok(SecurityStatus { fail_count, is_locked, kdf, kdf_mode, is_setup })
+}
+
+async fn fetch_security_status() -> Result<SecurityStatus, String> {
+    // VK_MSG_GET_SECURITY_REQ = 16
+    let response = send_command(16, vec![]).await?;
+    parse_security_status(&response)
 }
 
 #[tauri::command]
-async fn list_vault() -> Result<Vec<String>, String> {
-    // VK_MSG_VAULT_LIST_REQ = 20
-    let response = send_command(20, vec![]).await?;
+async fn get_security_status() -> Result<(u32, bool), String> {
+    let status = fetch_security_status().await?;
+    Ok((status.fail_count, status.is_locked))
+}
+
+#[tauri::command]
+async fn get_kdf_params() -> Result<KdfParams, String> {
+    let status = fetch_security_status().await?;
+    status.kdf.ok_or("Device firmware does not report KDF parameters".to_string())
+}
+
+/// Unlock with the PIN, setting the vault up on first use. A new vault runs
+/// the memory-hard Argon2id on the host; the device only adds its keyed,
+/// device-bound step and counts failures, so the PIN never leaves the host.
+#[tauri::command]
+async fn unlock_vault(pin: String) -> Result<String, String> {
+    let status = fetch_security_status().await?;
+    if status.is_locked {
+        return Err("LOCKED".to_string());
+    }
+    let mut params = status.kdf.ok_or("Device firmware does not report KDF parameters")?;
+
+    let response = if !status.is_setup {
+        params.t_cost = HOST_KDF_T_COST;
+        params.m_cost = HOST_KDF_M_COST;
+        params.lanes = HOST_KDF_LANES;
+        let key = zeroize::Zeroizing::new(derive_key(pin, params.clone())?);
+
+        // [Mode:1][TCost:4][MCost:4][Lanes:4][PreKey:32]
+        let mut payload = vec![KDF_MODE_HOST];
+        payload.extend_from_slice(&params.t_cost.to_le_bytes());
+        payload.extend_from_slice(&params.m_cost.to_le_bytes());
+        payload.extend_from_slice(&params.lanes.to_le_bytes());
+        payload.extend_from_slice(&key);
+        // VK_MSG_VAULT_SETUP_REQ = 8
+        send_command(8, payload).await?
+    } else if status.kdf_mode == KDF_MODE_HOST {
+        let key = zeroize::Zeroizing::new(derive_key(pin, params)?);
+        // VK_MSG_AUTH_REQ = 4
+        send_command(4, key.to_vec()).await?
+    } else {
+        // [PinLen:1][Pin:N]
+        let mut payload = vec![pin.len() as u8];
+        payload.extend_from_slice(pin.as_bytes());
+        // VK_MSG_VAULT_UNLOCK_REQ = 6
+        send_command(6, payload).await?
+    };
+
+    Ok(String::from_utf8_lossy(&response).to_string())
+}
+
+/// [NameLen:1][Name] per entry
+pub(crate) fn parse_vault_list(response: &[u8]) -> Vec<String> {
     let mut names = Vec::new();
     let mut offset = 0;
     while offset < response.len() {
@@ -96,7 +198,14 @@ async fn list_vault() -> Result<Vec<String>, String> {
         names.push(name);
         offset += name_len;
     }
-    Ok(names)
+    names
+}
+
+#[tauri::command]
+async fn list_vault() -> Result<Vec<String>, String> {
+    // VK_MSG_VAULT_LIST_REQ = 20
+    let response = send_command(20, vec![]).await?;
+    Ok(parse_vault_list(&response))
 }
 
 #[tauri::command]
@@ -136,19 +245,262 @@ async fn get_vault_secret(name: String) -> Result<String, String> {
     Ok(String::from_utf8_lossy(&response).to_string())
 }
 
+/// One entry of a bulk export: its secret, or the device's reason for not
+/// returning it
+#[derive(Debug, Clone, PartialEq, serde::Serialize)]
+pub struct VaultSecret {
+    pub name: String,
+    pub secret: Option<String>,
+    pub error: Option<String>,
+}
+
+/// CBOR [Next, [* [Name, Secret / Error]]]. Returns where to carry on (None
+/// once every entry was answered) and the entries.
+pub(crate) fn parse_vault_get_multi(
+    response: &[u8],
+) -> Result<(Option<u32>, Vec<VaultSecret>), String> {
+    use serde_cbor::Value;
+    let malformed = || "Malformed multi-get response".to_string();
+    let value: Value = serde_cbor::from_slice(response)
+        .map_err(|_| String::from_utf8_lossy(response).to_string())?;
+    let mut top = match value {
+        Value::Array(top) if top.len() == 2 => top,
+        _ => return Err(malformed()),
+    };
+    let (entries, next) = (top.pop().unwrap(), top.pop().unwrap());
+    let next = match next {
+        Value::Null => None,
+        Value::Integer(n) => Some(u32::try_from(n).map_err(|_| malformed())?),
+        _ => return Err(malformed()),
+    };
+    let Value::Array(entries) = entries else {
+        return Err(malformed());
+    };
+    let mut secrets = Vec::with_capacity(entries.len());
+    for entry in entries {
+        let secret = match entry {
+            Value::Array(pair) => match pair.as_slice() {
+                [Value::Text(name), Value::Bytes(secret)] => VaultSecret {
+                    name: name.clone(),
+                    secret: Some(String::from_utf8_lossy(secret).to_string()),
+                    error: None,
+                },
+                [Value::Text(name), Value::Text(error)] => VaultSecret {
+                    name: name.clone(),
+                    secret: None,
+                    error: Some(error.clone()),
+                },
+                _ => return Err(malformed()),
+            },
+            _ => return Err(malformed()),
+        };
+        secrets.push(secret);
+    }
+    Ok((next, secrets))
+}
+
+/// Name bytes per name-mode multi-get request, so the frame stays within
+/// the device's 1024-byte request limit
+const MULTI_GET_BATCH_BYTES: usize = 960;
+
+/// Name-mode multi-get payloads for `names`, [Mode:1 = 0] then
+/// [NameLen:1][Name] per entry, each with the names it asks for
+pub(crate) fn multi_get_batches(names: &[String]) -> Vec<(Vec<u8>, &[String])> {
+    let mut batches = Vec::new();
+    let mut first = 0;
+    while first < names.len() {
+        let mut payload = vec![0];
+        let mut end = first;
+        while end < names.len()
+            && (end == first || payload.len() + 1 + names[end].len() <= MULTI_GET_BATCH_BYTES)
+        {
+            payload.push(names[end].len() as u8);
+            payload.extend_from_slice(names[end].as_bytes());
+            end += 1;
+        }
+        batches.push((payload, &names[first..end]));
+        first = end;
+    }
+    batches
+}
+
+/// Every entry's secret: the entry list, then name-mode multi-get batches
+/// pipelined over the same open port, instead of one VAULT_GET per entry
+#[tauri::command]
+async fn export_vault() -> Result<Vec<VaultSecret>, String> {
+    let mut port = open_port()?;
+    // VK_MSG_VAULT_LIST_REQ = 20
+    let list = protocol::exchange(&mut port, &[(20, vec![])], rand::random())?;
+    let mut pending = parse_vault_list(&list[0]);
+    let mut secrets = Vec::new();
+    while !pending.is_empty() {
+        // A batch whose response filled up says how many of its names it
+        // answered; the rest go round again
+        let mut rest = Vec::new();
+        {
+            let batches = multi_get_batches(&pending);
+            // VK_MSG_VAULT_GET_MULTI_REQ = 28
+            let requests: Vec<(u8, Vec<u8>)> = batches.iter().map(|(payload, _)| (28, payload.clone())).collect();
+            let responses = protocol::exchange(&mut port, &requests, rand::random())?;
+            for ((_, names), response) in batches.iter().zip(&responses) {
+                let (next, entries) = parse_vault_get_multi(response)?;
+                secrets.extend(entries);
+                if let Some(answered) = next {
+                    rest.extend_from_slice(names.get(answered as usize..).unwrap_or_default());
+                }
+            }
+        }
+        if rest.len() >= pending.len() {
+            return Err("Export made no progress".to_string());
+        }
+        pending = rest;
+    }
+    Ok(secrets)
+}
+
 #[tauri::command]
 async fn get_device_status() -> Result<(u32, bool), String> {
     get_security_status().await
 }
 
+/// vk_totp_alg_t on the device
+const TOTP_ALGORITHMS: [&str; 3] = ["SHA1", "SHA256", "SHA512"];
+
+/// Current and next code of one TOTP entry
+#[derive(Debug, Clone, PartialEq, serde::Serialize)]
+pub struct TotpCode {
+    pub name: String,
+    pub period: u16,
+    pub current: String,
+    pub next: String,
+}
+
+/// RFC 4648 base32, as authenticator secrets are shown; padding, spaces and
+/// case are ignored
+pub(crate) fn decode_base32(text: &str) -> Result<Vec<u8>, String> {
+    let mut out = Vec::new();
+    let (mut acc, mut bits) = (0u32, 0u32);
+    for c in text.chars().filter(|c| !c.is_whitespace() && *c != '=') {
+        let v = match c.to_ascii_uppercase() {
+            c @ 'A'..='Z' => c as u32 - 'A' as u32,
+            c @ '2'..='7' => c as u32 - '2' as u32 + 26,
+            _ => return Err(format!("Invalid base32 character '{}'", c)),
+        };
+        acc = (acc << 5) | v;
+        bits += 5;
+        if bits >= 8 {
+            bits -= 8;
+            out.push((acc >> bits) as u8);
+        }
+    }
+    Ok(out)
+}
+
+/// [Total:1][Count:1] then per entry [NameLen:1][Name][Digits:1][Period:2]
+/// [Current:4][Next:4], little-endian. Returns the codes and how many
+/// entries matched on the device.
+pub(crate) fn parse_totp_batch(response: &[u8]) -> Result<(usize, Vec<TotpCode>), String> {
+    if response.len() < 2 {
+        return Err(String::from_utf8_lossy(response).to_string());
+    }
+    let total = response[0] as usize;
+    let count = response[1] as usize;
+    let mut codes = Vec::with_capacity(count);
+    let mut offset = 2;
+    for _ in 0..count {
+        let name_len = *response.get(offset).ok_or("Truncated TOTP batch")? as usize;
+        let end = offset + 1 + name_len + 11;
+        if end > response.len() {
+            return Err("Truncated TOTP batch".to_string());
+        }
+        let name = String::from_utf8_lossy(&response[offset + 1..offset + 1 + name_len]).to_string();
+        let at = offset + 1 + name_len;
+        let digits = response[at] as usize;
+        let period = u16::from_le_bytes([response[at + 1], response[at + 2]]);
+        let word = |i: usize| u32::from_le_bytes(response[i..i + 4].try_into().unwrap());
+        codes.push(TotpCode {
+            name,
+            period,
+            current: format!("{:0width$}", word(at + 3), width = digits),
+            next: format!("{:0width$}", word(at + 7), width = digits),
+        });
+        offset = end;
+    }
+    Ok((total, codes))
+}
+
 #[tauri::command]
-async fn get_totp(timestamp: u64) -> Result<String, String> {
-    let ts_bytes = timestamp.to_ne_bytes();
+async fn get_totp(timestamp: u64, name: String) -> Result<String, String> {
+    // [Timestamp:8][NameLen:1][Name]
+    let mut payload = timestamp.to_le_bytes().to_vec();
+    payload.push(name.len() as u8);
+    payload.extend_from_slice(name.as_bytes());
     // VK_MSG_TOTP_REQ = 30
-    let response = send_command(30, ts_bytes.to_vec()).await?;
+    let response = send_command(30, payload).await?;
     Ok(String::from_utf8_lossy(&response).to_string())
 }
 
+/// [Timestamp:8][PrefixLen:1][Prefix][Start:1]
+pub(crate) fn totp_batch_request(timestamp: u64, prefix: &str, start: usize) -> Vec<u8> {
+    let mut payload = timestamp.to_le_bytes().to_vec();
+    payload.push(prefix.len() as u8);
+    payload.extend_from_slice(prefix.as_bytes());
+    payload.push(start as u8);
+    payload
+}
+
+/// Codes for every TOTP entry whose name starts with `prefix` (all of them
+/// if empty), current and next: one round trip, or a few if the device
+/// answers part of them at a time
+#[tauri::command]
+async fn get_totp_codes(timestamp: u64, prefix: String) -> Result<Vec<TotpCode>, String> {
+    let mut port = open_port()?;
+    let mut codes = Vec::new();
+    loop {
+        // VK_MSG_TOTP_BATCH_REQ = 34
+        let request = (34, totp_batch_request(timestamp, &prefix, codes.len()));
+        let response = protocol::exchange(&mut port, &[request], rand::random())?;
+        let (total, batch) = parse_totp_batch(&response[0])?;
+        if batch.is_empty() && codes.len() < total {
+            return Err(format!("Device returned {} of {} TOTP codes", codes.len(), total));
+        }
+        codes.extend(batch);
+        if codes.len() >= total {
+            return Ok(codes);
+        }
+    }
+}
+
+#[tauri::command]
+async fn add_totp_entry(
+    name: String,
+    secret: String,
+    algorithm: String,
+    digits: u8,
+    period: u16,
+) -> Result<(), String> {
+    let alg = TOTP_ALGORITHMS
+        .iter()
+        .position(|a| a.eq_ignore_ascii_case(&algorithm))
+        .ok_or("Unsupported TOTP algorithm")?;
+    let seed = zeroize::Zeroizing::new(decode_base32(&secret)?);
+
+    // [NameLen:1][Name][Alg:1][Digits:1][Period:2][Seed:N]
+    let mut payload = zeroize::Zeroizing::new(vec![name.len() as u8]);
+    payload.extend_from_slice(name.as_bytes());
+    payload.push(alg as u8);
+    payload.push(digits);
+    payload.extend_from_slice(&period.to_le_bytes());
+    payload.extend_from_slice(&seed);
+
+    // VK_MSG_TOTP_ADD_REQ = 32
+    let response = send_command(32, payload.to_vec()).await?;
+    if response != b"OK" {
+        return Err(String::from_utf8_lossy(&response).to_string());
+    }
+    Ok(())
+}
+
 #[tauri::command]
 async fn delete_vault_entry(name: String) -> Result<(), String> {
     let mut payload = Vec::new();
@@ -169,14 +521,20 @@ pub fn run() {
             greet, 
             get_device_status, 
             send_command, 
+            send_commands,
             derive_key, 
             get_totp,
+            get_totp_codes,
+            add_totp_entry,
             type_text,
             get_security_status,
+            get_kdf_params,
+            unlock_vault,
             list_vault,
             add_vault_entry,
             delete_vault_entry,
-            get_vault_secret
+            get_vault_secret,
+            export_vault
         ])
         .run(tauri::generate_context!())
         .expect("error while running tauri application");
@@ -1,4 +1,5 @@
 use serde::{Serialize, Deserialize};
+use std::io::{Read, Write};
 
 #[derive(Serialize, Deserialize, Debug)]
 pub struct VkMessage {
@@ -6,15 +7,51 @@ pub struct VkMessage {
     pub version: u8,
     #[serde(rename = "type")]
     pub msg_type: u8,
+    #[serde(with = "bstr")]
     pub payload: Vec<u8>,
     #[serde(skip_serializing_if = "Option::is_none")]
     pub id: Option<u32>,
 }
 
+/// The payload travels as a CBOR byte string, which the firmware hands to its
+/// handlers in place; serde's default for `Vec<u8>` is an array of integers
+mod bstr {
+    use serde::{de, Deserializer, Serializer};
+    use std::fmt;
+
+    pub fn serialize<S: Serializer>(bytes: &[u8], s: S) -> Result<S::Ok, S::Error> {
+        s.serialize_bytes(bytes)
+    }
+
+    pub fn deserialize<'de, D: Deserializer<'de>>(d: D) -> Result<Vec<u8>, D::Error> {
+        struct Bytes;
+
+        impl<'de> de::Visitor<'de> for Bytes {
+            type Value = Vec<u8>;
+
+            fn expecting(&self, f: &mut fmt::Formatter) -> fmt::Result {
+                f.write_str("a byte string")
+            }
+
+            fn visit_bytes<E: de::Error>(self, v: &[u8]) -> Result<Vec<u8>, E> {
+                Ok(v.to_vec())
+            }
+
+            fn visit_byte_buf<E: de::Error>(self, v: Vec<u8>) -> Result<Vec<u8>, E> {
+                Ok(v)
+            }
+        }
+
+        d.deserialize_byte_buf(Bytes)
+    }
+}
+
 pub const MSG_PING: u8 = 0;
 pub const MSG_PONG: u8 = 1;
 pub const MSG_AUTH_CHALLENGE: u8 = 2;
 pub const MSG_VAULT_LIST_REQ: u8 = 4;
+/// Heartbeat from a long-running request: [Percent:1], same id as the request
+pub const MSG_PROGRESS: u8 = 60;
 
 impl VkMessage {
     pub fn new_ping(id: u32) -> Self {
@@ -34,3 +71,135 @@ impl VkMessage {
         serde_cbor::from_slice(data)
     }
 }
+
+/// Nesting accepted when measuring a message
+const CBOR_MAX_DEPTH: u32 = 4;
+
+/// Length of the CBOR item at the start of `buf`, or `None` while part of it
+/// is still to arrive. Serial reads end anywhere, so messages are measured
+/// before they are decoded.
+pub fn cbor_item_len(buf: &[u8]) -> Result<Option<usize>, String> {
+    item_len(buf, CBOR_MAX_DEPTH)
+}
+
+fn item_len(buf: &[u8], depth: u32) -> Result<Option<usize>, String> {
+    let Some(&first) = buf.first() else {
+        return Ok(None);
+    };
+    let (major, info) = (first >> 5, first & 0x1f);
+    let (arg, head) = match info {
+        0..=23 => (info as u64, 1),
+        24..=27 => {
+            let head = 1 + (1usize << (info - 24));
+            if buf.len() < head {
+                return Ok(None);
+            }
+            let arg = buf[1..head].iter().fold(0u64, |a, &b| a << 8 | b as u64);
+            (arg, head)
+        }
+        _ => return Err("Unsupported CBOR (indefinite length)".to_string()),
+    };
+
+    match major {
+        // Byte and text strings
+        2 | 3 => {
+            let end = usize::try_from(arg)
+                .ok()
+                .and_then(|len| len.checked_add(head))
+                .ok_or("CBOR string too long")?;
+            Ok((buf.len() >= end).then_some(end))
+        }
+        // Arrays and maps
+        4 | 5 => {
+            if depth == 0 {
+                return Err("CBOR nested too deeply".to_string());
+            }
+            let items = if major == 5 { arg.saturating_mul(2) } else { arg };
+            let mut pos = head;
+            for _ in 0..items {
+                match item_len(&buf[pos..], depth - 1)? {
+                    Some(len) => pos += len,
+                    None => return Ok(None),
+                }
+            }
+            Ok(Some(pos))
+        }
+        // Tag, then the tagged item
+        6 => {
+            if depth == 0 {
+                return Err("CBOR nested too deeply".to_string());
+            }
+            Ok(item_len(&buf[head..], depth - 1)?.map(|len| head + len))
+        }
+        // Integers, simple values, floats
+        _ => Ok(Some(head)),
+    }
+}
+
+/// Takes every complete message off the front of `buf`. A partial one stays
+/// for the next read to finish.
+pub fn take_frames(buf: &mut Vec<u8>) -> Result<Vec<VkMessage>, String> {
+    let mut frames = Vec::new();
+    while let Some(len) = cbor_item_len(buf)? {
+        frames.push(VkMessage::from_cbor(&buf[..len]).map_err(|e| e.to_string())?);
+        buf.drain(..len);
+    }
+    Ok(frames)
+}
+
+/// Requests `exchange` keeps in flight at once
+pub const PIPELINE_WINDOW: usize = 8;
+
+/// Sends `requests` with up to `PIPELINE_WINDOW` of them outstanding and
+/// returns each response payload, in request order. The device answers as
+/// requests become ready (a device-mode unlock only when its Argon2 job
+/// finishes), so responses are matched by id. Ids count up from `first_id`;
+/// frames with other ids, left over from an earlier exchange, are ignored.
+pub fn exchange<P: Read + Write>(
+    port: &mut P,
+    requests: &[(u8, Vec<u8>)],
+    first_id: u32,
+) -> Result<Vec<Vec<u8>>, String> {
+    let mut responses: Vec<Option<Vec<u8>>> = vec![None; requests.len()];
+    let (mut sent, mut done) = (0, 0);
+    let mut pending = Vec::new();
+    let mut res_buf = [0u8; 2048];
+
+    while done < requests.len() {
+        // Top the window up in one write
+        let mut out = Vec::new();
+        while sent < requests.len() && sent - done < PIPELINE_WINDOW {
+            let (msg_type, payload) = &requests[sent];
+            let msg = VkMessage {
+                version: 1,
+                msg_type: *msg_type,
+                payload: payload.clone(),
+                id: Some(first_id.wrapping_add(sent as u32)),
+            };
+            out.extend(msg.to_cbor().map_err(|e| e.to_string())?);
+            sent += 1;
+        }
+        if !out.is_empty() {
+            port.write_all(&out).map_err(|e| e.to_string())?;
+        }
+
+        let len = port.read(&mut res_buf).map_err(|e| e.to_string())?;
+        if len == 0 {
+            return Err("Device closed the connection".to_string());
+        }
+        pending.extend_from_slice(&res_buf[..len]);
+        for msg in take_frames(&mut pending)? {
+            // Progress frames only say that a request is still running
+            if msg.msg_type == MSG_PROGRESS {
+                continue;
+            }
+            let Some(id) = msg.id else { continue };
+            let index = id.wrapping_sub(first_id) as usize;
+            if index < sent && responses[index].is_none() {
+                responses[index] = Some(msg.payload);
+                done += 1;
+            }
+        }
+    }
+    Ok(responses.into_iter().map(Option::unwrap_or_default).collect())
+}
@@ -13,10 +13,195 @@ mod tests {
         assert_eq!(decoded.payload, b"PING");
     }
 
+    #[test]
+    fn test_payload_is_byte_string() {
+        // Same bytes as the firmware's host test decodes
+        let cbor = VkMessage::new_ping(12345).to_cbor().unwrap();
+        let want = b"\xa4\x61v\x01\x64type\x00\x67payload\x44PING\x62id\x19\x30\x39";
+        assert_eq!(cbor, want.to_vec());
+    }
+
+    #[test]
+    fn test_take_frames_across_reads() {
+        let mut stream = VkMessage::new_ping(1).to_cbor().unwrap();
+        stream.extend(VkMessage::new_ping(2).to_cbor().unwrap());
+        let third = VkMessage::new_ping(3).to_cbor().unwrap();
+        stream.extend_from_slice(&third[..5]);
+
+        let frames = take_frames(&mut stream).unwrap();
+        assert_eq!(frames.iter().map(|m| m.id).collect::<Vec<_>>(), [Some(1), Some(2)]);
+        assert_eq!(stream, third[..5].to_vec());
+
+        stream.extend_from_slice(&third[5..]);
+        let frames = take_frames(&mut stream).unwrap();
+        assert_eq!(frames.len(), 1);
+        assert_eq!(frames[0].payload, b"PING");
+        assert!(stream.is_empty());
+
+        assert!(take_frames(&mut vec![0xbf]).is_err());
+    }
+
+    /// Echoes each request's payload, but holds replies back until the host
+    /// stops writing, then answers newest first, between a Progress frame and
+    /// a stale reply. Reads return a few bytes at a time.
+    #[derive(Default)]
+    struct MockDevice {
+        written: Vec<u8>,
+        held: Vec<VkMessage>,
+        out: std::collections::VecDeque<u8>,
+        most_held: usize,
+    }
+
+    impl std::io::Write for MockDevice {
+        fn write(&mut self, buf: &[u8]) -> std::io::Result<usize> {
+            self.written.extend_from_slice(buf);
+            self.held.extend(take_frames(&mut self.written).unwrap());
+            self.most_held = self.most_held.max(self.held.len());
+            Ok(buf.len())
+        }
+
+        fn flush(&mut self) -> std::io::Result<()> {
+            Ok(())
+        }
+    }
+
+    impl std::io::Read for MockDevice {
+        fn read(&mut self, buf: &mut [u8]) -> std::io::Result<usize> {
+            if self.out.is_empty() {
+                for req in self.held.drain(..).rev() {
+                    let progress = VkMessage { version: 1, msg_type: MSG_PROGRESS, payload: vec![50], id: req.id };
+                    let stale = VkMessage { version: 1, msg_type: req.msg_type + 1, payload: vec![], id: Some(0x5eed_0000) };
+                    let res = VkMessage { version: 1, msg_type: req.msg_type + 1, payload: req.payload, id: req.id };
+                    for msg in [progress, stale, res] {
+                        self.out.extend(msg.to_cbor().unwrap());
+                    }
+                }
+            }
+            let n = buf.len().min(5).min(self.out.len());
+            for b in buf.iter_mut().take(n) {
+                *b = self.out.pop_front().unwrap();
+            }
+            Ok(n)
+        }
+    }
+
+    #[test]
+    fn test_exchange_matches_out_of_order_responses() {
+        let requests: Vec<(u8, Vec<u8>)> = (0..20u8).map(|i| (22, vec![i; i as usize])).collect();
+        let mut device = MockDevice::default();
+
+        let responses = exchange(&mut device, &requests, u32::MAX - 3).unwrap();
+        assert_eq!(responses.len(), requests.len());
+        for (i, res) in responses.iter().enumerate() {
+            assert_eq!(res, &requests[i].1);
+        }
+        assert_eq!(device.most_held, PIPELINE_WINDOW);
+        assert!(exchange(&mut device, &[], 0).unwrap().is_empty());
+    }
+
     #[test]
     fn test_protocol_error_handling() {
         let invalid_cbor = vec![0xFF, 0x00, 0x01];
         let result = VkMessage::from_cbor(&invalid_cbor);
         assert!(result.is_err());
     }
+
+    #[test]
+    fn test_security_status_kdf_params() {
+        let mut res = vec![2, 0, 0, 0, 0];
+        res.extend_from_slice(&3u32.to_le_bytes());
+        res.extend_from_slice(&192u32.to_le_bytes());
+        res.extend_from_slice(&2u32.to_le_bytes());
+        res.extend_from_slice(&[0xAB; 16]);
+        res.extend_from_slice(&[1, 0]);
+
+        let status = crate::parse_security_status(&res).unwrap();
+        assert_eq!(status.fail_count, 2);
+        assert!(!status.is_locked);
+        assert_eq!(status.kdf_mode, 1);
+        assert!(!status.is_setup);
+        let kdf = status.kdf.expect("KDF parameters missing");
+        assert_eq!((kdf.t_cost, kdf.m_cost, kdf.lanes), (3, 192, 2));
+        assert_eq!(kdf.salt, vec![0xAB; 16]);
+
+        // Older firmware only sends the first five bytes
+        let status = crate::parse_security_status(&[0, 0, 0, 0, 1]).unwrap();
+        assert!(status.is_locked);
+        assert!(status.kdf.is_none());
+    }
+
+    #[test]
+    fn test_base32_secret() {
+        // RFC 4648 section 10, and the usual authenticator formatting
+        assert_eq!(crate::decode_base32("MZXW6YTBOI======").unwrap(), b"foobar");
+        assert_eq!(crate::decode_base32("mzxw 6ytb oi").unwrap(), b"foobar");
+        assert!(crate::decode_base32("MZXW1").is_err());
+    }
+
+    #[test]
+    fn test_totp_batch() {
+        let mut res = vec![3, 2];
+        for (name, digits, current, next) in [("github", 6u8, 5924u32, 279037u32), ("aws", 8, 94287082, 7081804)] {
+            res.push(name.len() as u8);
+            res.extend_from_slice(name.as_bytes());
+            res.push(digits);
+            res.extend_from_slice(&30u16.to_le_bytes());
+            res.extend_from_slice(&current.to_le_bytes());
+            res.extend_from_slice(&next.to_le_bytes());
+        }
+
+        let (total, codes) = crate::parse_totp_batch(&res).unwrap();
+        assert_eq!(total, 3);
+        assert_eq!(codes.len(), 2);
+        assert_eq!(codes[0].name, "github");
+        assert_eq!((codes[0].current.as_str(), codes[0].next.as_str()), ("005924", "279037"));
+        assert_eq!((codes[1].current.as_str(), codes[1].next.as_str()), ("94287082", "07081804"));
+        assert_eq!(codes[1].period, 30);
+
+        assert!(crate::parse_totp_batch(&res[..res.len() - 1]).is_err());
+        assert!(crate::parse_totp_batch(b"FAIL").is_err());
+
+        // The rest is asked for from the third match on
+        let req = crate::totp_batch_request(0x0102, "gi", codes.len());
+        assert_eq!(req, [2, 1, 0, 0, 0, 0, 0, 0, 2, b'g', b'i', 2]);
+    }
+
+    #[test]
+    fn test_multi_get_batches() {
+        let names: Vec<String> = (0..100).map(|i| format!("entry {:02} with a long name", i)).collect();
+        let batches = crate::multi_get_batches(&names);
+        assert!(batches.len() > 1);
+        let mut asked = Vec::new();
+        for (payload, batch) in &batches {
+            assert!(payload.len() <= 960);
+            assert_eq!(payload[0], 0);
+            asked.extend_from_slice(batch);
+        }
+        assert_eq!(asked, names);
+        assert_eq!(&batches[0].0[1..8], b"\x19entry ");
+        assert!(crate::multi_get_batches(&[]).is_empty());
+
+        assert_eq!(crate::parse_vault_list(b"\x04mail\x04bank"), ["mail", "bank"]);
+        assert_eq!(crate::parse_vault_list(b"\x04mail\x09ba"), ["mail"]);
+    }
+
+    #[test]
+    fn test_vault_get_multi() {
+        // [12, [["github", h'6767'], ["none", "NOT_FOUND"]]], as the device
+        // sends it
+        let res = b"\x82\x0c\x82\x82\x66github\x42gg\x82\x64none\x69NOT_FOUND";
+        let (next, secrets) = crate::parse_vault_get_multi(res).unwrap();
+        assert_eq!(next, Some(12));
+        assert_eq!(secrets.len(), 2);
+        assert_eq!(secrets[0].name, "github");
+        assert_eq!(secrets[0].secret.as_deref(), Some("gg"));
+        assert_eq!(secrets[1].error.as_deref(), Some("NOT_FOUND"));
+        assert_eq!(secrets[1].secret, None);
+
+        let (next, secrets) = crate::parse_vault_get_multi(b"\x82\xf6\x80").unwrap();
+        assert_eq!((next, secrets.len()), (None, 0));
+
+        assert!(crate::parse_vault_get_multi(&res[..res.len() - 1]).is_err());
+        assert_eq!(crate::parse_vault_get_multi(b"LOCKED"), Err("LOCKED".to_string()));
+    }
 }
@@ -35,22 +35,45 @@ async function pingHardware() {
   }
 }
 
+// Current and next code of every TOTP entry, in one request
+let totpCodes = [];
+
 async function fetchTotp() {
+  const totpList = document.querySelector("#totp-list");
   try {
-    const code = await invoke("get_totp");
-    document.querySelector("#totp-code").textContent = code;
+    const timestamp = Math.floor(Date.now() / 1000);
+    totpCodes = await invoke("get_totp_codes", { timestamp, prefix: "" });
+    totpList.innerHTML = "";
+    totpCodes.forEach(code => {
+      const card = document.createElement("div");
+      card.className = "vault-card";
+      card.style.borderColor = "var(--accent-color)";
+      card.innerHTML = `
+        <div class="card-icon">🕒</div>
+        <div class="card-title">${code.name}</div>
+        <div class="totp-code"
+          style="font-size: 2rem; font-weight: 700; color: var(--accent-color); letter-spacing: 4px; margin: 16px 0;">
+          ${code.current}</div>
+        <div class="card-desc">Next ${code.next}, in <span class="totp-timer">${code.period}</span>s</div>
+      `;
+      code.card = card;
+      totpList.appendChild(card);
+    });
   } catch (err) {
     console.error(err);
   }
 }
 
 function startTotpTimer() {
-  const timerEl = document.querySelector("#totp-timer");
   setInterval(() => {
     const now = Math.floor(Date.now() / 1000);
-    const remains = 30 - (now % 30);
-    timerEl.textContent = remains;
-    if (remains === 30) fetchTotp();
+    let expired = false;
+    totpCodes.forEach(code => {
+      const remains = code.period - (now % code.period);
+      code.card.querySelector(".totp-timer").textContent = remains;
+      if (remains === code.period) expired = true;
+    });
+    if (expired) fetchTotp();
   }, 1000);
 }
 
@@ -81,10 +104,7 @@ async function unlockVault() {
   if (!pin) return;
 
   try {
-    const key = await invoke("derive_key", { pin });
-    // VK_MSG_AUTH_REQ = 4
-    const response = await invoke("send_command", { msgType: 4, payload: Array.from(key) });
-    const status = new TextDecoder().decode(new Uint8Array(response));
+    const status = await invoke("unlock_vault", { pin });
 
     if (status === "OK") {
       document.querySelector("#login-screen").classList.add("hidden");
@@ -0,0 +1,237 @@
+// Host throughput numbers for the firmware crypto, built by
+// host/CMakeLists.txt. Absolute figures are for the build machine; use them
+// to compare revisions, not to predict RP2350 timings.
+#include "argon2.h"
+#include "blake2b.h"
+#include "hmac_sha256.h"
+#include "p256-m.h"
+#include "tweetnacl.h"
+#include "vk_totp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static uint64_t bench_now(void) { return __rdtsc(); }
+#else
+#define BENCH_UNIT "ns"
+static uint64_t bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void bench_blake2b(size_t len, int iters) {
+  uint8_t *msg = calloc(1, len);
+  uint8_t out[BLAKE2B_OUTBYTES];
+  uint64_t best = UINT64_MAX;
+
+  for (int i = 0; i < iters; i++) {
+    uint64_t t0 = bench_now();
+    blake2b(out, sizeof(out), msg, len);
+    uint64_t t = bench_now() - t0;
+    if (t < best)
+      best = t;
+  }
+  printf("blake2b %6zu B: %8.2f %s/byte\n", len, (double)best / len,
+         BENCH_UNIT);
+  free(msg);
+}
+
+static void bench_argon2id(uint32_t t_cost, uint32_t m_cost, uint32_t lanes,
+                           argon2_backend want) {
+  if (argon2_select_backend(want) != want)
+    return;
+  size_t blocks = ARGON2_MEMORY_BLOCKS(m_cost);
+  argon2_block *memory = malloc(blocks * sizeof(argon2_block));
+  uint8_t tag[32];
+
+  double t0 = now_ms();
+  int rc = argon2id_hash_raw(t_cost, m_cost, lanes, "password", 8, "somesalt",
+                             8, tag, sizeof(tag), memory, blocks);
+  double ms = now_ms() - t0;
+  printf("argon2id %s t=%u m=%u p=%u: %8.2f ms%s\n",
+         want == ARGON2_BACKEND_AVX2 ? "avx2" : "portable", t_cost, m_cost,
+         lanes, ms, rc == ARGON2_OK ? "" : " (failed)");
+  free(memory);
+}
+
+static void bench_report(const char *name, uint64_t best) {
+  printf("%-24s %12llu %s\n", name, (unsigned long long)best, BENCH_UNIT);
+}
+
+static void bench_sha512(size_t len, int iters) {
+  static uint8_t msg[4096];
+  uint8_t out[64];
+  uint64_t best = UINT64_MAX;
+  char name[40];
+
+  for (int i = 0; i < iters; i++) {
+    uint64_t t0 = bench_now();
+    crypto_hash_sha512_tweet(out, msg, len);
+    uint64_t t1 = bench_now();
+    if (t1 - t0 < best)
+      best = t1 - t0;
+  }
+  snprintf(name, sizeof(name), "sha512 %zu B", len);
+  bench_report(name, best);
+}
+
+static void bench_ed25519(int iters) {
+  uint8_t pk[32], sk[64], msg[32] = {0}, sm[64 + sizeof(msg)], out[sizeof(sm)];
+  unsigned long long smlen, mlen;
+  uint64_t keypair = UINT64_MAX, sign = UINT64_MAX, open = UINT64_MAX;
+
+  for (int i = 0; i < iters; i++) {
+    memset(sk, i, 32);
+    uint64_t t0 = bench_now();
+    crypto_sign_ed25519_tweet_keypair(pk, sk);
+    uint64_t t1 = bench_now();
+    crypto_sign_ed25519_tweet(sm, &smlen, msg, sizeof(msg), sk);
+    uint64_t t2 = bench_now();
+    crypto_sign_ed25519_tweet_open(out, &mlen, sm, smlen, pk);
+    uint64_t t3 = bench_now();
+    if (t1 - t0 < keypair)
+      keypair = t1 - t0;
+    if (t2 - t1 < sign)
+      sign = t2 - t1;
+    if (t3 - t2 < open)
+      open = t3 - t2;
+  }
+  bench_report("ed25519 keypair", keypair);
+  bench_report("ed25519 sign 32 B", sign);
+  bench_report("ed25519 verify 32 B", open);
+}
+
+// Deterministic, the bench only needs valid scalars
+int p256_generate_random(uint8_t *output, unsigned output_size) {
+  static uint32_t state = 0x9e3779b9;
+  for (unsigned i = 0; i < output_size; i++) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    output[i] = (uint8_t)state;
+  }
+  return 0;
+}
+
+static void bench_p256(int iters) {
+  uint8_t priv[32], pub[64], peer_priv[32], peer_pub[64], secret[32];
+  uint8_t hash[32] = {0}, sig[64];
+  uint64_t keypair = UINT64_MAX, ecdh = UINT64_MAX, sign = UINT64_MAX,
+           verify = UINT64_MAX;
+
+  p256_gen_keypair(peer_priv, peer_pub);
+  for (int i = 0; i < iters; i++) {
+    uint64_t t0 = bench_now();
+    p256_gen_keypair(priv, pub);
+    uint64_t t1 = bench_now();
+    p256_ecdh_shared_secret(secret, priv, peer_pub);
+    uint64_t t2 = bench_now();
+    p256_ecdsa_sign(sig, priv, hash, sizeof(hash));
+    uint64_t t3 = bench_now();
+    p256_ecdsa_verify(sig, pub, hash, sizeof(hash));
+    uint64_t t4 = bench_now();
+    if (t1 - t0 < keypair)
+      keypair = t1 - t0;
+    if (t2 - t1 < ecdh)
+      ecdh = t2 - t1;
+    if (t3 - t2 < sign)
+      sign = t3 - t2;
+    if (t4 - t3 < verify)
+      verify = t4 - t3;
+  }
+  bench_report("p256 gen_keypair", keypair);
+  bench_report("p256 ecdh", ecdh);
+  bench_report("p256 ecdsa sign", sign);
+  bench_report("p256 ecdsa verify", verify);
+}
+
+// A MAC from the raw key against one from a prepared key schedule, which
+// skips the ipad and opad compressions; and HKDF for a 32-byte key
+static void bench_hmac_sha256(size_t len, int iters) {
+  static const uint8_t key[32] = {1};
+  uint8_t msg[1024] = {0}, mac[32], okm[32];
+  uint64_t raw = UINT64_MAX, keyed = UINT64_MAX, hkdf = UINT64_MAX;
+  hmac_sha256_key k;
+  char name[40];
+
+  hmac_sha256_setup(&k, key, sizeof(key));
+  for (int i = 0; i < iters; i++) {
+    uint64_t t0 = bench_now();
+    hmac_sha256(key, sizeof(key), msg, len, mac);
+    uint64_t t1 = bench_now();
+    hmac_sha256_keyed(&k, msg, len, mac);
+    uint64_t t2 = bench_now();
+    hkdf_sha256(okm, sizeof(okm), key, sizeof(key), msg, len, NULL, 0);
+    uint64_t t3 = bench_now();
+    if (t1 - t0 < raw)
+      raw = t1 - t0;
+    if (t2 - t1 < keyed)
+      keyed = t2 - t1;
+    if (t3 - t2 < hkdf)
+      hkdf = t3 - t2;
+  }
+  snprintf(name, sizeof(name), "hmac-sha256 %zu B", len);
+  bench_report(name, raw);
+  snprintf(name, sizeof(name), "hmac-sha256 keyed %zu B", len);
+  bench_report(name, keyed);
+  snprintf(name, sizeof(name), "hkdf-sha256 %zu B", len);
+  bench_report(name, hkdf);
+}
+
+// One code from the raw seed (four compressions) against one from cached
+// midstates (two)
+static void bench_totp(int iters) {
+  const uint8_t *seed = (const uint8_t *)"12345678901234567890";
+  uint64_t full = UINT64_MAX, cached = UINT64_MAX;
+  volatile uint32_t sink = 0;
+  vk_totp_key_t k;
+
+  vk_totp_key_init(&k, VK_TOTP_SHA1, 6, 30, seed, 20);
+  for (int i = 0; i < iters; i++) {
+    uint64_t t0 = bench_now();
+    sink += vk_totp_generate(seed, 20, 30u * i);
+    uint64_t t1 = bench_now();
+    sink += vk_totp_code(&k, 30u * i);
+    uint64_t t2 = bench_now();
+    if (t1 - t0 < full)
+      full = t1 - t0;
+    if (t2 - t1 < cached)
+      cached = t2 - t1;
+  }
+  bench_report("totp from seed", full);
+  bench_report("totp from midstates", cached);
+}
+
+int main(void) {
+  bench_blake2b(64, 10000);
+  bench_blake2b(1024, 2000);
+  bench_blake2b(65536, 100);
+
+  for (int b = ARGON2_BACKEND_PORTABLE; b <= ARGON2_BACKEND_AVX2; b++) {
+    bench_argon2id(3, 256, 2, b);
+    bench_argon2id(3, 4096, 2, b);
+    bench_argon2id(2, 65536, 1, b);
+  }
+  argon2_select_backend(ARGON2_BACKEND_AUTO);
+
+  bench_sha512(64, 2000);
+  bench_sha512(4096, 200);
+  bench_ed25519(20);
+  bench_p256(20);
+  bench_hmac_sha256(32, 1000);
+  bench_hmac_sha256(1024, 200);
+  bench_totp(1000);
+  return 0;
+}
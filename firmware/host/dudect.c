@@ -0,0 +1,312 @@
+// Timing-leak check for secret-dependent code, after dudect (Reparaz,
+// Balasch and Verbauwhede, "Dude, is my code constant time?", 2017).
+//
+// Each case runs one primitive on inputs of two classes, a fixed secret and
+// fresh random ones, interleaved in random order. A Welch t-test then
+// compares the two timing distributions, once on all measurements and once
+// per cut-off that drops the slowest ones (interrupts, migrations). |t|
+// above VK_DUDECT_T_LEAK on any of them is reported as a leak.
+//
+// Not part of ctest: the result is statistical and a full run takes about
+// half a minute on a desktop. Run it through the build:
+//   cmake --build build-host --target dudect
+// or pick cases by name prefix: ./vk_host_dudect aes gcm
+#include "aes.h"
+#include "p256-m.h"
+#include "tweetnacl.h"
+#include "vault.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t dudect_now(void) { return __rdtsc(); }
+#else
+static uint64_t dudect_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+// dudect's thresholds: 4.5 is the usual line, far beyond it is certain
+#define VK_DUDECT_T_LEAK 4.5
+
+#define VK_DUDECT_BATCH 10000
+// Cut-offs at percentiles 1 - 0.5^(10 (i + 1) / CROPS) of the first batch
+#define VK_DUDECT_CROPS 10
+
+typedef struct {
+  double n[2], mean[2], m2[2];
+} welch_t;
+
+static void welch_push(welch_t *w, int cls, double x) {
+  double d = x - w->mean[cls];
+  w->n[cls]++;
+  w->mean[cls] += d / w->n[cls];
+  w->m2[cls] += d * (x - w->mean[cls]);
+}
+
+static double welch_compute(const welch_t *w) {
+  if (w->n[0] < 2 || w->n[1] < 2)
+    return 0;
+  double v0 = w->m2[0] / (w->n[0] - 1), v1 = w->m2[1] / (w->n[1] - 1);
+  double se = sqrt(v0 / w->n[0] + v1 / w->n[1]);
+  return se > 0 ? (w->mean[0] - w->mean[1]) / se : 0;
+}
+
+// Test inputs only need to be unpredictable to the code under test
+static uint64_t rng_state;
+
+static uint64_t rng_next(void) {
+  uint64_t z = (rng_state += 0x9e3779b97f4a7c15u);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+  return z ^ (z >> 31);
+}
+
+static void rng_fill(uint8_t *buf, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    buf[i] = (uint8_t)rng_next();
+}
+
+int p256_generate_random(uint8_t *output, unsigned output_size) {
+  rng_fill(output, output_size);
+  return 0;
+}
+
+// Results go here so the calls cannot be optimised away
+static volatile uint32_t sink;
+
+// --- Cases ---
+//
+// prepare() fills one input of class 0 (the fixed secret) or 1 (random)
+// outside the timed region; run() is the only thing timed.
+
+typedef struct {
+  const char *name;
+  size_t input_len;
+  uint32_t samples;
+  void (*init)(void);
+  void (*prepare)(uint8_t *in, int cls);
+  void (*run)(const uint8_t *in);
+} dudect_case_t;
+
+static uint8_t fixed_in[64];
+static uint8_t key[32];
+static uint8_t gcm_ct[16], gcm_tag[16];
+static const uint8_t gcm_iv[12];
+static struct AES_ctx aes;
+static uint8_t peer_pub[64];
+
+static void prepare_fixed(uint8_t *in, size_t len, int cls) {
+  if (cls == 0)
+    memcpy(in, fixed_in, len);
+  else
+    rng_fill(in, len);
+}
+
+// Stored FIDO PIN hash against the fixed, matching hash or random ones
+static void init_fido_pin(void) {
+  rng_fill(fixed_in, 32);
+  vault_fido_set_pin(fixed_in);
+}
+static void prepare_32(uint8_t *in, int cls) { prepare_fixed(in, 32, cls); }
+static void run_fido_pin(const uint8_t *in) {
+  sink += vault_fido_verify_pin(in);
+}
+
+// Unlock canary check with a fixed wrong key against random wrong keys
+static void init_canary(void) {
+  rng_fill(key, sizeof(key));
+  vault_setup_canary(key);
+  rng_fill(fixed_in, 32);
+}
+static void run_canary(const uint8_t *in) { sink += vault_verify_pin(in); }
+
+// Tag check: wrong only in the last byte against random tags
+static void init_gcm_tag(void) {
+  uint8_t pt[16];
+  rng_fill(key, sizeof(key));
+  rng_fill(pt, sizeof(pt));
+  vk_crypto_encrypt(key, pt, sizeof(pt), (uint8_t *)gcm_iv, gcm_tag, gcm_ct);
+  memcpy(fixed_in, gcm_tag, 16);
+  fixed_in[15] ^= 1;
+}
+static void prepare_16(uint8_t *in, int cls) { prepare_fixed(in, 16, cls); }
+static void run_gcm_tag(const uint8_t *in) {
+  uint8_t pt[16];
+  sink += vk_crypto_decrypt(key, gcm_ct, sizeof(gcm_ct), gcm_iv, in, pt);
+}
+
+// GHASH over secret data: fixed against random plaintext, fixed key
+static void init_gcm_encrypt(void) {
+  rng_fill(key, sizeof(key));
+  rng_fill(fixed_in, 64);
+}
+static void prepare_64(uint8_t *in, int cls) { prepare_fixed(in, 64, cls); }
+static void run_gcm_encrypt(const uint8_t *in) {
+  uint8_t iv[12] = {0}, tag[16], ct[64];
+  vk_crypto_encrypt(key, in, 64, iv, tag, ct);
+  sink += tag[0];
+}
+
+// S-box lookups on secret state
+static void init_aes_block(void) {
+  rng_fill(key, sizeof(key));
+  AES_init_ctx(&aes, key);
+  rng_fill(fixed_in, 16);
+}
+static void run_aes_block(const uint8_t *in) {
+  uint8_t buf[16];
+  memcpy(buf, in, sizeof(buf));
+  AES_ECB_encrypt(&aes, buf);
+  sink += buf[0];
+}
+
+static void init_random(void) { rng_fill(fixed_in, sizeof(fixed_in)); }
+static void run_aes_key(const uint8_t *in) {
+  struct AES_ctx ctx;
+  AES_init_ctx(&ctx, in);
+  sink += ctx.RoundKey[AES_keyExpSize - 1];
+}
+
+// Comb multiplication of the base point by the hashed seed
+static void run_ed25519_keypair(const uint8_t *in) {
+  uint8_t pk[32], sk[64];
+  memcpy(sk, in, 32);
+  crypto_sign_ed25519_tweet_keypair(pk, sk);
+  sink += pk[0];
+}
+
+// Ed25519 signing key: seed plus public key; the public half only feeds the
+// hash, so random bytes there are as good as the real one
+static void run_ed25519_sign(const uint8_t *in) {
+  static const uint8_t msg[32];
+  uint8_t sm[64 + sizeof(msg)];
+  unsigned long long smlen;
+  crypto_sign_ed25519_tweet(sm, &smlen, msg, sizeof(msg), in);
+  sink += sm[0];
+}
+
+static void init_p256_ecdh(void) {
+  uint8_t priv[32];
+  p256_gen_keypair(priv, peer_pub);
+  rng_fill(fixed_in, 32);
+}
+static void run_p256_ecdh(const uint8_t *in) {
+  uint8_t secret[32];
+  sink += p256_ecdh_shared_secret(secret, in, peer_pub);
+}
+
+static const dudect_case_t cases[] = {
+    {"fido pin compare", 32, 1000000, init_fido_pin, prepare_32, run_fido_pin},
+    {"vault canary check", 32, 200000, init_canary, prepare_32, run_canary},
+    {"gcm tag compare", 16, 200000, init_gcm_tag, prepare_16, run_gcm_tag},
+    {"gcm encrypt 64 B", 64, 200000, init_gcm_encrypt, prepare_64,
+     run_gcm_encrypt},
+    {"aes-256 block", 16, 1000000, init_aes_block, prepare_16, run_aes_block},
+    {"aes-256 key expansion", 32, 1000000, init_random, prepare_32,
+     run_aes_key},
+    {"ed25519 keypair", 32, 20000, init_random, prepare_32,
+     run_ed25519_keypair},
+    {"ed25519 sign", 64, 20000, init_random, prepare_64, run_ed25519_sign},
+    {"p256 ecdh", 32, 5000, init_p256_ecdh, prepare_32, run_p256_ecdh},
+};
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Runs one case; returns the largest |t| over the uncropped test and the
+// cut-offs
+static double dudect_run(const dudect_case_t *c) {
+  uint32_t batch = c->samples < VK_DUDECT_BATCH ? c->samples / 10
+                                                : VK_DUDECT_BATCH;
+  uint8_t *in = malloc((size_t)batch * c->input_len);
+  uint8_t *cls = malloc(batch);
+  uint64_t *t = malloc(batch * sizeof(*t));
+  uint64_t crop[VK_DUDECT_CROPS];
+  welch_t w[1 + VK_DUDECT_CROPS] = {0};
+  double worst = 0;
+
+  if (!in || !cls || !t) {
+    fprintf(stderr, "out of memory\n");
+    exit(2);
+  }
+  if (c->init)
+    c->init();
+
+  // One extra batch up front: warms caches and sets the cut-offs
+  for (uint32_t done = 0; done < c->samples + batch; done += batch) {
+    for (uint32_t i = 0; i < batch; i++) {
+      cls[i] = rng_next() & 1;
+      c->prepare(in + (size_t)i * c->input_len, cls[i]);
+    }
+    for (uint32_t i = 0; i < batch; i++) {
+      const uint8_t *x = in + (size_t)i * c->input_len;
+      uint64_t t0 = dudect_now();
+      c->run(x);
+      t[i] = dudect_now() - t0;
+    }
+
+    if (done == 0) {
+      qsort(t, batch, sizeof(*t), cmp_u64);
+      for (int k = 0; k < VK_DUDECT_CROPS; k++) {
+        double p = 1 - pow(0.5, 10.0 * (k + 1) / VK_DUDECT_CROPS);
+        crop[k] = t[(uint32_t)(p * (batch - 1))];
+      }
+      continue;
+    }
+    for (uint32_t i = 0; i < batch; i++) {
+      welch_push(&w[0], cls[i], (double)t[i]);
+      for (int k = 0; k < VK_DUDECT_CROPS; k++) {
+        if (t[i] <= crop[k])
+          welch_push(&w[1 + k], cls[i], (double)t[i]);
+      }
+    }
+  }
+
+  for (int k = 0; k <= VK_DUDECT_CROPS; k++) {
+    double tk = fabs(welch_compute(&w[k]));
+    if (tk > worst)
+      worst = tk;
+  }
+  free(in);
+  free(cls);
+  free(t);
+  return worst;
+}
+
+static int selected(const char *name, int argc, char **argv) {
+  if (argc < 2)
+    return 1;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(name, argv[i], strlen(argv[i])) == 0)
+      return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  int leaks = 0;
+
+  rng_state = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+  printf("%-24s %9s %9s\n", "case", "samples", "max |t|");
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    const dudect_case_t *c = &cases[i];
+    if (!selected(c->name, argc, argv))
+      continue;
+    double t = dudect_run(c);
+    int leak = t > VK_DUDECT_T_LEAK;
+    printf("%-24s %9u %9.2f %s\n", c->name, c->samples, t,
+           leak ? "LEAK" : "ok");
+    fflush(stdout);
+    leaks += leak;
+  }
+  return leaks ? 1 : 0;
+}
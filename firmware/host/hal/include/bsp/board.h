@@ -0,0 +1,9 @@
+// Host stand-in for the TinyUSB BSP header of the same name
+#ifndef VK_HOST_BSP_BOARD_H
+#define VK_HOST_BSP_BOARD_H
+
+#include <stdint.h>
+
+uint32_t board_millis(void);
+
+#endif // VK_HOST_BSP_BOARD_H
@@ -0,0 +1,23 @@
+// Host stand-in for the Pico SDK header of the same name. Flash is a memory
+// image read through XIP_BASE like the real XIP window: 2 MiB of RAM unless
+// vk_host_flash_map (vk_host_hal.h) puts a caller's image there.
+#ifndef VK_HOST_HARDWARE_FLASH_H
+#define VK_HOST_HARDWARE_FLASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLASH_PAGE_SIZE 256
+#define FLASH_SECTOR_SIZE 4096
+#define VK_HOST_FLASH_SIZE (2 * 1024 * 1024)
+
+uintptr_t vk_host_xip_base(void);
+#define XIP_BASE vk_host_xip_base()
+
+// Like NOR flash, erase sets a sector to 0xFF and programming can only
+// clear bits. Both abort on a range outside the mapped image.
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data,
+                         size_t count);
+
+#endif // VK_HOST_HARDWARE_FLASH_H
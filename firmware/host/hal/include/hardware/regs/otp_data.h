@@ -0,0 +1,14 @@
+// Host stand-in for the Pico SDK header of the same name: the page lock
+// fields vk_crypto.c sets
+#ifndef VK_HOST_HARDWARE_REGS_OTP_DATA_H
+#define VK_HOST_HARDWARE_REGS_OTP_DATA_H
+
+#define OTP_DATA_PAGE0_LOCK1_ROW 0x00000f81
+#define OTP_DATA_PAGE0_LOCK1_LOCK_BL_LSB 4
+#define OTP_DATA_PAGE0_LOCK1_LOCK_BL_VALUE_INACCESSIBLE 0x3
+#define OTP_DATA_PAGE0_LOCK1_LOCK_NS_LSB 2
+#define OTP_DATA_PAGE0_LOCK1_LOCK_NS_VALUE_INACCESSIBLE 0x3
+#define OTP_DATA_PAGE0_LOCK1_LOCK_S_LSB 0
+#define OTP_DATA_PAGE0_LOCK1_LOCK_S_VALUE_READ_ONLY 0x1
+
+#endif // VK_HOST_HARDWARE_REGS_OTP_DATA_H
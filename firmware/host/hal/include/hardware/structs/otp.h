@@ -0,0 +1,19 @@
+// Host stand-in for the Pico SDK header of the same name. Only the SW_LOCK
+// registers, as plain memory.
+#ifndef VK_HOST_HARDWARE_STRUCTS_OTP_H
+#define VK_HOST_HARDWARE_STRUCTS_OTP_H
+
+#include <stdint.h>
+
+#define OTP_SW_LOCK0_NSEC_LSB 2
+#define OTP_SW_LOCK0_NSEC_VALUE_INACCESSIBLE 0x3
+#define OTP_SW_LOCK0_SEC_LSB 0
+#define OTP_SW_LOCK0_SEC_VALUE_READ_ONLY 0x1
+
+typedef struct {
+  uint32_t sw_lock[64];
+} otp_hw_t;
+
+extern otp_hw_t *const otp_hw;
+
+#endif // VK_HOST_HARDWARE_STRUCTS_OTP_H
@@ -0,0 +1,10 @@
+// Host stand-in for the Pico SDK header of the same name
+#ifndef VK_HOST_HARDWARE_SYNC_H
+#define VK_HOST_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+
+#endif // VK_HOST_HARDWARE_SYNC_H
@@ -0,0 +1,21 @@
+// Host stand-in for the Pico SDK header of the same name. The OTP rows are
+// emulated in RAM: blank at start-up, and a write can only set bits.
+#ifndef VK_HOST_PICO_BOOTROM_H
+#define VK_HOST_PICO_BOOTROM_H
+
+#include <stdint.h>
+
+#define BOOTROM_OK 0
+#define BOOTROM_ERROR_INVALID_ARG -4
+
+#define OTP_CMD_WRITE_BITS 0x00010000
+#define OTP_CMD_ECC_BITS 0x00020000
+#define OTP_CMD_ROW_BITS 0x0000ffff
+
+typedef struct {
+  uint32_t flags;
+} otp_cmd_t;
+
+int rom_func_otp_access(uint8_t *buf, uint32_t buf_len, otp_cmd_t cmd);
+
+#endif // VK_HOST_PICO_BOOTROM_H
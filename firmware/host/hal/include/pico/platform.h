@@ -0,0 +1,8 @@
+// Host stand-in for the Pico SDK header of the same name: just enough for
+// the firmware sources built by host/CMakeLists.txt
+#ifndef VK_HOST_PICO_PLATFORM_H
+#define VK_HOST_PICO_PLATFORM_H
+
+#define __uninitialized_ram(group) group
+
+#endif // VK_HOST_PICO_PLATFORM_H
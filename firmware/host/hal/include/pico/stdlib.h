@@ -0,0 +1,10 @@
+// Host stand-in for the Pico SDK header of the same name
+#ifndef VK_HOST_PICO_STDLIB_H
+#define VK_HOST_PICO_STDLIB_H
+
+#include "pico/platform.h"
+#include "pico/time.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#endif // VK_HOST_PICO_STDLIB_H
@@ -0,0 +1,11 @@
+// Host stand-in for the Pico SDK header of the same name
+#ifndef VK_HOST_PICO_TIME_H
+#define VK_HOST_PICO_TIME_H
+
+#include <stdint.h>
+
+// Monotonic clock, microseconds
+uint64_t time_us_64(void);
+void sleep_ms(uint32_t ms);
+
+#endif // VK_HOST_PICO_TIME_H
@@ -0,0 +1,13 @@
+// Host stand-in for the TinyUSB header of the same name: the HID calls
+// vk_fido.c makes. There is no host to take reports, so none are sent.
+#ifndef VK_HOST_TUSB_H
+#define VK_HOST_TUSB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+bool tud_hid_n_ready(uint8_t instance);
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const *report,
+                      uint16_t len);
+
+#endif // VK_HOST_TUSB_H
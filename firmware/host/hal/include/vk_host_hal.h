@@ -0,0 +1,34 @@
+// Controls for the Pico SDK stand-ins that only host programs need
+#ifndef VK_HOST_HAL_H
+#define VK_HOST_HAL_H
+
+#include "vk_crypto.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Use a caller's buffer as flash from now on.
+ * @param image Flash contents from offset flash_offs on; written by erase
+ * and program, so map files privately unless they should change.
+ * @param flash_offs Flash offset of image[0].
+ * @param len Image length.
+ */
+void vk_host_flash_map(uint8_t *image, uint32_t flash_offs, size_t len);
+
+// The emulated OTP rows of the device secret (VK_OTP_SECRET_ROW)
+void vk_host_otp_read(uint8_t secret[VK_DEVICE_SECRET_SIZE]);
+void vk_host_otp_write(const uint8_t secret[VK_DEVICE_SECRET_SIZE]);
+// The raw PAGEn_LOCK1 row of the secret's page (SW_LOCK is in otp_hw)
+uint32_t vk_host_otp_page_lock(void);
+
+// Run queued jobs (vault_init's KDF calibration) to the end, the way the
+// firmware main loop would
+void vk_host_run_jobs(void);
+
+// Provision secret, run vault_init and its calibration on fresh flash, then
+// set the vault up with pin the way the app does (Argon2id, then
+// vault_setup_prekey). Leaves it unlocked. false if any step failed.
+bool vk_host_open_vault(const uint8_t secret[VK_DEVICE_SECRET_SIZE],
+                        const char *pin);
+
+#endif // VK_HOST_HAL_H
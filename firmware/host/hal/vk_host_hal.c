@@ -0,0 +1,189 @@
+// Host implementations of the Pico SDK calls used by the firmware sources
+// that host/CMakeLists.txt builds (vault.c, vk_crypto.c, vk_fido.c). See
+// include/ for the matching headers.
+#include "argon2.h"
+#include "bsp/board.h"
+#include "hardware/flash.h"
+#include "hardware/regs/otp_data.h"
+#include "hardware/structs/otp.h"
+#include "pico/bootrom.h"
+#include "pico/time.h"
+#include "tusb.h"
+#include "vault.h"
+#include "vk_crypto.h"
+#include "vk_drbg.h"
+#include "vk_fido.h"
+#include "vk_host_hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static uint8_t vk_host_flash_ram[VK_HOST_FLASH_SIZE];
+static uint8_t *flash_image = vk_host_flash_ram;
+static uint32_t flash_first;
+static size_t flash_len = sizeof(vk_host_flash_ram);
+
+// Flash leaves the factory erased
+__attribute__((constructor)) static void vk_host_flash_init(void) {
+  memset(vk_host_flash_ram, 0xFF, sizeof(vk_host_flash_ram));
+}
+
+void vk_host_flash_map(uint8_t *image, uint32_t flash_offs, size_t len) {
+  flash_image = image;
+  flash_first = flash_offs;
+  flash_len = len;
+}
+
+uintptr_t vk_host_xip_base(void) {
+  return (uintptr_t)flash_image - flash_first;
+}
+
+static uint8_t *vk_host_flash_at(uint32_t offs, size_t count) {
+  if (offs < flash_first || offs - flash_first > flash_len ||
+      count > flash_len - (offs - flash_first)) {
+    fprintf(stderr, "flash access out of range: 0x%x + %zu\n", offs, count);
+    abort();
+  }
+  return flash_image + (offs - flash_first);
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+  if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE) {
+    fprintf(stderr, "flash erase not sector aligned: 0x%x + %zu\n",
+            flash_offs, count);
+    abort();
+  }
+  memset(vk_host_flash_at(flash_offs, count), 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data,
+                         size_t count) {
+  uint8_t *p = vk_host_flash_at(flash_offs, count);
+  for (size_t i = 0; i < count; i++)
+    p[i] &= data[i];
+}
+
+uint64_t time_us_64(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+void sleep_ms(uint32_t ms) {
+  struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+  nanosleep(&ts, NULL);
+}
+
+uint32_t board_millis(void) { return (uint32_t)(time_us_64() / 1000u); }
+
+// The device reads raw TRNG samples (src/vk_trng.c); the host uses the
+// operating system's random source
+uint32_t vk_drbg_noise(void) {
+  static FILE *urandom;
+  uint32_t v;
+
+  if (!urandom)
+    urandom = fopen("/dev/urandom", "rb");
+  if (!urandom || fread(&v, sizeof(v), 1, urandom) != 1) {
+    fprintf(stderr, "no /dev/urandom\n");
+    abort();
+  }
+  return v;
+}
+
+// The device secret rows (16 ECC rows of two bytes each) and the raw
+// PAGEn_LOCK1 row of their page
+static uint8_t vk_host_otp[VK_DEVICE_SECRET_SIZE];
+static uint32_t vk_host_otp_lock1;
+
+#define VK_HOST_OTP_LOCK1_ROW                                                  \
+  (OTP_DATA_PAGE0_LOCK1_ROW + 2 * (VK_OTP_SECRET_ROW / 64))
+
+static otp_hw_t vk_host_otp_hw;
+otp_hw_t *const otp_hw = &vk_host_otp_hw;
+
+int rom_func_otp_access(uint8_t *buf, uint32_t buf_len, otp_cmd_t cmd) {
+  if ((cmd.flags & OTP_CMD_ROW_BITS) == VK_HOST_OTP_LOCK1_ROW &&
+      !(cmd.flags & OTP_CMD_ECC_BITS) && buf_len == 4) {
+    uint32_t row;
+    memcpy(&row, buf, 4);
+    if (cmd.flags & OTP_CMD_WRITE_BITS)
+      vk_host_otp_lock1 |= row & 0xffffff;
+    else
+      memcpy(buf, &vk_host_otp_lock1, 4);
+    return BOOTROM_OK;
+  }
+  if ((cmd.flags & OTP_CMD_ROW_BITS) != VK_OTP_SECRET_ROW ||
+      buf_len != sizeof(vk_host_otp))
+    return BOOTROM_ERROR_INVALID_ARG;
+  if (cmd.flags & OTP_CMD_WRITE_BITS) {
+    for (uint32_t i = 0; i < buf_len; i++)
+      vk_host_otp[i] |= buf[i];
+  } else {
+    memcpy(buf, vk_host_otp, buf_len);
+  }
+  return BOOTROM_OK;
+}
+
+void vk_host_otp_read(uint8_t secret[VK_DEVICE_SECRET_SIZE]) {
+  memcpy(secret, vk_host_otp, sizeof(vk_host_otp));
+}
+
+void vk_host_otp_write(const uint8_t secret[VK_DEVICE_SECRET_SIZE]) {
+  memcpy(vk_host_otp, secret, sizeof(vk_host_otp));
+}
+
+uint32_t vk_host_otp_page_lock(void) { return vk_host_otp_lock1; }
+
+// The FIDO session state lives in vk_fido.c. Programs without it never fill
+// it, so there is nothing for vault.c to drop; weak so that programs that do
+// build vk_fido.c (test_pool.c) get the real ones.
+__attribute__((weak)) void vk_fido_reset_session(void) {}
+__attribute__((weak)) void vk_fido_forget_key(const uint8_t *cred_id) {
+  (void)cred_id;
+}
+
+bool tud_hid_n_ready(uint8_t instance) {
+  (void)instance;
+  return false;
+}
+
+bool tud_hid_n_report(uint8_t instance, uint8_t report_id, void const *report,
+                      uint16_t len) {
+  (void)instance;
+  (void)report_id;
+  (void)report;
+  (void)len;
+  return false;
+}
+
+void vk_host_run_jobs(void) {
+  while (vk_job_busy())
+    vk_job_task(board_millis());
+}
+
+bool vk_host_open_vault(const uint8_t secret[VK_DEVICE_SECRET_SIZE],
+                        const char *pin) {
+  uint8_t prekey[32] = {0};
+
+  vk_host_otp_write(secret);
+  // A fresh vault calibrates the KDF as a job and refuses setup until then
+  bool ok = vault_init() && vk_job_busy() &&
+            !vault_setup_prekey(vault_get_kdf_params(), prekey);
+  vk_host_run_jobs();
+
+  // The app's side of setup: Argon2id over the PIN
+  vk_kdf_params_t params = *vault_get_kdf_params();
+  size_t blocks = ARGON2_MEMORY_BLOCKS((size_t)params.m_cost);
+  argon2_block *memory = malloc(blocks * sizeof(argon2_block));
+  if (!memory)
+    return false;
+  argon2id_hash_raw(params.t_cost, params.m_cost, params.lanes, pin,
+                    strlen(pin), params.salt, ARGON2_SALT_SIZE, prekey, 32,
+                    memory, blocks);
+  free(memory);
+  ok = vault_setup_prekey(&params, prekey) && ok;
+  vk_crypto_zeroize(prekey, sizeof(prekey));
+  return ok;
+}
@@ -0,0 +1,421 @@
+// Offline recovery, audit and migration of a dumped vault image. vault.c
+// and vk_crypto.c run unchanged on the Pico SDK stand-ins in hal/, with the
+// dump mapped in as flash; Argon2 and the record decryption use the fastest
+// backend the CPU has (--portable forces the device code paths).
+//
+// The vault key is HMAC-SHA256(device secret, Argon2id(PIN)), so recovery
+// needs the 32-byte device secret from the chip's OTP rows as well as the
+// PIN. The retry counter does not apply: whoever holds both can already
+// guess offline. The firmware locks that OTP page against the bootloader
+// (vk_crypto.c), so picotool cannot read the secret from a provisioned chip.
+#include "argon2.h"
+#include "vault.h"
+#include "vk_host_gcm.h"
+#include "vk_host_hal.h"
+#include "vk_totp.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+static void usage(void) {
+  fprintf(
+      stderr,
+      "usage: vk_recover [--portable] info    IMAGE\n"
+      "       vk_recover [--portable] verify  IMAGE SECRET\n"
+      "       vk_recover [--portable] dump    IMAGE SECRET\n"
+      "       vk_recover [--portable] migrate IMAGE SECRET NEW_SECRET OUT\n"
+      "\n"
+      "IMAGE   dump of the whole flash, or of the %u-byte vault region at\n"
+      "        flash offset 0x%x\n"
+      "SECRET  the %u-byte device secret from OTP row 0x%x, raw\n"
+      "\n"
+      "info     header and record layout, no key needed\n"
+      "verify   check the PIN and the tag of every record\n"
+      "dump     print every record in the clear\n"
+      "migrate  re-encrypt for a device with NEW_SECRET, into OUT\n"
+      "\n"
+      "The PIN is read from standard input.\n",
+      VAULT_FLASH_SIZE, VAULT_FLASH_OFFSET, VK_DEVICE_SECRET_SIZE,
+      VK_OTP_SECRET_ROW);
+}
+
+static int fail(const char *what) {
+  fprintf(stderr, "vk_recover: %s\n", what);
+  return 1;
+}
+
+// --- Image ---
+
+typedef struct {
+  uint8_t *map;
+  size_t len;
+} image_t;
+
+// Mapped privately: vault.c writes back (retry counter, migration) land in
+// the mapping, never in the dump
+static int image_open(const char *path, image_t *img) {
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  uint32_t first;
+
+  if (fd < 0 || fstat(fd, &st) < 0) {
+    perror(path);
+    return -1;
+  }
+  img->len = (size_t)st.st_size;
+  if (img->len == VAULT_FLASH_SIZE) {
+    first = VAULT_FLASH_OFFSET;
+  } else if (img->len >= VAULT_FLASH_OFFSET + VAULT_FLASH_SIZE) {
+    first = 0;
+  } else {
+    close(fd);
+    fprintf(stderr, "%s: neither a flash nor a vault region dump\n", path);
+    return -1;
+  }
+  img->map = mmap(NULL, img->len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (img->map == MAP_FAILED) {
+    perror(path);
+    return -1;
+  }
+
+  // The security state leads the stored image; vault_init would format
+  // anything without its magic, or recalibrate a pre-calibration vault
+  const security_state_t *sec =
+      (const security_state_t *)(img->map + (VAULT_FLASH_OFFSET - first));
+  if (sec->magic != SECURITY_STATE_MAGIC) {
+    fprintf(stderr, "%s: no vault at 0x%x\n", path, VAULT_FLASH_OFFSET);
+    return -1;
+  }
+  if (sec->kdf.m_cost == 0) {
+    fprintf(stderr, "%s: vault predates KDF calibration\n", path);
+    return -1;
+  }
+
+  vk_host_flash_map(img->map, first, img->len);
+  return 0;
+}
+
+static int image_save(const image_t *img, const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (!f || fwrite(img->map, 1, img->len, f) != img->len || fclose(f) != 0) {
+    perror(path);
+    return -1;
+  }
+  return 0;
+}
+
+static int read_secret(const char *path, uint8_t out[VK_DEVICE_SECRET_SIZE]) {
+  FILE *f = fopen(path, "rb");
+  int extra;
+  if (!f) {
+    perror(path);
+    return -1;
+  }
+  size_t n = fread(out, 1, VK_DEVICE_SECRET_SIZE, f);
+  extra = fgetc(f);
+  fclose(f);
+  if (n != VK_DEVICE_SECRET_SIZE || extra != EOF) {
+    fprintf(stderr, "%s: expected %u bytes\n", path, VK_DEVICE_SECRET_SIZE);
+    return -1;
+  }
+  return 0;
+}
+
+// One line from stdin, without echo on a terminal
+static int read_pin(char *pin, size_t size) {
+  struct termios old, quiet;
+  int tty = isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &old) == 0;
+
+  if (tty) {
+    fprintf(stderr, "PIN: ");
+    quiet = old;
+    quiet.c_lflag &= ~(tcflag_t)ECHO;
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &quiet);
+  }
+  char *line = fgets(pin, (int)size, stdin);
+  if (tty) {
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &old);
+    fprintf(stderr, "\n");
+  }
+  if (!line)
+    return -1;
+  pin[strcspn(pin, "\r\n")] = 0;
+  return 0;
+}
+
+// --- Key ---
+
+// Argon2id with the vault's own parameters, in heap memory so host-mode
+// vaults (far more than the device arena) derive as well
+static int derive_prekey(const char *pin, uint8_t prekey[32]) {
+  const vk_kdf_params_t *p = vault_get_kdf_params();
+  size_t blocks = ARGON2_MEMORY_BLOCKS((size_t)p->m_cost);
+  argon2_block *memory = malloc(blocks * sizeof(argon2_block));
+
+  if (!memory)
+    return -1;
+  int res = argon2id_hash_raw(p->t_cost, p->m_cost, p->lanes, pin,
+                              strlen(pin), p->salt, ARGON2_SALT_SIZE, prekey,
+                              32, memory, blocks);
+  free(memory);
+  return res == ARGON2_OK ? 0 : -1;
+}
+
+// Prekey to vault key under the secret in the emulated OTP, then the canary
+// check vault_unlock_prekey would do, minus the retry counter
+static int unlock(const uint8_t prekey[32], uint8_t key[32]) {
+  if (!vk_crypto_device_bind(prekey, key) || !vault_verify_pin(key))
+    return -1;
+  vault_set_session_key(key);
+  return 0;
+}
+
+// --- Records ---
+
+typedef struct {
+  vault_entry_t entry;
+  uint8_t plain[ENTRY_SECRET_MAX];
+  bool ok;
+} record_t;
+
+static int load_records(record_t *rec) {
+  static char names[MAX_ENTRIES][ENTRY_NAME_MAX];
+  int n = vault_list(names, MAX_ENTRIES);
+  for (int i = 0; i < n; i++)
+    vault_get(names[i], &rec[i].entry);
+  return n;
+}
+
+// Every record with one key schedule per record on the chosen backend
+static int decrypt_records(const vk_host_gcm_t *gcm, const uint8_t key[32],
+                           record_t *rec, int n) {
+  int bad = 0;
+  for (int i = 0; i < n; i++) {
+    const vault_entry_t *e = &rec[i].entry;
+    rec[i].ok = e->secret_len <= ENTRY_SECRET_MAX &&
+                gcm->decrypt(key, e->encrypted_secret, e->secret_len,
+                             e->nonce, e->tag, rec[i].plain);
+    bad += !rec[i].ok;
+  }
+  return bad;
+}
+
+static const char *const alg_names[] = {"SHA1", "SHA256", "SHA512"};
+
+static void print_record(const record_t *r) {
+  const vault_entry_t *e = &r->entry;
+  printf("%.*s\t", ENTRY_NAME_MAX, e->name);
+  if (!r->ok) {
+    printf("BAD TAG\n");
+    return;
+  }
+  if (e->type == VAULT_ENTRY_TOTP && e->secret_len > 4 &&
+      r->plain[0] <= VK_TOTP_SHA512) {
+    printf("totp %s digits=%u period=%u seed=", alg_names[r->plain[0]],
+           r->plain[1], r->plain[2] | r->plain[3] << 8);
+    for (uint16_t i = 4; i < e->secret_len; i++)
+      printf("%02x", r->plain[i]);
+    printf("\n");
+    return;
+  }
+  bool text = true;
+  for (uint16_t i = 0; i < e->secret_len; i++)
+    text &= r->plain[i] >= 0x20 && r->plain[i] < 0x7f;
+  if (text) {
+    printf("text %.*s\n", e->secret_len, (const char *)r->plain);
+  } else {
+    printf("hex ");
+    for (uint16_t i = 0; i < e->secret_len; i++)
+      printf("%02x", r->plain[i]);
+    printf("\n");
+  }
+}
+
+// --- Commands ---
+
+static int cmd_info(void) {
+  static record_t rec[MAX_ENTRIES];
+  static vk_fido_cred_t creds[MAX_FIDO_CREDS];
+  const vk_kdf_params_t *p = vault_get_kdf_params();
+  int n = load_records(rec), totp = 0, bad = 0;
+
+  printf("kdf       argon2id t=%u m=%u KiB p=%u, %s\n", p->t_cost, p->m_cost,
+         p->lanes,
+         vault_get_kdf_mode() == VAULT_KDF_HOST ? "on the host" : "on device");
+  printf("set up    %s\n", vault_is_setup() ? "yes" : "no");
+  printf("failures  %u%s\n", vault_get_fail_count(),
+         vault_is_locked() ? " (locked)" : "");
+  for (int i = 0; i < n; i++) {
+    const vault_entry_t *e = &rec[i].entry;
+    const char *why = NULL;
+    if (memchr(e->name, 0, ENTRY_NAME_MAX) == NULL)
+      why = "name not terminated";
+    else if (e->secret_len > ENTRY_SECRET_MAX)
+      why = "length out of range";
+    else if (e->type > VAULT_ENTRY_TOTP)
+      why = "unknown type";
+    else if (e->type == VAULT_ENTRY_TOTP && e->secret_len <= 4)
+      why = "TOTP record too short";
+    if (why) {
+      printf("bad       %.*s: %s\n", ENTRY_NAME_MAX, e->name, why);
+      bad++;
+    }
+    totp += e->type == VAULT_ENTRY_TOTP;
+  }
+  printf("entries   %d (%d TOTP)\n", n, totp);
+  printf("fido      %d credentials, PIN %s\n",
+         vault_fido_list_all(creds, MAX_FIDO_CREDS),
+         vault_fido_has_pin() ? "set" : "not set");
+  vk_crypto_zeroize(creds, sizeof(creds));
+  return bad ? 1 : 0;
+}
+
+static int cmd_verify(const vk_host_gcm_t *gcm, const uint8_t key[32],
+                      bool show) {
+  static record_t rec[MAX_ENTRIES];
+  int n = load_records(rec);
+  int bad = decrypt_records(gcm, key, rec, n);
+
+  for (int i = 0; i < n; i++) {
+    if (show)
+      print_record(&rec[i]);
+    else
+      printf("%s\t%.*s\n", rec[i].ok ? "ok" : "BAD", ENTRY_NAME_MAX,
+             rec[i].entry.name);
+  }
+  fprintf(stderr, "%d records, %d bad\n", n, bad);
+  vk_crypto_zeroize(rec, sizeof(rec));
+  return bad ? 1 : 0;
+}
+
+// Same PIN, salt and KDF parameters; a new device secret gives a new vault
+// key, so the canary and every record are encrypted again. FIDO credentials
+// are stored as they are and move unchanged.
+static int cmd_migrate(const vk_host_gcm_t *gcm, const uint8_t prekey[32],
+                       const uint8_t key[32], const char *new_secret_path,
+                       const image_t *img, const char *out) {
+  static record_t rec[MAX_ENTRIES];
+  uint8_t new_secret[VK_DEVICE_SECRET_SIZE], new_key[32];
+  int n = load_records(rec), rc = 1;
+
+  if (decrypt_records(gcm, key, rec, n) != 0) {
+    fprintf(stderr, "vk_recover: records fail to verify, not migrating\n");
+    goto done;
+  }
+  if (read_secret(new_secret_path, new_secret) != 0)
+    goto done;
+  vk_host_otp_write(new_secret);
+  if (!vk_crypto_device_bind(prekey, new_key) ||
+      !vault_setup_canary(new_key))
+    goto done;
+  vault_set_session_key(new_key);
+
+  for (int i = 0; i < n; i++) {
+    const vault_entry_t *e = &rec[i].entry;
+    bool ok;
+    if (e->type == VAULT_ENTRY_TOTP) {
+      vault_totp_t t = {0};
+      t.alg = rec[i].plain[0];
+      t.digits = rec[i].plain[1];
+      t.period = (uint16_t)(rec[i].plain[2] | rec[i].plain[3] << 8);
+      t.seed_len = e->secret_len - 4;
+      memcpy(t.seed, &rec[i].plain[4], t.seed_len);
+      ok = vault_totp_set(e->name, &t);
+      vk_crypto_zeroize(&t, sizeof(t));
+    } else {
+      ok = vault_set(e->name, rec[i].plain, e->secret_len);
+    }
+    if (!ok) {
+      fprintf(stderr, "vk_recover: cannot re-encrypt %.*s\n", ENTRY_NAME_MAX,
+              e->name);
+      goto done;
+    }
+  }
+  // A fresh device starts with a clean retry counter
+  vault_report_auth_result(true);
+  if (image_save(img, out) == 0) {
+    fprintf(stderr, "%d records migrated to %s\n", n, out);
+    rc = 0;
+  }
+
+done:
+  vk_crypto_zeroize(rec, sizeof(rec));
+  vk_crypto_zeroize(new_secret, sizeof(new_secret));
+  vk_crypto_zeroize(new_key, sizeof(new_key));
+  return rc;
+}
+
+int main(int argc, char **argv) {
+  bool portable = false;
+  image_t img;
+  uint8_t secret[VK_DEVICE_SECRET_SIZE], prekey[32], key[32];
+  char pin[256];
+  int rc;
+
+  if (argc > 1 && strcmp(argv[1], "--portable") == 0) {
+    portable = true;
+    argc--;
+    argv++;
+  }
+  if (argc < 3) {
+    usage();
+    return 2;
+  }
+  const char *cmd = argv[1];
+  int want = strcmp(cmd, "info") == 0      ? 3
+             : strcmp(cmd, "migrate") == 0 ? 6
+             : strcmp(cmd, "verify") == 0 || strcmp(cmd, "dump") == 0
+                 ? 4
+                 : -1;
+  if (argc != want) {
+    usage();
+    return 2;
+  }
+
+  argon2_backend kdf = argon2_select_backend(
+      portable ? ARGON2_BACKEND_PORTABLE : ARGON2_BACKEND_AUTO);
+  const vk_host_gcm_t *gcm = vk_host_gcm_select(portable);
+  fprintf(stderr, "argon2: %s, aes-gcm: %s\n",
+          kdf == ARGON2_BACKEND_AVX2 ? "avx2" : "portable", gcm->name);
+
+  // The secret has to be in OTP before vault_init, or it burns a new one
+  if (want > 3 && read_secret(argv[3], secret) != 0)
+    return 1;
+  if (want > 3)
+    vk_host_otp_write(secret);
+  vk_crypto_zeroize(secret, sizeof(secret));
+  if (image_open(argv[2], &img) != 0)
+    return 1;
+  vault_init();
+  vk_host_run_jobs();
+
+  if (want == 3)
+    return cmd_info();
+
+  if (read_pin(pin, sizeof(pin)) != 0)
+    return fail("no PIN on standard input");
+  rc = derive_prekey(pin, prekey);
+  vk_crypto_zeroize(pin, sizeof(pin));
+  if (rc != 0)
+    return fail("key derivation failed");
+  if (unlock(prekey, key) != 0) {
+    vk_crypto_zeroize(prekey, sizeof(prekey));
+    return fail("wrong PIN or device secret");
+  }
+
+  if (strcmp(cmd, "migrate") == 0)
+    rc = cmd_migrate(gcm, prekey, key, argv[4], &img, argv[5]);
+  else
+    rc = cmd_verify(gcm, key, strcmp(cmd, "dump") == 0);
+
+  vault_lock();
+  vk_crypto_zeroize(prekey, sizeof(prekey));
+  vk_crypto_zeroize(key, sizeof(key));
+  return rc;
+}
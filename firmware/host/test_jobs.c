@@ -0,0 +1,272 @@
+// Main-loop scheduling of the resumable crypto, built by host/CMakeLists.txt.
+// Runs each job the way the firmware does (one vk_job_task slice per pass,
+// with a USB service call in between) and checks that the longest gap between
+// service calls stays under VK_HOST_MAX_GAP_US, and that the sliced results
+// match the one-shot functions.
+#include "argon2.h"
+#include "p256-m.h"
+#include "tweetnacl.h"
+#include "vk_job.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef VK_HOST_MAX_GAP_US
+#define VK_HOST_MAX_GAP_US 10000
+#endif
+
+static int failures = 0;
+
+static void expect(const char *name, int ok) {
+  printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok)
+    failures++;
+}
+
+static uint64_t now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// Deterministic stand-in for the TRNG, so sliced and one-shot key
+// generation can be compared
+static uint32_t rng_state;
+
+int p256_generate_random(uint8_t *output, unsigned output_size) {
+  for (unsigned i = 0; i < output_size; i++) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    output[i] = (uint8_t)rng_state;
+  }
+  return 0;
+}
+
+// --- Simulated main loop ---
+
+static uint64_t last_service_us;
+static uint64_t max_gap_us;
+
+static void usb_service(void) {
+  uint64_t t = now_us();
+  if (last_service_us && t - last_service_us > max_gap_us)
+    max_gap_us = t - last_service_us;
+  last_service_us = t;
+}
+
+static vk_job_status_t finished_status;
+static int finished;
+
+static void record_finish(vk_job_t *job, vk_job_status_t status) {
+  (void)job;
+  finished_status = status;
+  finished = 1;
+}
+
+// start() runs where a request handler would, between two service calls.
+// Returns the finish status.
+static vk_job_status_t run_job(vk_job_t *job, int (*start)(void),
+                               unsigned cancel_after) {
+  last_service_us = 0;
+  max_gap_us = 0;
+  finished = 0;
+  job->finish = record_finish;
+
+  usb_service();
+  if (!start() || !vk_job_start(job, (uint32_t)(now_us() / 1000)))
+    return VK_JOB_FAILED;
+  for (unsigned pass = 0; !finished; pass++) {
+    usb_service();
+    if (pass == cancel_after)
+      vk_job_cancel(job);
+    vk_job_task((uint32_t)(now_us() / 1000));
+  }
+  usb_service();
+  return finished_status;
+}
+
+static void check_gap(const char *name) {
+  char label[96];
+  snprintf(label, sizeof(label), "%s: max gap %llu us <= %u us", name,
+           (unsigned long long)max_gap_us, (unsigned)VK_HOST_MAX_GAP_US);
+  expect(label, max_gap_us <= VK_HOST_MAX_GAP_US);
+}
+
+// --- Argon2id ---
+
+#define KDF_M_COST 256
+#define KDF_BLOCKS ARGON2_MEMORY_BLOCKS(KDF_M_COST)
+
+static argon2_block kdf_memory[KDF_BLOCKS];
+static argon2_job kdf;
+static uint8_t kdf_tag[32];
+
+static vk_job_status_t kdf_step(vk_job_t *job) {
+  int res = argon2id_step(&kdf, VK_JOB_ARGON2_BLOCKS);
+  job->percent = (uint8_t)argon2id_progress(&kdf);
+  if (res == ARGON2_PENDING)
+    return VK_JOB_MORE;
+  return res == ARGON2_OK ? VK_JOB_DONE : VK_JOB_FAILED;
+}
+
+static int kdf_start(void) {
+  argon2_context ctx = {0};
+  ctx.out = kdf_tag;
+  ctx.outlen = sizeof(kdf_tag);
+  ctx.pwd = (const uint8_t *)"correct horse";
+  ctx.pwdlen = 13;
+  ctx.salt = (const uint8_t *)"0123456789abcdef";
+  ctx.saltlen = 16;
+  ctx.t_cost = 3;
+  ctx.m_cost = KDF_M_COST;
+  ctx.lanes = 2;
+  ctx.memory = kdf_memory;
+  ctx.memory_blocks = KDF_BLOCKS;
+  return argon2id_begin(&kdf, &ctx) == ARGON2_OK;
+}
+
+static int is_zero(const void *p, size_t n) {
+  const uint8_t *b = (const uint8_t *)p;
+  uint8_t acc = 0;
+  while (n--)
+    acc |= *b++;
+  return acc == 0;
+}
+
+static void test_argon2_job(void) {
+  uint8_t want[32];
+  argon2id_hash_raw(3, KDF_M_COST, 2, "correct horse", 13, "0123456789abcdef",
+                    16, want, sizeof(want), kdf_memory, KDF_BLOCKS);
+
+  vk_job_t job = {.step = kdf_step};
+  vk_job_status_t status = run_job(&job, kdf_start, UINT32_MAX);
+  expect("argon2id job completes", status == VK_JOB_DONE);
+  expect("argon2id job matches one-shot",
+         memcmp(kdf_tag, want, sizeof(want)) == 0);
+  check_gap("argon2id job");
+
+  // Cancelled mid-way: the owner aborts and the matrix is wiped
+  status = run_job(&job, kdf_start, 3);
+  if (status == VK_JOB_CANCELLED)
+    argon2id_abort(&kdf);
+  expect("argon2id job cancels", status == VK_JOB_CANCELLED);
+  expect("argon2id cancel wipes memory",
+         is_zero(kdf_memory, sizeof(kdf_memory)));
+}
+
+// --- Ed25519 ---
+
+static crypto_sign_ed25519_tweet_job ed25519;
+static uint8_t ed_sk[64], ed_pk[32], ed_sm[64 + 32];
+static unsigned long long ed_smlen;
+
+static vk_job_status_t ed25519_step(vk_job_t *job) {
+  (void)job;
+  return crypto_sign_ed25519_tweet_step(&ed25519, VK_JOB_ED25519_STEPS)
+             ? VK_JOB_MORE
+             : VK_JOB_DONE;
+}
+
+static int ed25519_keypair_start(void) {
+  return crypto_sign_ed25519_tweet_keypair_start(&ed25519, ed_pk, ed_sk) == 0;
+}
+
+static int ed25519_sign_start(void) {
+  return crypto_sign_ed25519_tweet_start(&ed25519, ed_sm, &ed_smlen,
+                                         (const uint8_t *)"VaultKey", 8,
+                                         ed_sk) == 0;
+}
+
+static void test_ed25519_job(void) {
+  // RFC 8032, section 7.1, test 1
+  static const uint8_t seed[32] = {
+      0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a,
+      0xf4, 0x92, 0xec, 0x2c, 0xc4, 0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32,
+      0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60};
+  static const uint8_t want_pk[32] = {
+      0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe,
+      0xd3, 0xc9, 0x64, 0x07, 0x3a, 0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6,
+      0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a};
+  uint8_t want_sm[64 + 8], m[64 + 8];
+  unsigned long long smlen, mlen;
+
+  memcpy(ed_sk, seed, 32);
+  vk_job_t job = {.step = ed25519_step};
+  expect("ed25519 keypair job completes",
+         run_job(&job, ed25519_keypair_start, UINT32_MAX) == VK_JOB_DONE);
+  expect("ed25519 keypair job matches RFC 8032",
+         memcmp(ed_pk, want_pk, 32) == 0 && memcmp(ed_sk + 32, want_pk, 32) == 0);
+  check_gap("ed25519 keypair job");
+
+  crypto_sign_ed25519_tweet(want_sm, &smlen, (const uint8_t *)"VaultKey", 8,
+                            ed_sk);
+  expect("ed25519 sign job completes",
+         run_job(&job, ed25519_sign_start, UINT32_MAX) == VK_JOB_DONE);
+  expect("ed25519 sign job matches one-shot",
+         ed_smlen == smlen && memcmp(ed_sm, want_sm, smlen) == 0);
+  expect("ed25519 sign job verifies",
+         crypto_sign_ed25519_tweet_open(m, &mlen, ed_sm, ed_smlen, ed_pk) == 0);
+  check_gap("ed25519 sign job");
+}
+
+// --- P-256 ---
+
+static p256_keypair_job p256;
+static uint8_t p256_priv[32], p256_pub[64];
+
+static vk_job_status_t p256_step(vk_job_t *job) {
+  (void)job;
+  return p256_gen_keypair_step(&p256, VK_JOB_P256_STEPS) == P256_PENDING
+             ? VK_JOB_MORE
+             : VK_JOB_DONE;
+}
+
+static int p256_start(void) {
+  return p256_gen_keypair_start(&p256, p256_priv, p256_pub) == P256_SUCCESS;
+}
+
+static void test_p256_job(void) {
+  uint8_t want_priv[32], want_pub[64], peer_priv[32], peer_pub[64];
+  uint8_t s1[32], s2[32];
+
+  rng_state = 0x2545f491;
+  p256_gen_keypair(want_priv, want_pub);
+  p256_gen_keypair(peer_priv, peer_pub);
+
+  rng_state = 0x2545f491;
+  vk_job_t job = {.step = p256_step};
+  expect("p256 keypair job completes",
+         run_job(&job, p256_start, UINT32_MAX) == VK_JOB_DONE);
+  expect("p256 keypair job matches one-shot",
+         memcmp(p256_priv, want_priv, 32) == 0 &&
+             memcmp(p256_pub, want_pub, 64) == 0);
+  expect("p256 keypair job agrees on ECDH",
+         p256_ecdh_shared_secret(s1, p256_priv, peer_pub) == P256_SUCCESS &&
+             p256_ecdh_shared_secret(s2, peer_priv, p256_pub) ==
+                 P256_SUCCESS &&
+             memcmp(s1, s2, 32) == 0);
+  check_gap("p256 keypair job");
+}
+
+int main(void) {
+  test_argon2_job();
+  test_ed25519_job();
+  test_p256_job();
+
+  // One job at a time
+  vk_job_t a = {.step = kdf_step, .finish = record_finish};
+  vk_job_t b = a;
+  expect("job slot is exclusive", vk_job_start(&a, 0) && !vk_job_start(&b, 0));
+  vk_job_cancel(&a);
+  vk_job_task(0);
+  expect("job slot frees after cancel", !vk_job_busy());
+
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("all checks passed\n");
+  return 0;
+}
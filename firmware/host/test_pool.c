@@ -0,0 +1,102 @@
+// Key pool (vk_pool.c), built by host/CMakeLists.txt on the vault and FIDO
+// sources as the device builds them. Checks that pooled keys are the keys
+// the one-shot functions give, that refill waits for jobs and for an open
+// vault, and that ending the session drops the pool.
+#include "tweetnacl.h"
+#include "vault.h"
+#include "vk_fido.h"
+#include "vk_host_hal.h"
+#include "vk_job.h"
+#include "vk_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Enough main-loop passes to fill every slot
+#define POOL_PASSES 1000
+
+static int failures = 0;
+
+static void expect(const char *name, int ok) {
+  printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok)
+    failures++;
+}
+
+// Button and LED, in main.c on the device
+bool vk_main_button_pressed(void) { return false; }
+void vk_main_set_led_mode(bool wait_for_touch) { (void)wait_for_touch; }
+void vk_main_led_off(void) {}
+
+static void run_pool(void) {
+  for (int i = 0; i < POOL_PASSES; i++)
+    vk_pool_task();
+}
+
+static bool pool_empty(void) {
+  uint8_t seed[32], pk[32], priv[32], pub[64];
+  return !vk_pool_take_ed25519(seed, pk) && !vk_pool_take_p256(priv, pub);
+}
+
+// A job that never finishes until it is cancelled
+static vk_job_status_t idle_step(vk_job_t *job) {
+  (void)job;
+  return VK_JOB_MORE;
+}
+
+static void idle_finish(vk_job_t *job, vk_job_status_t status) {
+  (void)job;
+  (void)status;
+}
+
+static void open_vault(void) {
+  uint8_t secret[VK_DEVICE_SECRET_SIZE] = {1, 2, 3, 4};
+  expect("vault setup",
+         vk_host_open_vault(secret, "2468") && vault_has_session_key());
+}
+
+static void test_pool(void) {
+  static vk_job_t idle = {.step = idle_step, .finish = idle_finish};
+  uint8_t seed[32], pk[32], sk[64], want[32];
+
+  run_pool();
+  expect("no refill while locked", pool_empty());
+
+  open_vault();
+  expect("idle job starts", vk_job_start(&idle, 0));
+  run_pool();
+  expect("no refill while a job runs", pool_empty());
+  vk_job_cancel(&idle);
+  vk_host_run_jobs();
+
+  run_pool();
+  expect("pool fills while unlocked and idle",
+         vk_pool_take_ed25519(seed, pk));
+  memcpy(sk, seed, 32);
+  crypto_sign_ed25519_tweet_keypair(want, sk);
+  expect("pooled key matches crypto_sign_keypair for its seed",
+         memcmp(pk, want, 32) == 0 && memcmp(&sk[32], want, 32) == 0);
+
+  run_pool();
+  vk_fido_reset_session();
+  expect("vk_fido_reset_session wipes the pool", pool_empty());
+
+  uint8_t priv[32], pub[64];
+  run_pool();
+  expect("pool refills after the reset", vk_pool_take_p256(priv, pub) &&
+                                             vk_pool_take_ed25519(seed, pk));
+  run_pool();
+  vault_lock();
+  expect("locking the vault wipes the pool", pool_empty());
+}
+
+int main(void) {
+  test_pool();
+
+  if (failures) {
+    printf("%d failure(s)\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all pool checks passed\n");
+  return EXIT_SUCCESS;
+}
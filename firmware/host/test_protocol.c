@@ -0,0 +1,744 @@
+// USB transport, built by host/CMakeLists.txt: vk_message decoding, the
+// receive ring that puts requests back together across USB reads, the SPSC
+// rings between USB callbacks and the main loop, run across threads, the
+// per-request scratch arena, and VAULT_GET_MULTI on vault.c.
+#include "cb0r.h"
+#include "vault.h"
+#include "vk_arena.h"
+#include "vk_host_hal.h"
+#include "vk_multi.h"
+#include "vk_protocol.h"
+#include "vk_spsc.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+static void expect(const char *name, int ok) {
+  printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok)
+    failures++;
+}
+
+static size_t hex_to_bytes(const char *hex, uint8_t *out) {
+  size_t len = strlen(hex) / 2;
+  for (size_t i = 0; i < len; i++) {
+    unsigned int b;
+    sscanf(hex + 2 * i, "%2x", &b);
+    out[i] = (uint8_t)b;
+  }
+  return len;
+}
+
+static uint32_t rng_state = 0x9e3779b9;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// A request as the app's serde_cbor writes it: keys in struct order
+static size_t make_request(uint8_t type, uint32_t id, const uint8_t *payload,
+                           size_t len, uint8_t *out) {
+  uint8_t *p = out;
+  p += cb0r_write(p, CB0R_MAP, 4);
+  *p++ = 0x61, *p++ = 'v';
+  p += cb0r_write(p, CB0R_INT, 1);
+  memcpy(p, "\x64type", 5), p += 5;
+  p += cb0r_write(p, CB0R_INT, type);
+  memcpy(p, "\x67payload", 8), p += 8;
+  p += cb0r_write(p, CB0R_BYTE, len);
+  memcpy(p, payload, len), p += len;
+  *p++ = 0x62, *p++ = 'i', *p++ = 'd';
+  p += cb0r_write(p, CB0R_INT, id);
+  return (size_t)(p - out);
+}
+
+static void test_parse(void) {
+  uint8_t frame[64];
+  vk_packet_t pkt;
+
+  // VkMessage::new_ping(12345) from the app
+  size_t len = hex_to_bytes("a461760164747970650067706179"
+                            "6c6f61644450494e47626964193039",
+                            frame);
+  expect("parse app ping", vk_protocol_parse(frame, len, &pkt) &&
+                               pkt.version == 1 && pkt.type == VK_MSG_PING &&
+                               pkt.id == 12345 && pkt.payload_len == 4 &&
+                               pkt.payload == frame + 19 &&
+                               memcmp(pkt.payload, "PING", 4) == 0);
+
+  int truncated = 1;
+  for (size_t i = 0; i < len; i++)
+    truncated &= !vk_protocol_parse(frame, (uint16_t)i, &pkt);
+  expect("parse rejects every truncation", truncated);
+  frame[len] = 0;
+  expect("parse rejects trailing bytes",
+         !vk_protocol_parse(frame, (uint16_t)(len + 1), &pkt));
+
+  // Without an id; payload as an array, as serde writes a bare Vec<u8>
+  len = hex_to_bytes("a3617601647479706502677061796c6f616440", frame);
+  expect("parse without id", vk_protocol_parse(frame, len, &pkt) &&
+                                 pkt.type == VK_MSG_INFO_REQ && pkt.id == 0 &&
+                                 pkt.payload_len == 0);
+  len = hex_to_bytes("a3617601647479706500677061796c6f6164820102", frame);
+  expect("parse rejects an array payload",
+         !vk_protocol_parse(frame, len, &pkt));
+  len = hex_to_bytes("a3617602647479706500677061796c6f616440", frame);
+  expect("parse rejects another version",
+         !vk_protocol_parse(frame, len, &pkt));
+  len = hex_to_bytes("a36176016474797065190100677061796c6f616440", frame);
+  expect("parse rejects type > 255", !vk_protocol_parse(frame, len, &pkt));
+  len = hex_to_bytes("a3617601647479706500677061796c6f61645f41014102ff",
+                     frame);
+  expect("parse rejects indefinite lengths",
+         !vk_protocol_parse(frame, len, &pkt));
+}
+
+static void test_create(void) {
+  static uint8_t payload[300], out[400];
+  vk_packet_t pkt;
+
+  for (size_t i = 0; i < sizeof(payload); i++)
+    payload[i] = (uint8_t)i;
+  uint16_t len = vk_protocol_create_packet(VK_MSG_ERROR, UINT32_MAX, payload,
+                                           sizeof(payload), out, sizeof(out));
+  expect("create: longest header is VK_PROTO_OVERHEAD",
+         len == sizeof(payload) + VK_PROTO_OVERHEAD);
+  expect("create round trip",
+         vk_protocol_parse(out, len, &pkt) && pkt.type == VK_MSG_ERROR &&
+             pkt.id == UINT32_MAX && pkt.payload_len == sizeof(payload) &&
+             memcmp(pkt.payload, payload, sizeof(payload)) == 0);
+  expect("create refuses a short buffer",
+         vk_protocol_create_packet(VK_MSG_ERROR, 1, payload, sizeof(payload),
+                                   out, sizeof(payload) + 29) == 0);
+}
+
+// --- Receive ring ---
+
+#define STREAM_FRAMES 400
+// Largest payload that still fits a request frame
+#define PAYLOAD_MAX (VK_PROTO_FRAME_MAX - VK_PROTO_OVERHEAD)
+
+typedef struct {
+  uint8_t type;
+  uint32_t id;
+  uint16_t len;
+  uint8_t sum; // of the payload bytes
+} seen_t;
+
+static seen_t seen[STREAM_FRAMES + 8];
+static int nseen;
+
+static void drain(void) {
+  vk_packet_t pkt;
+  while (vk_protocol_rx_next(&pkt)) {
+    seen_t *s = &seen[nseen++];
+    s->type = (uint8_t)pkt.type;
+    s->id = pkt.id;
+    s->len = pkt.payload_len;
+    s->sum = 0;
+    for (uint16_t i = 0; i < pkt.payload_len; i++)
+      s->sum += pkt.payload[i];
+  }
+}
+
+// Writes data the way tud_cdc_rx_cb does, chunk bytes (0: random up to a
+// USB packet) per read, handling requests whenever a read has landed
+static void stream(const uint8_t *data, size_t len, size_t chunk) {
+  size_t off = 0;
+  while (off < len) {
+    uint32_t space;
+    uint8_t *dst = vk_protocol_rx_buffer(&space);
+    size_t n = chunk ? chunk : 1 + rng() % 64;
+    if (n > len - off)
+      n = len - off;
+    if (dst) {
+      if (n > space)
+        n = space;
+      memcpy(dst, data + off, n);
+      vk_protocol_rx_commit((uint32_t)n);
+      off += n;
+    }
+    drain();
+  }
+  drain();
+}
+
+static void test_ring(void) {
+  static uint8_t data[STREAM_FRAMES * (VK_PROTO_FRAME_MAX + 64)];
+  static seen_t want[STREAM_FRAMES];
+  uint8_t payload[VK_PROTO_FRAME_MAX];
+  size_t len = 0, one;
+
+  vk_protocol_init();
+
+  // One request a byte at a time
+  one = make_request(VK_MSG_VAULT_GET_REQ, 7, (const uint8_t *)"\4mail", 5,
+                     data);
+  nseen = 0;
+  stream(data, one - 1, 1);
+  expect("ring waits for the last byte", nseen == 0);
+  stream(data + one - 1, 1, 1);
+  expect("ring byte by byte", nseen == 1 && seen[0].id == 7 &&
+                                  seen[0].len == 5 &&
+                                  seen[0].type == VK_MSG_VAULT_GET_REQ);
+
+  // Sizes from empty up to the longest frame, many per read and split
+  // across reads and around the end of the ring
+  int ok = 1;
+  for (int chunk = 0; chunk <= 512; chunk += 512) {
+    len = 0;
+    for (int i = 0; i < STREAM_FRAMES; i++) {
+      uint16_t plen = (uint16_t)(rng() % (VK_PROTO_FRAME_MAX - 40));
+      if (i % 50 == 0)
+        plen = VK_PROTO_FRAME_MAX - 30;
+      want[i].type = (uint8_t)(rng() % 64);
+      want[i].id = rng();
+      want[i].len = plen;
+      want[i].sum = 0;
+      for (uint16_t j = 0; j < plen; j++) {
+        payload[j] = (uint8_t)rng();
+        want[i].sum += payload[j];
+      }
+      len += make_request(want[i].type, want[i].id, payload, plen, data + len);
+    }
+    nseen = 0;
+    stream(data, len, (size_t)chunk);
+    ok &= nseen == STREAM_FRAMES;
+    for (int i = 0; ok && i < STREAM_FRAMES; i++)
+      ok &= seen[i].type == want[i].type && seen[i].id == want[i].id &&
+            seen[i].len == want[i].len && seen[i].sum == want[i].sum;
+  }
+  expect("ring reassembles back-to-back and split frames", ok);
+
+  // Junk before a request, a frame too long to take, then a good one
+  memcpy(data, "\xff\x00garbage", 9);
+  len = 9;
+  len += make_request(VK_MSG_PING, 1, payload, 0, data + len);
+  memset(payload, 0, sizeof(payload));
+  len += make_request(VK_MSG_PING, 2, payload, VK_PROTO_FRAME_MAX, data + len);
+  len += make_request(VK_MSG_PING, 3, payload, 0, data + len);
+  nseen = 0;
+  stream(data, len, 0);
+  expect("ring resynchronises after junk and oversized frames",
+         nseen == 2 && seen[0].id == 1 && seen[1].id == 3);
+}
+
+// Moves a USB packet's worth or less of the outbox into the receive ring,
+// the way the host reading the CDC FIFO would, and handles what arrived
+static uint32_t outbox_waits;
+
+static bool outbox_wait(uint32_t rounds) {
+  (void)rounds;
+  const uint8_t *data;
+  uint32_t len = vk_protocol_tx_peek(&data), space;
+  uint32_t n = 1 + rng() % 64;
+  uint8_t *dst = vk_protocol_rx_buffer(&space);
+  if (n > len)
+    n = len;
+  if (dst && n) {
+    if (n > space)
+      n = space;
+    memcpy(dst, data, n);
+    vk_protocol_rx_commit(n);
+    vk_protocol_tx_consume(n);
+  }
+  drain();
+  outbox_waits++;
+  return true;
+}
+
+// Responses larger than the outbox, with nothing but the outbox between
+// them and the host: writes wait for it to drain in random pieces, and they
+// come out whole and in order (checked by looping them back through the
+// receive ring)
+static void test_outbox(void) {
+  static uint8_t payload[PAYLOAD_MAX];
+  static seen_t want[STREAM_FRAMES];
+  int ok = 1;
+
+  vk_protocol_init();
+  vk_protocol_set_wait(outbox_wait);
+  nseen = 0;
+  for (int i = 0; i < STREAM_FRAMES; i++) {
+    seen_t *w = &want[i];
+    w->type = (uint8_t)(rng() % 64);
+    w->id = rng();
+    w->len = (uint16_t)(rng() % sizeof(payload));
+    w->sum = 0;
+    for (uint16_t j = 0; j < w->len; j++) {
+      payload[j] = (uint8_t)rng();
+      w->sum += payload[j];
+    }
+    ok &= vk_protocol_send((vk_msg_type_t)w->type, w->id, payload, w->len);
+  }
+  while (vk_protocol_tx_space() < VK_PROTO_TX_RING)
+    outbox_wait(0);
+  vk_protocol_set_wait(NULL);
+  for (int i = 0; ok && i < STREAM_FRAMES; i++)
+    ok &= seen[i].type == want[i].type && seen[i].id == want[i].id &&
+          seen[i].len == want[i].len && seen[i].sum == want[i].sum;
+  expect("outbox waits for room instead of refusing", outbox_waits > 0);
+  expect("outbox delivers every response whole and in order",
+         ok && nseen == STREAM_FRAMES);
+
+  // Without a hook, or once it gives up, the rest of the response is
+  // dropped and end says so
+  vk_protocol_init();
+  memset(payload, 0, sizeof(payload));
+  ok = vk_protocol_begin(VK_MSG_PONG, 5, VK_PROTO_TX_RING * 2);
+  vk_protocol_write(payload, VK_PROTO_TX_RING * 2);
+  ok &= !vk_protocol_end() && vk_protocol_tx_space() == 0;
+  vk_protocol_init();
+  expect("outbox gives up without a wait hook", ok);
+}
+
+// Responses streamed in pieces with the sink standing in for the CDC FIFO:
+// it takes what it has room for, the outbox holds a little more, and writes
+// wait on the hook (the host reading the FIFO) for the rest. Checked by
+// looping the FIFO back through the receive ring.
+static uint8_t fifo[STREAM_FRAMES * (PAYLOAD_MAX + VK_PROTO_OVERHEAD)];
+static size_t fifo_len;
+static uint32_t sink_bytes;
+
+static uint32_t test_sink(const uint8_t *data, uint32_t len) {
+  // Usually room for a few USB packets, sometimes nearly full
+  uint32_t n = rng() % 32 == 0 ? rng() % 64 : 256;
+  if (n > len)
+    n = len;
+  memcpy(fifo + fifo_len, data, n);
+  fifo_len += n;
+  sink_bytes += n;
+  return n;
+}
+
+// The host has read the FIFO: the sink takes more on the next call
+static uint32_t stream_waits;
+
+static bool stream_wait(uint32_t rounds) {
+  stream_waits++;
+  return rounds < 4;
+}
+
+// Moves everything queued in the outbox into the FIFO
+static void fifo_drain(void) {
+  const uint8_t *data;
+  uint32_t n;
+  while ((n = vk_protocol_tx_peek(&data)) != 0) {
+    memcpy(fifo + fifo_len, data, n);
+    fifo_len += n;
+    vk_protocol_tx_consume(n);
+  }
+}
+
+static void test_stream(void) {
+  static uint8_t payload[PAYLOAD_MAX];
+  static seen_t want[STREAM_FRAMES];
+  int ok = 1, open_refused = 1;
+
+  vk_protocol_init();
+  vk_protocol_set_sink(test_sink);
+  vk_protocol_set_wait(stream_wait);
+  fifo_len = 0;
+  for (int i = 0; i < STREAM_FRAMES; i++) {
+    seen_t *w = &want[i];
+    w->type = (uint8_t)(rng() % 64);
+    w->id = rng();
+    w->len = (uint16_t)(rng() % sizeof(payload));
+    w->sum = 0;
+    for (uint16_t j = 0; j < w->len; j++) {
+      payload[j] = (uint8_t)rng();
+      w->sum += payload[j];
+    }
+    ok &= vk_protocol_begin((vk_msg_type_t)w->type, w->id, w->len);
+    open_refused &= w->len == 0 || !vk_protocol_begin(VK_MSG_ERROR, 1, 0);
+    for (uint16_t off = 0; off < w->len;) {
+      uint16_t n = (uint16_t)(1 + rng() % 100);
+      if (n > w->len - off)
+        n = w->len - off;
+      vk_protocol_write(payload + off, n);
+      off += n;
+    }
+    ok &= vk_protocol_end();
+    // Now and then the main loop flushes the outbox into the FIFO
+    if (rng() % 2)
+      fifo_drain();
+  }
+  fifo_drain();
+  vk_protocol_set_sink(NULL);
+  vk_protocol_set_wait(NULL);
+
+  nseen = 0;
+  stream(fifo, fifo_len, 0);
+  for (int i = 0; ok && i < STREAM_FRAMES; i++)
+    ok &= seen[i].type == want[i].type && seen[i].id == want[i].id &&
+          seen[i].len == want[i].len && seen[i].sum == want[i].sum;
+  expect("stream refuses a second open response", open_refused);
+  expect("stream hands most bytes straight to the sink",
+         sink_bytes > fifo_len / 2 && sink_bytes < fifo_len);
+  expect("stream waits on the hook once the outbox is full",
+         stream_waits > 0);
+  expect("stream delivers every response whole and in order",
+         ok && nseen == STREAM_FRAMES);
+
+  // A payload that comes up short is padded, keeping the stream in step
+  vk_protocol_init();
+  ok = vk_protocol_begin(VK_MSG_PONG, 9, 8);
+  vk_protocol_write((const uint8_t *)"abc", 3);
+  ok &= !vk_protocol_end();
+  ok &= vk_protocol_send(VK_MSG_PONG, 10, (const uint8_t *)"x", 1);
+  fifo_len = 0;
+  fifo_drain();
+  nseen = 0;
+  stream(fifo, fifo_len, 0);
+  expect("stream pads a short payload",
+         ok && nseen == 2 && seen[0].len == 8 &&
+             seen[0].sum == (uint8_t)('a' + 'b' + 'c') && seen[1].id == 10);
+}
+
+// --- SPSC rings ---
+
+#define SPSC_REPORTS 100000
+
+static uint8_t spsc_buf[16][64];
+static vk_spsc_t spsc = VK_SPSC_INIT(spsc_buf, 64, 16);
+
+// Report i: its number, then bytes derived from it
+static void spsc_report(uint32_t i, uint8_t *out) {
+  memcpy(out, &i, 4);
+  for (int j = 4; j < 64; j++)
+    out[j] = (uint8_t)(i * 31 + j);
+}
+
+static void *spsc_producer(void *arg) {
+  (void)arg;
+  for (uint32_t i = 0; i < SPSC_REPORTS;) {
+    uint8_t *slot = vk_spsc_claim(&spsc);
+    if (!slot) {
+      sched_yield();
+      continue;
+    }
+    spsc_report(i++, slot);
+    vk_spsc_publish(&spsc);
+  }
+  return NULL;
+}
+
+static void test_spsc(void) {
+  uint8_t report[64];
+  const uint8_t *slot;
+  int ok = 1;
+
+  for (int i = 0; i < 16; i++)
+    ok &= vk_spsc_push(&spsc, report, 64);
+  expect("spsc holds its slots", ok && vk_spsc_free(&spsc) == 0);
+  expect("spsc refuses when full", !vk_spsc_push(&spsc, report, 64) &&
+                                       vk_spsc_claim(&spsc) == NULL);
+  while (vk_spsc_peek(&spsc))
+    vk_spsc_release(&spsc);
+  expect("spsc refuses an oversized report",
+         !vk_spsc_push(&spsc, report, 65) && vk_spsc_free(&spsc) == 16);
+
+  // Another thread fills slots while this one takes them, as the USB
+  // callback and the main loop (or the two cores) would
+  pthread_t producer;
+  pthread_create(&producer, NULL, spsc_producer, NULL);
+  for (uint32_t i = 0; i < SPSC_REPORTS;) {
+    if ((slot = vk_spsc_peek(&spsc)) == NULL) {
+      sched_yield();
+      continue;
+    }
+    spsc_report(i++, report);
+    ok &= memcmp(slot, report, 64) == 0;
+    vk_spsc_release(&spsc);
+  }
+  pthread_join(producer, NULL);
+  expect("spsc passes reports across threads whole and in order",
+         ok && vk_spsc_peek(&spsc) == NULL);
+}
+
+// The receive ring fed from another thread: the CDC side only writes and
+// commits, this side only takes requests
+static const uint8_t *threaded_data;
+static size_t threaded_len;
+
+static void *ring_producer(void *arg) {
+  (void)arg;
+  size_t off = 0;
+  while (off < threaded_len) {
+    uint32_t space;
+    uint8_t *dst = vk_protocol_rx_buffer(&space);
+    if (!dst) {
+      sched_yield();
+      continue;
+    }
+    size_t n = 1 + (off * 7) % 64;
+    if (n > threaded_len - off)
+      n = threaded_len - off;
+    if (n > space)
+      n = space;
+    memcpy(dst, threaded_data + off, n);
+    vk_protocol_rx_commit((uint32_t)n);
+    off += n;
+  }
+  return NULL;
+}
+
+static void test_ring_threads(void) {
+  static uint8_t data[STREAM_FRAMES * (VK_PROTO_FRAME_MAX + 64)];
+  static uint8_t payload[PAYLOAD_MAX];
+  static seen_t want[STREAM_FRAMES];
+  size_t len = 0;
+
+  for (int i = 0; i < STREAM_FRAMES; i++) {
+    want[i].type = (uint8_t)(rng() % 64);
+    want[i].id = rng();
+    want[i].len = (uint16_t)(rng() % sizeof(payload));
+    want[i].sum = 0;
+    for (uint16_t j = 0; j < want[i].len; j++) {
+      payload[j] = (uint8_t)rng();
+      want[i].sum += payload[j];
+    }
+    len += make_request(want[i].type, want[i].id, payload, want[i].len,
+                        data + len);
+  }
+
+  vk_protocol_init();
+  threaded_data = data;
+  threaded_len = len;
+  nseen = 0;
+  pthread_t producer;
+  pthread_create(&producer, NULL, ring_producer, NULL);
+  while (nseen < STREAM_FRAMES) {
+    drain();
+    sched_yield();
+  }
+  pthread_join(producer, NULL);
+
+  int ok = 1;
+  for (int i = 0; i < STREAM_FRAMES; i++)
+    ok &= seen[i].type == want[i].type && seen[i].id == want[i].id &&
+          seen[i].len == want[i].len && seen[i].sum == want[i].sum;
+  expect("ring reassembles requests written from another thread", ok);
+}
+
+// --- Request arena ---
+
+static void test_arena(void) {
+  uint8_t *a = vk_arena_alloc(3);
+  uint8_t *b = vk_arena_alloc(100);
+  expect("arena aligns to 8 bytes",
+         a && b && b - a == 8 && ((uintptr_t)b & 7) == 0);
+  memset(a, 0xa5, 3);
+  memset(b, 0x5a, 100);
+  expect("arena refuses what does not fit",
+         vk_arena_alloc(VK_REQ_ARENA_BYTES) == NULL);
+  vk_arena_release(VK_ARENA_CDC, VK_MSG_VAULT_LIST_REQ);
+  expect("arena peak counts refused requests",
+         vk_arena_peak(VK_ARENA_CDC, VK_MSG_VAULT_LIST_REQ) ==
+             8 + 104 + VK_REQ_ARENA_BYTES);
+
+  uint8_t *c = vk_arena_alloc(VK_REQ_ARENA_BYTES);
+  int zeroed = c == a;
+  for (size_t i = 0; c && i < VK_REQ_ARENA_BYTES; i++)
+    zeroed &= c[i] == 0;
+  expect("arena starts over, wiped, after a release", zeroed);
+  vk_arena_release(VK_ARENA_FIDO, 0x01);
+
+  vk_arena_alloc(16);
+  vk_arena_release(VK_ARENA_CDC, VK_MSG_VAULT_LIST_REQ);
+  expect("arena keeps peaks per source and type",
+         vk_arena_peak(VK_ARENA_CDC, VK_MSG_VAULT_LIST_REQ) ==
+             8 + 104 + VK_REQ_ARENA_BYTES &&
+             vk_arena_peak(VK_ARENA_FIDO, 0x01) == VK_REQ_ARENA_BYTES &&
+             vk_arena_peak(VK_ARENA_FIDO, VK_MSG_VAULT_LIST_REQ) == 0);
+}
+
+// --- VAULT_GET_MULTI ---
+
+static void open_vault(void) {
+  uint8_t secret[VK_DEVICE_SECRET_SIZE] = {5, 6, 7, 8};
+  expect("vault setup", vk_host_open_vault(secret, "2468"));
+}
+
+// One request through vk_multi_get, its response collected by the sink
+static uint8_t multi_res[4096];
+static uint32_t multi_len;
+static vk_packet_t multi_packet;
+static uint16_t multi_max = 1024;
+
+static uint32_t multi_sink(const uint8_t *data, uint32_t len) {
+  if (len > sizeof(multi_res) - multi_len)
+    len = sizeof(multi_res) - multi_len;
+  memcpy(&multi_res[multi_len], data, len);
+  multi_len += len;
+  return len;
+}
+
+static bool multi_get(const uint8_t *payload, uint16_t len) {
+  vk_packet_t req = {VK_PROTO_VERSION, VK_MSG_VAULT_GET_MULTI_REQ, 77, payload,
+                     len};
+  multi_len = 0;
+  vk_multi_get(&req, multi_max);
+  // Not vk_protocol_parse: replies may be longer than any request frame
+  cb0r_s map, type, id, body;
+  if (!cb0r_read(multi_res, multi_len, &map) || map.type != CB0R_MAP ||
+      !cb0r_find(&map, CB0R_UTF8, 4, (uint8_t *)"type", &type) ||
+      !cb0r_find(&map, CB0R_UTF8, 2, (uint8_t *)"id", &id) ||
+      !cb0r_find(&map, CB0R_UTF8, 7, (uint8_t *)"payload", &body))
+    return false;
+  multi_packet.type = (vk_msg_type_t)type.value;
+  multi_packet.payload = cb0r_value(&body);
+  multi_packet.payload_len = (uint16_t)cb0r_vlen(&body);
+  return id.value == 77 && cb0r_value(&body) + cb0r_vlen(&body) ==
+                               multi_res + multi_len;
+}
+
+// Next (-1 for null) and the entries of the last response
+static bool multi_decode(long *next, cb0r_t entries) {
+  cb0r_s top, n;
+  if (multi_packet.type != VK_MSG_VAULT_GET_MULTI_RES ||
+      !cb0r_read((uint8_t *)multi_packet.payload, multi_packet.payload_len,
+                 &top) ||
+      top.type != CB0R_ARRAY || !cb0r_get(&top, 0, &n) ||
+      !cb0r_get(&top, 1, entries) || entries->type != CB0R_ARRAY)
+    return false;
+  *next = n.type == CB0R_NULL ? -1 : (long)n.value;
+  return n.type == CB0R_NULL || n.type == CB0R_INT;
+}
+
+static bool cbor_is(cb0r_t item, cb0r_e type, const void *data, size_t len) {
+  return item->type == type && cb0r_vlen(item) == len &&
+         memcmp(cb0r_value(item), data, len) == 0;
+}
+
+// Entry i is [name, value], value a byte string or an error text
+static bool multi_entry(cb0r_t entries, uint32_t i, const char *name,
+                        cb0r_e type, const char *value) {
+  cb0r_s entry, n, v;
+  return cb0r_get(entries, i, &entry) && cb0r_get(&entry, 0, &n) &&
+         cb0r_get(&entry, 1, &v) &&
+         cbor_is(&n, CB0R_UTF8, name, strlen(name)) &&
+         cbor_is(&v, type, value, strlen(value));
+}
+
+static void test_multi(void) {
+  char name[ENTRY_NAME_MAX];
+  uint8_t secret[ENTRY_SECRET_MAX];
+  cb0r_s entries;
+  long next;
+
+  vk_protocol_init();
+  vk_protocol_set_sink(multi_sink);
+  expect("multi-get on a locked vault answers LOCKED",
+         multi_get((const uint8_t[]){VK_MULTI_CURSOR, 0, 0}, 3) &&
+             multi_packet.type == VK_MSG_ERROR &&
+             multi_packet.payload_len == 6 &&
+             memcmp(multi_packet.payload, "LOCKED", 6) == 0);
+
+  open_vault();
+  // Enough long entries that a cursor walk takes several responses
+  int stored = 2;
+  bool set = vault_set("mail", (const uint8_t *)"hunter2", 7) &&
+             vault_set("bank", (const uint8_t *)"s3cret", 6);
+  memset(secret, 's', sizeof(secret));
+  for (; stored < 24; stored++) {
+    snprintf(name, sizeof(name), "entry %02d with a long name", stored);
+    set &= vault_set(name, secret, sizeof(secret));
+  }
+  expect("multi-get entries stored", set);
+
+  // Found, not found, too long, then a found one after it
+  uint8_t req[128], *p = req;
+  *p++ = VK_MULTI_NAMES;
+  *p++ = 4, memcpy(p, "mail", 4), p += 4;
+  *p++ = 4, memcpy(p, "nope", 4), p += 4;
+  *p++ = 40, memset(p, 'x', 40), p += 40;
+  *p++ = 4, memcpy(p, "bank", 4), p += 4;
+  char too_long[41] = {0};
+  memset(too_long, 'x', 40);
+  expect("multi-get answers a mixed batch entry by entry",
+         multi_get(req, (uint16_t)(p - req)) &&
+             multi_decode(&next, &entries) && next == -1 &&
+             entries.count == 4 &&
+             multi_entry(&entries, 0, "mail", CB0R_BYTE, "hunter2") &&
+             multi_entry(&entries, 1, "nope", CB0R_UTF8, "NOT_FOUND") &&
+             multi_entry(&entries, 2, too_long, CB0R_UTF8, "TOO_LONG") &&
+             multi_entry(&entries, 3, "bank", CB0R_BYTE, "s3cret"));
+
+  // A name cut short by the end of the payload ends the batch
+  p = req;
+  *p++ = VK_MULTI_NAMES;
+  *p++ = 4, memcpy(p, "mail", 4), p += 4;
+  *p++ = 10, memcpy(p, "ba", 2), p += 2;
+  expect("multi-get marks a name that runs past the payload",
+         multi_get(req, (uint16_t)(p - req)) &&
+             multi_decode(&next, &entries) && next == -1 &&
+             entries.count == 2 &&
+             multi_entry(&entries, 0, "mail", CB0R_BYTE, "hunter2") &&
+             multi_entry(&entries, 1, "ba", CB0R_UTF8, "MALFORMED"));
+
+  expect("multi-get rejects an unknown mode",
+         multi_get((const uint8_t[]){7, 0, 0}, 3) &&
+             multi_packet.type == VK_MSG_VAULT_GET_MULTI_RES &&
+             multi_packet.payload_len == 4 &&
+             memcmp(multi_packet.payload, "FAIL", 4) == 0);
+  expect("multi-get rejects a short cursor",
+         multi_get((const uint8_t[]){VK_MULTI_CURSOR, 0}, 2) &&
+             multi_packet.type == VK_MSG_VAULT_GET_MULTI_RES &&
+             multi_packet.payload_len == 4 &&
+             memcmp(multi_packet.payload, "FAIL", 4) == 0);
+
+  // The cursor walk: the first response fills up, the rest follow from Next
+  int pages = 0, seen_entries = 0, ok = 1;
+  long slot = 0;
+  do {
+    uint8_t cursor[3] = {VK_MULTI_CURSOR, (uint8_t)slot, (uint8_t)(slot >> 8)};
+    ok &= multi_get(cursor, 3) && multi_decode(&next, &entries) &&
+          entries.count > 0 && (next == -1 || next > slot);
+    ok &= multi_packet.payload_len <= 1024;
+    if (pages == 0)
+      ok &= next != -1;
+    seen_entries += ok ? (int)entries.count : 0;
+    slot = next;
+    pages++;
+  } while (ok && next != -1 && pages < 10);
+  expect("multi-get continues from the cursor after a full payload",
+         ok && pages > 1 && seen_entries == stored);
+
+  // Unbounded, as the firmware asks: every entry in one reply, larger than
+  // the outbox and than a request frame
+  multi_max = VK_PROTO_PAYLOAD_MAX;
+  expect("multi-get streams the whole vault in one reply",
+         multi_get((const uint8_t[]){VK_MULTI_CURSOR, 0, 0}, 3) &&
+             multi_decode(&next, &entries) && next == -1 &&
+             entries.count == (uint32_t)stored &&
+             multi_packet.payload_len > VK_PROTO_FRAME_MAX);
+  vk_protocol_set_sink(NULL);
+  vault_lock();
+}
+
+int main(void) {
+  test_parse();
+  test_create();
+  test_ring();
+  test_outbox();
+  test_stream();
+  test_spsc();
+  test_ring_threads();
+  test_arena();
+  test_multi();
+
+  if (failures) {
+    printf("%d failure(s)\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all protocol checks passed\n");
+  return EXIT_SUCCESS;
+}
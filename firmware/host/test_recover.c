@@ -0,0 +1,223 @@
+// Offline recovery tool, built by host/CMakeLists.txt. Checks the AES-GCM
+// backends against each other and published vectors, then builds a vault
+// image with vault.c and runs vk_recover (path in argv[1]) over it.
+#include "hardware/flash.h"
+#include "hardware/structs/otp.h"
+#include "vault.h"
+#include "vk_host_gcm.h"
+#include "vk_host_hal.h"
+#include "vk_totp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static int failures = 0;
+
+static void expect(const char *name, int ok) {
+  printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok)
+    failures++;
+}
+
+static void hex_to_bytes(const char *hex, uint8_t *out, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    unsigned int b;
+    sscanf(hex + 2 * i, "%2x", &b);
+    out[i] = (uint8_t)b;
+  }
+}
+
+static uint32_t rng_state = 0x2545f491;
+
+static void fill(uint8_t *buf, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    buf[i] = (uint8_t)rng_state;
+  }
+}
+
+// --- AES-GCM backends ---
+
+static void test_gcm_backend(const vk_host_gcm_t *gcm) {
+  uint8_t key[32] = {0}, iv[12] = {0}, pt[80] = {0}, ct[80], tag[16],
+          want[32], out[80];
+  char name[80];
+
+  // McGrew and Viega, test cases 13 and 14
+  gcm->encrypt(key, pt, 0, iv, tag, ct);
+  hex_to_bytes("530f8afbc74536b9a963b4f1c4cb738b", want, 16);
+  snprintf(name, sizeof(name), "gcm %s empty message", gcm->name);
+  expect(name, memcmp(tag, want, 16) == 0);
+  gcm->encrypt(key, pt, 16, iv, tag, ct);
+  hex_to_bytes("cea7403d4d606b6e074ec5d3baf39d18"
+               "d0d1c8a799996bf0265b98b5d48ab919",
+               want, 32);
+  snprintf(name, sizeof(name), "gcm %s one block", gcm->name);
+  expect(name, memcmp(ct, want, 16) == 0 && memcmp(tag, want + 16, 16) == 0);
+
+  // Every length up to five blocks against the device code
+  int same = 1, opens = 1, rejects = 1;
+  for (uint16_t len = 0; len <= sizeof(pt); len++) {
+    uint8_t ct2[80], tag2[16];
+    fill(key, sizeof(key));
+    fill(iv, sizeof(iv));
+    fill(pt, len);
+    gcm->encrypt(key, pt, len, iv, tag, ct);
+    vk_host_gcm_portable.encrypt(key, pt, len, iv, tag2, ct2);
+    same &= memcmp(ct, ct2, len) == 0 && memcmp(tag, tag2, 16) == 0;
+    opens &= gcm->decrypt(key, ct, len, iv, tag, out) &&
+             memcmp(out, pt, len) == 0;
+    tag[len % 16] ^= 0x80;
+    rejects &= !gcm->decrypt(key, ct, len, iv, tag, out);
+  }
+  snprintf(name, sizeof(name), "gcm %s matches the device code", gcm->name);
+  expect(name, same);
+  snprintf(name, sizeof(name), "gcm %s decrypts", gcm->name);
+  expect(name, opens);
+  snprintf(name, sizeof(name), "gcm %s rejects a bad tag", gcm->name);
+  expect(name, rejects);
+}
+
+static void test_gcm(void) {
+  test_gcm_backend(&vk_host_gcm_portable);
+  if (vk_host_gcm_select(false) != &vk_host_gcm_portable)
+    test_gcm_backend(vk_host_gcm_select(false));
+  else
+    printf("skip gcm hardware backend (not available)\n");
+}
+
+// --- vk_recover ---
+
+#define PIN "2468"
+
+static char dir[] = "/tmp/vk_recover_XXXXXX";
+static const char *tool;
+
+static void write_file(const char *name, const void *data, size_t len) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", dir, name);
+  FILE *f = fopen(path, "wb");
+  if (!f || fwrite(data, 1, len, f) != len || fclose(f) != 0) {
+    perror(path);
+    exit(EXIT_FAILURE);
+  }
+}
+
+// Runs vk_recover with pin on stdin; returns its exit status and stdout
+static int run(const char *pin, const char *args, char *out, size_t size) {
+  char cmd[1024];
+  snprintf(cmd, sizeof(cmd),
+           "cd %s && printf '%%s\\n' '%s' | %s %s 2>/dev/null", dir, pin,
+           tool, args);
+  FILE *p = popen(cmd, "r");
+  size_t n = 0;
+  if (!p)
+    return -1;
+  if (out) {
+    n = fread(out, 1, size - 1, p);
+    out[n] = 0;
+  } else {
+    char sink[256];
+    while (fread(sink, 1, sizeof(sink), p) > 0)
+      ;
+  }
+  int status = pclose(p);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// A host-KDF vault with a text secret, a binary one and a TOTP entry
+static void make_vault(const uint8_t secret[VK_DEVICE_SECRET_SIZE]) {
+  static const uint8_t blob[] = {0x00, 0xff, 0x10, 0x80};
+  vault_totp_t totp = {VK_TOTP_SHA256, 8, 60, "12345678901234567890", 20};
+
+  expect("vault init calibrates as a job, then sets up",
+         vk_host_open_vault(secret, PIN));
+  const vk_kdf_params_t *params = vault_get_kdf_params();
+  expect("calibration stores its parameters",
+         params->m_cost >= VK_KDF_MIN_M_COST && params->t_cost >= 1);
+  // PAGEn_LOCK1 0x3d in all three copies: bootloader and non-secure
+  // inaccessible, secure read-only. SW_LOCK the same for this boot.
+  expect("device secret page locked",
+         vk_host_otp_page_lock() == 0x3d3d3d &&
+             otp_hw->sw_lock[VK_OTP_SECRET_ROW / 64] == 0xd);
+  expect("vault entries stored",
+         vault_set("mail", (const uint8_t *)"hunter2", 7) &&
+             vault_set("backup", blob, sizeof(blob)) &&
+             vault_totp_set("github", &totp));
+  vault_lock();
+}
+
+static void test_recover(void) {
+  uint8_t secret_a[VK_DEVICE_SECRET_SIZE], secret_b[VK_DEVICE_SECRET_SIZE];
+  static char dump[4096], again[4096];
+  const uint8_t *flash = (const uint8_t *)XIP_BASE;
+
+  if (!mkdtemp(dir)) {
+    perror(dir);
+    exit(EXIT_FAILURE);
+  }
+  fill(secret_a, sizeof(secret_a));
+  fill(secret_b, sizeof(secret_b));
+  make_vault(secret_a);
+
+  write_file("vault.bin", flash + VAULT_FLASH_OFFSET, VAULT_FLASH_SIZE);
+  write_file("flash.bin", flash, VK_HOST_FLASH_SIZE);
+  write_file("a.bin", secret_a, sizeof(secret_a));
+  write_file("b.bin", secret_b, sizeof(secret_b));
+
+  expect("recover info, region dump", run("", "info vault.bin", NULL, 0) == 0);
+  expect("recover info, whole flash", run("", "info flash.bin", NULL, 0) == 0);
+  expect("recover verify", run(PIN, "verify vault.bin a.bin", NULL, 0) == 0);
+  expect("recover rejects a wrong PIN",
+         run("1357", "verify vault.bin a.bin", NULL, 0) == 1);
+  expect("recover rejects a wrong device secret",
+         run(PIN, "verify vault.bin b.bin", NULL, 0) == 1);
+
+  run(PIN, "dump flash.bin a.bin", dump, sizeof(dump));
+  expect("recover dump",
+         strstr(dump, "mail\ttext hunter2\n") &&
+             strstr(dump, "backup\thex 00ff1080\n") &&
+             strstr(dump, "github\ttotp SHA256 digits=8 period=60 "
+                          "seed=3132333435363738393031323334353637383930\n"));
+  run(PIN, "--portable dump vault.bin a.bin", again, sizeof(again));
+  expect("recover dump, portable backends", strcmp(dump, again) == 0);
+
+  expect("recover migrate",
+         run(PIN, "migrate vault.bin a.bin b.bin moved.bin", NULL, 0) == 0);
+  run(PIN, "dump moved.bin b.bin", again, sizeof(again));
+  expect("migrated image opens with the new secret", strcmp(dump, again) == 0);
+  expect("migrated image rejects the old secret",
+         run(PIN, "verify moved.bin a.bin", NULL, 0) == 1);
+
+  char cmd[300];
+  snprintf(cmd, sizeof(cmd), "rm -rf %s", dir);
+  if (system(cmd) != 0)
+    printf("warning: %s left behind\n", dir);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s PATH_TO_VK_RECOVER\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  // Runs happen in the scratch directory
+  tool = realpath(argv[1], NULL);
+  if (!tool) {
+    perror(argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  test_gcm();
+  test_recover();
+
+  if (failures) {
+    printf("%d failure(s)\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all recovery checks passed\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,683 @@
+// Known-answer tests for the firmware crypto, built by host/CMakeLists.txt
+#include "argon2.h"
+#include "blake2b.h"
+#include "hmac_sha256.h"
+#include "p256-m.h"
+#include "tweetnacl.h"
+#include "vk_drbg.h"
+#include "vk_totp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failures = 0;
+
+static void hex_to_bytes(const char *hex, uint8_t *out, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    unsigned int b;
+    sscanf(hex + 2 * i, "%2x", &b);
+    out[i] = (uint8_t)b;
+  }
+}
+
+static void check(const char *name, const uint8_t *got, const char *want_hex) {
+  size_t len = strlen(want_hex) / 2;
+  uint8_t want[256];
+  hex_to_bytes(want_hex, want, len);
+  if (memcmp(got, want, len) != 0) {
+    printf("FAIL %s\n  got  ", name);
+    for (size_t i = 0; i < len; i++)
+      printf("%02x", got[i]);
+    printf("\n  want %s\n", want_hex);
+    failures++;
+  } else {
+    printf("ok   %s\n", name);
+  }
+}
+
+static void expect(const char *name, int ok) {
+  printf("%s %s\n", ok ? "ok  " : "FAIL", name);
+  if (!ok)
+    failures++;
+}
+
+// --- BLAKE2b ---
+
+static void test_blake2b(void) {
+  uint8_t out[BLAKE2B_OUTBYTES], key[BLAKE2B_KEYBYTES], msg[1000];
+  for (size_t i = 0; i < sizeof(key); i++)
+    key[i] = (uint8_t)i;
+  for (size_t i = 0; i < sizeof(msg); i++)
+    msg[i] = (uint8_t)i;
+
+  // RFC 7693, appendix A
+  blake2b(out, 64, "abc", 3);
+  check("blake2b-512 \"abc\"", out,
+        "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+        "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+  blake2b(out, 64, "", 0);
+  check("blake2b-512 empty", out,
+        "786a02f742015903c6c6fd852552d272912f4740e15847618a86e217f71f5419"
+        "d25e1031afee585313896444934eb04b903a685b1448b755d56f701afe9be2ce");
+
+  // Reference blake2b-kat.txt, keyed, empty message
+  blake2b_state S;
+  blake2b_init_key(&S, 64, key, sizeof(key));
+  blake2b_final(&S, out);
+  check("blake2b-512 keyed empty", out,
+        "10ebb67700b1868efb4417987acf4690ae9d972fb7a590c2f02871799aaa4786"
+        "b5e996e8f0f4eb981fc214b005f42d2ff4233499391653df7aefcbc13fc51568");
+
+  // Streaming must match one-shot across block boundaries
+  const char *msg_1000 =
+      "9fe687126e6566313081b43167cbfa0b4f721b45a5afd4076af327765d63a616"
+      "478ffbd1cd5fbe4033e8638b8bcf8de6b3978b54a30f1d9d8d68fbe66c2b74cf";
+  blake2b(out, 64, msg, sizeof(msg));
+  check("blake2b-512 1000 bytes one-shot", out, msg_1000);
+  static const size_t splits[] = {1, 127, 128, 129, 256, 999};
+  for (size_t i = 0; i < sizeof(splits) / sizeof(splits[0]); i++) {
+    blake2b_init(&S, 64);
+    blake2b_update(&S, msg, splits[i]);
+    blake2b_update(&S, msg + splits[i], sizeof(msg) - splits[i]);
+    blake2b_final(&S, out);
+    char name[64];
+    snprintf(name, sizeof(name), "blake2b-512 1000 bytes split at %zu",
+             splits[i]);
+    check(name, out, msg_1000);
+  }
+
+  blake2b_init_key(&S, 32, "key", 3);
+  blake2b_update(&S, msg, sizeof(msg));
+  blake2b_final(&S, out);
+  check("blake2b-256 keyed 1000 bytes", out,
+        "623c4b875b9d056ae7097ffa0647c4820b38a9e39ecc07c1636912f75478c029");
+
+  if (blake2b_init(&S, 0) == 0 || blake2b_init(&S, 65) == 0 ||
+      blake2b_init_key(&S, 64, key, 65) == 0) {
+    printf("FAIL blake2b rejects bad lengths\n");
+    failures++;
+  }
+}
+
+static void test_blake2b_long(void) {
+  // H' (RFC 9106, section 3.3) at the lengths Argon2 uses
+  uint8_t out[ARGON2_BLOCK_SIZE];
+  blake2b_long(out, 32, "abc", 3);
+  check("H' T=32", out,
+        "6cfcbf5d43e547674bfbc009070570bcb84e272d359c1e9277e416d74cbbe1c6");
+  blake2b_long(out, 100, "abc", 3);
+  check("H' T=100", out,
+        "4c9ba23bcafae5e571a5d41673bb8084a4a1de2688416ed390f669d33d364f3d"
+        "4d9bfa7fe762680c6b2362711c4ce5b2c60ddcd14c1277ec1369c79f44c28966"
+        "98a2b0773a3ce2e410532fa7c72f0bb61ccca0c24c362f337555cbf2998f2d36"
+        "01be70d1");
+  blake2b_long(out, sizeof(out), "abc", 3);
+  check("H' T=1024 head", out,
+        "4038a0ea5c85fa5a0ea62fd668347bd44afd8da63438fd92fb08bee04dbe89ac");
+  check("H' T=1024 tail", out + sizeof(out) - 64,
+        "09b19078a98dd48ef08da6762f125e673682d8822123b6d0fe99c97fda5e5840"
+        "6c64c157c76bb0a4bd1fc3f8fe819e96fbfdc50ba0194abc940ec7cdc9fff8a0");
+}
+
+// --- Argon2id ---
+
+static argon2_block *argon2_alloc(uint32_t m_cost, size_t *blocks) {
+  *blocks = ARGON2_MEMORY_BLOCKS(m_cost);
+  return malloc(*blocks * sizeof(argon2_block));
+}
+
+// Known answers, once per block function the build and CPU offer
+static void test_argon2id_backend(argon2_backend want, const char *label) {
+  uint8_t pwd[32], salt[16], secret[8], ad[12], tag[32];
+  char name[64];
+
+  if (argon2_select_backend(want) != want) {
+    printf("skip argon2id %s (not available)\n", label);
+    return;
+  }
+
+  // RFC 9106, section 5.3
+  memset(pwd, 0x01, sizeof(pwd));
+  memset(salt, 0x02, sizeof(salt));
+  memset(secret, 0x03, sizeof(secret));
+  memset(ad, 0x04, sizeof(ad));
+
+  argon2_context ctx = {0};
+  ctx.out = tag;
+  ctx.outlen = sizeof(tag);
+  ctx.pwd = pwd;
+  ctx.pwdlen = sizeof(pwd);
+  ctx.salt = salt;
+  ctx.saltlen = sizeof(salt);
+  ctx.secret = secret;
+  ctx.secretlen = sizeof(secret);
+  ctx.ad = ad;
+  ctx.adlen = sizeof(ad);
+  ctx.t_cost = 3;
+  ctx.m_cost = 32;
+  ctx.lanes = 4;
+  ctx.memory = argon2_alloc(ctx.m_cost, &ctx.memory_blocks);
+  if (argon2id_ctx(&ctx) != ARGON2_OK)
+    failures++;
+  free(ctx.memory);
+  snprintf(name, sizeof(name), "argon2id %s rfc9106 t=3 m=32 p=4", label);
+  check(name, tag,
+        "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+
+  // Reference implementation test.c, v=0x13
+  size_t blocks;
+  argon2_block *memory = argon2_alloc(1 << 16, &blocks);
+  if (argon2id_hash_raw(2, 1 << 16, 1, "password", 8, "somesalt", 8, tag, 32,
+                        memory, blocks) != ARGON2_OK)
+    failures++;
+  free(memory);
+  snprintf(name, sizeof(name), "argon2id %s password/somesalt t=2 m=64M p=1",
+           label);
+  check(name, tag,
+        "09316115d5cf24ed5a15a31a3ba326e5cf32edc24702987c02b6566f61913cf7");
+}
+
+static void test_argon2id(void) {
+  uint8_t tag[32];
+  size_t blocks;
+  argon2_block *memory = argon2_alloc(64, &blocks);
+
+  test_argon2id_backend(ARGON2_BACKEND_PORTABLE, "portable");
+  test_argon2id_backend(ARGON2_BACKEND_AVX2, "avx2");
+  argon2_select_backend(ARGON2_BACKEND_AUTO);
+
+  // Parameter validation
+  if (argon2id_hash_raw(1, 15, 2, "pw", 2, "somesalt", 8, tag, 32, memory,
+                        blocks) != ARGON2_INCORRECT_PARAMETER) {
+    printf("FAIL argon2id rejects m_cost < 8 * lanes\n");
+    failures++;
+  }
+  if (argon2id_hash_raw(1, 64, 2, "pw", 2, "somesalt", 8, tag, 32, memory,
+                        ARGON2_MEMORY_BLOCKS(64) - 1) !=
+      ARGON2_MEMORY_ALLOCATION_ERROR) {
+    printf("FAIL argon2id rejects an undersized arena\n");
+    failures++;
+  }
+  free(memory);
+}
+
+// --- Ed25519 ---
+
+static void test_ed25519_one(const char *name, const char *seed_hex,
+                             const char *pk_hex, const char *msg_hex,
+                             const char *sig_hex) {
+  uint8_t pk[32], sk[64], msg[8], sm[64 + sizeof(msg)], out[sizeof(sm)];
+  unsigned long long smlen, mlen;
+  size_t n = strlen(msg_hex) / 2;
+  char label[64];
+
+  hex_to_bytes(seed_hex, sk, 32);
+  hex_to_bytes(msg_hex, msg, n);
+  crypto_sign_ed25519_tweet_keypair(pk, sk);
+  snprintf(label, sizeof(label), "ed25519 %s public key", name);
+  check(label, pk, pk_hex);
+
+  crypto_sign_ed25519_tweet(sm, &smlen, msg, n, sk);
+  snprintf(label, sizeof(label), "ed25519 %s signature", name);
+  check(label, sm, sig_hex);
+  if (crypto_sign_ed25519_tweet_open(out, &mlen, sm, smlen, pk) != 0) {
+    printf("FAIL ed25519 %s verifies\n", name);
+    failures++;
+  }
+}
+
+static void test_ed25519(void) {
+  // RFC 8032, section 7.1
+  test_ed25519_one(
+      "rfc8032 test 1",
+      "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+      "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a", "",
+      "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8"
+      "821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b");
+  test_ed25519_one(
+      "rfc8032 test 2",
+      "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+      "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c", "72",
+      "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085a"
+      "c1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00");
+  test_ed25519_one(
+      "rfc8032 test 3",
+      "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+      "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+      "af82",
+      "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff"
+      "9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a");
+
+  // The signing comb against the ladder used by verification, over seeds
+  // that exercise every digit pattern; a flipped bit must not verify.
+  uint8_t pk[32], sk[64], msg[32], sm[64 + sizeof(msg)], out[sizeof(sm)];
+  unsigned long long smlen, mlen;
+  int bad = 0;
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 32; j++) {
+      sk[j] = (uint8_t)(i * 37 + j * 101 + (i == 1 ? 0xff : 0));
+      msg[j] = (uint8_t)(i ^ j);
+    }
+    crypto_sign_ed25519_tweet_keypair(pk, sk);
+    crypto_sign_ed25519_tweet(sm, &smlen, msg, sizeof(msg), sk);
+    if (crypto_sign_ed25519_tweet_open(out, &mlen, sm, smlen, pk) != 0)
+      bad++;
+    sm[i] ^= 1;
+    if (crypto_sign_ed25519_tweet_open(out, &mlen, sm, smlen, pk) == 0)
+      bad++;
+  }
+  if (bad) {
+    printf("FAIL ed25519 sign/verify round trips (%d)\n", bad);
+    failures++;
+  }
+
+  // Detached signing over parts matches the attached form, including parts
+  // that straddle SHA-512 blocks and empty ones
+  static uint8_t long_msg[300], long_sm[64 + sizeof(long_msg)];
+  static const unsigned splits[][3] = {
+      {300, 0, 0}, {1, 127, 172}, {128, 0, 172}, {0, 0, 300}, {111, 17, 172}};
+  uint8_t sig[64];
+  for (size_t i = 0; i < sizeof(long_msg); i++)
+    long_msg[i] = (uint8_t)(i * 7);
+  crypto_sign_ed25519_tweet(long_sm, &smlen, long_msg, sizeof(long_msg), sk);
+  bad = 0;
+  for (size_t i = 0; i < sizeof(splits) / sizeof(splits[0]); i++) {
+    crypto_sign_ed25519_tweet_iov parts[3];
+    const uint8_t *at = long_msg;
+    for (int k = 0; k < 3; k++) {
+      parts[k].base = at;
+      parts[k].len = splits[i][k];
+      at += splits[i][k];
+    }
+    crypto_sign_ed25519_tweet_detached(sig, parts, 3, sk);
+    if (memcmp(sig, long_sm, 64) != 0)
+      bad++;
+  }
+  if (bad) {
+    printf("FAIL ed25519 detached signatures over parts (%d)\n", bad);
+    failures++;
+  }
+
+  // A cached expanded key signs the same as the seed
+  uint8_t d[64];
+  crypto_sign_ed25519_tweet_iov whole = {long_msg, sizeof(long_msg)};
+  crypto_sign_ed25519_tweet_expand(d, sk);
+  crypto_sign_ed25519_tweet_detached_expanded(sig, &whole, 1, d, sk + 32);
+  if (memcmp(sig, long_sm, 64) != 0) {
+    printf("FAIL ed25519 signature with an expanded key\n");
+    failures++;
+  }
+}
+
+// --- P-256 ---
+
+// Key generation draws the private key from here: a fixed key while
+// rng_fixed is set, xorshift otherwise
+static const uint8_t *rng_fixed;
+static uint32_t rng_state = 0x9e3779b9;
+
+int p256_generate_random(uint8_t *output, unsigned output_size) {
+  for (unsigned i = 0; i < output_size; i++) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    output[i] = rng_fixed ? rng_fixed[i] : (uint8_t)rng_state;
+  }
+  return 0;
+}
+
+static void test_p256(void) {
+  // RFC 6979, A.2.5
+  uint8_t priv[32], pub[64], sig[64], x[32], hash[32] = {1, 2, 3};
+  hex_to_bytes(
+      "c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721", priv,
+      32);
+  rng_fixed = priv;
+  p256_gen_keypair(priv, pub);
+  rng_fixed = NULL;
+  check("p256 rfc6979 public key", pub,
+        "60fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6"
+        "7903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299");
+
+  // The fixed-base comb against the variable-base ladder (ECDH with G as
+  // the peer), over random keys and the edges of [1, n-1]; signatures made
+  // with comb nonces verify through the ladder
+  static const char *const edges[] = {
+      "0000000000000000000000000000000000000000000000000000000000000001",
+      "0000000000000000000000000000000000000000000000000000000000000002",
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632550",
+      "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc63254f"};
+  uint8_t g[64], edge[32];
+  hex_to_bytes(
+      "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296"
+      "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5",
+      g, 64);
+  int bad = 0;
+  for (int i = 0; i < 68; i++) {
+    if (i < 4) {
+      hex_to_bytes(edges[i], edge, 32);
+      rng_fixed = edge;
+    }
+    p256_gen_keypair(priv, pub);
+    rng_fixed = NULL;
+    if (p256_ecdh_shared_secret(x, priv, g) != P256_SUCCESS ||
+        memcmp(x, pub, 32) != 0)
+      bad++;
+    hash[31] = (uint8_t)i;
+    if (p256_ecdsa_sign(sig, priv, hash, sizeof(hash)) != P256_SUCCESS ||
+        p256_ecdsa_verify(sig, pub, hash, sizeof(hash)) != P256_SUCCESS)
+      bad++;
+  }
+  if (bad) {
+    printf("FAIL p256 comb against ladder (%d)\n", bad);
+    failures++;
+  }
+}
+
+// --- SHA-512 ---
+
+static void test_sha512(void) {
+  static const uint16_t lens[] = {111, 112, 127, 128, 239, 1000};
+  static const char *const want[] = {
+      "3dfde1184fd99f233f98be4250f4edb9", "acc96c509e6d01787330a4c6a241e2cd",
+      "a315910cb7812a8e66d87c0c49a42d93", "31f33a52b36dc2e70c83b604fa999a5c",
+      "d5e023834c68aeb6e8eef9619ed5fb6f", "76f1e766ac03deff8c614780dc1f2682"};
+  static uint8_t msg[1000];
+  uint8_t out[64];
+  char name[48];
+
+  // FIPS 180-2, appendix C
+  crypto_hash_sha512_tweet(out, (const uint8_t *)"", 0);
+  check("sha512 empty", out,
+        "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+        "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+  crypto_hash_sha512_tweet(out, (const uint8_t *)"abc", 3);
+  check("sha512 abc", out,
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+        "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+  crypto_hash_sha512_tweet(
+      out,
+      (const uint8_t *)"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklm"
+                       "nhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqr"
+                       "stu",
+      112);
+  check("sha512 two blocks", out,
+        "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+        "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+
+  // Lengths either side of the padding and block boundaries
+  for (size_t i = 0; i < sizeof(msg); i++)
+    msg[i] = (uint8_t)(i * 7 + 1);
+  for (int i = 0; i < 6; i++) {
+    crypto_hash_sha512_tweet(out, msg, lens[i]);
+    snprintf(name, sizeof(name), "sha512 %u bytes", lens[i]);
+    check(name, out, want[i]);
+  }
+
+  // Streamed in parts of every length from 0 to 299
+  crypto_hash_sha512_tweet_state c;
+  crypto_hash_sha512_tweet_init(&c);
+  for (int n = 0; n < 300; n++)
+    crypto_hash_sha512_tweet_update(&c, msg, n);
+  crypto_hash_sha512_tweet_final(&c, out);
+  check("sha512 streamed", out,
+        "a18ca2d0e88b4a275394abfbccae15ed09b8b17007c7fbb056d01b30e4e0b55c"
+        "dafe53aea32800aed9ee7f6da559adb12ac6329fb2d72e5f4d8d3ebca25eb986");
+}
+
+// --- HMAC-SHA256 / HKDF ---
+
+static void test_hmac_sha256(void) {
+  // RFC 4231, test cases 1-7 (6 and 7 with a 131-byte key)
+  static const char *const names[] = {
+      "hmac-sha256 rfc4231 1", "hmac-sha256 rfc4231 2",
+      "hmac-sha256 rfc4231 3", "hmac-sha256 rfc4231 4",
+      "hmac-sha256 rfc4231 5", "hmac-sha256 rfc4231 6",
+      "hmac-sha256 rfc4231 7"};
+  static const char *const want[] = {
+      "b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7",
+      "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+      "773ea91e36800e46854db8ebd09181a72959098b3ef8c122d9635514ced565fe",
+      "82558a389a443c0ea4cc819899f2083a85f0faa3e578f8077a2e3ff46729665b",
+      "a3b6167473100ee06e0c796c2955552b",
+      "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+      "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2"};
+  static const char *const big =
+      "This is a test using a larger than block-size key and a larger than "
+      "block-size data. The key needs to be hashed before being used by the "
+      "HMAC algorithm.";
+  uint8_t key[131], msg[160], mac[32];
+  size_t key_len, msg_len;
+
+  for (int i = 0; i < 7; i++) {
+    switch (i) {
+    case 0:
+      memset(key, 0x0b, key_len = 20);
+      memcpy(msg, "Hi There", msg_len = 8);
+      break;
+    case 1:
+      memcpy(key, "Jefe", key_len = 4);
+      memcpy(msg, "what do ya want for nothing?", msg_len = 28);
+      break;
+    case 2:
+      memset(key, 0xaa, key_len = 20);
+      memset(msg, 0xdd, msg_len = 50);
+      break;
+    case 3:
+      for (key_len = 0; key_len < 25; key_len++)
+        key[key_len] = (uint8_t)(key_len + 1);
+      memset(msg, 0xcd, msg_len = 50);
+      break;
+    case 4:
+      memset(key, 0x0c, key_len = 20);
+      memcpy(msg, "Test With Truncation", msg_len = 20);
+      break;
+    case 5:
+      memset(key, 0xaa, key_len = 131);
+      memcpy(msg, "Test Using Larger Than Block-Size Key - Hash Key First",
+             msg_len = 54);
+      break;
+    default:
+      memcpy(msg, big, msg_len = strlen(big));
+      break;
+    }
+    hmac_sha256(key, key_len, msg, msg_len, mac);
+    check(names[i], mac, want[i]);
+  }
+
+  // A prepared key schedule, and the message streamed in pieces
+  hmac_sha256_key k;
+  hmac_sha256_ctx c;
+  hmac_sha256_setup(&k, key, key_len);
+  hmac_sha256_init(&c, &k);
+  for (size_t off = 0; off < msg_len; off += 13)
+    hmac_sha256_update(&c, msg + off, msg_len - off < 13 ? msg_len - off : 13);
+  hmac_sha256_final(&c, mac);
+  check("hmac-sha256 streamed", mac, want[6]);
+}
+
+static void test_hkdf_sha256(void) {
+  // RFC 5869, appendix A.1-A.3
+  uint8_t ikm[80], salt[80], info[80], prk[32], okm[82];
+
+  memset(ikm, 0x0b, 22);
+  for (int i = 0; i < 13; i++)
+    salt[i] = (uint8_t)i;
+  for (int i = 0; i < 10; i++)
+    info[i] = (uint8_t)(0xf0 + i);
+  hkdf_sha256_extract(prk, salt, 13, ikm, 22);
+  check("hkdf-sha256 rfc5869 1 prk", prk,
+        "077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5");
+  hkdf_sha256_expand(okm, 42, prk, 32, info, 10);
+  check("hkdf-sha256 rfc5869 1 okm", okm,
+        "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf"
+        "34007208d5b887185865");
+
+  for (int i = 0; i < 80; i++) {
+    ikm[i] = (uint8_t)i;
+    salt[i] = (uint8_t)(0x60 + i);
+    info[i] = (uint8_t)(0xb0 + i);
+  }
+  hkdf_sha256(okm, 82, salt, 80, ikm, 80, info, 80);
+  check("hkdf-sha256 rfc5869 2 okm", okm,
+        "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c"
+        "59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71"
+        "cc30c58179ec3e87c14c01d5c1f3434f1d87");
+
+  memset(ikm, 0x0b, 22);
+  hkdf_sha256_extract(prk, NULL, 0, ikm, 22);
+  check("hkdf-sha256 rfc5869 3 prk", prk,
+        "19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04");
+  hkdf_sha256(okm, 42, NULL, 0, ikm, 22, NULL, 0);
+  check("hkdf-sha256 rfc5869 3 okm", okm,
+        "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d"
+        "9d201395faa4b61a96c8");
+
+  expect("hkdf-sha256 rejects over 255 blocks",
+         hkdf_sha256_expand(okm, 255 * 32 + 1, prk, 32, NULL, 0) == -1);
+}
+
+// --- TOTP ---
+
+static void test_totp(void) {
+  // RFC 6238, appendix B: 8 digits, 30 s, a seed per hash
+  static const uint64_t times[] = {59,         1111111109, 1111111111,
+                                   1234567890, 2000000000, 20000000000ull};
+  static const uint32_t want[3][6] = {
+      {94287082, 7081804, 14050471, 89005924, 69279037, 65353130},
+      {46119246, 68084774, 67062674, 91819424, 90698825, 77737706},
+      {90693936, 25091201, 99943326, 93441116, 38618901, 47863826}};
+  static const char *const names[3] = {"totp rfc6238 sha1",
+                                       "totp rfc6238 sha256",
+                                       "totp rfc6238 sha512"};
+  const uint8_t *seed = (const uint8_t *)"1234567890123456789012345678901234"
+                                         "567890123456789012345678901234";
+  static const uint16_t seed_len[3] = {20, 32, 64};
+  vk_totp_key_t k;
+
+  for (int alg = 0; alg < 3; alg++) {
+    int bad = !vk_totp_key_init(&k, (vk_totp_alg_t)alg, 8, 30, seed,
+                                seed_len[alg]);
+    for (int i = 0; i < 6; i++)
+      bad += vk_totp_code(&k, times[i]) != want[alg][i];
+    expect(names[alg], bad == 0);
+  }
+
+  // The 6-digit, 30 s shorthand
+  expect("totp sha1 6 digits", vk_totp_generate(seed, 20, 59) == 287082);
+
+  // Other digit counts and periods
+  vk_totp_key_init(&k, VK_TOTP_SHA1, 8, 60, seed, 20);
+  expect("totp 60 s period", vk_totp_code(&k, 1234567890) == 55713351);
+
+  // Keys of a full block, and longer ones hashed first (RFC 2104)
+  uint8_t key[130];
+  for (int i = 0; i < 64; i++)
+    key[i] = (uint8_t)i;
+  expect("totp 64-byte key", vk_totp_generate(key, 64, 59) == 602149);
+  memset(key, 0xaa, sizeof(key));
+  expect("totp 80-byte key",
+         vk_totp_generate(key, 80, 1234567890) == 408871);
+  vk_totp_key_init(&k, VK_TOTP_SHA256, 7, 30, key, 100);
+  expect("totp sha256 100-byte key", vk_totp_code(&k, 1234567890) == 2927047);
+  vk_totp_key_init(&k, VK_TOTP_SHA512, 6, 30, key, 130);
+  expect("totp sha512 130-byte key", vk_totp_code(&k, 1234567890) == 461671);
+
+  expect("totp rejects bad parameters",
+         !vk_totp_key_init(&k, VK_TOTP_SHA1, 5, 30, seed, 20) &&
+             !vk_totp_key_init(&k, VK_TOTP_SHA1, 9, 30, seed, 20) &&
+             !vk_totp_key_init(&k, VK_TOTP_SHA1, 6, 0, seed, 20) &&
+             !vk_totp_key_init(&k, (vk_totp_alg_t)3, 6, 30, seed, 20));
+}
+
+// --- DRBG ---
+
+enum { NOISE_GOOD, NOISE_STUCK, NOISE_BIASED };
+static int noise_mode;
+static uint32_t noise_state;
+
+uint32_t vk_drbg_noise(void) {
+  switch (noise_mode) {
+  case NOISE_STUCK:
+    return 0x5a5a5a5a;
+  case NOISE_BIASED: { // Three bytes in four are zero, never many in a row
+    uint32_t x = (++noise_state & 0xff) | 1;
+    return x << 24;
+  }
+  default:
+    noise_state ^= noise_state << 13;
+    noise_state ^= noise_state >> 17;
+    noise_state ^= noise_state << 5;
+    return noise_state;
+  }
+}
+
+static int all_zero(const uint8_t *p, size_t n) {
+  uint8_t acc = 0;
+  while (n--)
+    acc |= *p++;
+  return acc == 0;
+}
+
+static void test_drbg(void) {
+  static uint8_t a[1000], b[1000];
+
+  // Same noise, same output, however the requests are split across the
+  // buffer refills
+  noise_mode = NOISE_GOOD;
+  noise_state = 0x2545f491;
+  vk_drbg_uninstantiate();
+  int ok = vk_drbg_generate(a, 1) && vk_drbg_generate(a + 1, 300) &&
+           vk_drbg_generate(a + 301, sizeof(a) - 301);
+  noise_state = 0x2545f491;
+  vk_drbg_uninstantiate();
+  ok = ok && vk_drbg_generate(b, sizeof(b));
+  expect("drbg output is independent of request sizes",
+         ok && memcmp(a, b, sizeof(a)) == 0);
+  expect("drbg output is not the noise", !all_zero(a, sizeof(a)));
+
+  // Past the reseed interval fresh noise is mixed into the key
+  for (int i = 0; ok && i <= VK_DRBG_RESEED_BYTES / (int)sizeof(b); i++)
+    ok = vk_drbg_generate(b, sizeof(b));
+  expect("drbg keeps serving across a reseed", ok);
+
+  // A stuck source trips the repetition count test during start-up, and
+  // the failure is sticky
+  noise_mode = NOISE_STUCK;
+  vk_drbg_uninstantiate();
+  memset(a, 0xff, sizeof(a));
+  expect("drbg rejects a stuck source",
+         !vk_drbg_ready() && !vk_drbg_generate(a, 32) && all_zero(a, 32));
+  noise_mode = NOISE_GOOD;
+  expect("drbg failure is sticky", !vk_drbg_generate(a, 32));
+
+  // Three quarters of the bytes the same value never repeats long enough
+  // for the repetition count test, but trips the adaptive proportion test
+  noise_mode = NOISE_BIASED;
+  vk_drbg_uninstantiate();
+  expect("drbg rejects a biased source", !vk_drbg_ready());
+
+  noise_mode = NOISE_GOOD;
+  vk_drbg_uninstantiate();
+  expect("drbg recovers after uninstantiate", vk_drbg_generate(a, 32));
+}
+
+int main(void) {
+  test_blake2b();
+  test_blake2b_long();
+  test_argon2id();
+  test_ed25519();
+  test_p256();
+  test_sha512();
+  test_hmac_sha256();
+  test_hkdf_sha256();
+  test_totp();
+  test_drbg();
+
+  if (failures) {
+    printf("%d failure(s)\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("all vectors passed\n");
+  return EXIT_SUCCESS;
+}
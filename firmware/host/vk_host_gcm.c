@@ -0,0 +1,206 @@
+#include "vk_host_gcm.h"
+#include "vk_crypto.h"
+#include <string.h>
+
+const vk_host_gcm_t vk_host_gcm_portable = {"portable", vk_crypto_encrypt,
+                                            vk_crypto_decrypt};
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+// Compiled for AES-NI and PCLMULQDQ by attribute, so the rest of the build
+// runs on any x86 and vk_host_gcm_select checks the CPU first
+#define VK_NI __attribute__((target("aes,pclmul,sse4.1")))
+
+typedef struct {
+  __m128i rk[15];
+  __m128i h; // Byte-reversed hash key
+} vk_gcm_ni_t;
+
+#define EXPAND_A(prev, prev2, rcon)                                            \
+  vk_ni_expand(prev2, _mm_shuffle_epi32(                                       \
+                          _mm_aeskeygenassist_si128(prev, rcon), 0xff))
+#define EXPAND_B(prev, prev2)                                                  \
+  vk_ni_expand(prev2, _mm_shuffle_epi32(_mm_aeskeygenassist_si128(prev, 0),    \
+                                        0xaa))
+
+VK_NI static __m128i vk_ni_expand(__m128i k, __m128i t) {
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  k = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+  return _mm_xor_si128(k, t);
+}
+
+VK_NI static __m128i vk_ni_block(const vk_gcm_ni_t *c, __m128i x) {
+  x = _mm_xor_si128(x, c->rk[0]);
+  for (int i = 1; i < 14; i++)
+    x = _mm_aesenc_si128(x, c->rk[i]);
+  return _mm_aesenclast_si128(x, c->rk[14]);
+}
+
+VK_NI static __m128i vk_ni_bswap(__m128i x) {
+  return _mm_shuffle_epi8(
+      x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// GF(2^128) product of byte-reversed operands (Intel's carry-less
+// multiplication white paper, algorithm 5: shift left, then reduce)
+VK_NI static __m128i vk_ni_gfmul(__m128i a, __m128i b) {
+  __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+  __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                              _mm_clmulepi64_si128(a, b, 0x01));
+  __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+  lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+  hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+  // The operands are bit-reflected, so the 256-bit product is one bit short
+  __m128i c_lo = _mm_srli_epi32(lo, 31), c_hi = _mm_srli_epi32(hi, 31);
+  lo = _mm_or_si128(_mm_slli_epi32(lo, 1), _mm_slli_si128(c_lo, 4));
+  hi = _mm_or_si128(_mm_slli_epi32(hi, 1), _mm_slli_si128(c_hi, 4));
+  hi = _mm_or_si128(hi, _mm_srli_si128(c_lo, 12));
+
+  // Reduce modulo x^128 + x^7 + x^2 + x + 1
+  __m128i t = _mm_xor_si128(
+      _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+      _mm_slli_epi32(lo, 25));
+  __m128i t_hi = _mm_srli_si128(t, 4);
+  lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+  __m128i u = _mm_xor_si128(
+      _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+      _mm_srli_epi32(lo, 7));
+  u = _mm_xor_si128(u, t_hi);
+  return _mm_xor_si128(hi, _mm_xor_si128(lo, u));
+}
+
+VK_NI static void vk_ni_init(vk_gcm_ni_t *c, const uint8_t *key) {
+  __m128i *rk = c->rk;
+  rk[0] = _mm_loadu_si128((const __m128i *)key);
+  rk[1] = _mm_loadu_si128((const __m128i *)(key + 16));
+  rk[2] = EXPAND_A(rk[1], rk[0], 0x01);
+  rk[3] = EXPAND_B(rk[2], rk[1]);
+  rk[4] = EXPAND_A(rk[3], rk[2], 0x02);
+  rk[5] = EXPAND_B(rk[4], rk[3]);
+  rk[6] = EXPAND_A(rk[5], rk[4], 0x04);
+  rk[7] = EXPAND_B(rk[6], rk[5]);
+  rk[8] = EXPAND_A(rk[7], rk[6], 0x08);
+  rk[9] = EXPAND_B(rk[8], rk[7]);
+  rk[10] = EXPAND_A(rk[9], rk[8], 0x10);
+  rk[11] = EXPAND_B(rk[10], rk[9]);
+  rk[12] = EXPAND_A(rk[11], rk[10], 0x20);
+  rk[13] = EXPAND_B(rk[12], rk[11]);
+  rk[14] = EXPAND_A(rk[13], rk[12], 0x40);
+  c->h = vk_ni_bswap(vk_ni_block(c, _mm_setzero_si128()));
+}
+
+// Last block may be partial; GCM pads it with zeros
+VK_NI static __m128i vk_ni_load_partial(const uint8_t *p, size_t n) {
+  uint8_t b[16] = {0};
+  memcpy(b, p, n);
+  return _mm_loadu_si128((const __m128i *)b);
+}
+
+VK_NI static __m128i vk_ni_ghash(const vk_gcm_ni_t *c, const uint8_t *data,
+                                 uint16_t len) {
+  __m128i x = _mm_setzero_si128();
+  for (uint16_t i = 0; i < len; i += 16) {
+    size_t n = len - i < 16 ? len - i : 16;
+    __m128i b = n == 16 ? _mm_loadu_si128((const __m128i *)(data + i))
+                        : vk_ni_load_partial(data + i, n);
+    x = vk_ni_gfmul(_mm_xor_si128(x, vk_ni_bswap(b)), c->h);
+  }
+  // Lengths block: no AAD, ciphertext length in bits
+  __m128i lens = _mm_set_epi64x(0, (long long)len * 8);
+  return vk_ni_gfmul(_mm_xor_si128(x, lens), c->h);
+}
+
+// CTR from J0 + 1, four blocks in flight so the AES rounds overlap
+VK_NI static void vk_ni_ctr(const vk_gcm_ni_t *c, const uint8_t *iv,
+                            const uint8_t *in, uint16_t len, uint8_t *out) {
+  uint8_t j[16] = {0};
+  uint32_t ctr = 2;
+  uint16_t i = 0;
+
+  memcpy(j, iv, 12);
+  for (; i + 64 <= len; i += 64) {
+    __m128i k[4];
+    for (int b = 0; b < 4; b++) {
+      j[12] = (uint8_t)(ctr >> 24);
+      j[13] = (uint8_t)(ctr >> 16);
+      j[14] = (uint8_t)(ctr >> 8);
+      j[15] = (uint8_t)ctr++;
+      k[b] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)j), c->rk[0]);
+    }
+    for (int r = 1; r < 14; r++)
+      for (int b = 0; b < 4; b++)
+        k[b] = _mm_aesenc_si128(k[b], c->rk[r]);
+    for (int b = 0; b < 4; b++) {
+      k[b] = _mm_aesenclast_si128(k[b], c->rk[14]);
+      _mm_storeu_si128(
+          (__m128i *)(out + i + 16 * b),
+          _mm_xor_si128(k[b],
+                        _mm_loadu_si128((const __m128i *)(in + i + 16 * b))));
+    }
+  }
+  for (; i < len; i += 16) {
+    uint8_t ks[16];
+    size_t n = len - i < 16 ? len - i : 16;
+    j[12] = (uint8_t)(ctr >> 24);
+    j[13] = (uint8_t)(ctr >> 16);
+    j[14] = (uint8_t)(ctr >> 8);
+    j[15] = (uint8_t)ctr++;
+    _mm_storeu_si128((__m128i *)ks,
+                     vk_ni_block(c, _mm_loadu_si128((const __m128i *)j)));
+    for (size_t b = 0; b < n; b++)
+      out[i + b] = in[i + b] ^ ks[b];
+  }
+}
+
+VK_NI static __m128i vk_ni_tag(const vk_gcm_ni_t *c, const uint8_t *iv,
+                               const uint8_t *ciphertext, uint16_t len) {
+  uint8_t j0[16] = {0};
+  memcpy(j0, iv, 12);
+  j0[15] = 1;
+  __m128i s = vk_ni_block(c, _mm_loadu_si128((const __m128i *)j0));
+  return _mm_xor_si128(vk_ni_bswap(vk_ni_ghash(c, ciphertext, len)), s);
+}
+
+VK_NI static bool vk_ni_encrypt(const uint8_t *key, const uint8_t *plaintext,
+                                uint16_t len, uint8_t *iv, uint8_t *tag,
+                                uint8_t *ciphertext) {
+  vk_gcm_ni_t c;
+  vk_ni_init(&c, key);
+  vk_ni_ctr(&c, iv, plaintext, len, ciphertext);
+  _mm_storeu_si128((__m128i *)tag, vk_ni_tag(&c, iv, ciphertext, len));
+  vk_crypto_zeroize(&c, sizeof(c));
+  return true;
+}
+
+VK_NI static bool vk_ni_decrypt(const uint8_t *key, const uint8_t *ciphertext,
+                                uint16_t len, const uint8_t *iv,
+                                const uint8_t *tag, uint8_t *plaintext) {
+  vk_gcm_ni_t c;
+  vk_ni_init(&c, key);
+  // Compare the whole tag at once: no early exit on the first wrong byte
+  __m128i diff = _mm_xor_si128(vk_ni_tag(&c, iv, ciphertext, len),
+                               _mm_loadu_si128((const __m128i *)tag));
+  bool ok = _mm_testz_si128(diff, diff);
+  if (ok)
+    vk_ni_ctr(&c, iv, ciphertext, len, plaintext);
+  vk_crypto_zeroize(&c, sizeof(c));
+  return ok;
+}
+
+static const vk_host_gcm_t vk_host_gcm_ni = {"aes-ni+pclmul", vk_ni_encrypt,
+                                             vk_ni_decrypt};
+#endif
+
+const vk_host_gcm_t *vk_host_gcm_select(bool portable) {
+#if defined(__x86_64__) || defined(__i386__)
+  if (!portable && __builtin_cpu_supports("aes") &&
+      __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    return &vk_host_gcm_ni;
+#else
+  (void)portable;
+#endif
+  return &vk_host_gcm_portable;
+}
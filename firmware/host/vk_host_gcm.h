@@ -0,0 +1,27 @@
+// AES-256-GCM for the host tools, with the same message format as
+// vk_crypto_encrypt/vk_crypto_decrypt (96-bit IV, no AAD, 128-bit tag).
+// The portable backend is vk_crypto.c itself; x86 hosts with AES-NI and
+// PCLMULQDQ also get a hardware one, chosen at run time.
+#ifndef VK_HOST_GCM_H
+#define VK_HOST_GCM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+  const char *name;
+  bool (*encrypt)(const uint8_t *key, const uint8_t *plaintext, uint16_t len,
+                  uint8_t *iv, uint8_t *tag, uint8_t *ciphertext);
+  bool (*decrypt)(const uint8_t *key, const uint8_t *ciphertext, uint16_t len,
+                  const uint8_t *iv, const uint8_t *tag, uint8_t *plaintext);
+} vk_host_gcm_t;
+
+extern const vk_host_gcm_t vk_host_gcm_portable;
+
+/**
+ * @brief Fastest backend this CPU supports.
+ * @param portable Only consider the portable backend.
+ */
+const vk_host_gcm_t *vk_host_gcm_select(bool portable);
+
+#endif // VK_HOST_GCM_H
@@ -3,6 +3,12 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "vk_crypto.h"
+
+// Define flash offset for the vault (last 64KB of 2MB flash for compatibility)
+// Many Zero boards only have 2MB or 4MB. 16MB was too aggressive and likely crashed the board.
+#define VAULT_FLASH_OFFSET (1024 * 1024 * 2 - 65536)
+#define VAULT_FLASH_SIZE 65536 // Region reserved for the vault image
 
 #define MAX_ENTRIES 100
 #define MAX_FIDO_CREDS 10
@@ -16,9 +22,34 @@ typedef struct {
   uint8_t tag[16];
   uint16_t secret_len;
   bool occupied;
-  uint8_t _padding[1]; // Align to 128 bytes
+  uint8_t type; // vault_entry_type_t; keeps the entry at 128 bytes
 } vault_entry_t;
 
+typedef enum {
+  VAULT_ENTRY_SECRET = 0, // Opaque secret (passwords, notes)
+  VAULT_ENTRY_TOTP = 1,   // vault_totp_t
+} vault_entry_type_t;
+
+// A TOTP entry, stored encrypted as [Alg:1][Digits:1][Period:2][Seed:N]
+#define VAULT_TOTP_SEED_MAX (ENTRY_SECRET_MAX - 4)
+
+typedef struct {
+  uint8_t alg;     // vk_totp_alg_t
+  uint8_t digits;  // 6..8
+  uint16_t period; // Seconds
+  uint8_t seed[VAULT_TOTP_SEED_MAX]; // Raw key bytes, not base32
+  uint16_t seed_len;
+} vault_totp_t;
+
+// Current and next code of one TOTP entry
+typedef struct {
+  char name[ENTRY_NAME_MAX];
+  uint8_t digits;
+  uint16_t period;
+  uint32_t current;
+  uint32_t next;
+} vault_totp_code_t;
+
 #define FIDO_CREDID_MAX 32
 #define FIDO_RPID_MAX 64
 #define FIDO_USER_MAX 64
@@ -41,10 +72,20 @@ typedef struct {
   uint8_t canary_tag[16];    // Auth tag for canary
   uint8_t fido_pin_hash[32]; // SHA-256 of LEFT(SHA-256(PIN), 16)
   bool fido_pin_set;
-  uint8_t _padding[55]; // Align to 128 bytes
+  vk_kdf_params_t kdf; // Argon2id parameters and salt, calibrated at setup
+  uint8_t kdf_mode;    // vault_kdf_mode_t
+  uint8_t _padding[23]; // Align to 128 bytes
 } security_state_t;
 
 #define SECURITY_STATE_MAGIC 0x564B5353 // "VKSS"
+#define VAULT_MAX_FAILS 5
+
+// Where the memory-hard half of the KDF runs. Either way the device adds
+// the keyed step (vk_crypto_device_bind) and enforces the retry counter.
+typedef enum {
+  VAULT_KDF_DEVICE = 0, // PIN sent to the device, Argon2id on the RP2350
+  VAULT_KDF_HOST = 1,   // Host sends its Argon2id result (much more memory)
+} vault_kdf_mode_t;
 
 // Session API
 void vault_set_session_key(const uint8_t *key);
@@ -53,18 +94,39 @@ const uint8_t *vault_get_session_key(void);
 bool vault_verify_pin(const uint8_t *key);
 bool vault_setup_canary(const uint8_t *key);
 
+// Device-mode unlock and setup run Argon2 as a main-loop job (vk_job.h).
+// done is called once with the outcome, progress (may be NULL) on every
+// heartbeat. The start calls return false if the request is invalid or
+// another job is running; done is not called then. The PIN may be wiped as
+// soon as they return.
+typedef void (*vault_done_fn)(bool success, void *user);
+typedef void (*vault_progress_fn)(uint8_t percent, void *user);
+
+// First-time setup, only while !vault_is_setup(). vault_setup_prekey keeps
+// the device salt and records the host's Argon2id cost parameters.
+bool vault_setup_start(const char *pin, vault_done_fn done,
+                       vault_progress_fn progress, void *user);
+bool vault_setup_prekey(const vk_kdf_params_t *host_params,
+                        const uint8_t prekey[32]);
+
 // Security API
 bool vault_is_setup(void);
 bool vault_is_locked(void);
 uint32_t vault_get_fail_count(void);
 void vault_report_auth_result(bool success);
+const vk_kdf_params_t *vault_get_kdf_params(void);
 
-// Initialize vault (mount flash, verify integrity)
+// Initialize vault (mount flash, verify integrity). May start the KDF
+// calibration job. False if the device secret or calibration failed.
 bool vault_init(void);
 
 // List entry names
 int vault_list(char names[][ENTRY_NAME_MAX], int max_count);
 
+// Walk entry names in place, without copying them out: start with *slot = 0
+// and call until NULL. Valid until the vault next changes.
+const char *vault_next_name(int *slot);
+
 // Set entry
 bool vault_set(const char *name, const uint8_t *secret, uint16_t len);
 
@@ -75,15 +137,30 @@ bool vault_get(const char *name, vault_entry_t *out_entry);
 bool vault_get_decrypted(const char *name, uint8_t *out_secret,
                          uint16_t *out_len);
 
+// TOTP entries. The HMAC midstates are cached for the session, so only the
+// first code of an entry pays for the decrypt and key setup.
+bool vault_totp_set(const char *name, const vault_totp_t *totp);
+bool vault_totp_generate(const char *name, uint64_t timestamp,
+                         vault_totp_code_t *out);
+// Codes of every TOTP entry whose name starts with prefix ("" for all), up
+// to max; returns how many matched, which may exceed max
+int vault_totp_batch(const char *prefix, uint64_t timestamp,
+                     vault_totp_code_t *out, int max);
+
 // Delete entry
 bool vault_delete(const char *name);
 
-// Format vault (danger!)
-void vault_format(void);
+// Format vault (danger!). KDF calibration then runs as a job; false if it
+// could not start, and setup fails until it has run.
+bool vault_format(void);
 
 // Session Management
 void vault_lock(void);
-bool vault_unlock(const char *pin);
+bool vault_unlock_start(const char *pin, vault_done_fn done,
+                        vault_progress_fn progress, void *user);
+bool vault_unlock_prekey(const uint8_t prekey[32]);
+void vault_kdf_cancel(void); // Abort a running unlock/setup KDF
+vault_kdf_mode_t vault_get_kdf_mode(void);
 void vault_update_activity(void);
 void vault_check_autolock(void);
 uint32_t vault_get_fail_count(void);
@@ -95,6 +172,8 @@ bool vault_fido_get_by_id(const uint8_t *cred_id, vk_fido_cred_t *out_cred);
 int vault_fido_list_by_rp(const char *rp_id, vk_fido_cred_t *out_creds,
                           int max_count);
 int vault_fido_list_all(vk_fido_cred_t *out_creds, int max_count);
+// Same walk as vault_next_name, over stored credentials
+const vk_fido_cred_t *vault_fido_next(int *slot);
 bool vault_fido_delete(const uint8_t *cred_id);
 
 // FIDO2 PIN API
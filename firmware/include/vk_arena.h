@@ -0,0 +1,37 @@
+#ifndef VK_ARENA_H
+#define VK_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Scratch memory for one request. Handlers take their response and work
+// buffers from a static bump arena instead of the stack, and the dispatcher
+// calls vk_arena_release once the request has been handled: that wipes what
+// was used (it may have held secrets), records the request's peak and starts
+// over. Nothing is freed on its own.
+//
+// Peaks are kept per message type, so the arena (and the stacks) can be
+// sized from measured numbers; the host reads them with ARENA_STATS.
+// Set from CMake (VK_REQ_ARENA_BYTES).
+#ifndef VK_REQ_ARENA_BYTES
+#define VK_REQ_ARENA_BYTES 8192
+#endif
+
+typedef enum {
+  VK_ARENA_CDC,  // Indexed by vk_msg_type_t
+  VK_ARENA_FIDO, // Indexed by CTAP2 command
+  VK_ARENA_SOURCES,
+} vk_arena_source_t;
+
+// size bytes, zeroed and 8-byte aligned, or NULL if the rest of the arena is
+// too small. A refused request still counts towards the peak, so the numbers
+// show what the arena would need.
+void *vk_arena_alloc(size_t size);
+
+// End of a request of the given source and type
+void vk_arena_release(vk_arena_source_t source, uint8_t type);
+
+// Most bytes one request of that type has asked for since boot (saturates)
+uint16_t vk_arena_peak(vk_arena_source_t source, uint8_t type);
+
+#endif // VK_ARENA_H
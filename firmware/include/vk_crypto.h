@@ -5,20 +5,96 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "argon2.h"
+#include "vk_job.h"
 
 // AES-256-GCM Settings
 #define AES_KEY_SIZE 32
 #define GCM_IV_SIZE 12
 #define GCM_TAG_SIZE 16
 
-// Argon2id Settings (Hardware-friendly defaults)
+// Argon2id Settings
 #define ARGON2_SALT_SIZE 16
-#define ARGON2_MEM_COST 2048
-#define ARGON2_TIME_COST 3
-#define ARGON2_LANES 1
+#define ARGON2_LANES 2 // One lane per RP2350 core
 
-// KDF: Derive a master key from user PIN and salt
-bool vk_crypto_kdf(const char *pin, const uint8_t *salt, uint8_t *out_key);
+// KDF scratch arena: statically reserved RAM for Argon2 (KiB). Every m_cost
+// used on the device must fit in it. Set from CMake (VK_KDF_ARENA_KIB).
+#ifndef VK_KDF_ARENA_KIB
+#define VK_KDF_ARENA_KIB 256
+#endif
+#define VK_KDF_MAX_M_COST VK_KDF_ARENA_KIB
+
+// Unlock latency the calibration aims for (ms). Set from CMake
+// (VK_KDF_TARGET_MS).
+#ifndef VK_KDF_TARGET_MS
+#define VK_KDF_TARGET_MS 1000
+#endif
+
+// Security floor: calibration never goes below these, even on a slow part
+#define VK_KDF_MIN_M_COST 64
+#define VK_KDF_MIN_T_COST 1
+#define VK_KDF_MAX_T_COST 16
+
+// Argon2id parameters chosen at setup and persisted with the vault
+typedef struct {
+  uint32_t t_cost;
+  uint32_t m_cost; // KiB
+  uint32_t lanes;
+  uint8_t salt[ARGON2_SALT_SIZE];
+} vk_kdf_params_t;
+
+
+// KDF: Derive a master key from user PIN with the persisted parameters
+bool vk_crypto_kdf(const char *pin, const vk_kdf_params_t *params,
+                   uint8_t *out_key);
+
+// Resumable KDF, stepped from the main-loop job scheduler so USB stays
+// serviced. Shares the KDF arena with vk_crypto_kdf: one derivation at a time.
+// pin may be wiped once start returns; out_key is written by the last step.
+typedef struct {
+  argon2_job argon2;
+} vk_kdf_job_t;
+
+bool vk_crypto_kdf_start(vk_kdf_job_t *job, const char *pin,
+                         const vk_kdf_params_t *params, uint8_t *out_key);
+vk_job_status_t vk_crypto_kdf_step(vk_kdf_job_t *job, uint8_t *percent);
+void vk_crypto_kdf_abort(vk_kdf_job_t *job);
+
+// KDF calibration: time Argon2id on this device and pick the strongest
+// parameters (memory first, then passes) that unlock within target_ms.
+// Generates a fresh salt. The probes are KDF runs, so it is a job as well;
+// params holds the result once a step returns VK_JOB_DONE.
+typedef struct {
+  vk_kdf_job_t kdf;
+  vk_kdf_params_t *params;
+  uint64_t target_us;
+  uint64_t probe_us; // Time spent in the running probe's slices
+  uint64_t lo_us;
+  uint8_t phase;
+  uint8_t out[32];
+} vk_kdf_calibration_t;
+
+bool vk_crypto_kdf_calibrate_start(vk_kdf_calibration_t *cal,
+                                   uint32_t target_ms, vk_kdf_params_t *params);
+vk_job_status_t vk_crypto_kdf_calibrate_step(vk_kdf_calibration_t *cal,
+                                             uint8_t *percent);
+void vk_crypto_kdf_calibrate_abort(vk_kdf_calibration_t *cal);
+
+// Device-bound key step. The vault key is HMAC-SHA256(device secret,
+// Argon2id result), where the device secret is generated on first boot and
+// kept in RP2350 OTP, so guessing PINs offline needs the chip itself.
+#define VK_DEVICE_SECRET_SIZE 32
+#ifndef VK_OTP_SECRET_ROW
+#define VK_OTP_SECRET_ROW 0xc00 // 16 ECC rows in the user area
+#endif
+
+// Provision the device secret if the OTP rows are still blank, then lock
+// its OTP page against the bootloader and non-secure reads. Call at every
+// boot; false if the secret or the lock could not be set.
+bool vk_crypto_device_secret_init(void);
+
+// Finish key derivation: out_key = HMAC-SHA256(device secret, prekey)
+bool vk_crypto_device_bind(const uint8_t prekey[32], uint8_t out_key[32]);
 
 // AES-GCM Encryption
 bool vk_crypto_encrypt(const uint8_t *key, const uint8_t *plaintext,
@@ -33,8 +109,11 @@ bool vk_crypto_decrypt(const uint8_t *key, const uint8_t *ciphertext,
 // Memory Sanitization
 void vk_crypto_zeroize(void *v, size_t n);
 
-// Randomness
-void vk_crypto_get_random(uint8_t *buffer, size_t len);
+// Randomness, from the health-tested DRBG (vk_drbg.h). false, with buffer
+// zeroed, if the entropy source has failed.
+bool vk_crypto_get_random(uint8_t *buffer, size_t len);
+// Runs the TRNG start-up health test and seeds the DRBG if needed; false
+// once a health test has failed
 bool vk_crypto_trng_check(void);
 
 #endif // VK_CRYPTO_H
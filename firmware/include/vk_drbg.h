@@ -0,0 +1,50 @@
+#ifndef VK_DRBG_H
+#define VK_DRBG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Random bytes for keys, nonces, IVs and credential IDs: a ChaCha20 DRBG
+// with fast key erasure, serving bytes from a buffer. It is seeded, and
+// reseeded every VK_DRBG_RESEED_BYTES of output, from the noise source
+// below. Every noise byte goes through the SP 800-90B continuous health
+// tests: repetition count and adaptive proportion. Once a test fails, the
+// DRBG refuses to produce output until reboot.
+
+// Noise source, provided by the platform: raw RP2350 TRNG samples on the
+// device (vk_trng.c), not a conditioned or pseudo-random stream
+extern uint32_t vk_drbg_noise(void);
+
+// Min-entropy assumed per noise byte (bits). Raw ring oscillator samples
+// are biased and correlated, so this is low. It sets the test cutoffs
+// below for a false alarm rate of 2^-20 (SP 800-90B, 4.4).
+#define VK_DRBG_H_BITS 1
+#define VK_DRBG_RCT_CUTOFF 21  // 1 + ceil(20 / H)
+#define VK_DRBG_APT_WINDOW 512 // Bytes
+#define VK_DRBG_APT_CUTOFF 311 // 1 + CRITBINOM(512, 2^-H, 1 - 2^-20)
+
+// Noise bytes per (re)seed: 256 bytes at H = 1 carry 256 bits
+#define VK_DRBG_SEED_BYTES 256
+// Start-up test: noise bytes run through both tests before first use
+#define VK_DRBG_STARTUP_BYTES 1024
+#ifndef VK_DRBG_RESEED_BYTES
+#define VK_DRBG_RESEED_BYTES (64 * 1024)
+#endif
+
+// Fill out with len random bytes. Seeds on first use. false (and out
+// zeroed) if the noise source failed a health test.
+bool vk_drbg_generate(void *out, size_t len);
+
+// Run the start-up test and seed now, if not done yet. false once a health
+// test has failed.
+bool vk_drbg_ready(void);
+
+// Mix fresh noise into the key before the next output
+bool vk_drbg_reseed(void);
+
+// Wipe all state, including a health test failure; the next use runs the
+// start-up test again
+void vk_drbg_uninstantiate(void);
+
+#endif // VK_DRBG_H
@@ -37,6 +37,14 @@ typedef struct {
   uint8_t capFlags;
 } u2fhid_init_resp_t;
 
+/**
+ * Queue an incoming FIDO HID report; safe from the USB callback. False if
+ * the queue is full and the report was dropped.
+ *
+ * @param report 64-byte HID report buffer
+ */
+bool vk_fido_receive(uint8_t const *report);
+
 /**
  * Handle an incoming FIDO HID report.
  *
@@ -45,11 +53,27 @@ typedef struct {
 void vk_fido_handle_report(uint8_t const *report);
 
 /**
- * Send a FIDO HID response.
+ * Main-loop pass: handle queued reports, poll a pending user-presence
+ * check and send queued responses as the endpoint becomes ready.
+ */
+void vk_fido_task(uint32_t now_ms);
+
+/**
+ * Queue a FIDO HID response; sent from vk_fido_task. Dropped whole if the
+ * outbox cannot take all of it.
  */
 void vk_fido_send_response(uint32_t cid, uint8_t cmd, uint8_t const *data,
                            uint16_t len);
 
+/**
+ * Wipe the session state: the PIN protocol keys and token and the cached
+ * expanded signing keys. Called when the vault locks.
+ */
 void vk_fido_reset_session(void);
 
+/**
+ * Drop the cached expanded signing key of a deleted credential.
+ */
+void vk_fido_forget_key(const uint8_t *cred_id);
+
 #endif // VK_FIDO_H
@@ -0,0 +1,67 @@
+#ifndef VK_JOB_H
+#define VK_JOB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Long crypto operations (Argon2 unlock, Ed25519 signing, P-256 key
+// generation) run as jobs: the main loop calls vk_job_task once per pass and
+// the job does one bounded slice of work, so tud_task() keeps being serviced
+// and the host can see progress or cancel.
+//
+// Slice sizes trade latency for overhead; the defaults keep a slice around a
+// millisecond on RP2350.
+#ifndef VK_JOB_ARGON2_BLOCKS
+#define VK_JOB_ARGON2_BLOCKS 32 // Argon2 blocks per lane per slice
+#endif
+#ifndef VK_JOB_ED25519_STEPS
+#define VK_JOB_ED25519_STEPS 8 // Ed25519 comb steps per slice
+#endif
+#ifndef VK_JOB_P256_STEPS
+#define VK_JOB_P256_STEPS 8 // P-256 comb steps per slice
+#endif
+
+// Heartbeat interval for progress / keepalive messages (ms)
+#ifndef VK_JOB_NOTIFY_MS
+#define VK_JOB_NOTIFY_MS 100
+#endif
+
+typedef enum {
+  VK_JOB_MORE = 0,
+  VK_JOB_DONE,
+  VK_JOB_FAILED,
+  VK_JOB_CANCELLED,
+} vk_job_status_t;
+
+typedef struct vk_job vk_job_t;
+
+// Jobs are owned by the module that starts them (static storage); the
+// scheduler only holds a pointer.
+struct vk_job {
+  // One bounded slice of work: VK_JOB_MORE, VK_JOB_DONE or VK_JOB_FAILED
+  vk_job_status_t (*step)(vk_job_t *job);
+  // Called exactly once with the outcome; must wipe any secret state
+  void (*finish)(vk_job_t *job, vk_job_status_t status);
+  // Optional heartbeat while the job runs, every VK_JOB_NOTIFY_MS
+  void (*notify)(vk_job_t *job);
+  void *user;
+  uint8_t percent; // Updated by step, read by notify
+
+  // Scheduler state
+  uint32_t last_notify_ms;
+  bool cancel;
+};
+
+// Queue a job. Only one runs at a time; false if the slot is taken.
+bool vk_job_start(vk_job_t *job, uint32_t now_ms);
+
+// Ask a job to stop if it is the one running; its finish then sees
+// VK_JOB_CANCELLED on the next vk_job_task
+void vk_job_cancel(vk_job_t *job);
+
+bool vk_job_busy(void);
+
+// Run one slice of the current job. Call once per main-loop pass.
+void vk_job_task(uint32_t now_ms);
+
+#endif // VK_JOB_H
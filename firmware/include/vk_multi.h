@@ -0,0 +1,17 @@
+#ifndef VK_MULTI_H
+#define VK_MULTI_H
+
+#include "vk_protocol.h"
+#include <stdint.h>
+
+// VAULT_GET_MULTI: many secrets in one response, for syncing or exporting
+// (protocol README, "Bulk Export"). The first payload byte picks the entries:
+#define VK_MULTI_NAMES 0  // [Mode:1] then [NameLen:1][Name] per entry
+#define VK_MULTI_CURSOR 1 // [Mode:1][Slot:2], every entry from Slot on
+
+// Answers one request, streamed to the protocol sink, with at most
+// payload_max bytes of payload; Next says where to carry on past that.
+// Every path answers with the request's id.
+void vk_multi_get(const vk_packet_t *packet, uint16_t payload_max);
+
+#endif // VK_MULTI_H
@@ -0,0 +1,30 @@
+#ifndef VK_POOL_H
+#define VK_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Keys made ahead of time while the device sits idle and unlocked, so
+// MakeCredential and getKeyAgreement can answer without a scalar
+// multiplication. vk_pool_task does one bounded slice of refill work per
+// main-loop pass, only while no other job runs; the pool is wiped when the
+// vault locks.
+#ifndef VK_POOL_ED25519
+#define VK_POOL_ED25519 2 // Ready Ed25519 credential keypairs
+#endif
+#ifndef VK_POOL_P256
+#define VK_POOL_P256 1 // Ready P-256 key agreement keys
+#endif
+
+// One refill slice. Call once per main-loop pass.
+void vk_pool_task(void);
+
+// Take a ready keypair out of the pool; false if none is ready. seed is the
+// 32-byte Ed25519 secret seed.
+bool vk_pool_take_ed25519(uint8_t seed[32], uint8_t pk[32]);
+bool vk_pool_take_p256(uint8_t priv[32], uint8_t pub[64]);
+
+// Drop every pooled key and any refill in progress
+void vk_pool_wipe(void);
+
+#endif // VK_POOL_H
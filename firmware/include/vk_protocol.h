@@ -7,14 +7,33 @@
 // Protocol Constants
 #define VK_PROTO_VERSION 1
 
+// Bytes vk_protocol_create_packet adds around a payload at most: the map,
+// its four keys and the longest type, id and byte string heads
+#define VK_PROTO_OVERHEAD 30
+
+// Longest request frame accepted; longer ones are dropped unread
+#define VK_PROTO_FRAME_MAX 1024
+// Receive ring, a power of two. Holds a few of TinyUSB's 512-byte CDC reads
+// so requests can arrive split or back to back.
+#define VK_PROTO_RX_RING 2048
+// Outbox for responses, a power of two: a small spill for what the CDC FIFO
+// cannot take yet. Replies are not held whole; once it fills, writes wait
+// for the FIFO to drain (see vk_protocol_set_wait).
+#define VK_PROTO_TX_RING 256
+// Longest response payload: the header carries its length in 16 bits
+#define VK_PROTO_PAYLOAD_MAX UINT16_MAX
+
 typedef enum {
   VK_MSG_PING = 0,
   VK_MSG_PONG = 1,
   VK_MSG_INFO_REQ = 2,
   VK_MSG_INFO_RES = 3,
-  VK_MSG_AUTH_REQ = 4,
+  VK_MSG_AUTH_REQ = 4, // Host-KDF unlock: [PreKey:32]
+  VK_MSG_AUTH_RES = 5,
   VK_MSG_VAULT_UNLOCK_REQ = 6,
   VK_MSG_VAULT_UNLOCK_RES = 7,
+  VK_MSG_VAULT_SETUP_REQ = 8,
+  VK_MSG_VAULT_SETUP_RES = 9,
   VK_MSG_GET_SECURITY_REQ = 16,
   VK_MSG_GET_SECURITY_RES = 17,
   VK_MSG_VAULT_LIST_REQ = 20,
@@ -25,8 +44,14 @@ typedef enum {
   VK_MSG_VAULT_ADD_RES = 25,
   VK_MSG_VAULT_DEL_REQ = 26,
   VK_MSG_VAULT_DEL_RES = 27,
-  VK_MSG_TOTP_REQ = 30,
+  VK_MSG_VAULT_GET_MULTI_REQ = 28, // Names or a slot, see protocol README
+  VK_MSG_VAULT_GET_MULTI_RES = 29,
+  VK_MSG_TOTP_REQ = 30, // [Timestamp:8][NameLen:1][Name]
   VK_MSG_TOTP_RES = 31,
+  VK_MSG_TOTP_ADD_REQ = 32, // [NameLen:1][Name][Alg:1][Digits:1][Period:2][Seed]
+  VK_MSG_TOTP_ADD_RES = 33,
+  VK_MSG_TOTP_BATCH_REQ = 34, // [Timestamp:8][PrefixLen:1][Prefix][Start:1]
+  VK_MSG_TOTP_BATCH_RES = 35,
   VK_MSG_KEYB_TYPE_REQ = 14,
   VK_MSG_KEYB_TYPE_RES = 15,
   VK_MSG_FIDO_LIST_REQ = 40,
@@ -39,9 +64,16 @@ typedef enum {
   VK_MSG_FIDO_SET_PIN_RES = 47,
   VK_MSG_LOCK_REQ = 50,
   VK_MSG_LOCK_RES = 51,
+  VK_MSG_PROGRESS = 60, // [Percent:1], sent with the id of a running request
+  VK_MSG_CANCEL_REQ = 62,
+  VK_MSG_CANCEL_RES = 63,
+  VK_MSG_ARENA_STATS_REQ = 64, // Request arena peaks, see vk_arena.h
+  VK_MSG_ARENA_STATS_RES = 65,
   VK_MSG_ERROR = 255
 } vk_msg_type_t;
 
+// A decoded vk_message (protocol/v1/schema.cddl). payload points into the
+// frame it came from; id is 0 if the request had none.
 typedef struct {
   uint8_t version;
   vk_msg_type_t type;
@@ -53,10 +85,54 @@ typedef struct {
 // Initialize protocol handler
 void vk_protocol_init(void);
 
-// Parse incoming CBOR data into a packet
+// Parse one complete CBOR message of exactly len bytes
 bool vk_protocol_parse(const uint8_t *data, uint16_t len,
                        vk_packet_t *out_packet);
 
+// Receive side. CDC reads go straight into the ring: rx_buffer returns where
+// the next bytes go and how many fit in one piece (NULL when full),
+// rx_commit adds the bytes read. rx_next returns each complete request in
+// turn, its payload pointing into the ring; the packet stays valid until the
+// next rx_next call.
+uint8_t *vk_protocol_rx_buffer(uint32_t *space);
+void vk_protocol_rx_commit(uint32_t len);
+bool vk_protocol_rx_next(vk_packet_t *out_packet);
+
+// Send side. Bytes go straight to the sink (the CDC TX FIFO) as they are
+// produced, as long as nothing is queued ahead of them and the sink takes
+// them; the rest spills into the outbox. When that is full too, the write
+// calls the wait hook until the sink has taken enough. tx_peek returns the
+// oldest queued bytes that lie in one piece, tx_consume drops len of them
+// once the FIFO has them.
+//
+// The sink returns how many bytes it took; NULL (the default) queues all.
+typedef uint32_t (*vk_protocol_sink_t)(const uint8_t *data, uint32_t len);
+void vk_protocol_set_sink(vk_protocol_sink_t sink);
+
+// Lets the sink make progress while a write waits (on the device: run the
+// USB stack and flush the FIFO). rounds counts the calls since the sink or
+// the hook last took any bytes. Returning false gives up: the rest of the
+// open response is dropped. Without a hook a write gives up straight away.
+typedef bool (*vk_protocol_wait_t)(uint32_t rounds);
+void vk_protocol_set_wait(vk_protocol_wait_t wait);
+
+// Streams one response: begin writes the header for a payload of
+// payload_len bytes, write passes on payload pieces in any sizes, end closes
+// it. begin fails, writing nothing, only if another response is open; the
+// payload need not fit the outbox. end pads a payload that came up short
+// with zeros, so the stream stays in step, and returns false for it or for
+// bytes the wait hook gave up on.
+bool vk_protocol_begin(vk_msg_type_t type, uint32_t id, uint16_t payload_len);
+void vk_protocol_write(const uint8_t *data, uint16_t len);
+bool vk_protocol_end(void);
+
+// A whole response in one call; false as for vk_protocol_end
+bool vk_protocol_send(vk_msg_type_t type, uint32_t id, const uint8_t *payload,
+                      uint16_t payload_len);
+uint32_t vk_protocol_tx_space(void);
+uint32_t vk_protocol_tx_peek(const uint8_t **data);
+void vk_protocol_tx_consume(uint32_t len);
+
 // Create a CBOR response
 uint16_t vk_protocol_create_packet(vk_msg_type_t type, uint32_t id,
                                    const uint8_t *payload, uint16_t payload_len,
@@ -0,0 +1,50 @@
+#ifndef VK_SPSC_H
+#define VK_SPSC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Lock-free single-producer / single-consumer ring of fixed-size slots.
+//
+// USB callbacks only copy raw reports in; the main loop takes them out and
+// does the work, so a callback never runs a handler or re-enters tud_task().
+// Each side writes only its own counter and publishes it with a release
+// store that the other side reads with an acquire load, so neither masks
+// interrupts, and a ring can sit between the two cores as well.
+//
+// Counters run free and wrap; slots is a power of two.
+typedef struct {
+  uint8_t *storage; // slots * slot_size bytes
+  uint16_t slot_size;
+  uint16_t slots;
+  uint32_t head; // Written by the producer only
+  uint32_t tail; // Written by the consumer only
+} vk_spsc_t;
+
+#define VK_SPSC_INIT(storage, slot_size, slots)                                \
+  {(uint8_t *)(storage), (slot_size), (slots), 0, 0}
+
+// Counter access for rings that lay out their own storage (vk_protocol.c)
+#define VK_SPSC_LOAD(counter) __atomic_load_n(&(counter), __ATOMIC_ACQUIRE)
+#define VK_SPSC_STORE(counter, value)                                          \
+  __atomic_store_n(&(counter), (value), __ATOMIC_RELEASE)
+
+// Producer: the next free slot to fill in place, or NULL when full. Nothing
+// is visible to the consumer until vk_spsc_publish.
+uint8_t *vk_spsc_claim(vk_spsc_t *q);
+void vk_spsc_publish(vk_spsc_t *q);
+
+// Producer: copies len (<= slot_size) bytes into a slot, zero padded.
+// False, with nothing queued, when the ring is full.
+bool vk_spsc_push(vk_spsc_t *q, const void *data, size_t len);
+
+// Producer: slots that can be claimed before the ring is full
+uint32_t vk_spsc_free(vk_spsc_t *q);
+
+// Consumer: the oldest slot, or NULL when empty. It stays valid, and is not
+// reused by the producer, until vk_spsc_release.
+const uint8_t *vk_spsc_peek(vk_spsc_t *q);
+void vk_spsc_release(vk_spsc_t *q);
+
+#endif // VK_SPSC_H
@@ -1,10 +1,58 @@
 #ifndef VK_TOTP_H
 #define VK_TOTP_H
 
+#include "hmac_sha256.h"
+#include <stdbool.h>
 #include <stdint.h>
 
+typedef enum {
+  VK_TOTP_SHA1 = 0,
+  VK_TOTP_SHA256 = 1,
+  VK_TOTP_SHA512 = 2,
+} vk_totp_alg_t;
+
+#define VK_TOTP_DIGITS_MIN 6
+#define VK_TOTP_DIGITS_MAX 8
+
+/**
+ * @brief TOTP parameters with the HMAC key reduced to the hash states after
+ * its ipad and opad blocks. A code then costs two compressions instead of
+ * four. As secret as the key itself.
+ */
+typedef struct {
+  uint8_t alg;     // vk_totp_alg_t
+  uint8_t digits;  // VK_TOTP_DIGITS_MIN..VK_TOTP_DIGITS_MAX
+  uint16_t period; // Seconds
+  union {
+    uint32_t sha1[2][5];   // [0] inner, [1] outer
+    hmac_sha256_key sha256;
+    uint8_t sha512[2][64]; // Big-endian, as crypto_hashblocks keeps it
+  } mid;
+} vk_totp_key_t;
+
+/**
+ * @brief Precompute the midstates for a TOTP secret (RFC 6238).
+ * @param k Output key.
+ * @param alg HMAC hash.
+ * @param digits Code length.
+ * @param period Time step in seconds.
+ * @param key Secret seed bytes.
+ * @param key_len Length of the secret seed.
+ * @return false if a parameter is out of range.
+ */
+bool vk_totp_key_init(vk_totp_key_t *k, vk_totp_alg_t alg, uint8_t digits,
+                      uint16_t period, const uint8_t *key, uint16_t key_len);
+
+/**
+ * @brief Generate a TOTP code from a precomputed key.
+ * @param k Key from vk_totp_key_init.
+ * @param timestamp Unix timestamp (UTC).
+ * @return The code, below 10^digits; shown zero-padded to k->digits.
+ */
+uint32_t vk_totp_code(const vk_totp_key_t *k, uint64_t timestamp);
+
 /**
- * @brief Generate a 6-digit TOTP code.
+ * @brief Generate a 6-digit, 30-second HMAC-SHA1 TOTP code.
  * @param key Secret seed bytes.
  * @param key_len Length of the secret seed.
  * @param timestamp Current Unix timestamp (UTC).
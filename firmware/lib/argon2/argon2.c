@@ -1,87 +1,54 @@
 #include "argon2.h"
-#include <stdlib.h>
+#include "blake2b.h"
 #include <string.h>
 
-/* BLAKE2b Internal */
-static const uint64_t blake2b_iv[8] = {
-    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
-    0xa54ff53a5f1d36f1ULL, 0x510e527fad682d1aULL, 0x9b05688c2b3e6c1fULL,
-    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+/*
+ * Argon2id as specified in RFC 9106 (version 0x13).
+ *
+ * Lanes are split between workers: on RP2350 core 0 fills the even lanes and
+ * core 1 the odd ones, on a host build (ARGON2_USE_PTHREADS) a second thread
+ * takes the place of core 1. Both workers meet at the end of every range of
+ * blocks they are handed; segment boundaries are the only synchronisation the
+ * algorithm requires, finer ranges just let a job yield between them.
+ */
+#if defined(LIB_PICO_MULTICORE)
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#define ARGON2_WORKERS 2
+#elif defined(ARGON2_USE_PTHREADS)
+#include <pthread.h>
+#define ARGON2_WORKERS 2
+#else
+#define ARGON2_WORKERS 1
+#endif
 
 static inline uint64_t rotr64(uint64_t x, int n) {
   return (x >> n) | (x << (64 - n));
 }
 
-static void blake2b_g(uint64_t *v, int a, int b, int c, int d, uint64_t x,
-                      uint64_t y) {
-  v[a] = v[a] + v[b] + x;
-  v[d] = rotr64(v[d] ^ v[a], 32);
-  v[c] = v[c] + v[d];
-  v[b] = rotr64(v[b] ^ v[c], 24);
-  v[a] = v[a] + v[b] + y;
-  v[d] = rotr64(v[d] ^ v[a], 16);
-  v[c] = v[c] + v[d];
-  v[b] = rotr64(v[b] ^ v[c], 63);
-}
-
-static void blake2b_round(uint64_t *v, const uint64_t *m, const uint8_t *s) {
-  blake2b_g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
-  blake2b_g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
-  blake2b_g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
-  blake2b_g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
-  blake2b_g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
-  blake2b_g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
-  blake2b_g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
-  blake2b_g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
-}
-
-static void blake2b_compress(uint64_t *h, const uint8_t *block, uint64_t t0,
-                             uint64_t t1, int last) {
-  static const uint8_t sigma[12][16] = {
-      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-      {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
-      {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
-      {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
-      {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
-      {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
-      {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
-      {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
-      {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
-      {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
-      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-      {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
-  uint64_t v[16], m[16];
-  memcpy(v, h, 64);
-  memcpy(v + 8, blake2b_iv, 64);
-  v[12] ^= t0;
-  v[13] ^= t1;
-  if (last)
-    v[14] = ~v[14];
-  for (int i = 0; i < 16; i++) {
-    uint64_t w;
-    memcpy(&w, block + i * 8, 8);
-    m[i] = w;
-  }
-  for (int i = 0; i < 12; i++)
-    blake2b_round(v, m, sigma[i]);
-  for (int i = 0; i < 8; i++)
-    h[i] ^= v[i] ^ v[i + 8];
-}
-
-static void blake2b(uint8_t *out, size_t outlen, const void *in, size_t inlen) {
-  uint64_t h[8];
-  memcpy(h, blake2b_iv, 64);
-  h[0] ^= 0x01010000 ^ outlen;
-  const uint8_t *p = (const uint8_t *)in;
-  while (inlen > 128) {
-    blake2b_compress(h, p, 128, 0, 0); // Simplified t counter
-    inlen -= 128;
-    p += 128;
-  }
-  uint8_t last[128] = {0};
-  memcpy(last, p, inlen);
-  blake2b_compress(h, last, (uint64_t)inlen, 0, 1);
-  memcpy(out, h, outlen);
+static inline uint64_t load64(const uint8_t *p) {
+  return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+         ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) |
+         ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) |
+         ((uint64_t)p[7] << 56);
+}
+
+static inline void store32(uint8_t *p, uint32_t w) {
+  p[0] = (uint8_t)w;
+  p[1] = (uint8_t)(w >> 8);
+  p[2] = (uint8_t)(w >> 16);
+  p[3] = (uint8_t)(w >> 24);
+}
+
+static inline void store64(uint8_t *p, uint64_t w) {
+  store32(p, (uint32_t)w);
+  store32(p + 4, (uint32_t)(w >> 32));
+}
+
+static void blake2b_update32(blake2b_state *S, uint32_t w) {
+  uint8_t b[4];
+  store32(b, w);
+  blake2b_update(S, b, 4);
 }
 
 /* Argon2 Block Mixing */
@@ -91,110 +58,539 @@ static inline uint64_t fBlaMka(uint64_t x, uint64_t y) {
   return x + y + 2 * xy;
 }
 
-static void G(uint64_t *a, uint64_t *b, uint64_t *c, uint64_t *d) {
-  *a = fBlaMka(*a, *b);
-  *d = rotr64(*d ^ *a, 32);
-  *c = fBlaMka(*c, *d);
-  *b = rotr64(*b ^ *c, 24);
-  *a = fBlaMka(*a, *b);
-  *d = rotr64(*d ^ *a, 16);
-  *c = fBlaMka(*c, *d);
-  *b = rotr64(*b ^ *c, 63);
-}
+#define GB(a, b, c, d)                                                         \
+  do {                                                                         \
+    a = fBlaMka(a, b);                                                         \
+    d = rotr64(d ^ a, 32);                                                     \
+    c = fBlaMka(c, d);                                                         \
+    b = rotr64(b ^ c, 24);                                                     \
+    a = fBlaMka(a, b);                                                         \
+    d = rotr64(d ^ a, 16);                                                     \
+    c = fBlaMka(c, d);                                                         \
+    b = rotr64(b ^ c, 63);                                                     \
+  } while (0)
+
+#define BLAKE2_ROUND_NOMSG(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11,   \
+                           v12, v13, v14, v15)                                 \
+  do {                                                                         \
+    GB(v0, v4, v8, v12);                                                       \
+    GB(v1, v5, v9, v13);                                                       \
+    GB(v2, v6, v10, v14);                                                      \
+    GB(v3, v7, v11, v15);                                                      \
+    GB(v0, v5, v10, v15);                                                      \
+    GB(v1, v6, v11, v12);                                                      \
+    GB(v2, v7, v8, v13);                                                       \
+    GB(v3, v4, v9, v14);                                                       \
+  } while (0)
 
-static void fill_block(const argon2_block *prev, const argon2_block *ref,
-                       argon2_block *next, int with_xor) {
-  argon2_block blockR;
-  for (int i = 0; i < 128; i++)
-    blockR.v[i] = prev->v[i] ^ ref->v[i];
-  argon2_block block_tmp;
-  memcpy(&block_tmp, &blockR, sizeof(argon2_block));
+/*
+ * next = P(prev ^ ref) ^ (prev ^ ref) [^ next]
+ *
+ * prev == NULL stands for the all-zero block, as used by the Argon2i address
+ * generator. tmp is one block of worker scratch so the permutation does not
+ * need 2 KiB of stack.
+ */
+static void fill_block_portable(const argon2_block *prev,
+                                const argon2_block *ref, argon2_block *next,
+                                int with_xor, argon2_block *tmp) {
+  uint64_t *r = tmp->v;
+  for (int i = 0; i < ARGON2_QWORDS_IN_BLOCK; i++)
+    r[i] = prev ? prev->v[i] ^ ref->v[i] : ref->v[i];
+  if (with_xor) {
+    for (int i = 0; i < ARGON2_QWORDS_IN_BLOCK; i++)
+      next->v[i] ^= r[i];
+  } else {
+    memcpy(next, tmp, sizeof(argon2_block));
+  }
 
   for (int i = 0; i < 8; i++) {
-    uint64_t *v = &blockR.v[16 * i];
-    G(&v[0], &v[4], &v[8], &v[12]);
-    G(&v[1], &v[5], &v[9], &v[13]);
-    G(&v[2], &v[6], &v[10], &v[14]);
-    G(&v[3], &v[7], &v[11], &v[15]);
-    G(&v[0], &v[5], &v[10], &v[15]);
-    G(&v[1], &v[6], &v[11], &v[12]);
-    G(&v[2], &v[7], &v[8], &v[13]);
-    G(&v[3], &v[4], &v[9], &v[14]);
+    BLAKE2_ROUND_NOMSG(r[16 * i], r[16 * i + 1], r[16 * i + 2], r[16 * i + 3],
+                       r[16 * i + 4], r[16 * i + 5], r[16 * i + 6],
+                       r[16 * i + 7], r[16 * i + 8], r[16 * i + 9],
+                       r[16 * i + 10], r[16 * i + 11], r[16 * i + 12],
+                       r[16 * i + 13], r[16 * i + 14], r[16 * i + 15]);
   }
   for (int i = 0; i < 8; i++) {
-    uint64_t *v = blockR.v;
-    G(&v[2 * i], &v[2 * i + 1], &v[2 * i + 16], &v[2 * i + 17]);
-    G(&v[2 * i + 32], &v[2 * i + 33], &v[2 * i + 48], &v[2 * i + 49]);
-    G(&v[2 * i + 64], &v[2 * i + 65], &v[2 * i + 80], &v[2 * i + 81]);
-    G(&v[2 * i + 96], &v[2 * i + 97], &v[2 * i + 112], &v[2 * i + 113]);
+    BLAKE2_ROUND_NOMSG(r[2 * i], r[2 * i + 1], r[2 * i + 16], r[2 * i + 17],
+                       r[2 * i + 32], r[2 * i + 33], r[2 * i + 48],
+                       r[2 * i + 49], r[2 * i + 64], r[2 * i + 65],
+                       r[2 * i + 80], r[2 * i + 81], r[2 * i + 96],
+                       r[2 * i + 97], r[2 * i + 112], r[2 * i + 113]);
   }
 
-  for (int i = 0; i < 128; i++) {
-    next->v[i] = blockR.v[i] ^ block_tmp.v[i];
-    if (with_xor)
-      next->v[i] ^= prev->v[i]; // Simplified with_xor for 2nd pass
+  for (int i = 0; i < ARGON2_QWORDS_IN_BLOCK; i++)
+    next->v[i] ^= r[i];
+}
+
+/*
+ * Host builds with ARGON2_USE_AVX2 also carry argon2_avx2.c and pick the
+ * block function at run time; the device only has the portable one.
+ */
+#if defined(ARGON2_USE_AVX2) && (defined(__x86_64__) || defined(__i386__))
+void argon2_fill_block_avx2(const argon2_block *prev, const argon2_block *ref,
+                            argon2_block *next, int with_xor,
+                            argon2_block *tmp);
+
+/* Set before the workers start, only read while they run */
+static void (*fill_block)(const argon2_block *prev, const argon2_block *ref,
+                          argon2_block *next, int with_xor,
+                          argon2_block *tmp);
+
+argon2_backend argon2_select_backend(argon2_backend want) {
+  if (want != ARGON2_BACKEND_PORTABLE && __builtin_cpu_supports("avx2")) {
+    fill_block = argon2_fill_block_avx2;
+    return ARGON2_BACKEND_AVX2;
   }
+  fill_block = fill_block_portable;
+  return ARGON2_BACKEND_PORTABLE;
 }
+#else
+#define fill_block fill_block_portable
 
-int argon2id_hash_raw(const uint32_t t_cost, const uint32_t m_cost,
-                      const uint32_t parallelism, const void *pwd,
-                      const size_t pwdlen, const void *salt,
-                      const size_t saltlen, void *out, const size_t outlen) {
-  if (parallelism != 1)
-    return -1;
-  if (m_cost < 8)
-    return -1;
-
-  argon2_block *memory = malloc(m_cost * sizeof(argon2_block));
-  if (!memory)
-    return -1;
-
-  // H0 = Blake2b(p, outlen, m_cost, t_cost, v, type, pwdlen, pwd, saltlen,
-  // salt, ...)
-  uint8_t h0[64];
-  uint32_t params[10];
-  params[0] = parallelism;
-  params[1] = (uint32_t)outlen;
-  params[2] = m_cost;
-  params[3] = t_cost;
-  params[4] = 0x13; // Version
-  params[5] = Argon2_id;
-  params[6] = (uint32_t)pwdlen;
-  // Note: This is an approximation of the complex multi-field H0.
-  // In a full implementation, each field is hashed sequentially.
-  blake2b(h0, 64, params, sizeof(params));
-  blake2b(h0, 64, pwd, pwdlen);
-  blake2b(h0, 64, salt, saltlen);
-
-  // Initialize first two blocks
-  for (uint32_t i = 0; i < 2; i++) {
-    uint8_t block_init[72];
-    memcpy(block_init, h0, 64);
-    memset(block_init + 64, 0, 4);
-    memcpy(block_init + 68, &i, 4);
-    // Simplified Blake2b-long for 1KB block
-    blake2b((uint8_t *)&memory[i], 1024, block_init, 72);
+argon2_backend argon2_select_backend(argon2_backend want) {
+  (void)want;
+  return ARGON2_BACKEND_PORTABLE;
+}
+#endif
+
+/* --- Memory filling --- */
+
+/* Per-worker scratch: Argon2i input block, address block, mixing buffer. */
+typedef struct {
+  argon2_block input;
+  argon2_block address;
+  argon2_block tmp;
+} argon2_scratch;
+
+_Static_assert(sizeof(argon2_scratch) ==
+                   ARGON2_WORKER_SCRATCH_BLOCKS * sizeof(argon2_block),
+               "scratch layout must match ARGON2_WORKER_SCRATCH_BLOCKS");
+_Static_assert(ARGON2_WORKERS <= ARGON2_MAX_WORKERS,
+               "ARGON2_MEMORY_BLOCKS does not cover every worker");
+
+typedef struct {
+  argon2_block *memory;
+  argon2_scratch *scratch; // One per worker, right after the matrix
+  uint32_t passes;
+  uint32_t lanes;
+  uint32_t lane_length;
+  uint32_t segment_length;
+  uint32_t memory_blocks;
+} argon2_instance;
+
+static void next_addresses(argon2_scratch *s) {
+  s->input.v[6]++;
+  fill_block(NULL, &s->input, &s->address, 0, &s->tmp);
+  fill_block(NULL, &s->address, &s->address, 0, &s->tmp);
+}
+
+static uint32_t index_alpha(const argon2_instance *inst, uint32_t pass,
+                            uint32_t slice, uint32_t index,
+                            uint32_t pseudo_rand, int same_lane) {
+  uint32_t reference_area_size;
+  if (pass == 0) {
+    if (slice == 0) {
+      reference_area_size = index - 1;
+    } else if (same_lane) {
+      reference_area_size = slice * inst->segment_length + index - 1;
+    } else {
+      reference_area_size =
+          slice * inst->segment_length + ((index == 0) ? -1 : 0);
+    }
+  } else {
+    if (same_lane) {
+      reference_area_size = inst->lane_length - inst->segment_length + index - 1;
+    } else {
+      reference_area_size =
+          inst->lane_length - inst->segment_length + ((index == 0) ? -1 : 0);
+    }
+  }
+
+  uint64_t relative_position = pseudo_rand;
+  relative_position = (relative_position * relative_position) >> 32;
+  relative_position =
+      reference_area_size - 1 -
+      (((uint64_t)reference_area_size * relative_position) >> 32);
+
+  uint32_t start_position = 0;
+  if (pass != 0) {
+    start_position = (slice == ARGON2_SYNC_POINTS - 1)
+                         ? 0
+                         : (slice + 1) * inst->segment_length;
+  }
+  return (uint32_t)((start_position + relative_position) % inst->lane_length);
+}
+
+// Fill blocks [begin, end) of one segment. Ranges may be filled one after the
+// other across separate calls; the Argon2i address block is rebuilt from its
+// counter when a range starts mid-way through one.
+static void fill_segment(const argon2_instance *inst, uint32_t pass,
+                         uint32_t lane, uint32_t slice, uint32_t begin,
+                         uint32_t end, argon2_scratch *s) {
+  if (pass == 0 && slice == 0 && begin < 2)
+    begin = 2; // Blocks 0 and 1 come from H'
+  if (begin >= end)
+    return;
+
+  // Argon2id: data-independent addressing for the first half of pass 0
+  int data_independent = (pass == 0) && (slice < ARGON2_SYNC_POINTS / 2);
+
+  if (data_independent) {
+    memset(&s->input, 0, sizeof(argon2_block));
+    s->input.v[0] = pass;
+    s->input.v[1] = lane;
+    s->input.v[2] = slice;
+    s->input.v[3] = inst->memory_blocks;
+    s->input.v[4] = inst->passes;
+    s->input.v[5] = Argon2_id;
+    s->input.v[6] = begin / ARGON2_QWORDS_IN_BLOCK;
+    if (begin % ARGON2_QWORDS_IN_BLOCK != 0)
+      next_addresses(s);
   }
 
-  // Fill blocks
-  for (uint32_t i = 2; i < m_cost; i++) {
-    // Argon2id: first half of first pass is Argon2i (independent addressing)
-    // second half and subsequent passes are Argon2d (dependent addressing)
-    uint32_t ref_idx;
-    if (i < m_cost / 2) {
-      // Placeholder for Argon2i addressing (pseudo-random from internal state)
-      ref_idx = (i - 1) % i;
+  uint32_t curr_offset =
+      lane * inst->lane_length + slice * inst->segment_length + begin;
+  uint32_t prev_offset = (curr_offset % inst->lane_length == 0)
+                             ? curr_offset + inst->lane_length - 1
+                             : curr_offset - 1;
+
+  for (uint32_t i = begin; i < end; i++, curr_offset++, prev_offset++) {
+    if (curr_offset % inst->lane_length == 1)
+      prev_offset = curr_offset - 1;
+
+    uint64_t pseudo_rand;
+    if (data_independent) {
+      if (i % ARGON2_QWORDS_IN_BLOCK == 0)
+        next_addresses(s);
+      pseudo_rand = s->address.v[i % ARGON2_QWORDS_IN_BLOCK];
     } else {
-      // Argon2d: data-dependent addressing
-      uint64_t val = memory[i - 1].v[0];
-      ref_idx = (uint32_t)(val % (i - 1));
+      pseudo_rand = inst->memory[prev_offset].v[0];
     }
-    fill_block(&memory[i - 1], &memory[ref_idx], &memory[i], 0);
+
+    uint32_t ref_lane = (uint32_t)((pseudo_rand >> 32) % inst->lanes);
+    if (pass == 0 && slice == 0)
+      ref_lane = lane;
+
+    uint32_t ref_index = index_alpha(inst, pass, slice, i,
+                                     (uint32_t)pseudo_rand, ref_lane == lane);
+
+    fill_block(&inst->memory[prev_offset],
+               &inst->memory[inst->lane_length * ref_lane + ref_index],
+               &inst->memory[curr_offset], pass != 0, &s->tmp);
   }
+}
+
+// The same block range of every segment in one slice
+typedef struct {
+  const argon2_instance *inst;
+  uint32_t pass;
+  uint32_t slice;
+  uint32_t begin;
+  uint32_t end;
+} argon2_range;
+
+// Fill the lanes of a range that belong to the given worker
+static void fill_range_worker(const argon2_range *r, uint32_t worker) {
+  for (uint32_t lane = worker; lane < r->inst->lanes; lane += ARGON2_WORKERS)
+    fill_segment(r->inst, r->pass, lane, r->slice, r->begin, r->end,
+                 &r->inst->scratch[worker]);
+}
+
+#if defined(LIB_PICO_MULTICORE)
+
+static const argon2_range *volatile core1_range;
+static volatile uint32_t core1_token;
+static int core1_lanes;
+
+// Core 1 is only out of reset while it fills its lanes of one range: it is
+// launched at the start of fill_range, echoes the token when done and core 0
+// puts it back into reset. Between slices nothing runs on core 1, so the
+// firmware may erase or program flash while a job is still pending.
+static void argon2_core1_entry(void) {
+  __mem_fence_acquire();
+  fill_range_worker(core1_range, 1);
+  __mem_fence_release();
+  multicore_fifo_push_blocking(core1_token);
+  for (;;)
+    __wfe();
+}
+
+static void workers_start(const argon2_instance *inst) {
+  core1_lanes = inst->lanes > 1;
+  if (core1_lanes) {
+    multicore_reset_core1();
+    multicore_fifo_drain();
+  }
+}
 
-  // Final Hash
-  blake2b(out, outlen, &memory[m_cost - 1], 1024);
+static void workers_stop(void) {
+  core1_lanes = 0;
+  core1_range = NULL;
+}
+
+static int fill_range(const argon2_range *r) {
+  if (!core1_lanes) {
+    fill_range_worker(r, 0);
+    return ARGON2_OK;
+  }
 
-  free(memory);
-  return 0;
+  core1_range = r;
+  uint32_t token = ++core1_token;
+  __mem_fence_release();
+  multicore_launch_core1(argon2_core1_entry);
+  fill_range_worker(r, 0);
+  // Barrier: core 1 must be done before anything reads its lanes
+  uint32_t done = multicore_fifo_pop_blocking();
+  multicore_reset_core1();
+  if (done != token) {
+    workers_stop();
+    return ARGON2_THREAD_FAIL;
+  }
+  __mem_fence_acquire();
+  return ARGON2_OK;
+}
+
+#elif defined(ARGON2_USE_PTHREADS)
+
+static void *argon2_thread(void *p) {
+  fill_range_worker((const argon2_range *)p, 1);
+  return NULL;
+}
+
+static void workers_start(const argon2_instance *inst) { (void)inst; }
+
+static void workers_stop(void) {}
+
+static int fill_range(const argon2_range *r) {
+  pthread_t thread;
+  int spawned = r->inst->lanes > 1;
+  if (spawned &&
+      pthread_create(&thread, NULL, argon2_thread, (void *)r) != 0)
+    return ARGON2_THREAD_FAIL;
+  fill_range_worker(r, 0);
+  if (spawned && pthread_join(thread, NULL) != 0)
+    return ARGON2_THREAD_FAIL;
+  return ARGON2_OK;
+}
+
+#else
+
+static void workers_start(const argon2_instance *inst) { (void)inst; }
+
+static void workers_stop(void) {}
+
+static int fill_range(const argon2_range *r) {
+  fill_range_worker(r, 0);
+  return ARGON2_OK;
+}
+
+#endif
+
+static void initial_hash(uint8_t h0[ARGON2_PREHASH_DIGEST_LENGTH],
+                         const argon2_context *ctx) {
+  blake2b_state S;
+  blake2b_init(&S, ARGON2_PREHASH_DIGEST_LENGTH);
+  blake2b_update32(&S, ctx->lanes);
+  blake2b_update32(&S, ctx->outlen);
+  blake2b_update32(&S, ctx->m_cost);
+  blake2b_update32(&S, ctx->t_cost);
+  blake2b_update32(&S, ARGON2_VERSION_NUMBER);
+  blake2b_update32(&S, Argon2_id);
+  blake2b_update32(&S, ctx->pwdlen);
+  blake2b_update(&S, ctx->pwd, ctx->pwdlen);
+  blake2b_update32(&S, ctx->saltlen);
+  blake2b_update(&S, ctx->salt, ctx->saltlen);
+  blake2b_update32(&S, ctx->secretlen);
+  if (ctx->secretlen)
+    blake2b_update(&S, ctx->secret, ctx->secretlen);
+  blake2b_update32(&S, ctx->adlen);
+  if (ctx->adlen)
+    blake2b_update(&S, ctx->ad, ctx->adlen);
+  blake2b_final(&S, h0);
+}
+
+static void secure_wipe(void *v, size_t n) {
+  volatile uint8_t *p = (volatile uint8_t *)v;
+  while (n--)
+    *p++ = 0;
+}
+
+static void job_instance(const argon2_job *job, argon2_instance *inst) {
+  inst->segment_length = job->segment_length;
+  inst->lane_length = job->segment_length * ARGON2_SYNC_POINTS;
+  inst->memory_blocks = job->memory_blocks;
+  inst->passes = job->ctx.t_cost;
+  inst->lanes = job->ctx.lanes;
+  inst->memory = job->ctx.memory;
+  inst->scratch = (argon2_scratch *)&job->ctx.memory[job->memory_blocks];
+}
+
+static size_t job_used_bytes(const argon2_job *job) {
+  return (size_t)job->memory_blocks * sizeof(argon2_block) +
+         ARGON2_WORKERS * sizeof(argon2_scratch);
+}
+
+int argon2id_begin(argon2_job *job, const argon2_context *ctx) {
+  if (!job)
+    return ARGON2_INCORRECT_PARAMETER;
+  memset(job, 0, sizeof(*job));
+  if (!ctx || !ctx->out || ctx->outlen < ARGON2_MIN_OUTLEN)
+    return ARGON2_INCORRECT_PARAMETER;
+  if (ctx->t_cost < 1 || ctx->lanes < 1 || ctx->lanes > ARGON2_MAX_LANES)
+    return ARGON2_INCORRECT_PARAMETER;
+  if (ctx->m_cost < 2 * ARGON2_SYNC_POINTS * ctx->lanes)
+    return ARGON2_INCORRECT_PARAMETER;
+  if ((!ctx->pwd && ctx->pwdlen) || (!ctx->salt && ctx->saltlen) ||
+      (!ctx->secret && ctx->secretlen) || (!ctx->ad && ctx->adlen))
+    return ARGON2_INCORRECT_PARAMETER;
+  if (!ctx->memory || ctx->memory_blocks < ARGON2_MEMORY_BLOCKS(ctx->m_cost))
+    return ARGON2_MEMORY_ALLOCATION_ERROR;
+
+#if defined(ARGON2_USE_AVX2) && (defined(__x86_64__) || defined(__i386__))
+  if (!fill_block)
+    argon2_select_backend(ARGON2_BACKEND_AUTO);
+#endif
+
+  job->ctx = *ctx;
+  job->segment_length = ctx->m_cost / (ctx->lanes * ARGON2_SYNC_POINTS);
+  job->memory_blocks = job->segment_length * ARGON2_SYNC_POINTS * ctx->lanes;
+
+  argon2_instance inst;
+  job_instance(job, &inst);
+
+  // H0, then the first two blocks of every lane
+  uint8_t h0[ARGON2_PREHASH_DIGEST_LENGTH + 8];
+  initial_hash(h0, ctx);
+  for (uint32_t lane = 0; lane < inst.lanes; lane++) {
+    store32(h0 + ARGON2_PREHASH_DIGEST_LENGTH + 4, lane);
+    for (uint32_t i = 0; i < 2; i++) {
+      uint8_t block_bytes[ARGON2_BLOCK_SIZE];
+      store32(h0 + ARGON2_PREHASH_DIGEST_LENGTH, i);
+      blake2b_long(block_bytes, ARGON2_BLOCK_SIZE, h0, sizeof(h0));
+      argon2_block *b = &inst.memory[lane * inst.lane_length + i];
+      for (int j = 0; j < ARGON2_QWORDS_IN_BLOCK; j++)
+        b->v[j] = load64(block_bytes + j * 8);
+      secure_wipe(block_bytes, sizeof(block_bytes));
+    }
+  }
+  secure_wipe(h0, sizeof(h0));
+
+  // Everything secret now lives in the matrix; drop the caller's pointers
+  job->ctx.pwd = NULL;
+  job->ctx.pwdlen = 0;
+  job->ctx.secret = NULL;
+  job->ctx.secretlen = 0;
+  job->ctx.ad = NULL;
+  job->ctx.adlen = 0;
+
+  workers_start(&inst);
+  job->active = 1;
+  return ARGON2_OK;
+}
+
+int argon2id_step(argon2_job *job, uint32_t max_blocks) {
+  if (!job || !job->active)
+    return ARGON2_INCORRECT_PARAMETER;
+  if (max_blocks == 0)
+    max_blocks = 1;
+
+  argon2_instance inst;
+  job_instance(job, &inst);
+
+  if (job->pass < inst.passes) {
+    argon2_range r = {&inst, job->pass, job->slice, job->index,
+                      inst.segment_length};
+    if (r.end - r.begin > max_blocks)
+      r.end = r.begin + max_blocks;
+
+    int res = fill_range(&r);
+    if (res != ARGON2_OK) {
+      argon2id_abort(job);
+      return res;
+    }
+
+    job->index = r.end;
+    if (job->index == inst.segment_length) {
+      job->index = 0;
+      if (++job->slice == ARGON2_SYNC_POINTS) {
+        job->slice = 0;
+        job->pass++;
+      }
+    }
+    if (job->pass < inst.passes)
+      return ARGON2_PENDING;
+  }
+
+  workers_stop();
+
+  // Final block: XOR of the last block of every lane, then H'
+  argon2_block *final_block = &inst.scratch[0].tmp;
+  memcpy(final_block, &inst.memory[inst.lane_length - 1],
+         sizeof(argon2_block));
+  for (uint32_t lane = 1; lane < inst.lanes; lane++) {
+    const argon2_block *last =
+        &inst.memory[lane * inst.lane_length + inst.lane_length - 1];
+    for (int j = 0; j < ARGON2_QWORDS_IN_BLOCK; j++)
+      final_block->v[j] ^= last->v[j];
+  }
+  uint8_t final_bytes[ARGON2_BLOCK_SIZE];
+  for (int j = 0; j < ARGON2_QWORDS_IN_BLOCK; j++)
+    store64(final_bytes + j * 8, final_block->v[j]);
+  blake2b_long(job->ctx.out, job->ctx.outlen, final_bytes, ARGON2_BLOCK_SIZE);
+  secure_wipe(final_bytes, sizeof(final_bytes));
+
+  secure_wipe(inst.memory, job_used_bytes(job));
+  memset(job, 0, sizeof(*job));
+  return ARGON2_OK;
+}
+
+void argon2id_abort(argon2_job *job) {
+  if (!job || !job->active)
+    return;
+  workers_stop();
+  secure_wipe(job->ctx.memory, job_used_bytes(job));
+  memset(job, 0, sizeof(*job));
+}
+
+uint32_t argon2id_progress(const argon2_job *job) {
+  if (!job || !job->active)
+    return 0;
+  uint64_t total = (uint64_t)job->ctx.t_cost * ARGON2_SYNC_POINTS *
+                   job->segment_length;
+  uint64_t done =
+      ((uint64_t)job->pass * ARGON2_SYNC_POINTS + job->slice) *
+          job->segment_length +
+      job->index;
+  return (uint32_t)(done * 100 / total);
+}
+
+int argon2id_ctx(const argon2_context *ctx) {
+  argon2_job job;
+  int res = argon2id_begin(&job, ctx);
+  if (res != ARGON2_OK)
+    return res;
+  do {
+    res = argon2id_step(&job, UINT32_MAX);
+  } while (res == ARGON2_PENDING);
+  return res;
+}
+
+int argon2id_hash_raw(const uint32_t t_cost, const uint32_t m_cost,
+                      const uint32_t parallelism, const void *pwd,
+                      const size_t pwdlen, const void *salt,
+                      const size_t saltlen, void *out, const size_t outlen,
+                      argon2_block *memory, const size_t memory_blocks) {
+  argon2_context ctx = {0};
+  ctx.out = (uint8_t *)out;
+  ctx.outlen = (uint32_t)outlen;
+  ctx.pwd = (const uint8_t *)pwd;
+  ctx.pwdlen = (uint32_t)pwdlen;
+  ctx.salt = (const uint8_t *)salt;
+  ctx.saltlen = (uint32_t)saltlen;
+  ctx.t_cost = t_cost;
+  ctx.m_cost = m_cost;
+  ctx.lanes = parallelism;
+  ctx.memory = memory;
+  ctx.memory_blocks = memory_blocks;
+  return argon2id_ctx(&ctx);
 }
@@ -7,6 +7,28 @@
 
 #define ARGON2_BLOCK_SIZE 1024
 #define ARGON2_QWORDS_IN_BLOCK (ARGON2_BLOCK_SIZE / 8)
+#define ARGON2_SYNC_POINTS 4
+#define ARGON2_VERSION_NUMBER 0x13
+#define ARGON2_PREHASH_DIGEST_LENGTH 64
+#define ARGON2_MIN_OUTLEN 4
+#define ARGON2_MAX_LANES 16
+#define ARGON2_MAX_WORKERS 2
+#define ARGON2_WORKER_SCRATCH_BLOCKS 3
+
+/*
+ * Blocks of working memory argon2id_ctx needs for a given m_cost (KiB):
+ * the memory matrix plus per-worker scratch. Usable in constant expressions
+ * so callers can size a static arena.
+ */
+#define ARGON2_MEMORY_BLOCKS(m_cost)                                           \
+  ((m_cost) + ARGON2_MAX_WORKERS * ARGON2_WORKER_SCRATCH_BLOCKS)
+
+/* Status codes */
+#define ARGON2_OK 0
+#define ARGON2_PENDING 1 /* argon2id_step: more work left */
+#define ARGON2_INCORRECT_PARAMETER -1
+#define ARGON2_MEMORY_ALLOCATION_ERROR -2
+#define ARGON2_THREAD_FAIL -3
 
 typedef struct {
   uint64_t v[ARGON2_QWORDS_IN_BLOCK];
@@ -14,9 +36,89 @@ typedef struct {
 
 typedef enum { Argon2_d = 0, Argon2_i = 1, Argon2_id = 2 } argon2_type;
 
+/*
+ * Full parameter set for one Argon2id evaluation (RFC 9106, section 3.1).
+ * secret and ad are optional and may be NULL with a zero length.
+ */
+typedef struct {
+  uint8_t *out;
+  uint32_t outlen;
+  const uint8_t *pwd;
+  uint32_t pwdlen;
+  const uint8_t *salt;
+  uint32_t saltlen;
+  const uint8_t *secret;
+  uint32_t secretlen;
+  const uint8_t *ad;
+  uint32_t adlen;
+  uint32_t t_cost;
+  uint32_t m_cost; /* KiB, at least 8 * lanes */
+  uint32_t lanes;
+  /* Caller-owned working memory of at least ARGON2_MEMORY_BLOCKS(m_cost)
+   * blocks. Nothing is allocated internally; the region is wiped on return. */
+  argon2_block *memory;
+  size_t memory_blocks;
+} argon2_context;
+
+/*
+ * Argon2id over an explicit context. Lanes are spread over the available
+ * workers (both cores on RP2350, threads on a host build) and synchronised
+ * at every segment boundary.
+ *
+ * return: ARGON2_OK on success, a negative status code otherwise.
+ */
+int argon2id_ctx(const argon2_context *ctx);
+
+/*
+ * Resumable evaluation, for callers that must stay responsive (USB) while
+ * the KDF runs. argon2id_begin hashes the inputs, so pwd and secret may be
+ * wiped once it returns; out and memory must stay valid until the job ends.
+ * Treat the fields as private.
+ */
+typedef struct {
+  argon2_context ctx;
+  uint32_t segment_length;
+  uint32_t memory_blocks;
+  uint32_t pass;
+  uint32_t slice;
+  uint32_t index; /* next block within the current segment */
+  int active;
+} argon2_job;
+
+int argon2id_begin(argon2_job *job, const argon2_context *ctx);
+
+/*
+ * Fill at most max_blocks blocks of every lane in the current slice.
+ * return: ARGON2_PENDING while work is left, ARGON2_OK once the tag has been
+ * written to ctx->out, a negative status code on failure (job aborted).
+ */
+int argon2id_step(argon2_job *job, uint32_t max_blocks);
+
+/* Stop a job early and wipe its working memory */
+void argon2id_abort(argon2_job *job);
+
+/* Percentage of the block fills done so far */
+uint32_t argon2id_progress(const argon2_job *job);
+
+/*
+ * Block function used by later evaluations. ARGON2_BACKEND_AUTO, the
+ * default, takes AVX2 when the build has it (host, ARGON2_USE_AVX2) and the
+ * CPU supports it. Do not call while an evaluation is running.
+ *
+ * return: the backend now in use.
+ */
+typedef enum {
+  ARGON2_BACKEND_AUTO = 0,
+  ARGON2_BACKEND_PORTABLE = 1,
+  ARGON2_BACKEND_AVX2 = 2
+} argon2_backend;
+
+argon2_backend argon2_select_backend(argon2_backend want);
+
 int argon2id_hash_raw(const uint32_t t_cost, const uint32_t m_cost,
                       const uint32_t parallelism, const void *pwd,
                       const size_t pwdlen, const void *salt,
-                      const size_t saltlen, void *out, const size_t outlen);
+                      const size_t saltlen, void *out, const size_t outlen,
+                      argon2_block *memory, const size_t memory_blocks);
 
 #endif
@@ -0,0 +1,165 @@
+#include "argon2.h"
+
+/*
+ * AVX2 block compression for host builds (ARGON2_USE_AVX2), after the
+ * optimised backend of the Argon2 reference implementation. One ymm register
+ * holds four words, so a row round works on two rows at a time. Compiled
+ * with a target attribute, not -mavx2: argon2.c only calls it after checking
+ * the CPU at run time.
+ */
+#if defined(ARGON2_USE_AVX2) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+#define ARGON2_AVX2 __attribute__((target("avx2")))
+
+#define rotr32(x) _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1))
+#define rotr24(x)                                                              \
+  _mm256_shuffle_epi8(x, _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13,  \
+                                          14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0,  \
+                                          1, 2, 11, 12, 13, 14, 15, 8, 9, 10))
+#define rotr16(x)                                                              \
+  _mm256_shuffle_epi8(x, _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12,  \
+                                          13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7,  \
+                                          0, 1, 10, 11, 12, 13, 14, 15, 8, 9))
+#define rotr63(x) _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x))
+
+/* a = a + b + 2 * lo32(a) * lo32(b) */
+#define BLAMKA(a, b)                                                           \
+  do {                                                                         \
+    __m256i ml = _mm256_mul_epu32(a, b);                                       \
+    a = _mm256_add_epi64(a, _mm256_add_epi64(b, _mm256_add_epi64(ml, ml)));    \
+  } while (0)
+
+#define G1(A0, A1, B0, B1, C0, C1, D0, D1)                                     \
+  do {                                                                         \
+    BLAMKA(A0, B0);                                                            \
+    BLAMKA(A1, B1);                                                            \
+    D0 = rotr32(_mm256_xor_si256(D0, A0));                                     \
+    D1 = rotr32(_mm256_xor_si256(D1, A1));                                     \
+    BLAMKA(C0, D0);                                                            \
+    BLAMKA(C1, D1);                                                            \
+    B0 = rotr24(_mm256_xor_si256(B0, C0));                                     \
+    B1 = rotr24(_mm256_xor_si256(B1, C1));                                     \
+  } while (0)
+
+#define G2(A0, A1, B0, B1, C0, C1, D0, D1)                                     \
+  do {                                                                         \
+    BLAMKA(A0, B0);                                                            \
+    BLAMKA(A1, B1);                                                            \
+    D0 = rotr16(_mm256_xor_si256(D0, A0));                                     \
+    D1 = rotr16(_mm256_xor_si256(D1, A1));                                     \
+    BLAMKA(C0, D0);                                                            \
+    BLAMKA(C1, D1);                                                            \
+    B0 = rotr63(_mm256_xor_si256(B0, C0));                                     \
+    B1 = rotr63(_mm256_xor_si256(B1, C1));                                     \
+  } while (0)
+
+/* Rows: each register pair holds two whole rows, rotate within a register */
+#define DIAGONALIZE_1(A0, B0, C0, D0, A1, B1, C1, D1)                          \
+  do {                                                                         \
+    B0 = _mm256_permute4x64_epi64(B0, _MM_SHUFFLE(0, 3, 2, 1));                \
+    C0 = _mm256_permute4x64_epi64(C0, _MM_SHUFFLE(1, 0, 3, 2));                \
+    D0 = _mm256_permute4x64_epi64(D0, _MM_SHUFFLE(2, 1, 0, 3));                \
+    B1 = _mm256_permute4x64_epi64(B1, _MM_SHUFFLE(0, 3, 2, 1));                \
+    C1 = _mm256_permute4x64_epi64(C1, _MM_SHUFFLE(1, 0, 3, 2));                \
+    D1 = _mm256_permute4x64_epi64(D1, _MM_SHUFFLE(2, 1, 0, 3));                \
+  } while (0)
+
+#define UNDIAGONALIZE_1(A0, B0, C0, D0, A1, B1, C1, D1)                        \
+  do {                                                                         \
+    B0 = _mm256_permute4x64_epi64(B0, _MM_SHUFFLE(2, 1, 0, 3));                \
+    C0 = _mm256_permute4x64_epi64(C0, _MM_SHUFFLE(1, 0, 3, 2));                \
+    D0 = _mm256_permute4x64_epi64(D0, _MM_SHUFFLE(0, 3, 2, 1));                \
+    B1 = _mm256_permute4x64_epi64(B1, _MM_SHUFFLE(2, 1, 0, 3));                \
+    C1 = _mm256_permute4x64_epi64(C1, _MM_SHUFFLE(1, 0, 3, 2));                \
+    D1 = _mm256_permute4x64_epi64(D1, _MM_SHUFFLE(0, 3, 2, 1));                \
+  } while (0)
+
+/* Columns: each register holds word pairs of two columns, so the diagonal
+ * step swaps halves between the registers of a pair */
+#define DIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1)                          \
+  do {                                                                         \
+    __m256i t1 = _mm256_blend_epi32(B0, B1, 0xCC);                             \
+    __m256i t2 = _mm256_blend_epi32(B0, B1, 0x33);                             \
+    B1 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));                \
+    B0 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));                \
+    t1 = C0;                                                                   \
+    C0 = C1;                                                                   \
+    C1 = t1;                                                                   \
+    t1 = _mm256_blend_epi32(D0, D1, 0xCC);                                     \
+    t2 = _mm256_blend_epi32(D0, D1, 0x33);                                     \
+    D0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));                \
+    D1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));                \
+  } while (0)
+
+#define UNDIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1)                        \
+  do {                                                                         \
+    __m256i t1 = _mm256_blend_epi32(B0, B1, 0xCC);                             \
+    __m256i t2 = _mm256_blend_epi32(B0, B1, 0x33);                             \
+    B0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));                \
+    B1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));                \
+    t1 = C0;                                                                   \
+    C0 = C1;                                                                   \
+    C1 = t1;                                                                   \
+    t1 = _mm256_blend_epi32(D0, D1, 0x33);                                     \
+    t2 = _mm256_blend_epi32(D0, D1, 0xCC);                                     \
+    D0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));                \
+    D1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));                \
+  } while (0)
+
+#define ROUND_1(A0, A1, B0, B1, C0, C1, D0, D1)                                \
+  do {                                                                         \
+    G1(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    G2(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    DIAGONALIZE_1(A0, B0, C0, D0, A1, B1, C1, D1);                             \
+    G1(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    G2(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    UNDIAGONALIZE_1(A0, B0, C0, D0, A1, B1, C1, D1);                           \
+  } while (0)
+
+#define ROUND_2(A0, A1, B0, B1, C0, C1, D0, D1)                                \
+  do {                                                                         \
+    G1(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    G2(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    DIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1);                             \
+    G1(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    G2(A0, A1, B0, B1, C0, C1, D0, D1);                                        \
+    UNDIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1);                           \
+  } while (0)
+
+#define YMM_IN_BLOCK (ARGON2_BLOCK_SIZE / 32)
+
+/* Same contract as fill_block in argon2.c; tmp is unused, the state stays in
+ * registers and on the (host-sized) stack */
+ARGON2_AVX2 void argon2_fill_block_avx2(const argon2_block *prev,
+                                        const argon2_block *ref,
+                                        argon2_block *next, int with_xor,
+                                        argon2_block *tmp) {
+  __m256i s[YMM_IN_BLOCK], xy[YMM_IN_BLOCK];
+  int i;
+  (void)tmp;
+
+  for (i = 0; i < YMM_IN_BLOCK; i++) {
+    s[i] = _mm256_loadu_si256((const __m256i *)ref->v + i);
+    if (prev)
+      s[i] = _mm256_xor_si256(
+          s[i], _mm256_loadu_si256((const __m256i *)prev->v + i));
+    xy[i] = with_xor ? _mm256_xor_si256(
+                           s[i], _mm256_loadu_si256((__m256i *)next->v + i))
+                     : s[i];
+  }
+
+  for (i = 0; i < 4; i++)
+    ROUND_1(s[8 * i + 0], s[8 * i + 4], s[8 * i + 1], s[8 * i + 5],
+            s[8 * i + 2], s[8 * i + 6], s[8 * i + 3], s[8 * i + 7]);
+  for (i = 0; i < 4; i++)
+    ROUND_2(s[0 + i], s[4 + i], s[8 + i], s[12 + i], s[16 + i], s[20 + i],
+            s[24 + i], s[28 + i]);
+
+  for (i = 0; i < YMM_IN_BLOCK; i++)
+    _mm256_storeu_si256((__m256i *)next->v + i, _mm256_xor_si256(s[i], xy[i]));
+}
+
+#else
+typedef int argon2_avx2_unused; /* ISO C forbids an empty unit */
+#endif
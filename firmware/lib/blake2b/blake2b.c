@@ -0,0 +1,231 @@
+#include "blake2b.h"
+#include <string.h>
+
+/*
+ * BLAKE2b (RFC 7693), shared by Argon2 and anything else that needs it.
+ *
+ * The compression function is fully unrolled: every message word index is a
+ * compile-time constant, so on Cortex-M33 each G step turns into immediate-
+ * offset loads and 32-bit add/adc and shift pairs instead of sigma table
+ * lookups. The working state stays in locals so the compiler can keep as
+ * much of it in registers as the target allows.
+ */
+
+static const uint64_t blake2b_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+    0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+static inline uint64_t rotr64(uint64_t x, int n) {
+  return (x >> n) | (x << (64 - n));
+}
+
+static inline uint64_t load64(const uint8_t *p) {
+  uint32_t lo = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+                ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+  uint32_t hi = (uint32_t)p[4] | ((uint32_t)p[5] << 8) |
+                ((uint32_t)p[6] << 16) | ((uint32_t)p[7] << 24);
+  return ((uint64_t)hi << 32) | lo;
+}
+
+static inline void store32(uint8_t *p, uint32_t w) {
+  p[0] = (uint8_t)w;
+  p[1] = (uint8_t)(w >> 8);
+  p[2] = (uint8_t)(w >> 16);
+  p[3] = (uint8_t)(w >> 24);
+}
+
+static inline void store64(uint8_t *p, uint64_t w) {
+  store32(p, (uint32_t)w);
+  store32(p + 4, (uint32_t)(w >> 32));
+}
+
+static void secure_wipe(void *v, size_t n) {
+  volatile uint8_t *p = (volatile uint8_t *)v;
+  while (n--)
+    *p++ = 0;
+}
+
+#define G(a, b, c, d, x, y)                                                    \
+  do {                                                                         \
+    a = a + b + (x);                                                           \
+    d = rotr64(d ^ a, 32);                                                     \
+    c = c + d;                                                                 \
+    b = rotr64(b ^ c, 24);                                                     \
+    a = a + b + (y);                                                           \
+    d = rotr64(d ^ a, 16);                                                     \
+    c = c + d;                                                                 \
+    b = rotr64(b ^ c, 63);                                                     \
+  } while (0)
+
+#define ROUND(s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, \
+              s15)                                                             \
+  do {                                                                         \
+    G(v0, v4, v8, v12, m[s0], m[s1]);                                          \
+    G(v1, v5, v9, v13, m[s2], m[s3]);                                          \
+    G(v2, v6, v10, v14, m[s4], m[s5]);                                         \
+    G(v3, v7, v11, v15, m[s6], m[s7]);                                         \
+    G(v0, v5, v10, v15, m[s8], m[s9]);                                         \
+    G(v1, v6, v11, v12, m[s10], m[s11]);                                       \
+    G(v2, v7, v8, v13, m[s12], m[s13]);                                        \
+    G(v3, v4, v9, v14, m[s14], m[s15]);                                        \
+  } while (0)
+
+static void blake2b_compress(blake2b_state *S, const uint8_t *block,
+                             int last) {
+  uint64_t m[16];
+  for (int i = 0; i < 16; i++)
+    m[i] = load64(block + i * 8);
+
+  uint64_t v0 = S->h[0], v1 = S->h[1], v2 = S->h[2], v3 = S->h[3];
+  uint64_t v4 = S->h[4], v5 = S->h[5], v6 = S->h[6], v7 = S->h[7];
+  uint64_t v8 = blake2b_iv[0], v9 = blake2b_iv[1];
+  uint64_t v10 = blake2b_iv[2], v11 = blake2b_iv[3];
+  uint64_t v12 = blake2b_iv[4] ^ S->t[0];
+  uint64_t v13 = blake2b_iv[5] ^ S->t[1];
+  uint64_t v14 = last ? ~blake2b_iv[6] : blake2b_iv[6];
+  uint64_t v15 = blake2b_iv[7];
+
+  ROUND(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  ROUND(14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3);
+  ROUND(11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4);
+  ROUND(7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8);
+  ROUND(9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13);
+  ROUND(2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9);
+  ROUND(12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11);
+  ROUND(13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10);
+  ROUND(6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5);
+  ROUND(10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0);
+  ROUND(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  ROUND(14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3);
+
+  S->h[0] ^= v0 ^ v8;
+  S->h[1] ^= v1 ^ v9;
+  S->h[2] ^= v2 ^ v10;
+  S->h[3] ^= v3 ^ v11;
+  S->h[4] ^= v4 ^ v12;
+  S->h[5] ^= v5 ^ v13;
+  S->h[6] ^= v6 ^ v14;
+  S->h[7] ^= v7 ^ v15;
+}
+
+#undef ROUND
+#undef G
+
+static void blake2b_increment(blake2b_state *S, size_t inc) {
+  S->t[0] += inc;
+  if (S->t[0] < inc)
+    S->t[1]++;
+}
+
+int blake2b_init(blake2b_state *S, size_t outlen) {
+  return blake2b_init_key(S, outlen, NULL, 0);
+}
+
+int blake2b_init_key(blake2b_state *S, size_t outlen, const void *key,
+                     size_t keylen) {
+  if (outlen == 0 || outlen > BLAKE2B_OUTBYTES || keylen > BLAKE2B_KEYBYTES ||
+      (!key && keylen))
+    return -1;
+
+  memset(S, 0, sizeof(*S));
+  memcpy(S->h, blake2b_iv, sizeof(S->h));
+  S->h[0] ^= 0x01010000 ^ ((uint64_t)keylen << 8) ^ outlen;
+  S->outlen = outlen;
+
+  if (keylen) {
+    // The key is padded to a full block and processed as the first block
+    memcpy(S->buf, key, keylen);
+    S->buflen = BLAKE2B_BLOCKBYTES;
+  }
+  return 0;
+}
+
+void blake2b_update(blake2b_state *S, const void *in, size_t inlen) {
+  const uint8_t *p = (const uint8_t *)in;
+  if (inlen == 0)
+    return;
+
+  // The last block must be compressed by blake2b_final, so a full buffer
+  // is only flushed once more input arrives.
+  size_t fill = BLAKE2B_BLOCKBYTES - S->buflen;
+  if (inlen > fill) {
+    memcpy(S->buf + S->buflen, p, fill);
+    blake2b_increment(S, BLAKE2B_BLOCKBYTES);
+    blake2b_compress(S, S->buf, 0);
+    S->buflen = 0;
+    p += fill;
+    inlen -= fill;
+
+    // Compress whole blocks straight from the input
+    while (inlen > BLAKE2B_BLOCKBYTES) {
+      blake2b_increment(S, BLAKE2B_BLOCKBYTES);
+      blake2b_compress(S, p, 0);
+      p += BLAKE2B_BLOCKBYTES;
+      inlen -= BLAKE2B_BLOCKBYTES;
+    }
+  }
+  memcpy(S->buf + S->buflen, p, inlen);
+  S->buflen += inlen;
+}
+
+void blake2b_final(blake2b_state *S, void *out) {
+  uint8_t digest[BLAKE2B_OUTBYTES];
+  blake2b_increment(S, S->buflen);
+  memset(S->buf + S->buflen, 0, BLAKE2B_BLOCKBYTES - S->buflen);
+  blake2b_compress(S, S->buf, 1);
+  for (int i = 0; i < 8; i++)
+    store64(digest + i * 8, S->h[i]);
+  memcpy(out, digest, S->outlen);
+  secure_wipe(digest, sizeof(digest));
+  secure_wipe(S, sizeof(*S));
+}
+
+int blake2b(void *out, size_t outlen, const void *in, size_t inlen) {
+  blake2b_state S;
+  if (blake2b_init(&S, outlen) != 0)
+    return -1;
+  blake2b_update(&S, in, inlen);
+  blake2b_final(&S, out);
+  return 0;
+}
+
+int blake2b_long(void *out, size_t outlen, const void *in, size_t inlen) {
+  uint8_t *o = (uint8_t *)out;
+  uint8_t len_le[4];
+  blake2b_state S;
+
+  if (outlen == 0 || outlen > UINT32_MAX)
+    return -1;
+  store32(len_le, (uint32_t)outlen);
+
+  if (outlen <= BLAKE2B_OUTBYTES) {
+    blake2b_init(&S, outlen);
+    blake2b_update(&S, len_le, sizeof(len_le));
+    blake2b_update(&S, in, inlen);
+    blake2b_final(&S, o);
+    return 0;
+  }
+
+  // V1 = H^64(LE32(T) || X), then Vi = H^64(Vi-1); emit 32 bytes of each
+  uint8_t v[BLAKE2B_OUTBYTES];
+  blake2b_init(&S, BLAKE2B_OUTBYTES);
+  blake2b_update(&S, len_le, sizeof(len_le));
+  blake2b_update(&S, in, inlen);
+  blake2b_final(&S, v);
+  memcpy(o, v, BLAKE2B_OUTBYTES / 2);
+  o += BLAKE2B_OUTBYTES / 2;
+  size_t remaining = outlen - BLAKE2B_OUTBYTES / 2;
+
+  while (remaining > BLAKE2B_OUTBYTES) {
+    blake2b(v, BLAKE2B_OUTBYTES, v, BLAKE2B_OUTBYTES);
+    memcpy(o, v, BLAKE2B_OUTBYTES / 2);
+    o += BLAKE2B_OUTBYTES / 2;
+    remaining -= BLAKE2B_OUTBYTES / 2;
+  }
+
+  // The last step emits its full (possibly shorter) digest
+  blake2b(o, remaining, v, BLAKE2B_OUTBYTES);
+  secure_wipe(v, sizeof(v));
+  return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef BLAKE2B_H
+#define BLAKE2B_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BLAKE2B_BLOCKBYTES 128
+#define BLAKE2B_OUTBYTES 64
+#define BLAKE2B_KEYBYTES 64
+
+typedef struct {
+  uint64_t h[8];
+  uint64_t t[2];
+  uint8_t buf[BLAKE2B_BLOCKBYTES];
+  size_t buflen;
+  size_t outlen;
+} blake2b_state;
+
+/*
+ * Streaming BLAKE2b (RFC 7693).
+ *
+ * blake2b_init / blake2b_init_key return 0 on success and -1 if outlen is
+ * not in [1, 64] or keylen exceeds 64. blake2b_final wipes the state.
+ */
+int blake2b_init(blake2b_state *S, size_t outlen);
+int blake2b_init_key(blake2b_state *S, size_t outlen, const void *key,
+                     size_t keylen);
+void blake2b_update(blake2b_state *S, const void *in, size_t inlen);
+void blake2b_final(blake2b_state *S, void *out);
+
+/* One-shot helper, unkeyed */
+int blake2b(void *out, size_t outlen, const void *in, size_t inlen);
+
+/*
+ * H' variable-length hash from Argon2 (RFC 9106, section 3.3). Any
+ * outlen >= 1 is accepted; outputs above 64 bytes are chained.
+ */
+int blake2b_long(void *out, size_t outlen, const void *in, size_t inlen);
+
+#endif
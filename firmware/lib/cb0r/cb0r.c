@@ -1,7 +1,7 @@
 #include "cb0r.h"
 
 // Endian helpers for RP2350 (Little Endian)
-#ifndef __APPLE__
+#if !defined(__APPLE__) && !defined(htobe16) // glibc has them as macros
 static inline uint16_t htobe16(uint16_t x) { return (x << 8) | (x >> 8); }
 static inline uint32_t htobe32(uint32_t x) {
   return ((x & 0xFF000000) >> 24) | ((x & 0x00FF0000) >> 8) |
@@ -417,7 +417,7 @@ uint8_t cb0r_write(uint8_t *out, cb0r_e type, uint64_t number) {
     out[0] |= number;
     return 1;
   }
-  if (number >= UINT32_MAX) { // Simple check for uint64 size
+  if (number > UINT32_MAX) {
     out[0] |= 27;
     uint64_t be64 = htobe64(number);
     memcpy(out + 1, &be64, 8);
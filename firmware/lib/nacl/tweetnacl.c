@@ -8,28 +8,29 @@ typedef unsigned char u8;
 typedef unsigned long u32;
 typedef unsigned long long u64;
 typedef long long i64;
-typedef i64 gf[16];
+typedef int i32;
+
+/*
+ * Field elements mod 2^255 - 19 in radix 2^25.5: ten signed limbs of
+ * alternately 26 and 25 bits, as in ref10. A product is 100 32x32->64
+ * multiply-accumulates (SMLAL on Cortex-M33) instead of 256 64-bit ones.
+ */
+typedef i32 gf[10];
 
 static const u8 _0[16] = {0};
 static const u8 _9[32] = {9};
 static const gf gf0 = {0};
 static const gf gf1 = {1};
-static const gf _121665 = {0xDB41, 1};
-static const gf D = {0x78a3, 0x1359, 0x4dca, 0x75eb, 0xd8ab, 0x4141,
-                     0x0a4d, 0x0070, 0xe898, 0x7779, 0x4079, 0x8cc7,
-                     0xfe73, 0x2b6f, 0x6cee, 0x5203};
-static const gf D2 = {0xf159, 0x26b2, 0x9b94, 0xebd6, 0xb156, 0x8283,
-                      0x149a, 0x00e0, 0xd130, 0xeef3, 0x80f2, 0x198e,
-                      0xfce7, 0x56df, 0xd9dc, 0x2406};
-static const gf X = {0xd51a, 0x8f25, 0x2d60, 0xc956, 0xa7b2, 0x9525,
-                     0xc760, 0x692c, 0xdc5c, 0xfdd6, 0xe231, 0xc0a4,
-                     0x53fe, 0xcd6e, 0x36d3, 0x2169};
-static const gf Y = {0x6658, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666,
-                     0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666,
-                     0x6666, 0x6666, 0x6666, 0x6666};
-static const gf I = {0xa0b0, 0x4a0e, 0x1b27, 0xc4ee, 0xe478, 0xad2f,
-                     0x1806, 0x2f43, 0xd7a7, 0x3dfb, 0x0099, 0x2b4d,
-                     0xdf0b, 0x4fc1, 0x2480, 0x2b83};
+static const gf D = {0x35978a3, 0x0d37284, 0x3156ebd, 0x06a0a0e, 0x001c029,
+                     0x179e898, 0x3a03cbb, 0x1ce7198, 0x2e2b6ff, 0x1480db3};
+static const gf D2 = {0x2b2f159, 0x1a6e509, 0x22add7a, 0x0d4141d, 0x0038052,
+                      0x0f3d130, 0x3407977, 0x19ce331, 0x1c56dff, 0x0901b67};
+static const gf X = {0x325d51a, 0x18b5823, 0x0f6592a, 0x104a92d, 0x1a4b31d,
+                     0x1d6dc5c, 0x27118fe, 0x07fd814, 0x13cd6e5, 0x085a4db};
+static const gf Y = {0x2666658, 0x1999999, 0x0cccccc, 0x1333333, 0x1999999,
+                     0x0666666, 0x3333333, 0x0cccccc, 0x2666666, 0x1999999};
+static const gf I = {0x20ea0b0, 0x186c9d2, 0x08f189d, 0x035697f, 0x0bd0c60,
+                     0x1fbd7a7, 0x2804c9e, 0x1e16569, 0x004fc1d, 0x0ae0c92};
 
 static u32 L32(u32 x, int c) {
   return (x << c) | ((x & 0xffffffff) >> (32 - c));
@@ -120,50 +121,57 @@ sv add1305(u32 *h, const u32 *c) {
 static const u32 minusp[17] = {5, 0, 0, 0, 0, 0, 0, 0,  0,
                                0, 0, 0, 0, 0, 0, 0, 252};
 
+#define LIMB_BITS(i) (26 - ((i) & 1))
+
 sv set25519(gf r, const gf a) {
   int i;
-  FOR(i, 16) r[i] = a[i];
+  FOR(i, 10) r[i] = a[i];
 }
-sv car25519(gf o) {
+// Carry t into o, leaving limbs within 2^25 (26-bit) and 2^24 (25-bit)
+sv car25519(gf o, i64 t[10]) {
   int i;
   i64 c;
-  FOR(i, 16) {
-    o[i] += (1LL << 16);
-    c = o[i] >> 16;
-    o[(i + 1) * (i < 15)] += c - 1 + 37 * (c - 1) * (i == 15);
-    o[i] -= c << 16;
+  FOR(i, 11) {
+    int k = i % 10, b = LIMB_BITS(k);
+    c = (t[k] + ((i64)1 << (b - 1))) >> b;
+    t[(k + 1) % 10] += c * (k == 9 ? 19 : 1);
+    t[k] -= c * ((i64)1 << b);
   }
+  FOR(i, 10) o[i] = (i32)t[i];
 }
 sv sel25519(gf p, gf q, int b) {
-  i64 t, i, c = ~(b - 1);
-  FOR(i, 16) {
+  i32 t, c = ~(b - 1);
+  int i;
+  FOR(i, 10) {
     t = c & (p[i] ^ q[i]);
     p[i] ^= t;
     q[i] ^= t;
   }
 }
 sv pack25519(u8 *o, const gf n) {
-  int i, j, b;
-  gf m, t;
-  FOR(i, 16) t[i] = n[i];
-  car25519(t);
-  car25519(t);
-  car25519(t);
-  FOR(j, 2) {
-    m[0] = t[0] - 0xffed;
-    for (i = 1; i < 15; i++) {
-      m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
-      m[i - 1] &= 0xffff;
-    }
-    m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
-    b = (m[15] >> 16) & 1;
-    m[14] &= 0xffff;
-    sel25519(t, m, 1 - b);
+  i64 t[10], q;
+  u64 acc = 0;
+  int i, bits = 0;
+  gf h;
+  FOR(i, 10) t[i] = n[i];
+  car25519(h, t);
+  // q = 1 iff h >= p; then h - q * p = h + 19 * q - q * 2^255
+  q = (19 * (i64)h[9] + ((i64)1 << 24)) >> 25;
+  FOR(i, 10) q = (h[i] + q) >> LIMB_BITS(i);
+  t[0] = h[0] + 19 * q;
+  FOR(i, 9) {
+    t[i + 1] = h[i + 1] + (t[i] >> LIMB_BITS(i));
+    t[i] &= ((i64)1 << LIMB_BITS(i)) - 1;
   }
-  FOR(i, 16) {
-    o[2 * i] = t[i] & 0xff;
-    o[2 * i + 1] = t[i] >> 8;
+  t[9] &= ((i64)1 << 25) - 1;
+  FOR(i, 10) {
+    acc |= (u64)t[i] << bits;
+    for (bits += LIMB_BITS(i); bits >= 8; bits -= 8) {
+      *o++ = acc & 0xff;
+      acc >>= 8;
+    }
   }
+  *o = acc;
 }
 static int neq25519(const gf a, const gf b) {
   u8 c[32], d[32];
@@ -177,58 +185,117 @@ static u8 par25519(const gf a) {
   return d[0] & 1;
 }
 sv unpack25519(gf o, const u8 *n) {
-  int i;
-  FOR(i, 16) o[i] = n[2 * i] + ((i64)n[2 * i + 1] << 8);
-  o[15] &= 0x7fff;
+  u64 acc = 0;
+  int i, bits = 0;
+  FOR(i, 10) {
+    for (; bits < LIMB_BITS(i); bits += 8)
+      acc |= (u64)*n++ << bits;
+    o[i] = acc & ((1 << LIMB_BITS(i)) - 1);
+    acc >>= LIMB_BITS(i);
+    bits -= LIMB_BITS(i);
+  }
 }
 sv A(gf o, const gf a, const gf b) {
   int i;
-  FOR(i, 16) o[i] = a[i] + b[i];
+  FOR(i, 10) o[i] = a[i] + b[i];
 }
 sv Z(gf o, const gf a, const gf b) {
   int i;
-  FOR(i, 16) o[i] = a[i] - b[i];
+  FOR(i, 10) o[i] = a[i] - b[i];
 }
+/*
+ * a[i] * b[j] lands in limb i + j, times 2 when both i and j are odd (the
+ * 25-bit limbs round down) and times 19 past limb 9 (2^255 = 19). Inputs may
+ * be sums or differences of up to three reduced elements.
+ */
 sv M(gf o, const gf a, const gf b) {
-  i64 i, j, t[31];
-  FOR(i, 31) t[i] = 0;
-  FOR(i, 16) FOR(j, 16) t[i + j] += a[i] * b[j];
-  FOR(i, 15) t[i] += 38 * t[i + 16];
-  FOR(i, 16) o[i] = t[i];
-  car25519(o);
-  car25519(o);
-}
-sv S(gf o, const gf a) { M(o, a, a); }
-sv inv25519(gf o, const gf i) {
-  gf c;
-  int a;
-  FOR(a, 16) c[a] = i[a];
-  for (a = 253; a >= 0; a--) {
-    S(c, c);
-    if (a != 2 && a != 4)
-      M(c, c, i);
+  i64 t[10];
+  i32 b19[10];
+  int i, j;
+  FOR(i, 10) {
+    t[i] = 0;
+    b19[i] = 19 * b[i];
+  }
+  FOR(i, 10) {
+    i32 a1 = a[i], a2 = a[i] * (1 + (i & 1));
+    FOR(j, 10 - i) t[i + j] += (i64)(j & 1 ? a2 : a1) * b[j];
+    for (; j < 10; j++)
+      t[i + j - 10] += (i64)(j & 1 ? a2 : a1) * b19[j];
   }
-  FOR(a, 16) o[a] = c[a];
+  car25519(o, t);
 }
-sv pow2523(gf o, const gf i) {
-  gf c;
-  int a;
-  FOR(a, 16) c[a] = i[a];
-  for (a = 250; a >= 0; a--) {
-    S(c, c);
-    if (a != 1)
-      M(c, c, i);
+// 55 products: cross terms once, doubled
+sv S(gf o, const gf a) {
+  i64 t[10];
+  i32 a19[10];
+  int i, j;
+  FOR(i, 10) {
+    t[i] = 0;
+    a19[i] = 19 * a[i];
   }
-  FOR(a, 16) o[a] = c[a];
+  FOR(i, 10) for (j = i; j < 10; j++) {
+    i32 x = a[i] * ((i & j & 1) + 1) * ((i != j) + 1);
+    t[(i + j) % 10] += (i64)x * (i + j < 10 ? a[j] : a19[j]);
+  }
+  car25519(o, t);
+}
+sv Sn(gf o, const gf a, int n) {
+  S(o, a);
+  while (--n)
+    S(o, o);
+}
+// z^(2^250 - 1), and z^11 in z11; shared by inv25519 and pow2523
+sv pow2250(gf o, gf z11, const gf z) {
+  gf t0, t1, t2;
+  S(t0, z);
+  Sn(t1, t0, 2);
+  M(t1, z, t1);
+  M(z11, t0, t1);
+  S(t0, z11);
+  M(t1, t1, t0);  // 2^5 - 1
+  Sn(t0, t1, 5);
+  M(t1, t0, t1);  // 2^10 - 1
+  Sn(t0, t1, 10);
+  M(t0, t0, t1);  // 2^20 - 1
+  Sn(t2, t0, 20);
+  M(t0, t2, t0);  // 2^40 - 1
+  Sn(t0, t0, 10);
+  M(t1, t0, t1);  // 2^50 - 1
+  Sn(t0, t1, 50);
+  M(t0, t0, t1);  // 2^100 - 1
+  Sn(t2, t0, 100);
+  M(t0, t2, t0);  // 2^200 - 1
+  Sn(t0, t0, 50);
+  M(o, t0, t1);  // 2^250 - 1
+}
+// i^(p - 2)
+sv inv25519(gf o, const gf i) {
+  gf t, z11;
+  pow2250(t, z11, i);
+  Sn(t, t, 5);
+  M(o, t, z11);
+}
+// i^((p - 5) / 8)
+sv pow2523(gf o, const gf i) {
+  gf t, z11;
+  pow2250(t, z11, i);
+  Sn(t, t, 2);
+  M(o, t, i);
 }
 
-static u64 R(u64 x, int c) { return (x >> c) | (x << (64 - c)); }
-static u64 Ch(u64 x, u64 y, u64 z) { return (x & y) ^ (~x & z); }
-static u64 Maj(u64 x, u64 y, u64 z) { return (x & y) ^ (x & z) ^ (y & z); }
-static u64 Sigma0(u64 x) { return R(x, 28) ^ R(x, 34) ^ R(x, 39); }
-static u64 Sigma1(u64 x) { return R(x, 14) ^ R(x, 18) ^ R(x, 41); }
-static u64 sigma0(u64 x) { return R(x, 1) ^ R(x, 8) ^ (x >> 7); }
-static u64 sigma1(u64 x) { return R(x, 19) ^ R(x, 61) ^ (x >> 6); }
+/*
+ * SHA-512. Rounds are unrolled eight at a time so the working variables
+ * rotate by renaming instead of being copied, the schedule is a 16-word
+ * ring, and blocks load as big-endian 32-bit words (LDR + REV on the M33)
+ * rather than a byte at a time.
+ */
+#define R(x, c) (((x) >> (c)) | ((x) << (64 - (c))))
+#define Ch(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define Maj(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define Sigma0(x) (R(x, 28) ^ R(x, 34) ^ R(x, 39))
+#define Sigma1(x) (R(x, 14) ^ R(x, 18) ^ R(x, 41))
+#define sigma0(x) (R(x, 1) ^ R(x, 8) ^ ((x) >> 7))
+#define sigma1(x) (R(x, 19) ^ R(x, 61) ^ ((x) >> 6))
 
 static const u64 K[80] = {
     0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
@@ -259,58 +326,129 @@ static const u64 K[80] = {
     0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
     0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
 
-int crypto_hashblocks(u8 *x, const u8 *m, u64 n) {
-  u64 z[8], b[8], a[8], w[16], t;
-  int i, j;
-  FOR(i, 8) z[i] = a[i] = dl64(x + 8 * i);
-  while (n >= 128) {
-    FOR(i, 16) w[i] = dl64(m + 8 * i);
-    FOR(i, 80) {
-      FOR(j, 8) b[j] = a[j];
-      t = a[7] + Sigma1(a[4]) + Ch(a[4], a[5], a[6]) + K[i] + w[i % 16];
-      b[7] = t + Sigma0(a[0]) + Maj(a[0], a[1], a[2]);
-      b[3] += t;
-      FOR(j, 8) a[(j + 1) % 8] = b[j];
-      if (i % 16 == 15)
-        FOR(j, 16)
-        w[j] += w[(j + 9) % 16] + sigma0(w[(j + 1) % 16]) +
-                sigma1(w[(j + 14) % 16]);
+static u64 ld64be(const u8 *x) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) &&                          \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  unsigned int hi, lo;
+  memcpy(&hi, x, 4);
+  memcpy(&lo, x + 4, 4);
+  return (u64)__builtin_bswap32(hi) << 32 | __builtin_bswap32(lo);
+#else
+  return dl64(x);
+#endif
+}
+
+/* W[i] for i >= 16, written over W[i - 16] */
+#define W(i)                                                                   \
+  (w[(i) & 15] += sigma1(w[((i) + 14) & 15]) + w[((i) + 9) & 15] +            \
+                  sigma0(w[((i) + 1) & 15]))
+#define RND(a, b, c, d, e, f, g, h, i, wi)                                     \
+  t = h + Sigma1(e) + Ch(e, f, g) + K[i] + (wi);                               \
+  d += t;                                                                      \
+  h = t + Sigma0(a) + Maj(a, b, c)
+#define RND8(i, w0, w1, w2, w3, w4, w5, w6, w7)                                \
+  RND(a, b, c, d, e, f, g, h, i, w0);                                          \
+  RND(h, a, b, c, d, e, f, g, i + 1, w1);                                      \
+  RND(g, h, a, b, c, d, e, f, i + 2, w2);                                      \
+  RND(f, g, h, a, b, c, d, e, i + 3, w3);                                      \
+  RND(e, f, g, h, a, b, c, d, i + 4, w4);                                      \
+  RND(d, e, f, g, h, a, b, c, i + 5, w5);                                      \
+  RND(c, d, e, f, g, h, a, b, i + 6, w6);                                      \
+  RND(b, c, d, e, f, g, h, a, i + 7, w7)
+
+sv sha512_blocks(u64 *z, const u8 *m, u64 n) {
+  u64 a, b, c, d, e, f, g, h, t, w[16];
+  int i;
+  for (; n >= 128; m += 128, n -= 128) {
+    FOR(i, 16) w[i] = ld64be(m + 8 * i);
+    a = z[0];
+    b = z[1];
+    c = z[2];
+    d = z[3];
+    e = z[4];
+    f = z[5];
+    g = z[6];
+    h = z[7];
+    for (i = 0; i < 16; i += 8) {
+      RND8(i, w[i], w[i + 1], w[i + 2], w[i + 3], w[i + 4], w[i + 5], w[i + 6],
+           w[i + 7]);
     }
-    FOR(i, 8) {
-      a[i] += z[i];
-      z[i] = a[i];
+    for (; i < 80; i += 8) {
+      RND8(i, W(i), W(i + 1), W(i + 2), W(i + 3), W(i + 4), W(i + 5), W(i + 6),
+           W(i + 7));
     }
-    m += 128;
-    n -= 128;
+    z[0] += a;
+    z[1] += b;
+    z[2] += c;
+    z[3] += d;
+    z[4] += e;
+    z[5] += f;
+    z[6] += g;
+    z[7] += h;
   }
+}
+
+int crypto_hashblocks(u8 *x, const u8 *m, u64 n) {
+  u64 z[8];
+  int i;
+  FOR(i, 8) z[i] = ld64be(x + 8 * i);
+  sha512_blocks(z, m, n);
   FOR(i, 8) ts64(x + 8 * i, z[i]);
-  return n;
+  return n & 127;
 }
 
-static const u8 iv[64] = {
-    0x6a, 0x09, 0xe6, 0x67, 0xf3, 0xbc, 0xc9, 0x08, 0xbb, 0x67, 0xae,
-    0x85, 0x84, 0xca, 0xa7, 0x3b, 0x3c, 0x6e, 0xf3, 0x72, 0xfe, 0x94,
-    0xf8, 0x2b, 0xa5, 0x4f, 0xf5, 0x3a, 0x5f, 0x1d, 0x36, 0xf1, 0x51,
-    0x0e, 0x52, 0x7f, 0xad, 0xe6, 0x82, 0xd1, 0x9b, 0x05, 0x68, 0x8c,
-    0x2b, 0x3e, 0x6c, 0x1f, 0x1f, 0x83, 0xd9, 0xab, 0xfb, 0x41, 0xbd,
-    0x6b, 0x5b, 0xe0, 0xcd, 0x19, 0x13, 0x7e, 0x21, 0x79};
+static const u64 iv[8] = {0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+                          0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+                          0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+                          0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
 
-int crypto_hash_sha512_tweet(u8 *out, const u8 *m, u64 n) {
-  u8 h[64], x[256];
-  u64 i, b = n;
-  FOR(i, 64) h[i] = iv[i];
-  crypto_hashblocks(h, m, n);
-  m += n;
+typedef crypto_hash_sha512_tweet_state sha512_ctx;
+
+void crypto_hash_sha512_tweet_init(sha512_ctx *c) {
+  int i;
+  FOR(i, 8) c->h[i] = iv[i];
+  c->n = 0;
+}
+void crypto_hash_sha512_tweet_update(sha512_ctx *c, const u8 *m, u64 n) {
+  u64 i, k = c->n & 127;
+  c->n += n;
+  if (k) {
+    for (; n && k < 128; --n)
+      c->x[k++] = *m++;
+    if (k < 128)
+      return;
+    sha512_blocks(c->h, c->x, 128);
+  }
+  sha512_blocks(c->h, m, n);
+  m += n & ~(u64)127;
   n &= 127;
-  m -= n;
-  FOR(i, 256) x[i] = 0;
-  FOR(i, n) x[i] = m[i];
-  x[n] = 128;
-  n = 256 - 128 * (n < 112);
-  x[n - 9] = b >> 61;
-  ts64(x + n - 8, b << 3);
-  crypto_hashblocks(h, x, n);
-  FOR(i, 64) out[i] = h[i];
+  FOR(i, n) c->x[i] = m[i];
+}
+void crypto_hash_sha512_tweet_final(sha512_ctx *c, u8 *out) {
+  u64 i, n = c->n & 127;
+  FOR(i, n + 1) c->x[i] = i < n ? c->x[i] : 128;
+  for (i = n + 1; i < 128; ++i)
+    c->x[i] = 0;
+  if (n >= 112) {
+    sha512_blocks(c->h, c->x, 128);
+    FOR(i, 112) c->x[i] = 0;
+  }
+  ts64(c->x + 112, c->n >> 61);
+  ts64(c->x + 120, c->n << 3);
+  sha512_blocks(c->h, c->x, 128);
+  FOR(i, 8) ts64(out + 8 * i, c->h[i]);
+  FOR(i, sizeof(*c)) ((volatile u8 *)c)[i] = 0;
+}
+
+#define sha512_init crypto_hash_sha512_tweet_init
+#define sha512_update crypto_hash_sha512_tweet_update
+#define sha512_final crypto_hash_sha512_tweet_final
+
+int crypto_hash_sha512_tweet(u8 *out, const u8 *m, u64 n) {
+  sha512_ctx c;
+  sha512_init(&c);
+  sha512_update(&c, m, n);
+  sha512_final(&c, out);
   return 0;
 }
 
@@ -367,6 +505,100 @@ sv scalarbase(gf p[4], const u8 *s) {
   }
 }
 
+/*
+ * Fixed-base comb for secret scalars (signing nonce, key generation).
+ *
+ * The scalar is recoded into 64 signed radix-16 digits in [-8, 8] and
+ * s * B = sum e[i] * 16^i * B is built from a flash table of
+ * (j + 1) * 256^i * B: 32 mixed additions for the odd digits, four
+ * doublings, 32 more for the even digits. That is 68 point operations instead
+ * of the ladder's 512. Table lookups scan all eight entries, so timing does
+ * not depend on the scalar. Needs s[31] <= 127, which holds for clamped keys
+ * and values reduced mod L; verification keeps the ladder.
+ */
+#include "ed25519_base.h"
+
+#define COMB_STEPS crypto_sign_ed25519_tweet_STEPS
+
+// p += q, q affine as (y + x, y - x, 2 * d * x * y)
+sv madd(gf p[4], gf q[3]) {
+  gf a, b, c, d, e, f, g, h;
+  Z(a, p[1], p[0]);
+  M(a, a, q[1]);
+  A(b, p[0], p[1]);
+  M(b, b, q[0]);
+  M(c, p[3], q[2]);
+  A(d, p[2], p[2]);
+  Z(e, b, a);
+  Z(f, d, c);
+  A(g, d, c);
+  A(h, b, a);
+  M(p[0], e, f);
+  M(p[1], h, g);
+  M(p[2], g, f);
+  M(p[3], e, h);
+}
+
+// t = e * 256^pos * B for a digit e in [-8, 8]
+sv comb_select(gf t[3], int pos, signed char e) {
+  u8 buf[96], neg = (u8)e >> 7, mag = (u8)(e - (-(int)neg & e) * 2);
+  gf n;
+  int i, j;
+  FOR(i, 96) buf[i] = 0;
+  buf[0] = 1; // Neutral element: y + x = y - x = 1, 2dxy = 0
+  buf[32] = 1;
+  FOR(j, 8) {
+    u8 mask = (u8)-(((unsigned)(mag ^ (j + 1)) - 1u) >> 31);
+    FOR(i, 96) buf[i] ^= mask & (buf[i] ^ ed25519_base[pos][j][i]);
+  }
+  unpack25519(t[0], buf);
+  unpack25519(t[1], buf + 32);
+  unpack25519(t[2], buf + 64);
+  // -P swaps y + x with y - x and negates 2dxy
+  sel25519(t[0], t[1], neg);
+  Z(n, gf0, t[2]);
+  sel25519(t[2], n, neg);
+}
+
+sv comb_recode(signed char e[64], const u8 *s) {
+  signed char carry = 0;
+  int i;
+  FOR(i, 32) {
+    e[2 * i] = s[i] & 15;
+    e[2 * i + 1] = (s[i] >> 4) & 15;
+  }
+  FOR(i, 63) {
+    e[i] += carry;
+    carry = (e[i] + 8) >> 4;
+    e[i] -= carry * 16;
+  }
+  e[63] += carry;
+}
+
+sv comb_init(gf p[4], signed char e[64], const u8 *s) {
+  comb_recode(e, s);
+  set25519(p[0], gf0);
+  set25519(p[1], gf1);
+  set25519(p[2], gf1);
+  set25519(p[3], gf0);
+}
+
+// Steps 0..31 add the odd digits, step 32 multiplies by 16, steps 33..64
+// add the even digits
+sv comb_step(gf p[4], const signed char e[64], int step) {
+  gf t[3];
+  int i;
+  if (step < 32) {
+    comb_select(t, step, e[2 * step + 1]);
+    madd(p, t);
+  } else if (step == 32) {
+    FOR(i, 4) add(p, p);
+  } else {
+    comb_select(t, step - 33, e[2 * (step - 33)]);
+    madd(p, t);
+  }
+}
+
 static const u64 L[32] = {0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
                           0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
                           0,    0,    0,    0,    0,    0,    0,    0,
@@ -404,27 +636,31 @@ sv reduce(u8 *r) {
 
 int crypto_sign_ed25519_tweet(u8 *sm, u64 *smlen, const u8 *m, u64 n,
                               const u8 *sk) {
-  u8 d[64], h[64], r[64];
-  i64 i, j, x[64];
-  gf p[4];
-  crypto_hash_sha512_tweet(d, sk, 32);
-  d[0] &= 248;
-  d[31] &= 127;
-  d[31] |= 64;
-  *smlen = n + 64;
-  FOR(i, n) sm[64 + i] = m[i];
-  FOR(i, 32) sm[32 + i] = d[32 + i];
-  crypto_hash_sha512_tweet(r, sm + 32, n + 32);
-  reduce(r);
-  scalarbase(p, r);
-  pack(sm, p);
-  FOR(i, 32) sm[i + 32] = sk[i + 32];
-  crypto_hash_sha512_tweet(h, sm, n + 64);
-  reduce(h);
-  FOR(i, 64) x[i] = 0;
-  FOR(i, 32) x[i] = (u64)r[i];
-  FOR(i, 32) FOR(j, 32) x[i + j] += (u64)h[i] * (u64)d[j];
-  modL(sm + 32, x);
+  crypto_sign_ed25519_tweet_job job;
+  crypto_sign_ed25519_tweet_start(&job, sm, smlen, m, n, sk);
+  while (crypto_sign_ed25519_tweet_step(&job, COMB_STEPS))
+    ;
+  return 0;
+}
+
+int crypto_sign_ed25519_tweet_detached(u8 *sig,
+                                       const crypto_sign_ed25519_tweet_iov *m,
+                                       unsigned count, const u8 *sk) {
+  crypto_sign_ed25519_tweet_job job;
+  crypto_sign_ed25519_tweet_detached_start(&job, sig, m, count, sk);
+  while (crypto_sign_ed25519_tweet_step(&job, COMB_STEPS))
+    ;
+  return 0;
+}
+
+int crypto_sign_ed25519_tweet_detached_expanded(
+    u8 *sig, const crypto_sign_ed25519_tweet_iov *m, unsigned count,
+    const u8 *d, const u8 *pk) {
+  crypto_sign_ed25519_tweet_job job;
+  crypto_sign_ed25519_tweet_detached_expanded_start(&job, sig, m, count, d,
+                                                    pk);
+  while (crypto_sign_ed25519_tweet_step(&job, COMB_STEPS))
+    ;
   return 0;
 }
 
@@ -503,16 +739,122 @@ int crypto_sign_ed25519_tweet_open(u8 *m, u64 *mlen, const u8 *sm, u64 n,
 }
 
 int crypto_sign_ed25519_tweet_keypair(u8 *pk, u8 *sk) {
-  u8 d[64];
-  gf p[4];
-  int i;
-  // randombytes(sk, 32); // Must be provided externally
+  crypto_sign_ed25519_tweet_job job;
+  crypto_sign_ed25519_tweet_keypair_start(&job, pk, sk);
+  while (crypto_sign_ed25519_tweet_step(&job, COMB_STEPS))
+    ;
+  return 0;
+}
+
+/*
+ * Resumable signing and key generation. Everything up to the base point
+ * multiplication runs in _start, the comb in _step, and packing R and the
+ * final s = r + h * d mod L once the last comb step has run.
+ */
+sv wipe(void *v, u64 n) {
+  volatile u8 *p = (volatile u8 *)v;
+  while (n--)
+    *p++ = 0;
+}
+
+sv expand(u8 d[64], const u8 *sk) {
   crypto_hash_sha512_tweet(d, sk, 32);
   d[0] &= 248;
   d[31] &= 127;
   d[31] |= 64;
-  scalarbase(p, d);
-  pack(pk, p);
-  FOR(i, 32) sk[32 + i] = pk[i];
+}
+
+void crypto_sign_ed25519_tweet_expand(u8 *d, const u8 *sk) { expand(d, sk); }
+
+// Hashes prefix || parts into the nonce; the parts are read again at the end
+int crypto_sign_ed25519_tweet_detached_expanded_start(
+    crypto_sign_ed25519_tweet_job *job, u8 *sig,
+    const crypto_sign_ed25519_tweet_iov *m, unsigned count, const u8 *d,
+    const u8 *pk) {
+  sha512_ctx c;
+  unsigned i;
+  memset(job, 0, sizeof(*job));
+  FOR(i, 64) job->d[i] = d[i];
+  sha512_init(&c);
+  sha512_update(&c, job->d + 32, 32);
+  FOR(i, count) sha512_update(&c, m[i].base, m[i].len);
+  sha512_final(&c, job->r);
+  wipe(&c, sizeof(c));
+  reduce(job->r);
+  FOR(i, 32) job->a[i] = pk[i];
+  job->sig = sig;
+  job->m = m;
+  job->count = count;
+  comb_init(job->p, job->e, job->r);
+  return 0;
+}
+
+int crypto_sign_ed25519_tweet_detached_start(
+    crypto_sign_ed25519_tweet_job *job, u8 *sig,
+    const crypto_sign_ed25519_tweet_iov *m, unsigned count, const u8 *sk) {
+  u8 d[64];
+  expand(d, sk);
+  crypto_sign_ed25519_tweet_detached_expanded_start(job, sig, m, count, d,
+                                                    sk + 32);
+  wipe(d, sizeof(d));
+  return 0;
+}
+
+int crypto_sign_ed25519_tweet_start(crypto_sign_ed25519_tweet_job *job, u8 *sm,
+                                    u64 *smlen, const u8 *m, u64 n,
+                                    const u8 *sk) {
+  crypto_sign_ed25519_tweet_iov part = {sm + 64, n};
+  u64 i;
+  *smlen = n + 64;
+  FOR(i, n) sm[64 + i] = m[i];
+  crypto_sign_ed25519_tweet_detached_start(job, sm, &part, 1, sk);
+  job->part = part;
+  job->m = &job->part;
+  return 0;
+}
+
+int crypto_sign_ed25519_tweet_keypair_start(crypto_sign_ed25519_tweet_job *job,
+                                            u8 *pk, u8 *sk) {
+  memset(job, 0, sizeof(*job));
+  expand(job->r, sk);
+  job->pk = pk;
+  job->sk = sk;
+  comb_init(job->p, job->e, job->r);
+  return 0;
+}
+
+int crypto_sign_ed25519_tweet_step(crypto_sign_ed25519_tweet_job *job,
+                                   unsigned steps) {
+  i64 i, j, x[64];
+  u8 h[64];
+  for (; steps > 0 && job->step < COMB_STEPS; --steps, ++job->step)
+    comb_step(job->p, job->e, job->step);
+  if (job->step < COMB_STEPS)
+    return 1;
+
+  if (job->pk) {
+    pack(job->pk, job->p);
+    FOR(i, 32) job->sk[32 + i] = job->pk[i];
+  } else {
+    sha512_ctx c;
+    unsigned k;
+    pack(job->sig, job->p);
+    sha512_init(&c);
+    sha512_update(&c, job->sig, 32);
+    sha512_update(&c, job->a, 32);
+    FOR(k, job->count) sha512_update(&c, job->m[k].base, job->m[k].len);
+    sha512_final(&c, h);
+    reduce(h);
+    FOR(i, 64) x[i] = 0;
+    FOR(i, 32) x[i] = (u64)job->r[i];
+    FOR(i, 32) FOR(j, 32) x[i + j] += (u64)h[i] * (u64)job->d[j];
+    modL(job->sig + 32, x);
+    wipe(x, sizeof(x));
+  }
+  crypto_sign_ed25519_tweet_abort(job);
   return 0;
 }
+
+void crypto_sign_ed25519_tweet_abort(crypto_sign_ed25519_tweet_job *job) {
+  wipe(job, sizeof(*job));
+}
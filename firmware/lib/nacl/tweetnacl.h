@@ -18,7 +18,102 @@ extern int crypto_sign_ed25519_tweet_open(unsigned char *m,
 extern int crypto_sign_ed25519_tweet_keypair(unsigned char *pk,
                                              unsigned char *sk);
 
+/*
+ * Detached signing of a message given as `count` parts. The parts are
+ * streamed through SHA-512 where they lie (read twice, for the nonce and for
+ * the challenge), and only the 64-byte signature is written to sig.
+ */
+typedef struct {
+  const unsigned char *base;
+  unsigned long long len;
+} crypto_sign_ed25519_tweet_iov;
+
+extern int crypto_sign_ed25519_tweet_detached(
+    unsigned char *sig, const crypto_sign_ed25519_tweet_iov *m, unsigned count,
+    const unsigned char *sk);
+
+/*
+ * Signing with a pre-expanded key: d is SHA-512(sk[0..31]) clamped, as
+ * written by _expand, and pk the public key. Lets a caller that signs with
+ * the same key repeatedly skip the key hash; d is as secret as sk.
+ */
+extern void crypto_sign_ed25519_tweet_expand(unsigned char *d,
+                                             const unsigned char *sk);
+extern int crypto_sign_ed25519_tweet_detached_expanded(
+    unsigned char *sig, const crypto_sign_ed25519_tweet_iov *m, unsigned count,
+    const unsigned char *d, const unsigned char *pk);
+
+/*
+ * Resumable versions of sign and keypair for callers that must keep servicing
+ * USB while the base point multiplication runs. _start does the hashing, each
+ * _step runs up to `steps` of the crypto_sign_ed25519_tweet_STEPS comb steps
+ * and returns 1 while more remain, 0 once the signature (or pk and
+ * sk[32..63]) has been written. The outputs (sm, sig, or pk and sk) and
+ * the message parts of _detached_start must stay valid until then.
+ * The job holds secrets: finish it or call _abort, which wipes it.
+ */
+#define crypto_sign_ed25519_tweet_STEPS 65
+
+typedef struct {
+  int p[4][10];        /* point, field elements in radix 2^25.5 */
+  signed char e[64];   /* radix-16 digits of the scalar */
+  unsigned char d[64]; /* expanded secret key (signing) */
+  unsigned char r[64]; /* scalar: nonce, or expanded key for keypair */
+  unsigned char a[32]; /* public key */
+  unsigned char *sig;
+  const crypto_sign_ed25519_tweet_iov *m;
+  unsigned count;
+  crypto_sign_ed25519_tweet_iov part; /* the message, for _start */
+  unsigned char *pk;
+  unsigned char *sk;
+  int step;
+} crypto_sign_ed25519_tweet_job;
+
+extern int crypto_sign_ed25519_tweet_start(crypto_sign_ed25519_tweet_job *job,
+                                           unsigned char *sm,
+                                           unsigned long long *smlen,
+                                           const unsigned char *m,
+                                           unsigned long long mlen,
+                                           const unsigned char *sk);
+extern int crypto_sign_ed25519_tweet_detached_start(
+    crypto_sign_ed25519_tweet_job *job, unsigned char *sig,
+    const crypto_sign_ed25519_tweet_iov *m, unsigned count,
+    const unsigned char *sk);
+extern int crypto_sign_ed25519_tweet_detached_expanded_start(
+    crypto_sign_ed25519_tweet_job *job, unsigned char *sig,
+    const crypto_sign_ed25519_tweet_iov *m, unsigned count,
+    const unsigned char *d, const unsigned char *pk);
+extern int
+crypto_sign_ed25519_tweet_keypair_start(crypto_sign_ed25519_tweet_job *job,
+                                        unsigned char *pk, unsigned char *sk);
+extern int crypto_sign_ed25519_tweet_step(crypto_sign_ed25519_tweet_job *job,
+                                          unsigned steps);
+extern void crypto_sign_ed25519_tweet_abort(crypto_sign_ed25519_tweet_job *job);
+
 extern int crypto_hash_sha512_tweet(unsigned char *out, const unsigned char *m,
                                     unsigned long long n);
 
+/*
+ * Incremental SHA-512, for hashing a message given in parts. _final writes
+ * the 64-byte digest and wipes the state.
+ */
+typedef struct {
+  unsigned long long h[8];
+  unsigned char x[128];
+  unsigned long long n;
+} crypto_hash_sha512_tweet_state;
+
+extern void crypto_hash_sha512_tweet_init(crypto_hash_sha512_tweet_state *c);
+extern void crypto_hash_sha512_tweet_update(crypto_hash_sha512_tweet_state *c,
+                                            const unsigned char *m,
+                                            unsigned long long n);
+extern void crypto_hash_sha512_tweet_final(crypto_hash_sha512_tweet_state *c,
+                                           unsigned char *out);
+/*
+ * SHA-512 compression over the whole 128-byte blocks of m, updating the
+ * 64-byte big-endian state x. Returns the number of bytes left over.
+ */
+extern int crypto_hashblocks(unsigned char *x, const unsigned char *m,
+                             unsigned long long n);
+
 #endif
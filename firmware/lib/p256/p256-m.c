@@ -294,6 +294,15 @@ static uint64_t u32_muladd64(uint32_t x, uint32_t y, uint32_t z, uint32_t t)
 
 #endif /* GCC/Clang with Cortex-M/A CPU */
 
+/*
+ * Builds for a core known to have UMAAL (the RP2350's Cortex-M33) define
+ * P256_REQUIRE_UMAAL, so that flags lacking the DSP extension fail here
+ * instead of silently using the much slower 16x16-bit kernel.
+ */
+#if defined(P256_REQUIRE_UMAAL) && !defined(MULADD64_SMALL)
+#error "p256-m: UMAAL kernel not selected (is __ARM_FEATURE_DSP defined?)"
+#endif
+
 #if !defined(MULADD64_ASM)
 #if defined(MUL64_IS_CONSTANT_TIME)
 static uint64_t u32_muladd64(uint32_t x, uint32_t y, uint32_t z, uint32_t t)
@@ -1040,18 +1049,18 @@ static void point_to_bytes(uint8_t p[64],
  *
  **********************************************************************/
 
-/*
- * Scalar multiplication
- *
- * in: P = (px, py), affine (Montgomery), must be on the curve and not 0
- *     s in [1, n-1]
- * out: R = s * P = (rx, ry), affine coordinates (Montgomery).
- *
- * Note: as memory areas, none of the parameters may overlap.
- */
-static void scalar_mult(uint32_t rx[8], uint32_t ry[8],
-                        const uint32_t px[8], const uint32_t py[8],
-                        const uint32_t s[8])
+/* State of the variable-base ladder, resumable like the comb below */
+typedef struct {
+    uint32_t rx[8], ry[8], rz[8];
+    uint32_t px[8], py[8], py_neg[8];
+    uint32_t s_odd[8];
+    uint32_t negate;
+    unsigned bit;
+} p256_ladder;
+
+static void scalar_mult_init(p256_ladder *l,
+                             const uint32_t px[8], const uint32_t py[8],
+                             const uint32_t s[8])
 {
     /*
      * We use a signed binary ladder, see for example slides 10-14 of
@@ -1059,7 +1068,7 @@ static void scalar_mult(uint32_t rx[8], uint32_t ry[8],
      * implicit recoding, and a different loop initialisation to avoid feeding
      * 0 to our addition formulas, as they don't support it.
      */
-    uint32_t s_odd[8], py_neg[8], py_use[8], rz[8];
+    uint32_t zero[8];
 
     /*
      * Make s odd by replacing it with n - s if necessary.
@@ -1069,19 +1078,34 @@ static void scalar_mult(uint32_t rx[8], uint32_t ry[8],
      *
      * Either way, we can compute s * P as s_odd * P'.
      */
-    u256_sub(s_odd, p256_n.m, s); /* no carry, result still in [1, n-1] */
-    uint32_t negate = ~s[0] & 1;
-    u256_cmov(s_odd, s, 1 - negate);
+    u256_sub(l->s_odd, p256_n.m, s); /* no carry, result still in [1, n-1] */
+    l->negate = ~s[0] & 1;
+    u256_cmov(l->s_odd, s, 1 - l->negate);
+
+    /* Keep our own copy of P: callers may reuse its storage for R */
+    u256_cmov(l->px, px, 1);
+    u256_cmov(l->py, py, 1);
 
     /* Compute py_neg = - py mod p (that's the y coordinate of -P) */
-    u256_set32(py_use, 0);
-    m256_sub_p(py_neg, py_use, py);
+    u256_set32(zero, 0);
+    m256_sub_p(l->py_neg, zero, py);
 
     /* Initialize R = P' = (x:(-1)^negate * y:1) */
-    u256_cmov(rx, px, 1);
-    u256_cmov(ry, py, 1);
-    m256_set32(rz, 1, &p256_p);
-    u256_cmov(ry, py_neg, negate);
+    u256_cmov(l->rx, px, 1);
+    u256_cmov(l->ry, py, 1);
+    m256_set32(l->rz, 1, &p256_p);
+    u256_cmov(l->ry, l->py_neg, l->negate);
+
+    l->bit = 255;
+}
+
+/*
+ * Run up to `steps` iterations of the ladder started by scalar_mult_init().
+ * return: non-zero while iterations remain
+ */
+static int scalar_mult_steps(p256_ladder *l, unsigned steps)
+{
+    uint32_t py_use[8];
 
     /*
      * For any odd number s_odd = b255 ... b1 1, we have
@@ -1109,19 +1133,165 @@ static void scalar_mult(uint32_t rx[8], uint32_t ry[8],
      *      Otherwise, s_odd = n-2, and for this curve's value of n,
      *      we have b1 == 1, so sbit(b1) = 1 and 2 s_1 <= n-3.
      */
-    for (unsigned i = 255; i > 0; i--) {
-        uint32_t bit = (s_odd[i / 32] >> i % 32) & 1;
+    u256_set32(py_use, 0);
+    for (; steps > 0 && l->bit > 0; steps--, l->bit--) {
+        unsigned i = l->bit;
+        uint32_t bit = (l->s_odd[i / 32] >> i % 32) & 1;
 
         /* set (px, py_use) = sbit(bit) P' = sbit(bit) * (-1)^negate P */
-        u256_cmov(py_use, py, bit ^ negate);
-        u256_cmov(py_use, py_neg, (1 - bit) ^ negate);
+        u256_cmov(py_use, l->py, bit ^ l->negate);
+        u256_cmov(py_use, l->py_neg, (1 - bit) ^ l->negate);
 
         /* Update R = 2 * R +- P' */
-        point_double(rx, ry, rz);
-        point_add(rx, ry, rz, px, py_use);
+        point_double(l->rx, l->ry, l->rz);
+        point_add(l->rx, l->ry, l->rz, l->px, py_use);
+    }
+
+    return l->bit > 0;
+}
+
+/*
+ * Scalar multiplication
+ *
+ * in: P = (px, py), affine (Montgomery), must be on the curve and not 0
+ *     s in [1, n-1]
+ * out: R = s * P = (rx, ry), affine coordinates (Montgomery).
+ *
+ * Note: as memory areas, rx, ry and s may not overlap.
+ */
+static void scalar_mult(uint32_t rx[8], uint32_t ry[8],
+                        const uint32_t px[8], const uint32_t py[8],
+                        const uint32_t s[8])
+{
+    p256_ladder l;
+
+    scalar_mult_init(&l, px, py, s);
+    scalar_mult_steps(&l, 255);
+    point_to_affine(l.rx, l.ry, l.rz);
+
+    u256_cmov(rx, l.rx, 1);
+    u256_cmov(ry, l.ry, 1);
+    zeroize(&l, sizeof l);
+}
+
+/*
+ * Fixed-base scalar multiplication by G, for the secret random scalars of
+ * key generation and ECDSA signing (verification keeps scalar_mult()).
+ *
+ * s_odd, as in scalar_mult_init(), is recoded into 64 odd signed radix-16
+ * digits: with k_i = (s_odd >> 4i) | 1, d_i = (k_i mod 32) - 16 for i < 63
+ * and d_63 = k_63. Then s_odd * G = sum d_i 16^i G is built from p256_base,
+ * which holds the odd multiples of 256^i G: the odd-indexed digits first (32
+ * lookups, 31 additions), four doublings, then the even-indexed ones (32
+ * additions). That is 63 additions and 4 doublings instead of 255 of each.
+ *
+ * Digits are never 0, so point_add() never sees the point at infinity. In
+ * the first half a partial sum is smaller in magnitude than 256^(i+1), so it
+ * cannot equal +- the next term; in the second half that takes a relation
+ * between the two halves of the scalar that random scalars meet with
+ * negligible probability. Lookups scan all eight entries of a row.
+ */
+#include "p256_base.h"
+
+static void scalar_mult_base_init(p256_comb *c, const uint32_t s[8])
+{
+    uint32_t s_odd[8];
+
+    /* as in scalar_mult_init(), but -P' is folded into the digit signs */
+    u256_sub(s_odd, p256_n.m, s);
+    c->negate = ~s[0] & 1;
+    u256_cmov(s_odd, s, 1 - c->negate);
+
+    for (unsigned i = 0; i < 64; i++) {
+        unsigned pos = 4 * i;
+        uint32_t k = s_odd[pos / 32] >> (pos % 32);
+        if (pos % 32 == 28 && pos / 32 < 7)
+            k |= s_odd[pos / 32 + 1] << 4;
+        k |= 1;
+        c->digit[i] = (signed char) (i < 63 ? (int) (k & 31) - 16
+                                            : (int) (k & 15));
+    }
+
+    zeroize(s_odd, sizeof s_odd);
+    c->step = 0;
+}
+
+/* (x, y) = (-1)^negate * d * 256^pos * G for an odd digit d in [-15, 15] */
+static void scalar_mult_base_select(uint32_t x[8], uint32_t y[8],
+                                    unsigned pos, int d, uint32_t negate)
+{
+    uint32_t neg = (uint32_t) d >> 31;
+    uint32_t idx = (((uint32_t) d ^ (0 - neg)) + neg) >> 1; /* (|d|-1)/2 */
+    uint32_t y_neg[8], zero[8];
+
+    for (uint32_t j = 0; j < 8; j++) {
+        uint32_t eq = ((idx ^ j) - 1) >> 31;
+        u256_cmov(x, p256_base[pos][j][0], eq);
+        u256_cmov(y, p256_base[pos][j][1], eq);
+    }
+
+    u256_set32(zero, 0);
+    m256_sub_p(y_neg, zero, y);
+    u256_cmov(y, y_neg, neg ^ negate);
+}
+
+/*
+ * Run up to `steps` of the P256_COMB_STEPS steps started by
+ * scalar_mult_base_init(): 0..31 add the odd-indexed digits, 32 multiplies
+ * by 16, 33..64 add the even-indexed digits.
+ * return: non-zero while steps remain
+ */
+static int scalar_mult_base_steps(p256_comb *c, unsigned steps)
+{
+    uint32_t x[8], y[8];
+
+    for (; steps > 0 && c->step < P256_COMB_STEPS; steps--, c->step++) {
+        unsigned i = c->step;
+
+        if (i == 32) {
+            for (unsigned k = 0; k < 4; k++)
+                point_double(c->rx, c->ry, c->rz);
+            continue;
+        }
+
+        if (i < 32)
+            scalar_mult_base_select(x, y, i, c->digit[2 * i + 1], c->negate);
+        else
+            scalar_mult_base_select(x, y, i - 33, c->digit[2 * (i - 33)],
+                                    c->negate);
+
+        if (i == 0) {
+            u256_cmov(c->rx, x, 1);
+            u256_cmov(c->ry, y, 1);
+            m256_set32(c->rz, 1, &p256_p);
+        } else {
+            point_add(c->rx, c->ry, c->rz, x, y);
+        }
     }
 
-    point_to_affine(rx, ry, rz);
+    zeroize(x, sizeof x);
+    zeroize(y, sizeof y);
+    return c->step < P256_COMB_STEPS;
+}
+
+/*
+ * Fixed-base scalar multiplication
+ *
+ * in: s in [1, n-1], random
+ * out: R = s * G = (rx, ry), affine coordinates (Montgomery).
+ */
+static void scalar_mult_base(uint32_t rx[8], uint32_t ry[8],
+                             const uint32_t s[8])
+{
+    p256_comb c;
+
+    scalar_mult_base_init(&c, s);
+    scalar_mult_base_steps(&c, P256_COMB_STEPS);
+    point_to_affine(c.rx, c.ry, c.rz);
+
+    u256_cmov(rx, c.rx, 1);
+    u256_cmov(ry, c.ry, 1);
+    zeroize(&c, sizeof c);
 }
 
 /*
@@ -1178,7 +1348,7 @@ static int scalar_gen_with_pub(uint8_t sbytes[32], uint32_t s[8],
     while (ret != 0);
 
     /* compute and ouput the associated public key */
-    scalar_mult(x, y, p256_gx, p256_gy, s);
+    scalar_mult_base(x, y, s);
 
     /* the associated public key is not a secret */
     CT_UNPOISON(x, 32);
@@ -1202,6 +1372,62 @@ int p256_gen_keypair(uint8_t priv[32], uint8_t pub[64])
     return 0;
 }
 
+/*
+ * ECDH/ECDSA generate pair, resumable
+ */
+int p256_gen_keypair_start(p256_keypair_job *job,
+                           uint8_t priv[32], uint8_t pub[64])
+{
+    uint32_t s[8];
+    int ret;
+    unsigned nb_tried = 0;
+
+    /* same scalar generation as scalar_gen_with_pub() */
+    do {
+        if (nb_tried++ >= 4) {
+            zeroize(s, sizeof s);
+            return P256_RANDOM_FAILED;
+        }
+
+        ret = p256_generate_random(priv, 32);
+        CT_POISON(priv, 32);
+        if (ret != 0) {
+            zeroize(s, sizeof s);
+            return P256_RANDOM_FAILED;
+        }
+
+        ret = scalar_from_bytes(s, priv);
+        CT_UNPOISON(&ret, sizeof ret);
+    }
+    while (ret != 0);
+
+    scalar_mult_base_init(&job->comb, s);
+    job->pub = pub;
+    zeroize(s, sizeof s);
+    return P256_SUCCESS;
+}
+
+int p256_gen_keypair_step(p256_keypair_job *job, unsigned steps)
+{
+    if (scalar_mult_base_steps(&job->comb, steps))
+        return P256_PENDING;
+
+    point_to_affine(job->comb.rx, job->comb.ry, job->comb.rz);
+
+    /* the associated public key is not a secret */
+    CT_UNPOISON(job->comb.rx, 32);
+    CT_UNPOISON(job->comb.ry, 32);
+
+    point_to_bytes(job->pub, job->comb.rx, job->comb.ry);
+    p256_gen_keypair_abort(job);
+    return P256_SUCCESS;
+}
+
+void p256_gen_keypair_abort(p256_keypair_job *job)
+{
+    zeroize(job, sizeof *job);
+}
+
 /**********************************************************************
  *
  * ECDH
@@ -16,6 +16,7 @@
 #define P256_INVALID_PUBKEY     -2
 #define P256_INVALID_PRIVKEY    -3
 #define P256_INVALID_SIGNATURE  -4
+#define P256_PENDING            1   /* p256_gen_keypair_step(): not done */
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,46 @@ extern int p256_generate_random(uint8_t * output, unsigned output_size);
  */
 int p256_gen_keypair(uint8_t priv[32], uint8_t pub[64]);
 
+/*
+ * Resumable key pair generation, for callers that must stay responsive while
+ * the scalar multiplication runs. Treat the fields as private.
+ */
+#define P256_COMB_STEPS 65
+
+typedef struct {
+    uint32_t rx[8], ry[8], rz[8];
+    signed char digit[64];  /* odd signed radix-16 digits of the scalar */
+    uint32_t negate;
+    unsigned step;
+} p256_comb;
+
+typedef struct {
+    p256_comb comb;
+    uint8_t *pub;
+} p256_keypair_job;
+
+/*
+ * [in] draws from p256_generate_random()
+ * [out] priv: on success, holds the private key
+ * pub must stay valid until the job finishes; it is written by the last step.
+ *
+ * return:  P256_SUCCESS on success
+ *          P256_RANDOM_FAILED on failure
+ */
+int p256_gen_keypair_start(p256_keypair_job *job,
+                           uint8_t priv[32], uint8_t pub[64]);
+
+/*
+ * Run up to `steps` of the P256_COMB_STEPS fixed-base comb steps.
+ *
+ * return:  P256_PENDING while steps remain
+ *          P256_SUCCESS once pub has been written (job wiped)
+ */
+int p256_gen_keypair_step(p256_keypair_job *job, unsigned steps);
+
+/* Stop a job early and wipe it */
+void p256_gen_keypair_abort(p256_keypair_job *job);
+
 /*
  * ECDH compute shared secret
  *
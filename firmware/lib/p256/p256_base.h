@@ -0,0 +1,1092 @@
+/* Generated by tools/gen_p256_base.py, do not edit. */
+/* [i][j] = (2 * j + 1) * 256^i * G as (x, y), Montgomery domain */
+static const uint32_t p256_base[32][8][2][8] = {
+  {
+    {{0x18a9143c, 0x79e730d4, 0x5fedb601, 0x75ba95fc,
+      0x77622510, 0x79fb732b, 0xa53755c6, 0x18905f76},
+     {0xce95560a, 0xddf25357, 0xba19e45c, 0x8b4ab8e4,
+      0xdd21f325, 0xd2e88688, 0x25885d85, 0x8571ff18}},
+    {{0x4eebc127, 0xffac3f90, 0x087d81fb, 0xb027f84a,
+      0x87cbbc98, 0x66ad77dd, 0xb6ff747e, 0x26936a3f},
+     {0xc983a7eb, 0xb04c5c1f, 0x0861fe1a, 0x583e47ad,
+      0x1a2ee98e, 0x78820831, 0xe587cc07, 0xd5f06a29}},
+    {{0xc45c61f5, 0xbe1b8aae, 0x94b9537d, 0x90ec649a,
+      0xd076c20c, 0x941cb5aa, 0x890523c8, 0xc9079605},
+     {0xe7ba4f10, 0xeb309b4a, 0xe5eb882b, 0x73c568ef,
+      0x7e7a1f68, 0x3540a987, 0x2dd1e916, 0x73a076bb}},
+    {{0xa0173b4f, 0x0746354e, 0xd23c00f7, 0x2bd20213,
+      0x0c23bb08, 0xf43eaab5, 0xc3123e03, 0x13ba5119},
+     {0x3f5b9d4d, 0x2847d030, 0x5da67bdd, 0x6742f2f2,
+      0x77c94195, 0xef933bdc, 0x6e240867, 0xeaedd915}},
+    {{0x264e20e8, 0x75c96e8f, 0x59a7a841, 0xabe6bfed,
+      0x44c8eb00, 0x2cc09c04, 0xf0c4e16b, 0xe05b3080},
+     {0xa45f3314, 0x1eb7777a, 0xce5d45e3, 0x56af7bed,
+      0x88b12f1a, 0x2b6e019a, 0xfd835f9b, 0x086659cd}},
+    {{0x6245e404, 0xea7d260a, 0x6e7fdfe0, 0x9de40795,
+      0x8dac1ab5, 0x1ff3a415, 0x649c9073, 0x3e7090f1},
+     {0x2b944e88, 0x1a768561, 0xe57f61c8, 0x250f939e,
+      0x1ead643d, 0x0c0daa89, 0xe125b88e, 0x68930023}},
+    {{0x4b2ed709, 0xccc42563, 0x856fd30d, 0x0e356769,
+      0x559e9811, 0xbcbcd43f, 0x5395b759, 0x738477ac},
+     {0xc00ee17f, 0x35752b90, 0x742ed2e3, 0x68748390,
+      0xbd1f5bc1, 0x7cd06422, 0xc9e7b797, 0xfbc08769}},
+    {{0xbc60055b, 0x72bcd8b7, 0x56e27e4b, 0x03cc23ee,
+      0xe4819370, 0xee337424, 0x0ad3da09, 0xe2aa0e43},
+     {0x6383c45d, 0x40b8524f, 0x42a41b25, 0xd7663554,
+      0x778a4797, 0x64efa6de, 0x7079adf4, 0x2042170a}},
+  },
+  {
+    {{0x696946fc, 0x486d8ffa, 0xb9cba56d, 0x50fbc6d8,
+      0x90f35a15, 0x7e3d423e, 0xc0dd962c, 0x7c3da195},
+     {0x3cfd5d8b, 0xe673fdb0, 0x889dfca5, 0x0704b7c2,
+      0xf52305aa, 0xf6ce581f, 0x914d5e53, 0x399d49eb}},
+    {{0xed4c3717, 0x35d6a53e, 0x3d0ed2a3, 0x9f8240cf,
+      0xe5543aa5, 0x8c0d4d05, 0xdd33b4b4, 0x45d5bbfb},
+     {0x137fd28e, 0xfa04cc73, 0xc73b3ffd, 0x862ac6ef,
+      0x31f51ef2, 0x403ff9f5, 0xbc73f5a2, 0x34d5e0fc}},
+    {{0x08369a90, 0x33b2385c, 0x190eb4f8, 0x2990c59b,
+      0xc68eac80, 0x819a6145, 0x2ec4a014, 0x7a786d62},
+     {0x20ac3a8d, 0x33faadbe, 0x5aba2d30, 0x31a21781,
+      0xdba4f565, 0x209d2742, 0x55aa0fbb, 0xdb2ce9e3}},
+    {{0x74a86108, 0x0c4a58d4, 0xee4c5d90, 0xf8048a8f,
+      0xe86d4c80, 0xe3c7c924, 0x056a1e60, 0x28c889de},
+     {0xb214a040, 0x57e2662e, 0x37e10347, 0xe8c48e98,
+      0x80ac748a, 0x87742862, 0x186b06f2, 0xf1c24022}},
+    {{0xd5923359, 0xe8cbf1e5, 0x539b9fb0, 0xdb0cea9d,
+      0x49859b98, 0x0c5b34cf, 0xa4403cc6, 0x5e583c56},
+     {0xd48185b7, 0x11fc1a2d, 0x6e521787, 0xc93fbc7e,
+      0x05105b8b, 0x47e7a058, 0xdb8260c8, 0x7b4d4d58}},
+    {{0x39842194, 0xc5106109, 0x49d05295, 0xb7e2353e,
+      0xefb42ee0, 0xfc8c1d5c, 0x08ce811c, 0xe04884eb},
+     {0x7419f40e, 0xf1f75d81, 0xa995c241, 0x5b0ac162,
+      0xc4c55646, 0x120921bb, 0x8d33cf97, 0x713520c2}},
+    {{0x1726931a, 0x41d04ee2, 0x3660ecfd, 0x0bbbb2c8,
+      0x24818e18, 0xa6ef6de5, 0xe7d57887, 0xe421cc51},
+     {0xbea87be6, 0xf127d208, 0xb1cdd682, 0x16a475d3,
+      0x439b63f7, 0x9db1b684, 0xf0f113b6, 0x5359b3db}},
+    {{0xdcc18770, 0x3a5c752e, 0x8825c3a5, 0x4baf1f2f,
+      0x21b153ed, 0xebd63f74, 0xb2f64723, 0xa2383e47},
+     {0x2646d19a, 0xe7bf620a, 0x03c83ffd, 0x56cb44ec,
+      0x4f6be9f1, 0xaf7267c9, 0xc06bb5e9, 0x8b2dfd7b}},
+  },
+  {
+    {{0xe3779ee3, 0x0f0165fc, 0xbd495d9e, 0xe00e7f9d,
+      0x20284e7a, 0x1fa4efa2, 0x47ac6219, 0x4564bade},
+     {0xc4708e8e, 0x90e6312a, 0xa71e9adf, 0x4f5725fb,
+      0x3d684b9f, 0xe95f55ae, 0x1e94b415, 0x47f7ccb1}},
+    {{0xbe7a2af3, 0xbd9b8b1d, 0x4fb74a72, 0xec51caa9,
+      0x63879697, 0xb9937a4b, 0xec2687d5, 0x7c9a9d20},
+     {0x6ef5f014, 0x1773e44f, 0xe90c6900, 0x8abcf412,
+      0x8142161e, 0x387bd022, 0xfcb6ff2a, 0x50393755}},
+    {{0x59145a65, 0x3d613339, 0xfa406337, 0xcd9bc368,
+      0x2d8a52a0, 0x82d11be3, 0x97a1c590, 0xf6877b27},
+     {0xf5cbdb25, 0x837a819b, 0xde090249, 0x2a4fd1d8,
+      0x74990e5f, 0x622a7de7, 0x7945511b, 0x840fa5a0}},
+    {{0xe3533d77, 0x26e08c07, 0x2e341c99, 0xd7222e6a,
+      0x8d2dc4ed, 0x9d60ec3d, 0x7c476cf8, 0xbdfe0d8f},
+     {0x1d056605, 0x1fe59ab6, 0x86a8551f, 0xa9ea9df6,
+      0x47fb8d8c, 0x8489941e, 0x4a7f1b10, 0xfeb874eb}},
+    {{0x977eab40, 0x9164088d, 0x2760b390, 0x51f4c5b6,
+      0x340dd553, 0xd238238f, 0xdb1d31c9, 0x358566c3},
+     {0x5068f5ff, 0x3a5ad69e, 0xdaff6b06, 0xf31435fc,
+      0xd6debff0, 0xae549a5b, 0x75e01331, 0x59e5f0b7}},
+    {{0x5958cd79, 0xd5d5cdd3, 0x1d373114, 0x3580a1b5,
+      0xfa935726, 0xa36e4c91, 0xef20d760, 0xa38c534d},
+     {0x2ff5845b, 0x7088e40a, 0xbd78177f, 0xe5bb40bd,
+      0x857f9920, 0x4f06a7a8, 0xe968f05d, 0xe3cc3e50}},
+    {{0x96a71cba, 0x10595b56, 0xfdcadeb7, 0x944938b2,
+      0xfccd8471, 0xa282da4c, 0x0d37bfe1, 0x98ec05f3},
+     {0x0698304a, 0xe171ce1b, 0x21bdf79b, 0x2d691444,
+      0x1b21dec1, 0xd0cd3b74, 0x16a15f71, 0x712ecd8b}},
+    {{0x5963a46e, 0xe89f48c8, 0xa99e61c7, 0x658ab875,
+      0x4b8517b4, 0x6e296f87, 0xfc1bc656, 0x36c4fcdc},
+     {0xa3906def, 0xde5227a1, 0x62418945, 0x9fe95f57,
+      0xfdd96cde, 0x20c91e81, 0xda4480de, 0x5adbe47e}},
+  },
+  {
+    {{0x868af75d, 0xd9d0c8c4, 0x45c8c7ea, 0xd7325cff,
+      0xcc81ecb0, 0xab471996, 0x611824ed, 0xff5d55f3},
+     {0x1977a0ee, 0xbe314541, 0x722038c6, 0x5085c4c5,
+      0xf94bb495, 0x2d5335bf, 0xc8e2a082, 0x894ad8a6}},
+    {{0x1994ef20, 0xd1e059b2, 0x638ae318, 0x2a653b69,
+      0x2f699010, 0x70d5eb58, 0x09f5f84a, 0x279739f7},
+     {0x8b799336, 0x5da4663c, 0x203c37eb, 0xfdfdf14d,
+      0xa1dbfb2d, 0x32d8a9dc, 0x77d48f9b, 0xab40cff0}},
+    {{0xfbaf50a5, 0xf61790ab, 0x684e0750, 0xdf55e76b,
+      0xf176b005, 0xec516da7, 0x7a2dddc7, 0x575553bb},
+     {0x553afa73, 0x37c87ca3, 0x4d55c251, 0x315f3ffc,
+      0xaf3e5d35, 0xe846442a, 0x6495ff28, 0x61b91149}},
+    {{0x56f90823, 0x4bdf3a49, 0x741d777b, 0xba0f5080,
+      0xf38bf760, 0x091d71c3, 0x9b625b02, 0x9633d50f},
+     {0xb8c9de61, 0x03ecb743, 0x5de74720, 0xb4751254,
+      0x74ce1cb2, 0x9f9defc9, 0x00bd32ef, 0x774a4f6a}},
+    {{0xb0131e5b, 0x327bc002, 0xcb2514d9, 0x1739e6d5,
+      0x55a81543, 0xc8cbdafe, 0xe1137243, 0x5bb1a36c},
+     {0x17325327, 0x205da3c5, 0x515a057e, 0xc35c1a36,
+      0x42925f9b, 0xf00f64c9, 0xb7d59f7a, 0xbd14633c}},
+    {{0x41f37dbd, 0x47c10043, 0x6168ecf6, 0x96eccae3,
+      0x1ca46aa3, 0x65bde59d, 0xb8698ffa, 0x38a7027a},
+     {0x6dc34437, 0xa2b89dc8, 0x43a4153f, 0x5a0a118d,
+      0x1ce22fd8, 0x9e330a86, 0xb3bbd3bc, 0x28382af6}},
+    {{0xd81e0271, 0x0b2e27c0, 0x117a317c, 0xa67a7596,
+      0xa6723d99, 0x17f08928, 0x485310a3, 0x71a75681},
+     {0xafb66ca9, 0x90465462, 0xfbbe229d, 0x185e97cc,
+      0xddad8fc2, 0x6a1a606a, 0xb3c797cf, 0x2431f316}},
+    {{0x93529432, 0x47034011, 0x30743462, 0x1f106bdd,
+      0xcd66d8ca, 0xabfb9964, 0xe9bdadd5, 0x934d9d5a},
+     {0x908e3d22, 0x5976d815, 0x28e057bd, 0x344a362f,
+      0x5443dfb3, 0xf92cdadc, 0xf089603b, 0x001297ad}},
+  },
+  {
+    {{0x4147519a, 0x20288602, 0x26b372f0, 0xd0981eac,
+      0xa785ebc8, 0xa9d4a7ca, 0xdbdf58e9, 0xd953c50d},
+     {0xfd590f8f, 0x9d6361cc, 0x44e6c917, 0x72e9626b,
+      0x22eb64cf, 0x7fd96110, 0x9eb288f3, 0x863ebb7e}},
+    {{0xe90fb21e, 0xa18f07e0, 0xbba7fca1, 0x00fd2b80,
+      0x95cd67b5, 0x20387f27, 0xd39707f7, 0x5b89a4e7},
+     {0x894407ce, 0x8f83ad3f, 0x6c226132, 0xa0025b94,
+      0xf906c13b, 0xc79563c7, 0x4e7bb025, 0x5f548f31}},
+    {{0x31b85f09, 0xc1b3d3d3, 0xa88ae64a, 0x0f45354a,
+      0x2fec50fd, 0xa8b626d3, 0xe828834f, 0x1bdcfbd4},
+     {0xcd522539, 0xe45a2866, 0x810f7ab3, 0xfa9d4732,
+      0xc905f293, 0xd8c1d6b4, 0x3461b597, 0x10ac8047}},
+    {{0x6fc627e2, 0xbbb17514, 0x91573a51, 0xa0569bc5,
+      0x358243d5, 0xa7016d9e, 0xac1d6692, 0x0dac0c56},
+     {0xda590d5f, 0x993833b5, 0xde817491, 0xa8067803,
+      0x4dbf75d0, 0x65b4f212, 0xccf80cfb, 0xcc960232}},
+    {{0x6cf3d65b, 0x35d74280, 0x78b28dd9, 0x4b7c7906,
+      0x95e1f85f, 0xc4fcdd2f, 0x591350b6, 0xcf6fb7ba},
+     {0xedfc26af, 0x9f8e3287, 0xc2d0ed9a, 0xe2dd9e73,
+      0x24cbb703, 0xeab5d67f, 0x9a759a5a, 0x60c29399}},
+    {{0x7ca53d5f, 0xfb93ca3d, 0x04379cbf, 0x432649f0,
+      0xcba2ff75, 0xf506113a, 0x03718b35, 0x4594ae21},
+     {0x0d044627, 0x1aa6cee5, 0xf5c94aa2, 0xc0e0d2b7,
+      0xee4dd3f5, 0x0bf33d3d, 0x8477c97a, 0xaca96e28}},
+    {{0x6861a713, 0x995c068e, 0x63de88dc, 0xa9ba3394,
+      0x689a964f, 0xab954344, 0x0f5a0d6c, 0x58195aec},
+     {0xc98f8b50, 0xc5f207d5, 0x0c98ccf6, 0x6600cd28,
+      0x39c3e6c2, 0x1a680fe3, 0x660e87c0, 0xa23f3931}},
+    {{0xc78440a1, 0x43bc1b42, 0x32ac6c3f, 0x9a07e226,
+      0x0f4bcd15, 0xaf3d7ba1, 0xa36814c6, 0x3ad43c9d},
+     {0xa0c9c162, 0xca11f742, 0xc90b96ec, 0xd3e06fc6,
+      0x6bf2d03f, 0xeace6e76, 0xf8032795, 0x8bcd98e8}},
+  },
+  {
+    {{0x533ef217, 0x889f6d65, 0xc3ca2e87, 0x7158c7e4,
+      0xdc2b4167, 0xfb670dfb, 0x844c257f, 0x75910a01},
+     {0xcf88577d, 0xf336bf07, 0xe45e2ace, 0x22245250,
+      0x7ca23d85, 0x2ed92e8d, 0x2b812f58, 0x29f8be4c}},
+    {{0x51facc61, 0xc51e4143, 0xe68a25bc, 0xbaf2647d,
+      0x0ff872ed, 0x8f5271a0, 0x3d2d9659, 0x8f32ef99},
+     {0x7593cbd4, 0xca12488c, 0x02b82fab, 0xed266c5d,
+      0x14eb3f16, 0x0a2f78ad, 0x4d47afe3, 0xc3404948}},
+    {{0x09470496, 0x09c16702, 0xebd23815, 0xa489a5ed,
+      0x8edd4398, 0xc4dde464, 0x80111696, 0x3ca7b94a},
+     {0x2ad636a4, 0x3c385d68, 0x08dc5f1e, 0x67027025,
+      0xafa21943, 0x0c1965de, 0x610be69e, 0x18666e16}},
+    {{0x2a604b3b, 0x45beb4ca, 0x3a616762, 0x56f65184,
+      0x978b806e, 0xf52f5a70, 0x11dc4480, 0x7aa39787},
+     {0x0e01fabc, 0xe13fac2a, 0x237d99f9, 0x7c6ee8a5,
+      0x05211ffe, 0x251384ee, 0x1bc9d3eb, 0x4ff6976d}},
+    {{0x16e043a2, 0xdde04923, 0x1dd3d209, 0x98a45261,
+      0xd431ebe8, 0xeaf9f61b, 0xbaf56abd, 0x00919f4d},
+     {0x6d8774b1, 0xe42417db, 0x58e0e309, 0x5fc5279c,
+      0x3adf81ea, 0x64aa4061, 0xbc627c7f, 0xef419eda}},
+    {{0x7a4af00f, 0xfa24d053, 0xca294614, 0x3f938926,
+      0x3982182e, 0x0d700c18, 0x4cc59947, 0x80133443},
+     {0xec87c925, 0xf0397106, 0x0ed6665c, 0x62bd59fc,
+      0xc7cca8b5, 0xe8414348, 0x9f9f0a30, 0x574c7620}},
+    {{0xbb8b6a07, 0x95be42e2, 0xca23f86a, 0x64be74ee,
+      0x154ce470, 0xa73d74fd, 0xd8dc076a, 0x1c2d2857},
+     {0x5a887868, 0xb1fa1c57, 0x3de64818, 0x38df8e0b,
+      0xc34e8967, 0xd88e52f9, 0x8b4cc76c, 0x274b4f01}},
+    {{0xf8b7559d, 0x3f5c05b4, 0xfae29200, 0x0be4c7ac,
+      0x56532acc, 0xdd6d3ef7, 0xeea7a285, 0xf6c3ed87},
+     {0xf46ec59b, 0xe463b0a8, 0xecea6c83, 0x531d9b14,
+      0xc2dc836b, 0x3d6bdbaf, 0x2ab27f0b, 0x3ee501e9}},
+  },
+  {
+    {{0x0a750c0f, 0xcc7a6488, 0x4e548e83, 0x39bacfe3,
+      0x0c110f05, 0x3d418c76, 0xb1f11588, 0x3e4daa4c},
+     {0x5ffc69ff, 0x2733e7b5, 0x92053127, 0x46f147bc,
+      0xd722df94, 0x885b2434, 0xe6fc6b7c, 0x6a444f65}},
+    {{0xbdaedfbd, 0x6d0b16f4, 0x86746ced, 0x23fd3260,
+      0xff4b3e17, 0x8bfb1d2f, 0x019c14c8, 0xc7f2ec2d},
+     {0x45104b0d, 0x3e0832f2, 0xadea2b7e, 0x5f00dafb,
+      0x99fbfb0f, 0x29e5cf66, 0x61827cda, 0x264f9723}},
+    {{0xe30bc27f, 0x6eb1a2f3, 0xb0836511, 0xe5f0c05a,
+      0x4965ab0e, 0x4d741bbf, 0x83464bbd, 0xfeec41ca},
+     {0x99d0b09f, 0x1aca705f, 0xf42da5fa, 0xc5d6cc56,
+      0xcc52b931, 0x49964edd, 0xc884d8d8, 0x8ae59615}},
+    {{0x39f8868a, 0xf634b57b, 0x75cc69af, 0xe27f4fd4,
+      0xd0d5496e, 0xa47e58cb, 0xd323e07f, 0x8a26793f},
+     {0xfa30f349, 0xc61a9b72, 0xb696d134, 0x94c9d9c9,
+      0x5880a6d1, 0x792beca8, 0xaf039995, 0xbdcc4645}},
+    {{0x8c796c3c, 0xce7ef8e5, 0xdd66e57a, 0x9adaae84,
+      0x45227f33, 0x784ae13e, 0x2a85e757, 0xb046c5b8},
+     {0xec37631f, 0xb7aa50ae, 0x3b300758, 0xbedc4fca,
+      0x0ac9700b, 0x0f82567e, 0x4ff5f8d2, 0x1071d9d4}},
+    {{0xe51a2811, 0xd09ef6c4, 0xb8fb66b9, 0x39f6862b,
+      0x22dfaa99, 0x64e77f8d, 0x61b08aac, 0x7b105044},
+     {0x4a7df332, 0x71704e4c, 0x2ffe015b, 0xd0973434,
+      0x08d3020e, 0xab0eaf44, 0xed63b97a, 0x28b1909e}},
+    {{0xcdadcd4f, 0x2f3fa882, 0x5f631995, 0xa4ef6859,
+      0xe531766f, 0xe52ca2f9, 0x57e2c1d3, 0x20af5c30},
+     {0xe51e94b8, 0x1e4828f6, 0x1a2f5d4f, 0xf900a175,
+      0x392c58a0, 0xe831adb3, 0x1b6e5866, 0x4c5a90ca}},
+    {{0x6182827c, 0x5f3dcba8, 0xbd7e7252, 0xd1a448dd,
+      0xf493b815, 0x2d8f96fc, 0x3b0aa95f, 0xba0a4c26},
+     {0x63a0007f, 0x88a15140, 0x6a9c5846, 0x9564c25e,
+      0xdc0fcbca, 0x5a4d7b0f, 0x3f8a740e, 0x2275daa3}},
+  },
+  {
+    {{0x991724f3, 0xc7913e91, 0x39cbd686, 0x5eda799c,
+      0x63d4fc1e, 0xddb595c7, 0xac4fed54, 0x6b63b80b},
+     {0x7e5fb516, 0x6ea0fc69, 0xd0f1c964, 0x737708ba,
+      0x11a92ca5, 0x9628745f, 0x9a86967a, 0x61f37958}},
+    {{0x0d738ded, 0x46a8c418, 0xe0de5729, 0x6f1a5bb0,
+      0x8ba81675, 0xf10230b9, 0x112b33d4, 0x32c6f30c},
+     {0xd8fffb62, 0x7559129d, 0xb459bf05, 0x6a281b47,
+      0xfa3b6776, 0x77c1bd3a, 0x7829973a, 0x0709b380}},
+    {{0x877a21ec, 0x0b825852, 0x0f537a94, 0x300414a7,
+      0x21a9a6a2, 0x3f1cba40, 0x76943c00, 0x50824eee},
+     {0xf83cba5d, 0xa0dbfcec, 0x93b4f3c0, 0xf9538148,
+      0x48f24dd7, 0x61744162, 0xe4fb09dd, 0x5322d64d}},
+    {{0xf1f0ced1, 0xa337c447, 0x9492dd2b, 0x800cc793,
+      0xbea08efa, 0x4b93151d, 0xde0a741e, 0x820cf3f8},
+     {0x1c0f7d13, 0xff1982dc, 0x84dde6ca, 0xef921960,
+      0x45f96ee3, 0x1ad7d972, 0x29dea0c7, 0x319c8dbe}},
+    {{0x0eb919b0, 0x0ae1d63b, 0xa74b9620, 0xd74ee51d,
+      0xa674290c, 0x395458d0, 0x4620a510, 0x324c930f},
+     {0xfbac27d4, 0x2d1f4d19, 0x9bedeeac, 0x4086e8ca,
+      0x9b679ab8, 0x0cdd211b, 0x7090fec4, 0x5970167d}},
+    {{0x6224408a, 0xb7ff1ba1, 0x247cfc5e, 0xcc856e92,
+      0xc18bc493, 0x01f102e7, 0x2091c727, 0x4613ab74},
+     {0xc420bf2b, 0xaa25e89c, 0x90337ec2, 0x00a53176,
+      0x7d025fc7, 0xd2be9f43, 0x6e6fe3dc, 0x3316fb85}},
+    {{0x2064cfd1, 0x67332cfc, 0xb0651934, 0x339c31de,
+      0x2a3bcbea, 0x719b28d5, 0x9d6ae5c6, 0xee74c82b},
+     {0xbaf28ee6, 0x0927d05e, 0x9d719028, 0x82cecf2c,
+      0xddb30289, 0x0b0d353e, 0xfddb2e29, 0xfe4bb977}},
+    {{0x17a91cae, 0xe10b2ab8, 0x08e27f63, 0xb89aab65,
+      0xdba3ddf9, 0x7b3074a7, 0x330c2972, 0x1c20ce09},
+     {0x5fcf7e33, 0x6b9917b4, 0x945ceb42, 0xe6793743,
+      0x5c633d19, 0x18fc2215, 0xc7485474, 0xad1adb3c}},
+  },
+  {
+    {{0x16a0d2bb, 0x4f922fc5, 0x1a623499, 0x0d5cc16c,
+      0x57c62c8b, 0x9241cf3a, 0xfd1b667f, 0x2f5e6961},
+     {0xf5a01797, 0x5c15c70b, 0x60956192, 0x3d20b44d,
+      0x071fdb52, 0x04911b37, 0x8d6f0f7b, 0xf648f916}},
+    {{0xb5def996, 0x4090914b, 0x233dd1e7, 0x1cb69c83,
+      0x9b3d5e76, 0xc1e9c1d3, 0xfccf6012, 0x1f3338ed},
+     {0x2f5378a8, 0xb1e95d0d, 0x2f00cd21, 0xacf4c2c7,
+      0xeb5fe290, 0x6e984240, 0x248088ae, 0xd66c038d}},
+    {{0x614c0900, 0xd4992b30, 0xbd00c24b, 0xda98d121,
+      0x7ec4bfa1, 0x7f534dc8, 0x37dc34bc, 0x4a5ff674},
+     {0x1d7ea1d7, 0x68c196b8, 0x80a6d208, 0x38cf2893,
+      0xe3cbbd6e, 0xfd56cd09, 0x4205a5b6, 0xec72e27e}},
+    {{0xb88756dd, 0xe8b97932, 0xf17e3e61, 0xed4e8652,
+      0x3ee1c4a4, 0xc2dd1499, 0x597f8c0e, 0xc0aaee17},
+     {0x6c168af3, 0x15c4edb9, 0xb39ae875, 0x6563c7bf,
+      0x20adb436, 0xadfadb6f, 0x9a042ac0, 0xad55e8c9}},
+    {{0x909523c8, 0x65c29219, 0xa3a1c741, 0xa62f648f,
+      0x60c9e55a, 0x88598d4f, 0x0e4f347a, 0xbce9141b},
+     {0x35f9b988, 0x9af97d84, 0x320475b6, 0x0210da62,
+      0x9191476c, 0x3c076e22, 0x44fc7834, 0x7520dbd9}},
+    {{0x7850ec06, 0x664300b0, 0x7d3a10cf, 0xac5a38b9,
+      0xe34ab39d, 0x9233188d, 0x5072cbb9, 0xe77057e4},
+     {0xb59e78df, 0xbcf0c042, 0x1d97de52, 0x4cfc91e8,
+      0x3ee0ca4a, 0x4661a26c, 0xfb8507bc, 0x5620a4c1}},
+    {{0x04b6c5a0, 0x84b9ca15, 0x18f0e3a3, 0x35216f39,
+      0xbd986c00, 0x3ec2d2bc, 0xd19228fe, 0x8bf546d9},
+     {0x4cd623c3, 0xd1c655a4, 0x502b8e5a, 0x366ce718,
+      0xeea0bfe7, 0x2cfc84b4, 0xcf443e8e, 0xe01d5cee}},
+    {{0xbe063f64, 0xa75feaca, 0xbce47a09, 0x9b392f43,
+      0x1ad07aca, 0xd4241509, 0x8d26cd0f, 0x4b0c591b},
+     {0x92f1169a, 0x2d42ddfd, 0x4cbf2392, 0x63aeb1ac,
+      0x0691a2af, 0x1de9e877, 0xd98021da, 0xebe79af7}},
+  },
+  {
+    {{0xd005832a, 0x0db2fb5e, 0x91042e4f, 0x5f5efd3b,
+      0xed70f8ca, 0x8c4ffdc6, 0xb52da9cc, 0xe4645d0b},
+     {0xc9001d1f, 0x9596f58b, 0x4e117205, 0x52c8f0bc,
+      0xe398a084, 0xfd4aa0d2, 0x104f49de, 0x815bfe3a}},
+    {{0xd7ab9a2d, 0x524d226a, 0x7dfae958, 0x9c00090d,
+      0x8751d8c2, 0x0ba5f539, 0x3ab8262d, 0x8afcbcdd},
+     {0xe99d043b, 0x57392729, 0xaebc943a, 0xef51263b,
+      0x20862935, 0x9feace93, 0xb06c817b, 0x639efc03}},
+    {{0xc3b81990, 0xdec98d4a, 0x9e0cc8fe, 0x1cb83722,
+      0xd2b427b9, 0xfe0b0491, 0xe983a66c, 0x0f2386ac},
+     {0xb3291213, 0x930c4d1e, 0x59a62ae4, 0xa2f82b2e,
+      0xf93e89e3, 0x77233853, 0x11777c7f, 0x7f8063ac}},
+    {{0x02ff6072, 0x36e607cf, 0x8ad98cdc, 0xa47d2ca9,
+      0xf5f56609, 0xbf471d1e, 0xf264ada0, 0xbcf86623},
+     {0xaa9e5cb6, 0xb70c0687, 0x17401c6c, 0xc98124f2,
+      0xd4a61435, 0x8189635f, 0xa9d98ea6, 0xd28fb8af}},
+    {{0x017025f3, 0x3d4da8c3, 0xfb9579b4, 0xefcf628c,
+      0x1f3716ec, 0x5c4d0016, 0x6801116e, 0x9c27ebc4},
+     {0x1da1767e, 0x5eba0ea1, 0x47004c57, 0xfe151452,
+      0x8c2373b7, 0x3ace6df6, 0x5dbc37ac, 0x75c3dffe}},
+    {{0x80101b98, 0xb57276d9, 0xb82f0f66, 0x760883fd,
+      0x4bc3eff3, 0x89d7de75, 0x5dc2ab40, 0x03b60643},
+     {0xe05beeac, 0xcd6e53df, 0xbc3325cd, 0xf2f1e862,
+      0x774f03c3, 0xdd0f7921, 0x4552cc1b, 0x97ca7221}},
+    {{0xe224c5d7, 0x760cb3b5, 0x68616919, 0xfa3baf8c,
+      0x8d142552, 0x9fbca113, 0x7669ebf5, 0x1ab18bf1},
+     {0x9bdf25dd, 0x55e6f53e, 0xcb6cd154, 0x04cc0bf3,
+      0x95e89080, 0x595bef49, 0x104a9ac1, 0xfe9459a8}},
+    {{0xabb020e8, 0x694b64c5, 0x19c4eec7, 0x3d18c184,
+      0x1c4793e5, 0x9c4673ef, 0x056092e6, 0xc7b8aeb5},
+     {0xf0f8c16b, 0x3aa1ca43, 0xd679b2f6, 0x224ed5ec,
+      0x55a205c9, 0x0d56eeaf, 0x4b8e028b, 0xbfe115ba}},
+  },
+  {
+    {{0xf1c367ca, 0xe4050f1c, 0xc90fbc7d, 0x9bc85a9b,
+      0xe1a11032, 0xa373c4a2, 0xad0393a9, 0xb64232b7},
+     {0x167dad29, 0xf5577eb0, 0x94b78ab2, 0x1604f301,
+      0xe829348b, 0x0baa94af, 0x41654342, 0x77fbd8dd}},
+    {{0x68af43ee, 0xa2f7932c, 0x703d00bd, 0x5502468e,
+      0x2fb061f5, 0xe5dc978f, 0x28c815ad, 0xc9a1904a},
+     {0x470c56a4, 0xd3af538d, 0x193d8ced, 0x159abc5f,
+      0x20108ef3, 0x2a37245f, 0x223f7178, 0xfa17081e}},
+    {{0x8e2f7d90, 0x5c18acf8, 0x77be32cd, 0xfdbf33d7,
+      0xd2eb5ee9, 0x0a085cd7, 0xb3201115, 0x2d702cfb},
+     {0x85c88ce8, 0xb6e0ebdb, 0x1e01d617, 0x23a3ce3c,
+      0x567333ac, 0x3041618e, 0x157edb6b, 0x9dd0fd8f}},
+    {{0x6fa6110c, 0x516ff3a3, 0xfb93561f, 0x74fb1eb1,
+      0x8457522b, 0x6c0c9047, 0x6bb8bdc6, 0xcfd32104},
+     {0xcc80ad57, 0x2d6884a2, 0x86a9b637, 0x7c27fc35,
+      0xadf4e8cd, 0x3461baed, 0x617242f0, 0x1d56251a}},
+    {{0x21175ec1, 0x892c81a3, 0xee018109, 0x9159a505,
+      0x2d8be316, 0xc7013053, 0x426fa2e5, 0x76060c21},
+     {0x6b6f0f22, 0x074d2dfc, 0xca01a671, 0x9725fc64,
+      0x2770bd8e, 0x3f6679b9, 0xd7c9b3fe, 0x8fe6604f}},
+    {{0x73204349, 0x71d530cc, 0x94a0679c, 0xc9df473d,
+      0x4261e031, 0xc572f001, 0x22f135fe, 0x9786b71f},
+     {0x6b64e56f, 0xed6505fa, 0x05219c46, 0xe2fb48e9,
+      0xedf53d71, 0x0dbec45b, 0xc589f406, 0xd7d782f2}},
+    {{0x446cd7f4, 0x06513c8a, 0x906d52a6, 0x158c423b,
+      0xc423866c, 0x71503261, 0x93c148ee, 0x4b96f570},
+     {0x239a8523, 0x5daf9cc7, 0x95ac4b8b, 0x611b5976,
+      0x724bf7f6, 0xde3981db, 0x67afc443, 0x7e7d0f78}},
+    {{0x8ce59954, 0x3d1ab80c, 0x78222ac0, 0x742c5a94,
+      0x94f878dd, 0x3ddacbf8, 0xe7d54a99, 0xfc085117},
+     {0x21e38ec2, 0xfb0f1dfa, 0x16f4ff7f, 0x1c7b59cb,
+      0x7ea888fe, 0x98875239, 0xb10dc889, 0x705d270c}},
+  },
+  {
+    {{0xf79588c0, 0xa80d1db6, 0xb55768cc, 0xfa52fc69,
+      0x7f54438a, 0x0b4df1ae, 0xf9b46a4f, 0x0cadd1a7},
+     {0x1803dd6f, 0xb40ea6b3, 0x55eaae35, 0x488e4fa5,
+      0x382e4e16, 0x9f047d55, 0x2f6e0c98, 0xc9b5b7e0}},
+    {{0x83a7337b, 0x4b7d0e06, 0xffecf249, 0x1e3416d4,
+      0x66a2b71f, 0x24840eff, 0xb37cc26d, 0xd0d9a50a},
+     {0x6fe28ef7, 0xe2198150, 0x23324c7f, 0x3cc5ef16,
+      0x769b5263, 0x220f3455, 0xa10bf475, 0xe2ade2f1}},
+    {{0xdacddb7d, 0x03b6c8c7, 0x7e1edcad, 0x92ed5004,
+      0x54080633, 0xa0e46c2f, 0x46dec1ce, 0xcd37663d},
+     {0xf365b7cc, 0x396984c5, 0xe79bb95d, 0x294e3a2a,
+      0x27b1d3c1, 0x9aa17d77, 0xe49440f5, 0x3ffd3cfa}},
+    {{0x399f9cf3, 0x26679d11, 0x1e3c4394, 0x78e7a48e,
+      0x0d98daf1, 0x08722dea, 0x80030ea3, 0x37e7ed58},
+     {0x3c8aae72, 0xf3731ad4, 0xac729695, 0x7878be95,
+      0xbbc28352, 0x6a643aff, 0x78759b61, 0xef8b801b}},
+    {{0xb63afe75, 0xdcdd3709, 0x3f1af8ff, 0xad9d7f0b,
+      0x194f4bee, 0xdd6a8045, 0x2f7d998c, 0x867724cc},
+     {0x837751be, 0xd51d0aa5, 0x959a0658, 0x21d6754a,
+      0x695f7e58, 0xd2212611, 0x297363ef, 0xec4b93c2}},
+    {{0xb9d1a70f, 0x8165ec11, 0x384f6cae, 0x01347efc,
+      0xab7aeca9, 0xe95c01a0, 0xc6c99530, 0x459ba1c5},
+     {0x5cf3416b, 0x38967a63, 0x1e5457e2, 0x5c3761fd,
+      0xf03e9df6, 0x43e6077a, 0x8bd1c7f6, 0xb15d3462}},
+    {{0x35a75c49, 0xad87d3db, 0x61af03c5, 0xc69d8009,
+      0x3a6a6c4c, 0x31aef61a, 0xaa10a993, 0xb3292640},
+     {0xaaee340f, 0x959aae80, 0x7f381a3b, 0xf900528e,
+      0x853691a3, 0x44ecf76e, 0xe749e68e, 0xa081663c}},
+    {{0x6283e34a, 0x4f278213, 0xfbfa315f, 0x6f9fcf60,
+      0x9b701364, 0x224a2ab9, 0xf9fecadc, 0xb4b1b418},
+     {0x50ba1b9a, 0xbf7280fe, 0x33f36db9, 0x7e68259c,
+      0x154c9fb0, 0x8ccb754e, 0xdb2328f1, 0xf281adb1}},
+  },
+  {
+    {{0xb0e63d34, 0x4fe7ee31, 0xa9e54fab, 0xf4600572,
+      0xd5e7b5a4, 0xc0493334, 0x06d54831, 0x8589fb92},
+     {0x6583553a, 0xaa70f5cc, 0xe25649e5, 0x0879094a,
+      0x10044652, 0xcc904507, 0x02541c4f, 0xebb0696d}},
+    {{0x99375235, 0xb99f0e03, 0xb9917970, 0x7614c847,
+      0x524ec067, 0xfec93ce9, 0x9b122520, 0xe40e7bf8},
+     {0xee4c4774, 0xb5670631, 0x3b04914c, 0x6f03847a,
+      0xdc9dd226, 0xc96e9429, 0x8c57c1f8, 0x43489b6c}},
+    {{0xcc2338fb, 0x46ffd227, 0x90e26153, 0x89ff6fa9,
+      0x331a0076, 0xbe570779, 0x06e1f3af, 0x43d241c5},
+     {0xde9b62a3, 0xfdcdb97d, 0xa0ae30ea, 0x6a06e984,
+      0x4fbddf7d, 0xc9bf1680, 0xd36163c4, 0x170471a2}},
+    {{0x55950cc3, 0x361619e4, 0x56b66bb8, 0xc71d665c,
+      0xafac6d84, 0xea034b34, 0xe5e4c7e3, 0xa987f832},
+     {0x7a79a6a7, 0xa0742772, 0xe26d6c23, 0x56e5d017,
+      0x38167e10, 0x7e50b976, 0xe88aa84e, 0xaa6c81ef}},
+    {{0x4d325bbf, 0x473959d7, 0x8d6114b9, 0x2a61beec,
+      0x924be2ee, 0x25672a94, 0xf2c23d0c, 0xa48595db},
+     {0x6a221838, 0xe476848b, 0x35c1b673, 0xe743e69a,
+      0xd8468503, 0x2ab42499, 0xe9e90ba7, 0x62aa0054}},
+    {{0x73a904e0, 0xbdfb2717, 0x28888d73, 0x7ce1e40b,
+      0xeaa97d1b, 0x2e7e35f6, 0xa9afa097, 0xd061772a},
+     {0x7a1f7c59, 0x434ac7c4, 0xe79b7b9a, 0x6e21124a,
+      0xbb22ecc7, 0x055acff3, 0x84c858d3, 0x8bfd7ac9}},
+    {{0x9f1f68ad, 0x2fd57df5, 0xb06470c8, 0x5ddcc6db,
+      0xa9b47307, 0x801b6451, 0x76551bf4, 0x6b51c8e3},
+     {0xd44e1da9, 0xef0bd1f7, 0x4d4e600c, 0x714bcb1d,
+      0x0c6540c7, 0xc57bb9e4, 0x327cc644, 0x71bd1ec2}},
+    {{0x7f4dd81f, 0x9a52cf7e, 0x5e69c05e, 0xa0132be1,
+      0x2a0f4d72, 0x90dab747, 0x312d6706, 0xc142f911},
+     {0x8261998b, 0xe8d3631f, 0x615c1c94, 0xf0f42fae,
+      0xaec3fa5d, 0x2f4e948c, 0xa374101e, 0x242ae7a8}},
+  },
+  {
+    {{0xcf7d62d2, 0x20d3c982, 0x23ba8150, 0x1f36e29d,
+      0x92763f9e, 0x48ae0bf0, 0x1d3a7007, 0x7a527e6b},
+     {0x581a85e3, 0xb4a89097, 0xdc158be5, 0x1f1a520f,
+      0x167d726e, 0xf98db37d, 0x1113e862, 0x8802786e}},
+    {{0xf4c6b6ec, 0xf6e894d1, 0x18b3cd9b, 0x526b0827,
+      0x12117fbf, 0x73f952a8, 0x11945bf5, 0x2be864b0},
+     {0x42099b64, 0x86f18ea5, 0x07548ce2, 0x2770b28a,
+      0x295c1c9c, 0x97390f28, 0xcb5206c3, 0x672e6a43}},
+    {{0x47c64367, 0xcacce2c8, 0x45af4ec0, 0x6a496b9f,
+      0x6034042c, 0x2a0836f3, 0x0b6c62ea, 0x14a1f390},
+     {0x3ef1f540, 0xe7fa9363, 0x72a76d93, 0xd323b30a,
+      0x0feae451, 0xffeec8b5, 0xbd04ef87, 0x4eafc172}},
+    {{0xb3e59b89, 0xe4435a51, 0x4133a1c9, 0x13613955,
+      0x440bee59, 0x87f46973, 0x00c401e4, 0x714710f8},
+     {0xd6c446c9, 0xc0cf4bce, 0x6c4d5368, 0xe0aa7fd6,
+      0xfc68fc37, 0xde5d811a, 0xb7c2a057, 0x61febd72}},
+    {{0x65f837e2, 0x27375fe6, 0xd882179f, 0x93f8c68b,
+      0x59b16187, 0x584feadc, 0x483bc162, 0xe5b50be9},
+     {0xa2776625, 0x7ad9d6f1, 0x04ff457b, 0xe9d10080,
+      0x677618a6, 0x5b56d322, 0xe3e68673, 0x036694ea}},
+    {{0x1d8a4fd1, 0x6feaffc5, 0x5f1ad208, 0x59663b20,
+      0x24acb46a, 0xefc93cef, 0x5967118c, 0x54929de0},
+     {0x9acffb1c, 0x88570800, 0x145639ec, 0x492bbf2b,
+      0x38f0018e, 0x71f495a6, 0xc2792847, 0xe24365db}},
+    {{0xa6f29002, 0x4bedae86, 0xe034457a, 0x7abedb56,
+      0x179bff2a, 0x8bf3eec6, 0x390f4e6b, 0x9d626d57},
+     {0x14dd6ea3, 0x653fe0e9, 0x89bd6d08, 0x74837159,
+      0xebd9b03d, 0x85fb05b4, 0x4a768bbc, 0x7dc3f221}},
+    {{0x32b0ed8f, 0xaacc63f1, 0x2bafefd2, 0x04123724,
+      0x7e2d2a13, 0x0df9a798, 0x9c27591f, 0x09bd13cf},
+     {0x6e1afb50, 0xaa5f5e47, 0xb66eb646, 0xcd146a42,
+      0x1442ec3c, 0x3f07561d, 0x8ae8ec47, 0x7e547173}},
+  },
+  {
+    {{0xc360e25a, 0x8ce9b6bf, 0x075a1a78, 0xe6425195,
+      0x481732f4, 0x9dc756a8, 0x5432b57a, 0x83c0440f},
+     {0xd720281f, 0xc670b3f1, 0xd135e051, 0x2205910e,
+      0xdb052be7, 0xded14b0e, 0xc568ea39, 0x697b3d27}},
+    {{0x14092ebb, 0x0b89de93, 0x428e240c, 0xf17256bd,
+      0x93d2f064, 0xcf89a7f3, 0xe1ed3b14, 0x4f57841e},
+     {0xe708d855, 0x4ee14405, 0x03f1c3d0, 0x856aae72,
+      0xbdd7eed5, 0xc8e5424f, 0x73ab4270, 0x3333e4ef}},
+    {{0xa1f25897, 0xe75e7a88, 0xa1b5d4d8, 0x7ac6961f,
+      0x08f3ed5c, 0xe3e10773, 0x0a892dfb, 0x208a54ec},
+     {0x78660710, 0xbe826e19, 0x237df2c8, 0x0cf70a97,
+      0xed704da5, 0x418a7340, 0x08ca33fd, 0xa3eeb9a9}},
+    {{0x8434a920, 0xb4323d58, 0x622103c5, 0xc0af8e93,
+      0x938dbf9a, 0x667518ef, 0x83a9cdf2, 0xa1843073},
+     {0x5447ab80, 0x350a94aa, 0xc75a3d61, 0xe5e5a325,
+      0x68411a9e, 0x74ba507f, 0x594f70c5, 0x10581fc1}},
+    {{0xcb0c9c8c, 0x5aaa98a7, 0x81c4375c, 0x75105f30,
+      0x5ef1c90f, 0xceee5057, 0xc23a17bf, 0xb31e065f},
+     {0xd4b6d45a, 0x5364d275, 0x62ec8996, 0xd363f3ad,
+      0x4391c65b, 0xb5d21239, 0xebb41b47, 0x84564765}},
+    {{0xe75746b5, 0x33e95d07, 0xc40c78be, 0x1c1e1f6d,
+      0x222ff8e2, 0x967833ef, 0xb49180ad, 0x4bedcf6a},
+     {0x3d7a4c8a, 0x6b37e9c1, 0x6ddfe760, 0x2748887c,
+      0xaa3a5bbc, 0xf7055123, 0x7bbb8e74, 0x954ff225}},
+    {{0x6d3fea55, 0x4e23ca44, 0xf4810568, 0xb4ae9c86,
+      0x2a62f27d, 0x47bfb91b, 0xd9bac28c, 0x60deb4c9},
+     {0x7de6c34c, 0xa892d894, 0x4494587d, 0x4ee68259,
+      0x1a3f8a5b, 0x914ee14e, 0x28700385, 0xbb113eaa}},
+    {{0xa7b56eaf, 0xef9dc899, 0x34ef7316, 0x00c0e52c,
+      0xfe818a86, 0x5b1e4e24, 0xc538be47, 0x9d31e20d},
+     {0x3ed68974, 0x22eb932d, 0x7c4e87c4, 0xe44bbc08,
+      0x0dde9aef, 0x4121086e, 0x134f4345, 0x8e6b9cff}},
+  },
+  {
+    {{0xd111f8ec, 0x3e0e5c9d, 0xb7c4e760, 0xbcc33f8d,
+      0xbd392a51, 0x702f9a91, 0xc132e92d, 0x7da4a795},
+     {0x0bb1151b, 0x1a0b0ae3, 0x02e32251, 0x54febac8,
+      0x694e9e78, 0xea3a5082, 0xe4fe40b8, 0xe58ffec1}},
+    {{0x516e19e4, 0x7b23c513, 0xc5c4d593, 0x56e2e847,
+      0x5ce71ef6, 0x9f727d73, 0xf79a44c5, 0x5b6304a6},
+     {0x3ab7e433, 0x6638a736, 0xfe742f83, 0x1adea470,
+      0x5b7fc19f, 0xe054b854, 0xba1d0698, 0xf935381a}},
+    {{0x5846426f, 0x55366b7d, 0x247d441d, 0xe7d09e89,
+      0x736fbf48, 0x510b404d, 0xe784bd7d, 0x7fa003d0},
+     {0x17fd9596, 0x25f7614f, 0x35cb98db, 0x49e0e0a1,
+      0x2e83a76a, 0x2c65957b, 0xcddbe0f8, 0x5d40da8d}},
+    {{0x54530bb2, 0x9fb3bba3, 0xcb0869ea, 0xbde3ef77,
+      0x0b431163, 0x89bc9046, 0xe4819a35, 0x4d03d7d2},
+     {0x43b6a782, 0x33ae4f9e, 0x9c88a686, 0x216db307,
+      0x00ffedd9, 0x91dd88e0, 0x12bd4840, 0xb280da9f}},
+    {{0xf37f5937, 0xa37f3573, 0xd1e4fca5, 0xeb0f6c7d,
+      0xac8ab0fc, 0x2965a554, 0x274676ac, 0x17fbf56c},
+     {0xacf7d720, 0x2e2f6bd9, 0x10224766, 0x41fc8f88,
+      0x85d53bef, 0x517a14b3, 0x7d76a7d1, 0xdae327a5}},
+    {{0x94d7d9b1, 0x43c41ac1, 0xc82e7f17, 0x5bafdd82,
+      0x5fda0fca, 0xdf0614c1, 0xa8ae37ad, 0x74b043a7},
+     {0x9e71734c, 0x3ba6afa1, 0x9c450f2e, 0x15d5437e,
+      0x67e242b1, 0x4a5883fe, 0x2c1953c2, 0x5143bdc2}},
+    {{0xb1f3390b, 0xc676d7f2, 0xa5b61272, 0x9f7a1b8c,
+      0xc2e127a9, 0x4ebebfc9, 0x5dd997bf, 0x4602500c},
+     {0x4711230f, 0x7f09771c, 0x020f09c1, 0x058eb37c,
+      0xfee5e38b, 0xab693d4b, 0x4653cbc0, 0x9289eb1f}},
+    {{0xab952578, 0x54da9dc7, 0x26e84d0b, 0xb5423df2,
+      0x9b872042, 0xa8b64eeb, 0x5990f6df, 0xac205782},
+     {0x21f4c77a, 0x4ff696eb, 0xaab273af, 0x1a79c3e4,
+      0x9436b3f1, 0x29bc922e, 0xd6d9a27a, 0xff807ef8}},
+  },
+  {
+    {{0xbfe20925, 0x62a8c244, 0x8fdce867, 0x91c19ac3,
+      0xdd387063, 0x5a96a5d5, 0x21d324f6, 0x61d587d4},
+     {0xa37173ea, 0xe87673a2, 0x53778b65, 0x23848008,
+      0x05bab43e, 0x10f8441e, 0x4621efbe, 0xfa11fe12}},
+    {{0xb2335834, 0xc0f734a3, 0x90ef6860, 0x9526205a,
+      0x04e2bb0d, 0xcb8be717, 0x02f383fa, 0x2418871e},
+     {0x4082c157, 0xd7177681, 0x29c20073, 0xcc914ad0,
+      0xe587e728, 0xf186c1eb, 0x61bcd5fd, 0x6fdb3c22}},
+    {{0x2cf9d7c1, 0xcc7c4c1c, 0xee95e5ab, 0x1320886a,
+      0xbeae170c, 0xbb7b9056, 0xdbc0d662, 0xc8a5b250},
+     {0xc11d2303, 0x4ed81432, 0x1f03769f, 0x7da66912,
+      0x84539828, 0x3ac7a5fd, 0x3bccdd02, 0x14dada94}},
+    {{0xcbae2f70, 0x51b90651, 0x93aaa8eb, 0xefc4bc05,
+      0xdd1df499, 0x8ecd8689, 0x22f367a5, 0x1aee99a8},
+     {0xae8274c5, 0x95d485b9, 0x7d30b39c, 0x6c14d445,
+      0xbcc1ef81, 0xbafea90b, 0xa459a2ed, 0x7c5f317a}},
+    {{0x0deeaf52, 0x410dc6a9, 0x4c641c15, 0xb003fb02,
+      0x5bc504c4, 0x1384978c, 0x864a6a77, 0x37640487},
+     {0x222a77da, 0x05991bc6, 0x5e47eb11, 0x62260a57,
+      0xf21b432c, 0xc7af6613, 0xab4953e9, 0x22f3acc9}},
+    {{0x0c24efc8, 0x0d094277, 0xbef737a4, 0x0349fd04,
+      0x514cdd28, 0x6d1c9dd2, 0x30da9521, 0x29c135ff},
+     {0xf78b0b6f, 0xea6e4508, 0x678c143c, 0x176f5dd2,
+      0x4be21e65, 0x08148418, 0xe7df38c4, 0x27f7525c}},
+    {{0xe4652f1d, 0x9faaccf5, 0xd56157b2, 0xbd6fdd2a,
+      0x6261ec50, 0xa4f4fb1f, 0x476bcd52, 0x244e55ad},
+     {0x047d320b, 0x881c9305, 0x6181263f, 0x1ca983d5,
+      0x278fb8ee, 0x354e9a44, 0x396e4964, 0xad2dbc0f}},
+    {{0x88a2ffe4, 0xfce01767, 0x28e169a5, 0xdc506a35,
+      0x7af9c93a, 0x0ea10861, 0x03fa0e08, 0x1ed24361},
+     {0xa3d694e7, 0x96eaaa92, 0xef50bc74, 0xc0f43b4d,
+      0x64114db4, 0xce6aa58c, 0x7c000fd4, 0x8218e8ea}},
+  },
+  {
+    {{0x846e364f, 0xc16c236e, 0xdea50ca0, 0x7f33527c,
+      0x0926b86d, 0xc4810775, 0x0598e70c, 0x6c2a3609},
+     {0xf024e924, 0xa6755e52, 0x9db4afca, 0xe0fa07a4,
+      0x66831790, 0x15c3ce7d, 0xa6cbb0d6, 0x5b4ef350}},
+    {{0xa9d82abf, 0xe2a37598, 0xe6c170f5, 0x5f188ccb,
+      0x5066b087, 0x81682200, 0xc7155ada, 0xda22c212},
+     {0xfbddb479, 0x151e5d3a, 0x6d715b99, 0x4b606b84,
+      0xf997cb2e, 0x4a73b54b, 0x3ecd8b66, 0x9a1bfe43}},
+    {{0x1430c9ab, 0x5afddab6, 0x2238e997, 0x0bdd41d3,
+      0x418042ae, 0xf0947430, 0xcdddc4cb, 0x71f9adda},
+     {0xc52dd907, 0x7090c016, 0x29e2047f, 0xd9bdf44d,
+      0x1b1011a6, 0xe6f1fe80, 0xd9acdc78, 0xb63accbc}},
+    {{0xc0b7eff3, 0x0ad7337a, 0xc5e48b3c, 0x8552225e,
+      0x73f13a5f, 0xe6f78b0c, 0x82349cbe, 0x5e70062e},
+     {0xe7073969, 0x6b8d5048, 0xc33cb3d2, 0x392d2a29,
+      0x4ecaa20f, 0xee4f727c, 0x2ccde707, 0xa068c99e}},
+    {{0x1b3ec67b, 0x5b826fcb, 0x41356616, 0xece1b4b0,
+      0x56a3ab4f, 0x7d5ce77e, 0xaa212da0, 0xf6087f13},
+     {0x4db92129, 0xe6301505, 0x40407d11, 0xb8ae4c99,
+      0xdfab8385, 0x2b6de222, 0xb7d6c3b4, 0x9b323022}},
+    {{0xa5660af3, 0x60684b69, 0x9066d14b, 0x69aad23b,
+      0xfa4d020a, 0x4d9f9b49, 0xb5cd6a4a, 0xafb54ec1},
+     {0x32fd864d, 0x2b25fe18, 0x2b6b64d0, 0xee694506,
+      0x5001d8aa, 0x954a2a51, 0x7082b5b3, 0x5e100855}},
+    {{0xbc90eb1b, 0x20ecf71c, 0x651c1df4, 0x4234facf,
+      0xe681f678, 0xc720fce9, 0xa7c007f4, 0x680becdd},
+     {0x3181afea, 0x7c08dc06, 0xa34eca91, 0x75c1b050,
+      0x4b9e2333, 0x7d3479d5, 0xf3951aa3, 0xed16640a}},
+    {{0x64723e54, 0x911b5962, 0x004b327c, 0x34384f8c,
+      0xb85435f2, 0x06ca5c61, 0xe2c1075c, 0x12e0cd25},
+     {0xac727394, 0xa4b84cb8, 0x92b352c1, 0x50bd7204,
+      0x9cbd0fb4, 0xe85524a4, 0xe7876024, 0x10b9274b}},
+  },
+  {
+    {{0xc63c4962, 0x80531fe1, 0x981fdb25, 0x50541e89,
+      0xfd4c2b6b, 0xdc1291a1, 0xa6df4fca, 0xc0693a17},
+     {0x0117f203, 0xb2c4604e, 0x0a99b8d0, 0x245f1963,
+      0xc6212c44, 0xaedc20aa, 0x520f52a8, 0xb1ed4e56}},
+    {{0x6bdf22da, 0x18f37a9c, 0x90dc82df, 0xefbc432f,
+      0x5d703651, 0xc52cef8e, 0xd99881a5, 0x82887ba0},
+     {0xb920ec1d, 0x7cec9dda, 0xec3e8d3b, 0xd0d7e8c3,
+      0x4ca88747, 0x445bc395, 0x9fd53535, 0xedeaa2e0}},
+    {{0x296c9005, 0xb7d4cc0f, 0x7b0aebdb, 0x4b9094fa,
+      0xc00ec8d4, 0xe1bf10f1, 0xd667c101, 0xd807b1c4},
+     {0xbe713383, 0xa9412cdf, 0x81142ba1, 0x435e063e,
+      0xaf0a6bdc, 0x984c15ec, 0x92a3dab9, 0x592c2460}},
+    {{0x16e23e9d, 0x93656900, 0xa7cc41e1, 0xcb220c6b,
+      0x69d6245c, 0xb36b20c3, 0xb62e9a6a, 0x2d63c348},
+     {0xcdc0bcb5, 0xa3473e19, 0x8f601b98, 0x70f18b3f,
+      0xcde346e4, 0x8ad7a2c7, 0xbd3aaa64, 0xae9f6ec3}},
+    {{0x3274c7e1, 0x03022350, 0x4c4b6c26, 0x61ee8c93,
+      0x199389ce, 0x3c4397e3, 0x488757ce, 0xe0082600},
+     {0x06b4dafb, 0xaac3a2df, 0xddff5b6a, 0x45af0700,
+      0x8c1d9fa0, 0x0a597424, 0x391fc68b, 0x1640087d}},
+    {{0x4e5548bd, 0xf4873fcf, 0x03ce57f0, 0x8725da3f,
+      0xca953258, 0xd82f5c95, 0x7cf0747e, 0xac647f12},
+     {0x2d570bd5, 0xff2038b0, 0xa13ae03f, 0xb0c2a767,
+      0xe9932d16, 0xebaa27cd, 0x1234e901, 0xa686e3fc}},
+    {{0x63261ecc, 0x9f80435e, 0x4337d6c9, 0x6302a62e,
+      0xca4958a0, 0x91916a49, 0x3149d5d3, 0x55495899},
+     {0x9f91de3c, 0x378d020b, 0x4dd25170, 0x47b839a3,
+      0x38b7f258, 0x28258541, 0x437e7dec, 0xea5b14f7}},
+    {{0xb0018f44, 0x74f08736, 0xb446d0f5, 0xf4a03417,
+      0xa40ca6b2, 0x66a4aa2f, 0xbadb60ed, 0x215679f0},
+     {0x323e4eef, 0x3871195a, 0x20952b16, 0x8f0940c3,
+      0x879d5f7d, 0xfe8dac62, 0xc1a6e875, 0x649cb623}},
+  },
+  {
+    {{0x7189e71f, 0x32670d2f, 0x5ecf91e7, 0xc6438748,
+      0xdb757a21, 0x15758e57, 0x290a9ce5, 0x427d09f8},
+     {0x38384a7a, 0x846a308f, 0xb0732b99, 0xaac3acb4,
+      0x17845819, 0x9e941009, 0xa7ce5e03, 0x95cba111}},
+    {{0xa105fc8e, 0x37a01e48, 0x289ba48c, 0x769d754a,
+      0xd51c2180, 0xc08c6fe1, 0xb7bd1387, 0xb032dd33},
+     {0x020b0aa6, 0x953826db, 0x0664c73c, 0x05137e80,
+      0x660cf95d, 0xc66302c4, 0xb2cef28a, 0x99004e11}},
+    {{0x96ea6ca1, 0x1013e4f7, 0x1f792871, 0x567cdc2a,
+      0x5c658d45, 0xadb72870, 0xce600e98, 0xf7c1ff4a},
+     {0x4b6cad39, 0xa1ba8657, 0xba20b428, 0x3d58d634,
+      0xa2e6fdfb, 0xc0011cde, 0x7b18960d, 0xa832367a}},
+    {{0xf416448d, 0x1ecc032a, 0xec76d971, 0x4a7e8c10,
+      0xb90b6eae, 0x854f9805, 0x4bed0594, 0xfd0b1532},
+     {0xd98b5ca3, 0x89f71848, 0xf039b3ef, 0xd01fe5fc,
+      0x627bda2e, 0x4481332e, 0xa5073e41, 0xe67cecd7}},
+    {{0x4595a859, 0x2ab0bce9, 0x82084ee7, 0x4d8c2da0,
+      0xacca3d3c, 0x21ff8be5, 0x7827f633, 0xd8b80533},
+     {0x6becabbf, 0xf74e8c02, 0xfede4828, 0x9fae4dbe,
+      0x3cc46bcf, 0xd3885a5b, 0x6e6ad144, 0x2d535e2b}},
+    {{0x07605b28, 0x3aa1974f, 0x1e296255, 0x4f3d82a7,
+      0xb4e23f16, 0xbbe5ea03, 0x4e654193, 0x8f5c6c6b},
+     {0xd3e8ab01, 0x27181182, 0xf3ba6bc2, 0xc68bb231,
+      0x20af1fd7, 0x90a244d8, 0x5b713f4f, 0x605abc05}},
+    {{0xd221991a, 0xca5fe19b, 0xf05f400e, 0x271ff066,
+      0x9cf09896, 0x9d46ec4c, 0xec4febc3, 0xdcaa8dfd},
+     {0xadf19d04, 0xaa3995a0, 0x9da573a6, 0xc9863423,
+      0xf2465b2b, 0x378058b2, 0xb4c31612, 0x20d389f9}},
+    {{0xb7631c9d, 0xd7d199c7, 0xbb123942, 0x1322c2b8,
+      0xbe8b6848, 0xe662b68f, 0xcde99b14, 0xc970faf2},
+     {0xb06655e5, 0x61b27134, 0x81365d89, 0xadcef8f7,
+      0x21b851aa, 0x917b5ab5, 0x1cf694a7, 0x4f447212}},
+  },
+  {
+    {{0x6d3549cf, 0xd433e50f, 0xfacd665e, 0x6f33696f,
+      0xce11fcb4, 0x695bfdac, 0xaf7c9860, 0x810ee252},
+     {0x7159bb2c, 0x65450fe1, 0x758b357b, 0xf7dfbebe,
+      0xd69fea72, 0x2b057e74, 0x92731745, 0xd485717a}},
+    {{0xb898fd52, 0x6c8d0aa9, 0xbe9af1a7, 0x2fb38a57,
+      0x3b4f03f8, 0xe1f2b9a9, 0xc3f0cc6f, 0x2b1aad44},
+     {0x7cf2c084, 0x58b5332e, 0x0367d26d, 0x1c57d96f,
+      0xfa6e4a8d, 0x2297eabd, 0x4a0e2b6a, 0x65a947ee}},
+    {{0xfdd5b854, 0xf535b616, 0x5728719f, 0x592549c8,
+      0x06921cad, 0xe2314686, 0x311b1ef8, 0x98c8ce34},
+     {0xe9090b36, 0x28b937e7, 0x0bf7bbb7, 0x67fc3ab9,
+      0xa9d87974, 0x12337097, 0xf970e3fe, 0x3e5adca1}},
+    {{0xb3f85ff0, 0xcdcc68a7, 0x1a888044, 0xacd21cdd,
+      0x05dbe894, 0xb6719b2e, 0x8b8260d4, 0xfae1d3d8},
+     {0x8a1c5d92, 0xedfedece, 0xdc52077e, 0xbca01a94,
+      0x16dd13ed, 0xc085549c, 0x495ebaad, 0xdc5c3bae}},
+    {{0xbe7b643a, 0xcc17063f, 0x46085760, 0x7872e1c8,
+      0xb4214c9e, 0x86b0fffb, 0x72bf3638, 0xb18bbc0e},
+     {0x722591c9, 0x8b17de0c, 0x48c29e0c, 0x1edeab19,
+      0xf4304f20, 0x9fbfd98e, 0x9c77ffb6, 0x2d1dbb6b}},
+    {{0xc7141771, 0x255616d3, 0x2f226b66, 0xa86691ab,
+      0xb3ca63a9, 0xda19fea4, 0xae672f2b, 0xfc05dc42},
+     {0x718ba28f, 0xa9c6e786, 0x9c66b984, 0x07b7995b,
+      0x1b3702f2, 0x0f434f55, 0xda84eeff, 0xd6f6212f}},
+    {{0xb5b41d78, 0x4b0e7987, 0x4bf0c4f8, 0xea7df907,
+      0xfab80ecd, 0xb4d03560, 0xfb1db7e5, 0x6cf306f6},
+     {0x89fd4773, 0x0d59fb56, 0x00f9be33, 0xab254f40,
+      0x77352da4, 0x18a09a92, 0x641ea3ef, 0xf81862f5}},
+    {{0x9f759d01, 0xb59b0157, 0x7eae4fde, 0xa2923d2f,
+      0x690ba8c0, 0x18327757, 0x44f51443, 0x4bf7e38b},
+     {0xb413fc26, 0xb6812563, 0x79e53b36, 0xedb7d363,
+      0xc389f66d, 0x4fa585c4, 0x54bd3416, 0x8e1adc31}},
+  },
+  {
+    {{0x9db3b381, 0x263a2cfb, 0xd4df0a4b, 0x9c3a2dee,
+      0x7d04e61f, 0x728d06e9, 0x42449325, 0x8b1adfbc},
+     {0x7e053a1b, 0x6ec1d939, 0x66daf707, 0xee2be5c7,
+      0x810ac7ab, 0x80ba1e14, 0xf530f174, 0xdd2ae778}},
+    {{0xb6828f36, 0xadbaeb79, 0x01bd5b9e, 0x9d7a0258,
+      0x1e844b0c, 0xeda01e0d, 0x887edfc9, 0x4b625175},
+     {0x9669b621, 0x14109fdd, 0xf6f87b98, 0x88a2ca56,
+      0x170df6bc, 0xfe2eb788, 0xffa473f9, 0x0cea06f4}},
+    {{0x289a8619, 0x2618a091, 0x6671b173, 0xef796e60,
+      0x9090c632, 0x664e46e5, 0x1e66f8fb, 0xa38062d4},
+     {0x0573274e, 0x6c744a20, 0xa9271394, 0xd07b67e4,
+      0x6bdc0e20, 0x391223b2, 0xeb0a05a7, 0xbe2d93f1}},
+    {{0x4444896b, 0x7efa14b8, 0xf94027fb, 0x64974d2f,
+      0xde84487d, 0xefdcd0e8, 0x2b48989b, 0x8c45b260},
+     {0xd8463487, 0xa8fcbbc2, 0x3fbc476c, 0xd1b2b3f7,
+      0xc8f443c0, 0x21d005b7, 0x40c0139c, 0x518f2e67}},
+    {{0xa91f6791, 0xae51dca2, 0x9baa9efc, 0x2abe4190,
+      0x559c7ac1, 0xd9d2e2f4, 0xfc9f773a, 0xe82f4b51},
+     {0x4073e81c, 0xa7713027, 0xfbb596fc, 0xc0276fac,
+      0xa684f70c, 0x1d819fc9, 0xc9f7b1e0, 0x29b47fdd}},
+    {{0x721b33f2, 0x6a4590f4, 0xfedf04ea, 0x2124f1fb,
+      0x9745efe7, 0xf8e53cde, 0x65f046d9, 0xe7e10432},
+     {0xe4d0c7e6, 0xc3fca28e, 0x87253b1b, 0x847e339a,
+      0x3743e643, 0x9b595348, 0x4fd12fc5, 0xcb6a0a0b}},
+    {{0xa714181d, 0xec1214ed, 0x6067b341, 0x609ac13b,
+      0xa545df1f, 0xff4b4c97, 0x34d2076b, 0xa1240501},
+     {0x1409ca97, 0x6efa0c23, 0x20638c43, 0x254cc1a8,
+      0xdcfb46cd, 0xd4e363af, 0x03942a27, 0x62c2adc3}},
+    {{0x3fd40e09, 0x27b6a8ab, 0x77313ea9, 0xe455842e,
+      0x1f55988b, 0x8b51d1e2, 0x062bbbfc, 0x5716dd73},
+     {0x4e8bf3de, 0x633c11e5, 0x1b85be3b, 0x9a0e77b6,
+      0x0911cca6, 0x56510729, 0xefa6590f, 0x27e76495}},
+  },
+  {
+    {{0x979f3925, 0xb81d783e, 0xaf4c89a7, 0x1efd130a,
+      0xfd1bf7fa, 0x525c2144, 0x1b265a9e, 0x4b296904},
+     {0xb9db65b6, 0xed8e9634, 0x03599d8a, 0x35c82e32,
+      0x403563f3, 0xdaa7a54f, 0x022c38ab, 0x9df088ad}},
+    {{0xf111661e, 0x9e93ba24, 0xb105eb04, 0xedced484,
+      0xf424b578, 0x96dc9ba1, 0xe83e9069, 0xbf8f66b7},
+     {0xd7ed8216, 0x872d4df4, 0x8e2cbecf, 0xbf07f377,
+      0x98e73754, 0x4281d899, 0x8aab8708, 0xfec85fbb}},
+    {{0x1a3a93bc, 0x82eebe73, 0xa21adc1a, 0x42bbf465,
+      0xef030efd, 0xc10b6fa4, 0x87b097bb, 0x247aa4c7},
+     {0xf60c77da, 0x8b8dc632, 0xc223523e, 0x6ffbc26a,
+      0x344579cf, 0xa4f6ff11, 0x980250f6, 0x5825653c}},
+    {{0xd314e7bc, 0xeda6c595, 0x467899ed, 0x2ee7464b,
+      0x0a1ed5d3, 0x1cef423c, 0x69cc7613, 0x217e76ea},
+     {0xe7cda917, 0x27ccce1f, 0x8a893f16, 0x12d8016b,
+      0x9fc74f6b, 0xbcd6de84, 0xf3144e61, 0xfa5817e2}},
+    {{0x49ccd6d7, 0xc0b48d4e, 0x88bd5580, 0xff8fb02c,
+      0x07d473b2, 0xc75235e9, 0xa2188af3, 0x4fab1ac5},
+     {0x97576ec0, 0x030fa3bc, 0x0b7e7d2f, 0xe8c946e8,
+      0x70305600, 0x40a5c9cc, 0xc8b013b4, 0x6d8260a9}},
+    {{0xcfdcf7dd, 0x2b09d2c3, 0x723fcab4, 0x41a9fce3,
+      0x07f57ca3, 0x73d905f7, 0xac8e1555, 0x080f9fb1},
+     {0x9ba7a531, 0x7c088e84, 0xed9a147f, 0x07d35586,
+      0xaf48c336, 0x602846ab, 0x0ccf0e79, 0x7320fd32}},
+    {{0x7f8f875d, 0x92eb4090, 0x56c26bbf, 0x9c9d754e,
+      0x8110bbe7, 0x158cea61, 0x745f91ea, 0x62a6b802},
+     {0xc6e7394b, 0xa79c41aa, 0xad57ef10, 0x445b6a83,
+      0x6ea6f40c, 0x0c5277eb, 0x88633365, 0x319fe96b}},
+    {{0xd39b8c34, 0x77f84203, 0x3125eddb, 0xed8b1be6,
+      0xf6e39dc5, 0x5bbf2441, 0x6a5d678a, 0xb00f6ee6},
+     {0x57d0ea99, 0xba456ecf, 0x17e06c43, 0xdcae0f58,
+      0x0f5b4baa, 0x01643de4, 0xd161b9be, 0x2c324341}},
+  },
+  {
+    {{0x4c830320, 0xf3b7963f, 0x903203e3, 0x842c7aa0,
+      0xe7327afb, 0xaf22ca0a, 0x967609b6, 0x38e13092},
+     {0x757558f1, 0x73b8fb62, 0xf7eca8c1, 0x3cc3e831,
+      0xf6331627, 0xe4174474, 0xc3c40234, 0xa77989ca}},
+    {{0xb796d219, 0xb32cb8b0, 0x34741dd9, 0xc3e95f4f,
+      0x68edf6f5, 0x87212125, 0xa2b9cb8e, 0x7a03aee4},
+     {0xf53a89aa, 0x0cd3c376, 0x948a28dc, 0x0d8af9b1,
+      0x902ab04f, 0xcf86a3f4, 0x7f42002d, 0x8aacb62a}},
+    {{0x252bd479, 0x9cb0ae6c, 0x12b5848f, 0x05e0f88a,
+      0xa5c97663, 0x78f6d2b2, 0xc162225c, 0x6f6e149b},
+     {0xde601a89, 0xe602235c, 0xf373be1f, 0xd17bbe98,
+      0xa8471827, 0xcaf49a5b, 0x18aaa116, 0x7e1a0a85}},
+    {{0x35e6fc06, 0x8b1e5722, 0x0b3e13d5, 0x3477728f,
+      0xaa8a7372, 0x150c294d, 0x3bfa528a, 0xc0291d43},
+     {0xcec5a196, 0xc6c8bc67, 0x5c2e8a7c, 0xdeeb31e4,
+      0xfb6e1c51, 0xba93e244, 0x2e28e156, 0xb9f8b71b}},
+    {{0xee9523f0, 0x343ac0a3, 0x975ea978, 0xbb75eab2,
+      0x107387f4, 0x1bccf332, 0x9ab0062e, 0x790f9259},
+     {0x1e4f6a5f, 0xf1a363ad, 0x62519a50, 0x06e08b84,
+      0x7265f1ee, 0x60915187, 0x93ae985e, 0x6a80ca34}},
+    {{0xbe0f4492, 0x2dfb9e08, 0xe9d5e517, 0x3ff0da03,
+      0xf79466a8, 0x03dbe9a1, 0x15ea9932, 0x0b87bcd0},
+     {0xab1f58ab, 0xeb64fc83, 0x817edc8a, 0x6d9598da,
+      0x1d3b67e5, 0x699cff66, 0x92635853, 0x645c0f29}},
+    {{0xd7fe71f3, 0xd50e57c7, 0xbc97ce38, 0x15342190,
+      0x4df07b63, 0x51bda2de, 0x200eb87d, 0xba12aeae},
+     {0xa9b4f8f6, 0xabe135d2, 0xfad6d99c, 0x04619d65,
+      0x7994937c, 0x4a6683a7, 0x6f94f09a, 0x7a778c8b}},
+    {{0x425c6559, 0x8dd1fb83, 0x0af06fda, 0x7fc00ee6,
+      0x33d956df, 0xe98c9225, 0x4fbdc8a2, 0x0f1ef335},
+     {0xb79b8ea2, 0x2abb5145, 0xbdbff288, 0x40fd2945,
+      0xd7185db7, 0x6a814ac4, 0xc084609a, 0xc4329d6f}},
+  },
+  {
+    {{0xf4f8b16a, 0x56f8410e, 0xc47b266a, 0x97241afe,
+      0x6d9c87c1, 0x0a406b8e, 0xcd42ab1b, 0x803f3e02},
+     {0x04dbec69, 0x7f0309a8, 0x3bbad05f, 0xa83b85f7,
+      0xad8e197f, 0xc6097273, 0x5067adc1, 0xc097440e}},
+    {{0x3794f8dc, 0x266344a4, 0x483c5c36, 0xdcca923a,
+      0x3f9d10a0, 0x2d6b6bbf, 0x81d9bdf3, 0xb320c5ca},
+     {0x47b50a95, 0x620e28ff, 0xcef03371, 0x933e3b01,
+      0x99100153, 0xf081bf85, 0xc3a8c8d6, 0x183be9a0}},
+    {{0xe085116b, 0x25470fab, 0x87285310, 0x04a43375,
+      0xe2bfd52f, 0x4e39187e, 0x7d9ebc74, 0x36166b44},
+     {0xfd4b322c, 0x92ad433c, 0xba79ab51, 0x726aa817,
+      0xc1db15eb, 0xf96eacd8, 0x0476be63, 0xfaf71e91}},
+    {{0x49dee168, 0x72cfd2e9, 0x3e2af239, 0x1ae05223,
+      0x1d94066a, 0x009e75be, 0x38abf413, 0x6cca31c7},
+     {0x9bc49908, 0xb50bd61d, 0xf5e2bc1e, 0x4a9b4a8c,
+      0x946f83ac, 0xeb6cc5f7, 0xebffab28, 0x27da93fc}},
+    {{0x76257c51, 0x3ce519ef, 0x18d477e7, 0x6f5818d3,
+      0x7963edc0, 0xab022e03, 0x8bd1f5f3, 0xf0403a89},
+     {0x496033ca, 0xe43b8da0, 0xa1cfdd72, 0x0994e10e,
+      0xba73c0e2, 0xb1ec6d20, 0xb6bcfad1, 0x0329c9ec}},
+    {{0x3318d2d4, 0xbdec338e, 0xbe8de963, 0x733dd7bb,
+      0xa2c47ebd, 0x61bcc3ba, 0x35efcbde, 0xa821ad19},
+     {0x024cdd5c, 0x91ac668c, 0xc1cdfa49, 0x7ba558e4,
+      0x908fb4da, 0x491d4ce0, 0xf685bde8, 0x7ba869f9}},
+    {{0x79f464ba, 0xed1b5ec2, 0x47d72e26, 0x2d65e42c,
+      0x9e67f926, 0x8198e574, 0x34747e44, 0x41066738},
+     {0xe37e5447, 0x4637acc1, 0xf3e15822, 0x02cbc9ec,
+      0x805aa83c, 0x58a8e98e, 0x5595e800, 0x73facd6e}},
+    {{0x38330507, 0x468ff803, 0x4037a53e, 0x06f34ddf,
+      0x8d6993a4, 0x70cd1a40, 0x43e5c022, 0xf85a1597},
+     {0xc125a67d, 0x396fc9c2, 0x1064bfcb, 0x03b7bebf,
+      0xa9806dcb, 0x7c444592, 0x4487cd54, 0x1b02614b}},
+  },
+  {
+    {{0x81fdad90, 0x25914f78, 0x0d2cf6ab, 0xcf638f56,
+      0xcc054de5, 0xb90bc03f, 0x18b06350, 0x932811a7},
+     {0x9bbd11ff, 0x2f00b330, 0xb4044974, 0x76108a6f,
+      0xa851d266, 0x801bb9e0, 0xbf8990c1, 0x0dd099be}},
+    {{0x7b0ac93d, 0xebd6a677, 0x78f5e0d7, 0xa6e37b0d,
+      0x76f5492b, 0x2516c096, 0x9ac05f3a, 0x1e4bf888},
+     {0x4df0ba2b, 0xcdb42ce0, 0x5062341b, 0x935d5cfd,
+      0x82acac20, 0x8a303333, 0x5198b00e, 0x429438c4}},
+    {{0xc1770616, 0x6c626f56, 0x09da9a2d, 0x5351909e,
+      0xa3730e45, 0xe58e6825, 0x03ef0a79, 0x9d8c8bc0},
+     {0x056becfd, 0x543f78b6, 0xa090b36d, 0x33f13253,
+      0x794432f9, 0x82ad4997, 0x4721f502, 0x1386493c}},
+    {{0xb008733a, 0xe566f400, 0x512e1f57, 0xcba0697d,
+      0x40509cd0, 0x9537c2b2, 0x57353d8c, 0x5f989c69},
+     {0x4c3c2b2f, 0x7dbec972, 0xff031fa8, 0x90e02fa8,
+      0xcfd5d11f, 0xf4d15c53, 0x48314dfc, 0xb3404fae}},
+    {{0xf327a07f, 0xf02cc3a9, 0x4490937d, 0xefb27a9b,
+      0xb1b3afa5, 0x81451e96, 0x91883be4, 0x67e24de8},
+     {0x70869e54, 0x1ad65d47, 0x64a3856a, 0xd36291a4,
+      0x7132e880, 0x070a1abf, 0x0e28dfdf, 0x9511d0a3}},
+    {{0xc72a4be5, 0x9b185fac, 0x4d848089, 0xf66de236,
+      0x717afea9, 0xba14d07c, 0x2d551c1c, 0x25bfbfc0},
+     {0x4cdf3d88, 0x2cef0ecd, 0x647f73c4, 0x8cee2aa3,
+      0x722d67f7, 0xc10a7d3d, 0x94564a21, 0x090037a2}},
+    {{0x4f3815c4, 0x6ac07bb8, 0x1aa9017e, 0xddb9f624,
+      0xca85720a, 0x31e30228, 0x7cb75838, 0xe59d63f5},
+     {0x7baad2d0, 0x69e18e77, 0xd42f5d73, 0x2cfdb784,
+      0xf5774983, 0x025dd53d, 0xe042cd52, 0x2f80e7ce}},
+    {{0x4d6ee4ab, 0x43f18d7f, 0x9570c3dc, 0xd3ac8cde,
+      0x0b8c9b2a, 0x527e4907, 0xc5a4c0f1, 0x716709a7},
+     {0x916a26b1, 0x930852b0, 0x4e071177, 0x3cc17fcf,
+      0x59694868, 0x34f5e3d4, 0xa28f655d, 0xee0341ab}},
+  },
+  {
+    {{0xadf7cccf, 0x75d9bc15, 0xdfa1e1b0, 0x81a3e5d6,
+      0x249bc17e, 0x8c39e444, 0x8ea7fd43, 0xf37dccb2},
+     {0x907fba12, 0xda654873, 0x4a372904, 0x35daa6da,
+      0x6283a6c5, 0x0564cfc6, 0x4a9395bf, 0xd09fa4f6}},
+    {{0x5cfe5c48, 0xc51aa29e, 0x815ee096, 0x82c020ae,
+      0x7549a68a, 0x7848ad82, 0x60471355, 0x7933d489},
+     {0x67c51e57, 0x04998d2e, 0xd9944afc, 0x0f64020a,
+      0xa7fadac6, 0x7a299fe1, 0x5aefe92c, 0x40c73ff4}},
+    {{0x5488771a, 0xbf44ffc7, 0x7f2f2191, 0xcb76e3f1,
+      0x94f86a42, 0x4197bde3, 0x70641d9a, 0x45c25bb9},
+     {0xf88ce6dc, 0xd8a29e31, 0x4bb7ac7d, 0xbe2becfd,
+      0xb5670cc7, 0x13094214, 0x60af8433, 0xe90a8fd5}},
+    {{0x4ebd3f02, 0x0ecf9b8b, 0x86b770ea, 0xa47acd9d,
+      0x2da213ce, 0x93b84a6a, 0x53e7c8cf, 0xd760871b},
+     {0x36e530d7, 0x7a5f58e5, 0x1912ad51, 0x7abc52a5,
+      0x2ea0252a, 0x7ad43db0, 0xc176b742, 0x498b00ec}},
+    {{0x888ae17f, 0x9ff713ef, 0xb34b7beb, 0x6007f68f,
+      0x3b653d64, 0x5d2b1898, 0xd3ca4b1b, 0xcbf73e91},
+     {0x6cdfb3a1, 0x4b050ad5, 0xd1f833a4, 0x41bd3ec3,
+      0x719d7bf5, 0x78d7e2ee, 0x2a27412e, 0xea460467}},
+    {{0x441e760d, 0xc312ba68, 0xa50e512e, 0x84d0d061,
+      0x4bbdd849, 0xfe764f4e, 0x9dadd5c0, 0xa924adcf},
+     {0xdebfe976, 0x08685961, 0x29fba601, 0xd3d846c5,
+      0xdc3f4040, 0x43bf8227, 0xa49e9ff5, 0x05e767b8}},
+    {{0x9953e453, 0xc4689c30, 0x1712dca5, 0x5e355a2e,
+      0xf1cd96f7, 0x1ff83c81, 0x44cf56db, 0xb06b89fb},
+     {0x65f16e0d, 0x18277053, 0xe5618672, 0x6403b91d,
+      0xbe384bc6, 0xba3f9475, 0x303ce5f3, 0x7f691cbe}},
+    {{0x210f4045, 0x4589ba03, 0x01e8012a, 0xd5e73663,
+      0x74462ffa, 0x1c26052d, 0x4f989519, 0xe78f600c},
+     {0x7cee0b2f, 0xc63ca0c9, 0xaf760b5f, 0xbe588573,
+      0x593773cd, 0x05906fc4, 0xe322d5af, 0xd5970fb0}},
+  },
+  {
+    {{0xe457a477, 0xa0158eea, 0xee6ddc05, 0xd19857db,
+      0x18c41671, 0xb3265224, 0x3c2c0d58, 0x3ffdfc7e},
+     {0x26ee7cda, 0x3a3a5254, 0xdf02c3a8, 0x341b0869,
+      0x723bbfc8, 0xa023bf42, 0x14452691, 0x3d15002a}},
+    {{0x262a3539, 0xf3cae7e9, 0x6670d59e, 0x78a49d1d,
+      0xc1c5e1b9, 0x37de0f63, 0x69cb7c1c, 0x3072c30c},
+     {0x77c850e6, 0x1d278a52, 0x1f6a3de6, 0x84f15f8f,
+      0x592ca7ad, 0x46a8bb45, 0xe4d424b8, 0x1912e3ee}},
+    {{0x365e668b, 0xdc988086, 0xaabda5fb, 0xada8dcda,
+      0x255f1fbe, 0xbc146b4c, 0xcf34cfc3, 0x9cfcde29},
+     {0x7e85d1e4, 0xacbb453e, 0xf92358b5, 0x9ca09679,
+      0x240823ff, 0x15fc2d96, 0x0c11d11e, 0x8d65adf7}},
+    {{0x0296f4fd, 0x775557f1, 0xea51b436, 0x1dca76a3,
+      0xfb950805, 0xf3e98f60, 0x831cf7f1, 0x31ff32ea},
+     {0x8d2c714b, 0x643e7bf1, 0x2e9d2aca, 0x64b5c339,
+      0x6adc2d23, 0xa9fd9ccc, 0xcc721b9b, 0xfc2397ec}},
+    {{0xb48ec57d, 0xf031182d, 0x04b233b9, 0x515d32f8,
+      0x093aad26, 0x06bbb1d4, 0x0d83d1ec, 0x88a142fe},
+     {0x245c73f8, 0x3b95c099, 0x52edcd32, 0xb126d4af,
+      0x8fcb52e6, 0xf8022c1e, 0x0106d339, 0x5a51ac4c}},
+    {{0x7c64a054, 0xb7f70a1a, 0x9db43e79, 0x0dc1c0df,
+      0x51fe63d6, 0x6d0a4ae2, 0x7f0c8abf, 0xe0d5e332},
+     {0x2b7ecee8, 0xff550036, 0x5d055008, 0x3ea0e6f7,
+      0xf24ac84f, 0x30deb62f, 0x5d7116b7, 0x936969fd}},
+    {{0x2617cf7f, 0x02da7612, 0xeee35260, 0xd6e25d4e,
+      0xfd3533e9, 0xb2fa5b0a, 0xb9126f88, 0xe76bb7b0},
+     {0x88856866, 0x692e6a99, 0x49db65ca, 0x3fdf394f,
+      0x22d8d606, 0x25296991, 0x3dd7c4cf, 0xe815bfbf}},
+    {{0x4d844e7f, 0x69c984ed, 0x4a2e8a82, 0xd354b217,
+      0xfb2c4136, 0x25bd4add, 0x144b26e1, 0xf72df4de},
+     {0xe6101afd, 0xd0aa9db0, 0xe49bd1b8, 0x4445efaa,
+      0x331593b2, 0x5dc54eee, 0x094bf10b, 0xfa35e3b9}},
+  },
+  {
+    {{0x35d0b34a, 0xe3417bc0, 0x8327c0a7, 0x440b386b,
+      0xac0362d1, 0x8fb7262d, 0xe0cdf943, 0x2c41114c},
+     {0xad95a0b1, 0x2ba5cef1, 0x67d54362, 0xc09b37a8,
+      0x01e486c9, 0x26d6cdd2, 0x42ff9297, 0x20477abf}},
+    {{0x1e706ad9, 0x126f35b5, 0xc3a9ebdf, 0xb99cebb4,
+      0xbf608d90, 0xa75389af, 0xc6c89858, 0x76113c4f},
+     {0x97e2b5aa, 0x80de8eb0, 0x63b91304, 0x7e1022cc,
+      0x6ccc066c, 0x3bdab605, 0xb2edf900, 0x33cbb144}},
+    {{0xdace5aca, 0x157af101, 0x11a6a267, 0xc4fdbcf2,
+      0xc49c8609, 0xdaddf340, 0xe9604a65, 0x97e49f52},
+     {0x937e2ad5, 0x9be8e790, 0x326e17f1, 0x846e2508,
+      0x0bbbc0dc, 0x3f38007a, 0xb11e16d6, 0xcf03603f}},
+    {{0xf8ae7c38, 0x5ed0c007, 0x3d740192, 0x6db07a5c,
+      0x5fe36db3, 0xbe5e9c2a, 0x76e95046, 0xd5b9d57a},
+     {0x8eba20f2, 0x54ac32e7, 0x71b9a352, 0xef11ca8f,
+      0xff98a658, 0x305e373e, 0x823eb667, 0xffe5a100}},
+    {{0xda64309d, 0x5c8ed8d5, 0x91b30704, 0x61a6de56,
+      0x2f9b5808, 0xd6b52f6a, 0x98c958a7, 0x0eee4194},
+     {0x771e4caa, 0xcddd9aab, 0x78bc21be, 0x83965dfd,
+      0xb3b504f5, 0x02affce3, 0x561c8291, 0x30847a21}},
+    {{0x66131e2e, 0xb9d18cd3, 0x80fe2682, 0xf31d974f,
+      0xe4160289, 0xb6e49e0f, 0x08e92799, 0x7c48ec0b},
+     {0xd1989aa7, 0x818111d8, 0xebf926f9, 0xb34fa0aa,
+      0xa245474a, 0xdb5fe2f5, 0x3c7ca756, 0xf80a6ebb}},
+    {{0x3de9abe3, 0x8ea61059, 0x9cdc03be, 0x40434881,
+      0xcfedce8c, 0x9b261245, 0xcf5234a1, 0x78c318b4},
+     {0xfde24c99, 0x510bcf16, 0xa2c2ff5d, 0x2a77cb75,
+      0x27960fb4, 0x9c895c2b, 0xb0eda42b, 0xd30ce975}},
+    {{0xff57d051, 0x09521177, 0xfb6a1961, 0x2ff38037,
+      0xa3d76ad4, 0xfc0aba74, 0x25a7ec17, 0x7c764803},
+     {0x48879bc8, 0x7532d75f, 0x58ce6bc1, 0xea7eacc0,
+      0x8e896c16, 0xc82176b4, 0x2c750fed, 0x9a30e0b2}},
+  },
+  {
+    {{0xf23f2d92, 0x91213462, 0x60b94078, 0x6cab71bd,
+      0x176cde20, 0x6bdd0a63, 0xee4d54bc, 0x54c9b20c},
+     {0x9f2ac02f, 0x3cd2d8aa, 0x206eedb0, 0x03f8e617,
+      0x93086434, 0xc7f68e16, 0x92dd3db9, 0x831469c5}},
+    {{0xe36d0757, 0x4a9090cd, 0xd9a29382, 0xf722d7b1,
+      0x04b48ddf, 0xfb7fb04c, 0xebe16f43, 0x628ad2a7},
+     {0x20226040, 0xcd3fbfb5, 0x5104b6c4, 0x6c34ecb1,
+      0xc903c188, 0x30c0754e, 0x2d23cab0, 0xec336b08}},
+    {{0xcbb13d1b, 0xd213f923, 0x5bfb9bfe, 0x98799f42,
+      0x701144a9, 0x1ae8ddc9, 0x4c5595ee, 0x0b8b3bb6},
+     {0x3ecebb21, 0x0ea9ef2e, 0x3671f9a7, 0x17cb6c4b,
+      0x726f1d1f, 0x47ef464f, 0x6943a276, 0x171b9484}},
+    {{0xa607419d, 0xc9941109, 0xbb6bca80, 0xfaa71e62,
+      0x07c431f3, 0x34158c13, 0x992bc47a, 0x594abebc},
+     {0xeb78399f, 0x6dfea691, 0x3f42cba4, 0x48aafb35,
+      0x077c04f0, 0xedcd65af, 0xe884491a, 0x1a29a366}},
+    {{0xf7ea25aa, 0x7bf6a5c1, 0xfbb07d5f, 0xd165e6bf,
+      0x89e78671, 0xe3539361, 0x2bac4219, 0xa3fcac89},
+     {0xf0baa8ab, 0xdfab6fd4, 0xe2c1c2e5, 0x5a4adac1,
+      0x40d85849, 0x6cd75e31, 0x19b39181, 0xce263fea}},
+    {{0x9a29a5c5, 0xe042ece5, 0x3b6c8402, 0xb19b3c07,
+      0x19d92684, 0xc97667c7, 0xebc66372, 0xb5624622},
+     {0x3c04fa02, 0x0cb96e65, 0x8eaa39aa, 0x83a7176c,
+      0xeaa1633f, 0x2033561d, 0x4533df73, 0x45a9d086}},
+    {{0x5ece6e7c, 0xa29ae9df, 0x0facfb55, 0x0603ac8f,
+      0xdda233a5, 0xcfe85b7a, 0xbd75f0b8, 0xe618919f},
+     {0x99bf1603, 0xf555a3d2, 0xf184255a, 0x1f43afc9,
+      0x319a3e02, 0xdcdaf341, 0x03903a39, 0xd3b117ef}},
+    {{0x4d82f4c2, 0xb6b82fa7, 0x6804efb3, 0x90725a60,
+      0xadc3425e, 0xbc82ec46, 0x2787843e, 0xb7b80581},
+     {0xdd1fc74c, 0xdf46d91c, 0xe783a6c4, 0xdc1c62cb,
+      0x1a04cbba, 0x59d1b9f3, 0x95e40764, 0xd87f6f72}},
+  },
+  {
+    {{0x1f095615, 0x1083e2ea, 0x14e68c33, 0x0a28ad77,
+      0x3d8818be, 0x6bfc0252, 0xf35850cd, 0xb585113a},
+     {0x30df8aa1, 0x7d935f0b, 0x4ab7e3ac, 0xaddda07c,
+      0x552f00cb, 0x92c34299, 0x2909df6c, 0xc33ed1de}},
+    {{0x83cdd60e, 0xabe7905a, 0xa1170184, 0x50602fb5,
+      0xb023642a, 0x689886cd, 0xa6e1fb00, 0xd568d090},
+     {0x0259217f, 0x5b1922c7, 0xc43141e4, 0x93831cd9,
+      0x0c95f86e, 0xdfca3587, 0x568ae828, 0xdec2057a}},
+    {{0x42e06189, 0x860d523d, 0x4e3aff13, 0xbf077941,
+      0xc1b20650, 0x0b616dca, 0x2131300d, 0xe66dd6d1},
+     {0xff99abde, 0xd4a0fd67, 0xc7aac50d, 0xc9903550,
+      0x7c46b2d7, 0x022ecf8b, 0x3abf92af, 0x3333b1e8}},
+    {{0xbe42a582, 0xefecdef7, 0x65046be6, 0xd3fc6080,
+      0x09e8dba9, 0xc9af13c8, 0x641491ff, 0x1e6c9847},
+     {0xd30c31f7, 0x3b574925, 0xac2a2122, 0xb7eb72ba,
+      0xef0859e7, 0x776a0dac, 0x21900942, 0x06fec314}},
+    {{0xf4737f21, 0x7ec62fbb, 0x6209f5ac, 0xd8dba5ab,
+      0xa5f9adbe, 0x24b5d7a9, 0xa61dc768, 0x707d28f7},
+     {0xcaa999ea, 0x7711460b, 0x1c92e4cc, 0xba7b174d,
+      0x18d4bf2d, 0x3c4bab66, 0xeb8bd279, 0xb8f0c980}},
+    {{0xc0519a23, 0x28d675b2, 0x4f6952e3, 0x9ebf94fe,
+      0xa2294a8a, 0xf28bb767, 0xfe0af3f5, 0x85512b4d},
+     {0x99b16a0d, 0x18958ba8, 0xba7548a7, 0x95c2430c,
+      0xa16be615, 0xb30d1b10, 0x85bfb74c, 0xe3ebbb97}},
+    {{0xd2fdca23, 0x81eeb865, 0xcc8ef895, 0x5a15ee08,
+      0x01905614, 0x768fa10a, 0x880ee19b, 0xeff5b8ef},
+     {0xcb1c8a0e, 0xf0c0cabb, 0xb8c838f9, 0x2e1ee9cd,
+      0x8a4a14c0, 0x0587d8b8, 0x2ff698e5, 0xf6f27896}},
+    {{0x9e2fce99, 0x9c4b646e, 0x1e80857f, 0x68a21081,
+      0x3643b52a, 0x06d54e44, 0x0d8eb843, 0xde8d6d63},
+     {0x42146a0a, 0x70321563, 0x5eaa3622, 0x8ba826f2,
+      0x86138787, 0x227a58bd, 0x10281d37, 0x43b6c03c}},
+  },
+  {
+    {{0xee3c76cb, 0xf306a3c8, 0xd32a1f6e, 0x3cf11623,
+      0x6863e956, 0xe6d5ab64, 0x5c005c26, 0x3b8a4cbe},
+     {0x9ce6bb27, 0xdcd529a5, 0x04d4b16f, 0xc4afaa52,
+      0x7923798d, 0xb0624a26, 0x6b307fab, 0x85e56df6}},
+    {{0x9884aaf7, 0x89689595, 0x07b348a6, 0xb1959be3,
+      0x3c147c87, 0x96250e57, 0xdd0c61f8, 0xae0efb3a},
+     {0xca8c325e, 0xed00745e, 0xecff3f70, 0x3c911696,
+      0x319ad41d, 0x73acbc65, 0xf0b1c7ef, 0x7b01a020}},
+    {{0x224c08dc, 0x262143b5, 0x81b50c91, 0x2bbb09b4,
+      0xaca8c84f, 0xc16ed709, 0xb2850ca8, 0xa6210d9d},
+     {0x09cb54d6, 0x6d8df67a, 0x500919a4, 0x91eef6e0,
+      0x0f132857, 0x90f61381, 0xf8d5028b, 0x9acede47}},
+    {{0xde673629, 0x45e21446, 0x703c2d21, 0x57f7aa1e,
+      0x98c868c7, 0xa0e99b7f, 0x8b641676, 0x4e42f66d},
+     {0x91077896, 0x602884dc, 0xc2c9885b, 0xa0d690cf,
+      0x3b9a5187, 0xfeb4da33, 0x153c87ee, 0x5f789598}},
+    {{0xca66eca8, 0xb19b1c4f, 0x5663de54, 0xf04a20b5,
+      0xc223b617, 0x42a29a33, 0x44827e11, 0x86c68d0d},
+     {0xadba1206, 0x71f90dde, 0x7a6ceeea, 0xeeffb416,
+      0xc543e8af, 0x9e302fba, 0x1aa77b96, 0xcf07f747}},
+    {{0x475952af, 0x5fd7cafb, 0x54a43337, 0x23a6d719,
+      0xb1617941, 0xa83a7523, 0x12b37dd4, 0x0b7f35d4},
+     {0x2ae27eaf, 0x81ec5129, 0x318169df, 0x7ca92fb3,
+      0x78d0875a, 0xc01bfd60, 0xc99c436e, 0xcc6074e3}},
+    {{0xf57912b8, 0x4ca6bdeb, 0x98507b5a, 0x9a17577e,
+      0x59e51dfc, 0x8ed4ab77, 0x470f5a36, 0x103b7b2a},
+     {0x12553321, 0x0c8545ac, 0x60482817, 0xab5861a7,
+      0xb9b856cf, 0xf4b5f602, 0x7adf2e5f, 0x60995578}},
+    {{0xee5cb44f, 0x60ce25b1, 0x2c2d7598, 0xddcc7d18,
+      0x01847b5c, 0x1765a1b3, 0x5d0d23b7, 0xf5d9c363},
+     {0x928b65d0, 0x42ff1ba7, 0x6148e043, 0x587ac69d,
+      0xd320390b, 0x3099be0d, 0x4278329f, 0xa7b88dfc}},
+  },
+};
@@ -3,6 +3,5 @@
 #include "vk_crypto.h"
 
 int p256_generate_random(uint8_t *output, unsigned output_size) {
-    vk_crypto_get_random(output, output_size);
-    return 0;
+    return vk_crypto_get_random(output, output_size) ? 0 : -1;
 }
@@ -0,0 +1,145 @@
+#include "hmac_sha256.h"
+#include <string.h>
+
+#define BLOCK 64
+
+static void wipe(void *v, size_t n) {
+  volatile uint8_t *p = (volatile uint8_t *)v;
+  while (n--)
+    *p++ = 0;
+}
+
+/* A context that has absorbed exactly one block, at the given state */
+static void resume(SHA256_CTX *ctx, const uint32_t state[8]) {
+  memcpy(ctx->state, state, sizeof(ctx->state));
+  ctx->datalen = 0;
+  ctx->bitlen = 8 * BLOCK;
+}
+
+void hmac_sha256_setup(hmac_sha256_key *k, const uint8_t *key,
+                       size_t key_len) {
+  uint8_t pad[BLOCK], tk[HMAC_SHA256_BYTES];
+  SHA256_CTX ctx;
+  size_t i;
+
+  /* Keys longer than a block are hashed first */
+  if (key_len > BLOCK) {
+    sha256_init(&ctx);
+    sha256_update(&ctx, key, key_len);
+    sha256_final(&ctx, tk);
+    key = tk;
+    key_len = sizeof(tk);
+  }
+
+  memset(pad, 0x36, BLOCK);
+  for (i = 0; i < key_len; i++)
+    pad[i] ^= key[i];
+  sha256_init(&ctx);
+  sha256_update(&ctx, pad, BLOCK);
+  memcpy(k->inner, ctx.state, sizeof(k->inner));
+
+  /* 0x36 ^ 0x5c turns the inner pad into the outer one */
+  for (i = 0; i < BLOCK; i++)
+    pad[i] ^= 0x36 ^ 0x5c;
+  sha256_init(&ctx);
+  sha256_update(&ctx, pad, BLOCK);
+  memcpy(k->outer, ctx.state, sizeof(k->outer));
+
+  wipe(pad, sizeof(pad));
+  wipe(tk, sizeof(tk));
+  wipe(&ctx, sizeof(ctx));
+}
+
+void hmac_sha256_init(hmac_sha256_ctx *c, const hmac_sha256_key *k) {
+  resume(&c->ctx, k->inner);
+  memcpy(c->outer, k->outer, sizeof(c->outer));
+}
+
+void hmac_sha256_update(hmac_sha256_ctx *c, const uint8_t *data, size_t len) {
+  sha256_update(&c->ctx, data, len);
+}
+
+void hmac_sha256_final(hmac_sha256_ctx *c, uint8_t mac[HMAC_SHA256_BYTES]) {
+  uint8_t inner[HMAC_SHA256_BYTES];
+
+  sha256_final(&c->ctx, inner);
+  resume(&c->ctx, c->outer);
+  sha256_update(&c->ctx, inner, sizeof(inner));
+  sha256_final(&c->ctx, mac);
+
+  wipe(inner, sizeof(inner));
+  wipe(c, sizeof(*c));
+}
+
+void hmac_sha256_keyed(const hmac_sha256_key *k, const uint8_t *msg,
+                       size_t msg_len, uint8_t mac[HMAC_SHA256_BYTES]) {
+  hmac_sha256_ctx c;
+  hmac_sha256_init(&c, k);
+  hmac_sha256_update(&c, msg, msg_len);
+  hmac_sha256_final(&c, mac);
+}
+
+void hmac_sha256(const uint8_t *key, size_t key_len, const uint8_t *msg,
+                 size_t msg_len, uint8_t mac[HMAC_SHA256_BYTES]) {
+  hmac_sha256_key k;
+  hmac_sha256_setup(&k, key, key_len);
+  hmac_sha256_keyed(&k, msg, msg_len, mac);
+  wipe(&k, sizeof(k));
+}
+
+void hkdf_sha256_extract(uint8_t prk[HMAC_SHA256_BYTES], const uint8_t *salt,
+                         size_t salt_len, const uint8_t *ikm, size_t ikm_len) {
+  static const uint8_t zero_salt[HMAC_SHA256_BYTES] = {0};
+
+  if (!salt || !salt_len) {
+    salt = zero_salt;
+    salt_len = sizeof(zero_salt);
+  }
+  hmac_sha256(salt, salt_len, ikm, ikm_len, prk);
+}
+
+int hkdf_sha256_expand(uint8_t *okm, size_t okm_len, const uint8_t *prk,
+                       size_t prk_len, const uint8_t *info, size_t info_len) {
+  hmac_sha256_key k;
+  hmac_sha256_ctx c;
+  uint8_t t[HMAC_SHA256_BYTES];
+  uint8_t counter;
+  size_t n;
+
+  if (okm_len > 255 * HMAC_SHA256_BYTES)
+    return -1;
+
+  /* T(i) = HMAC(PRK, T(i-1) | info | i), all under one key schedule */
+  hmac_sha256_setup(&k, prk, prk_len);
+  for (counter = 1; okm_len; counter++) {
+    hmac_sha256_init(&c, &k);
+    if (counter > 1)
+      hmac_sha256_update(&c, t, sizeof(t));
+    hmac_sha256_update(&c, info, info_len);
+    hmac_sha256_update(&c, &counter, 1);
+    hmac_sha256_final(&c, t);
+
+    n = okm_len < sizeof(t) ? okm_len : sizeof(t);
+    memcpy(okm, t, n);
+    okm += n;
+    okm_len -= n;
+  }
+
+  wipe(&k, sizeof(k));
+  wipe(t, sizeof(t));
+  return 0;
+}
+
+int hkdf_sha256(uint8_t *okm, size_t okm_len, const uint8_t *salt,
+                size_t salt_len, const uint8_t *ikm, size_t ikm_len,
+                const uint8_t *info, size_t info_len) {
+  uint8_t prk[HMAC_SHA256_BYTES];
+  int res;
+
+  if (okm_len > 255 * HMAC_SHA256_BYTES)
+    return -1;
+  hkdf_sha256_extract(prk, salt, salt_len, ikm, ikm_len);
+  res = hkdf_sha256_expand(okm, okm_len, prk, sizeof(prk), info, info_len);
+  wipe(prk, sizeof(prk));
+  return res;
+}
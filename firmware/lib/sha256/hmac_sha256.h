@@ -0,0 +1,54 @@
+#ifndef HMAC_SHA256_H
+#define HMAC_SHA256_H
+
+#include "sha256.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define HMAC_SHA256_BYTES 32
+
+/*
+ * HMAC-SHA256 (RFC 2104) and HKDF-SHA256 (RFC 5869) on top of sha256.c.
+ *
+ * hmac_sha256_setup reduces a key to the SHA-256 states after its ipad and
+ * opad blocks. Every MAC under that key then starts from those states and
+ * skips two compressions; keep the key schedule around when the same key
+ * MACs repeatedly. It is as secret as the key; wipe it when done.
+ */
+typedef struct {
+  uint32_t inner[8];
+  uint32_t outer[8];
+} hmac_sha256_key;
+
+typedef struct {
+  SHA256_CTX ctx;
+  uint32_t outer[8];
+} hmac_sha256_ctx;
+
+void hmac_sha256_setup(hmac_sha256_key *k, const uint8_t *key, size_t key_len);
+
+/* Streaming MAC; hmac_sha256_final wipes the context */
+void hmac_sha256_init(hmac_sha256_ctx *c, const hmac_sha256_key *k);
+void hmac_sha256_update(hmac_sha256_ctx *c, const uint8_t *data, size_t len);
+void hmac_sha256_final(hmac_sha256_ctx *c, uint8_t mac[HMAC_SHA256_BYTES]);
+
+/* One-shot, with a prepared key schedule or a raw key */
+void hmac_sha256_keyed(const hmac_sha256_key *k, const uint8_t *msg,
+                       size_t msg_len, uint8_t mac[HMAC_SHA256_BYTES]);
+void hmac_sha256(const uint8_t *key, size_t key_len, const uint8_t *msg,
+                 size_t msg_len, uint8_t mac[HMAC_SHA256_BYTES]);
+
+/*
+ * HKDF. Extract writes a 32-byte PRK; a NULL or empty salt means 32 zero
+ * bytes. Expand returns 0, or -1 if okm_len exceeds 255 * 32. The PRK's key
+ * schedule is set up once for all output blocks.
+ */
+void hkdf_sha256_extract(uint8_t prk[HMAC_SHA256_BYTES], const uint8_t *salt,
+                         size_t salt_len, const uint8_t *ikm, size_t ikm_len);
+int hkdf_sha256_expand(uint8_t *okm, size_t okm_len, const uint8_t *prk,
+                       size_t prk_len, const uint8_t *info, size_t info_len);
+int hkdf_sha256(uint8_t *okm, size_t okm_len, const uint8_t *salt,
+                size_t salt_len, const uint8_t *ikm, size_t ikm_len,
+                const uint8_t *info, size_t info_len);
+
+#endif
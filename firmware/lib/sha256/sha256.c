@@ -73,8 +73,15 @@ void sha256_init(SHA256_CTX *ctx) {
 }
 
 void sha256_update(SHA256_CTX *ctx, const uint8_t data[], size_t len) {
-  uint32_t i;
-  for (i = 0; i < len; ++i) {
+  size_t i = 0;
+  // Whole blocks straight from the input when nothing is buffered
+  if (ctx->datalen == 0) {
+    for (; i + 64 <= len; i += 64) {
+      sha256_transform(ctx, data + i);
+      ctx->bitlen += 512;
+    }
+  }
+  for (; i < len; ++i) {
     ctx->data[ctx->datalen] = data[i];
     ctx->datalen++;
     if (ctx->datalen == 64) {
@@ -5,8 +5,12 @@
 #include "pico/stdlib.h"
 #include "tusb.h"
 #include "vault.h"
+#include "vk_arena.h"
 #include "vk_crypto.h"
 #include "vk_fido.h"
+#include "vk_job.h"
+#include "vk_multi.h"
+#include "vk_pool.h"
 #include "vk_protocol.h"
 #include "vk_totp.h"
 #include <stdint.h>
@@ -32,6 +36,7 @@ void ws2812_put_rgb(uint8_t r, uint8_t g, uint8_t b) {
 static bool led_blink_fast = false; // Fast blink for touch confirmation
 static bool led_active = false;     // Master LED switch
 static int led_state_override = -1; // -1: None, 0: Off, 1: Green Boot
+static bool vault_fault = false;    // vault_init or TRNG failed: no unlock
 
 void vk_main_set_led_mode(bool wait_for_touch) {
   led_blink_fast = wait_for_touch;
@@ -44,28 +49,8 @@ void vk_main_led_off(void) {
   ws2812_put_rgb(0, 0, 0); // All off
 }
 
-bool vk_main_wait_for_button(uint32_t timeout_ms) {
-  uint32_t start = board_millis();
-  vk_main_set_led_mode(true); // Fast blink
-
-  while (board_millis() - start < timeout_ms) {
-    tud_task(); // Keep USB alive
-
-    // Active low button (pull-up enabled)
-    if (!gpio_get(PIN_BUTTON)) {
-      vk_main_led_off();
-      return true;
-    }
-
-    // We must manually serve LED task here if blocking
-    extern void led_task_run(void);
-    led_task_run();
-
-    // Small delay to prevent tight loop if needed, but USB task handles it
-  }
-  vk_main_led_off();
-  return false;
-}
+// Active low (pull-up enabled). Polled by vk_fido for user presence.
+bool vk_main_button_pressed(void) { return !gpio_get(PIN_BUTTON); }
 
 void led_task_run(void) {
   // Boot Override (Green Pulse) - Handled by main init mostly
@@ -82,8 +67,8 @@ void led_task_run(void) {
     static bool toggle = false;
     toggle = !toggle;
     if (toggle) {
-      if (led_blink_fast)
-        ws2812_put_rgb(255, 0, 0); // Red for action
+      if (led_blink_fast || vault_fault)
+        ws2812_put_rgb(255, 0, 0); // Red for action, slow red for a fault
       else
         ws2812_put_rgb(0, 0, 255); // Blue for active
     } else {
@@ -95,212 +80,542 @@ void led_task_run(void) {
 // Forward declare for main loop
 void led_task(void) { led_task_run(); }
 
+// Device-mode KDF requests run as a job; this is the request waiting on it
+static struct {
+  vk_msg_type_t res_type;
+  uint32_t id;
+} kdf_request;
+
+// Outbox room a progress report leaves free; reports are skipped below it
+#define VK_MAIN_PROGRESS_ROOM 64
+// A reply the host has stopped reading for this long is abandoned
+#define VK_MAIN_TX_STALL_MS 2000
+
+// Responses are written into the CDC TX FIFO as they are encoded; what the
+// FIFO cannot take yet spills into the small protocol outbox, and when that
+// is full the write waits in vk_main_cdc_wait. List replies stream their
+// payload with vk_protocol_begin / write / end instead of building it first,
+// so they are not bounded by any buffer.
+static uint32_t vk_main_cdc_sink(const uint8_t *data, uint32_t len) {
+  return tud_cdc_write(data, len);
+}
+
+// Runs the USB stack so the host can take the FIFO. Requests that arrive
+// meanwhile only land in the receive ring (tud_cdc_rx_cb).
+static bool vk_main_cdc_wait(uint32_t rounds) {
+  static uint32_t stalled_since;
+  if (rounds == 0)
+    stalled_since = board_millis();
+  tud_task();
+  tud_cdc_write_flush();
+  return tud_ready() && board_millis() - stalled_since < VK_MAIN_TX_STALL_MS;
+}
+
+static void vk_main_send(vk_msg_type_t type, uint32_t id,
+                         const uint8_t *payload, uint16_t len) {
+  vk_protocol_send(type, id, payload, len);
+}
+
+static void vk_main_send_status(vk_msg_type_t type, uint32_t id,
+                                const char *status) {
+  vk_main_send(type, id, (const uint8_t *)status, (uint16_t)strlen(status));
+}
+
+static void vk_main_kdf_progress(uint8_t percent, void *user) {
+  (void)user;
+  // Best effort: skipped rather than wait on a host that is not reading
+  if (vk_protocol_tx_space() >= VK_MAIN_PROGRESS_ROOM)
+    vk_main_send(VK_MSG_PROGRESS, kdf_request.id, &percent, 1);
+}
+
+static void vk_main_kdf_done(bool success, void *user) {
+  (void)user;
+  vk_main_send_status(kdf_request.res_type, kdf_request.id,
+                      success ? "OK" : "FAIL");
+}
+
+// Start an unlock or setup job for a CDC request. Replies straight away
+// (BUSY / FAIL) when it cannot start.
+static void vk_main_kdf_request(vk_msg_type_t res_type, uint32_t id,
+                                const char *pin, bool setup) {
+  if (vk_job_busy()) {
+    vk_main_send_status(res_type, id, "BUSY");
+    return;
+  }
+  kdf_request.res_type = res_type;
+  kdf_request.id = id;
+  bool started =
+      setup ? vault_setup_start(pin, vk_main_kdf_done, vk_main_kdf_progress,
+                                NULL)
+            : vault_unlock_start(pin, vk_main_kdf_done, vk_main_kdf_progress,
+                                 NULL);
+  if (!started)
+    vk_main_send_status(res_type, id, "FAIL");
+}
+
+// Moves queued responses into the CDC FIFO as far as it has room
+static void vk_main_cdc_flush(void) {
+  const uint8_t *data;
+  uint32_t len;
+  while ((len = vk_protocol_tx_peek(&data)) != 0) {
+    uint32_t written = tud_cdc_write(data, len);
+    vk_protocol_tx_consume(written);
+    if (written < len)
+      break;
+  }
+  tud_cdc_write_flush();
+}
+
+// Moves whatever the CDC FIFO holds into the protocol ring. Requests may
+// arrive split across reads or several to a read; handlers get their payload
+// in place in the ring.
+static void vk_main_cdc_receive(void) {
+  uint32_t space;
+  uint8_t *dst;
+  while (tud_cdc_available() && (dst = vk_protocol_rx_buffer(&space)) != NULL)
+    vk_protocol_rx_commit(tud_cdc_read(dst, space));
+}
+
+// Invoked when CDC data arrives. Requests are handled from the main loop.
 void tud_cdc_rx_cb(uint8_t itf) {
   (void)itf;
-  if (tud_cdc_available()) {
-    uint8_t buf[1024];
-    uint32_t count = tud_cdc_read(buf, sizeof(buf));
-
-    vk_packet_t packet;
-    if (vk_protocol_parse(buf, (uint16_t)count, &packet)) {
-      vault_update_activity();
-
-      if (packet.type == VK_MSG_INFO_REQ) {
-        uint8_t res_buf[64];
-        uint16_t res_len = vk_protocol_create_packet(
-            VK_MSG_INFO_RES, packet.id, (const uint8_t *)"VaultKey v1.0", 13,
-            res_buf, sizeof(res_buf));
-        tud_cdc_write(res_buf, res_len);
-        tud_cdc_write_flush();
-      } else if (packet.type == VK_MSG_VAULT_UNLOCK_REQ) {
-        // [PinLen:1][Pin:N]
-        if (packet.payload_len > 1) {
-          uint8_t pin_len = packet.payload[0];
-          if (pin_len + 1 <= packet.payload_len) {
-            char pin[64];
-            memcpy(pin, &packet.payload[1], pin_len);
-            pin[pin_len] = '\0';
-            bool success = vault_unlock(pin);
-            uint8_t res_buf[64];
-            uint16_t res_len = vk_protocol_create_packet(
-                VK_MSG_VAULT_UNLOCK_RES, packet.id,
-                (const uint8_t *)(success ? "OK" : "FAIL"), success ? 2 : 4,
-                res_buf, sizeof(res_buf));
-            tud_cdc_write(res_buf, res_len);
-            tud_cdc_write_flush();
-          }
-        }
-      } else if (packet.type == VK_MSG_VAULT_ADD_REQ) {
-        if (packet.payload_len > 2) {
-          uint8_t name_len = packet.payload[0];
-          char name[ENTRY_NAME_MAX];
-          uint8_t safe_name_len =
-              name_len < (ENTRY_NAME_MAX - 1) ? name_len : (ENTRY_NAME_MAX - 1);
-          memcpy(name, &packet.payload[1], safe_name_len);
-          name[safe_name_len] = '\0';
-
-          uint16_t secret_offset = 1 + name_len;
-          if (secret_offset < packet.payload_len) {
-            uint8_t secret_len = packet.payload[secret_offset];
-            uint8_t *secret = &packet.payload[secret_offset + 1];
-            bool success = vault_set(name, secret, secret_len);
-            uint8_t res_buf[64];
-            uint16_t res_len = vk_protocol_create_packet(
-                VK_MSG_VAULT_ADD_RES, packet.id,
-                (const uint8_t *)(success ? "OK" : "FAIL"), success ? 2 : 4,
-                res_buf, sizeof(res_buf));
-            tud_cdc_write(res_buf, res_len);
-            tud_cdc_write_flush();
-          }
-        }
-      } else if (packet.type == VK_MSG_VAULT_GET_REQ) {
-        if (packet.payload_len > 1) {
-          uint8_t name_len = packet.payload[0];
-          char name[ENTRY_NAME_MAX];
-          uint8_t safe_name_len =
-              name_len < (ENTRY_NAME_MAX - 1) ? name_len : (ENTRY_NAME_MAX - 1);
-          memcpy(name, &packet.payload[1], safe_name_len);
-          name[safe_name_len] = '\0';
-
-          uint8_t secret[ENTRY_SECRET_MAX];
-          uint16_t secret_len = 0;
-          bool success = vault_get_decrypted(name, secret, &secret_len);
-
-          uint8_t res_buf[128];
-          uint16_t res_len =
-              vk_protocol_create_packet(VK_MSG_VAULT_GET_RES, packet.id, secret,
-                                        secret_len, res_buf, sizeof(res_buf));
-
-          vk_crypto_zeroize(secret, sizeof(secret));
-          tud_cdc_write(res_buf, res_len);
-          tud_cdc_write_flush();
-        }
-      } else if (packet.type == VK_MSG_VAULT_DEL_REQ) {
-        if (packet.payload_len > 0) {
-          uint8_t name_len = packet.payload[0];
-          char name[ENTRY_NAME_MAX];
-          uint8_t safe_name_len =
-              name_len < (ENTRY_NAME_MAX - 1) ? name_len : (ENTRY_NAME_MAX - 1);
-          memcpy(name, &packet.payload[1], safe_name_len);
-          name[safe_name_len] = '\0';
-          bool success = vault_delete(name);
-          uint8_t res_buf[64];
-          uint16_t res_len = vk_protocol_create_packet(
-              VK_MSG_VAULT_DEL_RES, packet.id,
-              (const uint8_t *)(success ? "OK" : "FAIL"), success ? 2 : 4,
-              res_buf, sizeof(res_buf));
-          tud_cdc_write(res_buf, res_len);
-          tud_cdc_write_flush();
-        }
-      } else if (packet.type == VK_MSG_VAULT_LIST_REQ) {
-        char names[MAX_ENTRIES][ENTRY_NAME_MAX];
-        int count = vault_list(names, MAX_ENTRIES);
-        uint8_t list_payload[1024];
-        uint16_t offset = 0;
-        for (int i = 0; i < count; i++) {
-          uint8_t nlen = (uint8_t)strlen(names[i]);
-          if (offset + 1 + nlen > sizeof(list_payload))
-            break;
-          list_payload[offset++] = nlen;
-          memcpy(&list_payload[offset], names[i], nlen);
-          offset += nlen;
-        }
-        uint8_t res_buf[1024 + 64];
-        uint16_t res_len = vk_protocol_create_packet(
-            VK_MSG_VAULT_LIST_RES, packet.id, list_payload, offset, res_buf,
-            sizeof(res_buf));
-        tud_cdc_write(res_buf, res_len);
-        tud_cdc_write_flush();
-      } else if (packet.type == VK_MSG_GET_SECURITY_REQ) {
-        uint8_t status[5];
-        uint32_t fails = vault_get_fail_count();
-        memcpy(status, &fails, 4);
-        status[4] = vault_is_locked() ? 1 : 0;
-        uint8_t res_buf[64];
-        uint16_t res_len =
-            vk_protocol_create_packet(VK_MSG_GET_SECURITY_RES, packet.id,
-                                      status, 5, res_buf, sizeof(res_buf));
-        tud_cdc_write(res_buf, res_len);
-        tud_cdc_write_flush();
-      } else if (packet.type == VK_MSG_TOTP_REQ) {
-        if (packet.payload_len >= 8) {
-          uint64_t ts = 0;
-          memcpy(&ts, packet.payload, 8);
-          const uint8_t mock_seed[] = "JBSWY3DPEHPK3PXP";
-          uint32_t code =
-              vk_totp_generate(mock_seed, sizeof(mock_seed) - 1, ts);
-          char code_str[8];
-          snprintf(code_str, sizeof(code_str), "%06lu", code); // Correct format
-          uint8_t res_buf[64];
-          uint16_t res_len = vk_protocol_create_packet(
-              VK_MSG_TOTP_RES, packet.id, (const uint8_t *)code_str, 6, res_buf,
-              sizeof(res_buf));
-          tud_cdc_write(res_buf, res_len);
-          tud_cdc_write_flush();
-        }
-      } else if (packet.type == VK_MSG_LOCK_REQ) {
-        vault_lock();
-        uint8_t res_buf[64];
-        uint16_t res_len = vk_protocol_create_packet(VK_MSG_LOCK_RES, packet.id,
-                                                     (const uint8_t *)"OK", 2,
-                                                     res_buf, sizeof(res_buf));
-        tud_cdc_write(res_buf, res_len);
-        tud_cdc_write_flush();
-      } else if (packet.type == VK_MSG_FIDO_LIST_REQ) {
-        vk_fido_cred_t creds[MAX_FIDO_CREDS];
-        int count = vault_fido_list_all(creds, MAX_FIDO_CREDS);
-        uint8_t list_payload[1024];
-        uint16_t offset = 0;
-        for (int i = 0; i < count; i++) {
-          uint8_t rplen = (uint8_t)strlen(creds[i].rp_id);
-          if (offset + 64 > sizeof(list_payload))
-            break;
-          list_payload[offset++] = rplen;
-          memcpy(&list_payload[offset], creds[i].rp_id, rplen);
-          offset += rplen;
-          list_payload[offset++] = 32;
-          memcpy(&list_payload[offset], creds[i].credential_id, 32);
-          offset += 32;
-        }
-        uint8_t res_buf[1024 + 64];
-        uint16_t res_len = vk_protocol_create_packet(
-            VK_MSG_FIDO_LIST_RES, packet.id, list_payload, offset, res_buf,
-            sizeof(res_buf));
-        tud_cdc_write(res_buf, res_len);
-        tud_cdc_write_flush();
-      } else if (packet.type == VK_MSG_FIDO_DEL_REQ) {
-        if (packet.payload_len == 32) {
-          bool success = vault_fido_delete(packet.payload);
-          uint8_t res_buf[64];
-          uint16_t res_len = vk_protocol_create_packet(
-              VK_MSG_FIDO_DEL_RES, packet.id,
-              (const uint8_t *)(success ? "OK" : "FAIL"), success ? 2 : 4,
-              res_buf, sizeof(res_buf));
-          tud_cdc_write(res_buf, res_len);
-          tud_cdc_write_flush();
-        }
-      } else if (packet.type == VK_MSG_FIDO_PIN_STATUS_REQ) {
-        uint8_t status = vault_fido_has_pin() ? 1 : 0;
-        uint8_t res_buf[64];
-        uint16_t res_len =
-            vk_protocol_create_packet(VK_MSG_FIDO_PIN_STATUS_RES, packet.id,
-                                      &status, 1, res_buf, sizeof(res_buf));
-        tud_cdc_write(res_buf, res_len);
-        tud_cdc_write_flush();
-      } else if (packet.type == VK_MSG_FIDO_SET_PIN_REQ) {
-        if (packet.payload_len == 32) {
-          bool success = vault_fido_set_pin(packet.payload);
-          uint8_t res_buf[64];
-          uint16_t res_len = vk_protocol_create_packet(
-              VK_MSG_FIDO_SET_PIN_RES, packet.id,
-              (const uint8_t *)(success ? "OK" : "FAIL"), success ? 2 : 4,
-              res_buf, sizeof(res_buf));
-          tud_cdc_write(res_buf, res_len);
-          tud_cdc_write_flush();
-        }
-      }
+  vk_main_cdc_receive();
+}
+
+// --- CDC request handlers ---
+//
+// One function per request type, found through vk_main_handlers. The packet
+// and its payload point into the receive ring and stay valid for the call.
+// Every path answers with the request's id, FAIL for a malformed payload.
+// Larger buffers come from the request arena (vk_arena.h).
+
+// Request scratch; when the arena is spent the request is answered with
+// ERROR "NOMEM" and NULL returned
+static void *vk_main_scratch(const vk_packet_t *packet, size_t size) {
+  void *p = vk_arena_alloc(size);
+  if (!p)
+    vk_main_send_status(VK_MSG_ERROR, packet->id, "NOMEM");
+  return p;
+}
+
+// Unlock and setup requests on a vault that failed to initialize are
+// answered with ERROR "VAULT_INIT"
+static bool vk_main_vault_fault(const vk_packet_t *packet) {
+  if (vault_fault)
+    vk_main_send_status(VK_MSG_ERROR, packet->id, "VAULT_INIT");
+  return vault_fault;
+}
+
+// Requests that write the vault to flash are answered BUSY while a job is
+// pending: unlock and setup store their result when they finish, and a
+// stored record must not be rewritten under them
+static bool vk_main_job_busy(const vk_packet_t *packet,
+                             vk_msg_type_t res_type) {
+  if (vk_job_busy())
+    vk_main_send_status(res_type, packet->id, "BUSY");
+  return vk_job_busy();
+}
+
+static void vk_main_on_info(const vk_packet_t *packet) {
+  vk_main_send_status(VK_MSG_INFO_RES, packet->id, "VaultKey v1.0");
+}
+
+static void vk_main_on_vault_unlock(const vk_packet_t *packet) {
+  if (vk_main_vault_fault(packet))
+    return;
+  // [PinLen:1][Pin:N]. Argon2 runs as a job; the response is sent
+  // when it finishes.
+  char pin[64];
+  uint8_t pin_len = packet->payload_len > 1 ? packet->payload[0] : 0;
+  if (packet->payload_len > 1 && pin_len + 1 <= packet->payload_len &&
+      pin_len < sizeof(pin)) {
+    memcpy(pin, &packet->payload[1], pin_len);
+    pin[pin_len] = '\0';
+    vk_main_kdf_request(VK_MSG_VAULT_UNLOCK_RES, packet->id, pin, false);
+    vk_crypto_zeroize(pin, sizeof(pin));
+  } else {
+    vk_main_send_status(VK_MSG_VAULT_UNLOCK_RES, packet->id, "FAIL");
+  }
+}
+
+static void vk_main_on_auth(const vk_packet_t *packet) {
+  if (vk_main_vault_fault(packet))
+    return;
+  if (vk_main_job_busy(packet, VK_MSG_AUTH_RES))
+    return;
+  // [PreKey:32] Argon2id result computed by the host
+  bool success =
+      packet->payload_len == 32 && vault_unlock_prekey(packet->payload);
+  vk_main_send_status(VK_MSG_AUTH_RES, packet->id, success ? "OK" : "FAIL");
+}
+
+static void vk_main_on_vault_setup(const vk_packet_t *packet) {
+  if (vk_main_vault_fault(packet))
+    return;
+  // VAULT_KDF_DEVICE: [Mode:1][PinLen:1][Pin:N]
+  // VAULT_KDF_HOST:   [Mode:1][TCost:4][MCost:4][Lanes:4][PreKey:32]
+  if (packet->payload_len > 1 && packet->payload[0] == VAULT_KDF_DEVICE) {
+    // Argon2 runs as a job; the response is sent when it finishes
+    uint8_t pin_len = packet->payload[1];
+    char pin[64];
+    if (pin_len + 2 <= packet->payload_len && pin_len < sizeof(pin)) {
+      memcpy(pin, &packet->payload[2], pin_len);
+      pin[pin_len] = '\0';
+      vk_main_kdf_request(VK_MSG_VAULT_SETUP_RES, packet->id, pin, true);
+      vk_crypto_zeroize(pin, sizeof(pin));
+    } else {
+      vk_main_send_status(VK_MSG_VAULT_SETUP_RES, packet->id, "FAIL");
+    }
+  } else if (!vk_main_job_busy(packet, VK_MSG_VAULT_SETUP_RES)) {
+    bool success = false;
+    if (packet->payload_len == 1 + 12 + 32 &&
+        packet->payload[0] == VAULT_KDF_HOST) {
+      vk_kdf_params_t host_params;
+      memcpy(&host_params.t_cost, &packet->payload[1], 4);
+      memcpy(&host_params.m_cost, &packet->payload[5], 4);
+      memcpy(&host_params.lanes, &packet->payload[9], 4);
+      success = vault_setup_prekey(&host_params, &packet->payload[13]);
+    }
+    vk_main_send_status(VK_MSG_VAULT_SETUP_RES, packet->id,
+                        success ? "OK" : "FAIL");
+  }
+}
+
+static void vk_main_on_vault_add(const vk_packet_t *packet) {
+  if (vk_main_job_busy(packet, VK_MSG_VAULT_ADD_RES))
+    return;
+  // [NameLen:1][Name:N][SecretLen:1][Secret:M]
+  bool success = false;
+  uint8_t name_len = packet->payload_len > 0 ? packet->payload[0] : 0;
+  uint16_t secret_offset = 1 + name_len;
+  if (secret_offset < packet->payload_len) {
+    uint8_t secret_len = packet->payload[secret_offset];
+    if (secret_offset + 1 + secret_len <= packet->payload_len &&
+        secret_len <= ENTRY_SECRET_MAX) {
+      char name[ENTRY_NAME_MAX];
+      uint8_t safe_name_len =
+          name_len < (ENTRY_NAME_MAX - 1) ? name_len : (ENTRY_NAME_MAX - 1);
+      memcpy(name, &packet->payload[1], safe_name_len);
+      name[safe_name_len] = '\0';
+      success = vault_set(name, &packet->payload[secret_offset + 1],
+                          secret_len);
+    }
+  }
+  vk_main_send_status(VK_MSG_VAULT_ADD_RES, packet->id,
+                      success ? "OK" : "FAIL");
+}
+
+static void vk_main_on_vault_get(const vk_packet_t *packet) {
+  // [NameLen:1][Name:N]
+  if (packet->payload_len < 1 ||
+      1 + packet->payload[0] > packet->payload_len) {
+    vk_main_send_status(VK_MSG_VAULT_GET_RES, packet->id, "FAIL");
+    return;
+  }
+  uint8_t name_len = packet->payload[0];
+  char name[ENTRY_NAME_MAX];
+  uint8_t safe_name_len =
+      name_len < (ENTRY_NAME_MAX - 1) ? name_len : (ENTRY_NAME_MAX - 1);
+  memcpy(name, &packet->payload[1], safe_name_len);
+  name[safe_name_len] = '\0';
+
+  uint8_t secret[ENTRY_SECRET_MAX];
+  uint16_t secret_len = 0;
+  bool success = vault_get_decrypted(name, secret, &secret_len);
+
+  vk_main_send(VK_MSG_VAULT_GET_RES, packet->id, secret, secret_len);
+  vk_crypto_zeroize(secret, sizeof(secret));
+}
+
+static void vk_main_on_vault_del(const vk_packet_t *packet) {
+  if (vk_main_job_busy(packet, VK_MSG_VAULT_DEL_RES))
+    return;
+  // [NameLen:1][Name:N]
+  bool success = false;
+  if (packet->payload_len > 0 &&
+      1 + packet->payload[0] <= packet->payload_len) {
+    uint8_t name_len = packet->payload[0];
+    char name[ENTRY_NAME_MAX];
+    uint8_t safe_name_len =
+        name_len < (ENTRY_NAME_MAX - 1) ? name_len : (ENTRY_NAME_MAX - 1);
+    memcpy(name, &packet->payload[1], safe_name_len);
+    name[safe_name_len] = '\0';
+    success = vault_delete(name);
+  }
+  vk_main_send_status(VK_MSG_VAULT_DEL_RES, packet->id,
+                      success ? "OK" : "FAIL");
+}
+
+static void vk_main_on_vault_list(const vk_packet_t *packet) {
+  // [NameLen:1][Name] per entry, streamed from the vault's own names. Sized
+  // in a first pass, since the header carries the length.
+  const char *name;
+  uint16_t len = 0;
+  int slot = 0, count = 0;
+  while ((name = vault_next_name(&slot)) != NULL) {
+    len += 1 + (uint16_t)strlen(name);
+    count++;
+  }
+  if (!vk_protocol_begin(VK_MSG_VAULT_LIST_RES, packet->id, len))
+    return;
+  for (slot = 0; count > 0; count--) {
+    name = vault_next_name(&slot);
+    uint8_t nlen = (uint8_t)strlen(name);
+    vk_protocol_write(&nlen, 1);
+    vk_protocol_write((const uint8_t *)name, nlen);
+  }
+  vk_protocol_end();
+}
+
+static void vk_main_on_vault_get_multi(const vk_packet_t *packet) {
+  vk_multi_get(packet, VK_PROTO_PAYLOAD_MAX);
+}
+
+static void vk_main_on_get_security(const vk_packet_t *packet) {
+  // [Fails:4][Locked:1][TCost:4][MCost:4][Lanes:4][Salt:16][Mode:1]
+  // [Setup:1]. The KDF fields let the host derive the same key from
+  // the PIN.
+  uint8_t status[5 + 12 + ARGON2_SALT_SIZE + 2];
+  uint32_t fails = vault_get_fail_count();
+  memcpy(status, &fails, 4);
+  status[4] = vault_is_locked() ? 1 : 0;
+  const vk_kdf_params_t *kdf = vault_get_kdf_params();
+  memcpy(&status[5], &kdf->t_cost, 4);
+  memcpy(&status[9], &kdf->m_cost, 4);
+  memcpy(&status[13], &kdf->lanes, 4);
+  memcpy(&status[17], kdf->salt, ARGON2_SALT_SIZE);
+  status[33] = (uint8_t)vault_get_kdf_mode();
+  status[34] = vault_is_setup() ? 1 : 0;
+  vk_main_send(VK_MSG_GET_SECURITY_RES, packet->id, status, sizeof(status));
+}
+
+static void vk_main_on_totp(const vk_packet_t *packet) {
+  // [Timestamp:8][NameLen:1][Name]
+  vault_totp_code_t c;
+  bool ok = false;
+  if (packet->payload_len > 9 && packet->payload[8] < ENTRY_NAME_MAX &&
+      packet->payload_len >= 9 + packet->payload[8]) {
+    uint64_t ts = 0;
+    memcpy(&ts, packet->payload, 8);
+    char name[ENTRY_NAME_MAX] = {0};
+    memcpy(name, &packet->payload[9], packet->payload[8]);
+    ok = vault_totp_generate(name, ts, &c);
+  }
+  if (!ok) {
+    vk_main_send_status(VK_MSG_TOTP_RES, packet->id, "FAIL");
+  } else {
+    char code_str[12];
+    snprintf(code_str, sizeof(code_str), "%0*lu", (int)c.digits,
+             (unsigned long)c.current);
+    vk_main_send(VK_MSG_TOTP_RES, packet->id, (const uint8_t *)code_str,
+                 c.digits);
+  }
+}
+
+static void vk_main_on_totp_add(const vk_packet_t *packet) {
+  if (vk_main_job_busy(packet, VK_MSG_TOTP_ADD_RES))
+    return;
+  bool success = false;
+  if (packet->payload_len > 1) {
+    uint8_t name_len = packet->payload[0];
+    uint16_t seed_off = 1 + name_len + 4;
+    if (name_len > 0 && name_len < ENTRY_NAME_MAX &&
+        packet->payload_len > seed_off &&
+        packet->payload_len - seed_off <= VAULT_TOTP_SEED_MAX) {
+      char name[ENTRY_NAME_MAX] = {0};
+      memcpy(name, &packet->payload[1], name_len);
+      const uint8_t *p = &packet->payload[1 + name_len];
+      vault_totp_t totp = {.alg = p[0], .digits = p[1]};
+      totp.period = (uint16_t)(p[2] | p[3] << 8);
+      totp.seed_len = packet->payload_len - seed_off;
+      memcpy(totp.seed, &packet->payload[seed_off], totp.seed_len);
+      success = vault_totp_set(name, &totp);
+      vk_crypto_zeroize(&totp, sizeof(totp));
+    }
+  }
+  vk_main_send_status(VK_MSG_TOTP_ADD_RES, packet->id, success ? "OK" : "FAIL");
+}
+
+static void vk_main_on_totp_batch(const vk_packet_t *packet) {
+  // [Timestamp:8][PrefixLen:1][Prefix][Start:1], Start optional (0).
+  // [Total:1][Count:1] then per entry from Start [NameLen:1][Name]
+  // [Digits:1][Period:2][Current:4][Next:4]: one round trip for the whole
+  // authenticator view. A host that gets Start + Count < Total asks again
+  // from there.
+  if (packet->payload_len < 9 || packet->payload[8] >= ENTRY_NAME_MAX ||
+      packet->payload_len < 9 + packet->payload[8]) {
+    vk_main_send_status(VK_MSG_TOTP_BATCH_RES, packet->id, "FAIL");
+    return;
+  }
+  uint64_t ts = 0;
+  memcpy(&ts, packet->payload, 8);
+  char prefix[ENTRY_NAME_MAX] = {0};
+  memcpy(prefix, &packet->payload[9], packet->payload[8]);
+  int start = packet->payload_len > 9 + packet->payload[8]
+                  ? packet->payload[9 + packet->payload[8]]
+                  : 0;
+
+  vault_totp_code_t *codes =
+      vk_main_scratch(packet, MAX_ENTRIES * sizeof(vault_totp_code_t));
+  if (!codes)
+    return;
+  int total = vault_totp_batch(prefix, ts, codes, MAX_ENTRIES);
+  int stored = total < MAX_ENTRIES ? total : MAX_ENTRIES;
+  uint16_t len = 2;
+  int count = 0;
+  for (int i = start; i < stored; i++, count++)
+    len += 1 + (uint16_t)strlen(codes[i].name) + 11;
+
+  if (vk_protocol_begin(VK_MSG_TOTP_BATCH_RES, packet->id, len)) {
+    vk_protocol_write((const uint8_t[]){(uint8_t)total, (uint8_t)count}, 2);
+    for (int i = start; i < start + count; i++) {
+      const vault_totp_code_t *c = &codes[i];
+      uint8_t head = (uint8_t)strlen(c->name), tail[11];
+      tail[0] = c->digits;
+      memcpy(&tail[1], &c->period, 2);
+      memcpy(&tail[3], &c->current, 4);
+      memcpy(&tail[7], &c->next, 4);
+      vk_protocol_write(&head, 1);
+      vk_protocol_write((const uint8_t *)c->name, head);
+      vk_protocol_write(tail, sizeof(tail));
+      vk_crypto_zeroize(tail, sizeof(tail));
+    }
+    vk_protocol_end();
+  }
+}
+
+static void vk_main_on_lock(const vk_packet_t *packet) {
+  vault_lock();
+  vk_main_send_status(VK_MSG_LOCK_RES, packet->id, "OK");
+}
+
+static void vk_main_on_cancel(const vk_packet_t *packet) {
+  // Stops a running unlock/setup; its own response reports FAIL
+  vault_kdf_cancel();
+  vk_main_send_status(VK_MSG_CANCEL_RES, packet->id, "OK");
+}
+
+static void vk_main_on_fido_list(const vk_packet_t *packet) {
+  // [RpIdLen:1][RpId][IdLen:1][CredentialId:32] per credential, streamed
+  // from the vault like the entry list
+  const vk_fido_cred_t *cred;
+  uint16_t len = 0;
+  int slot = 0, count = 0;
+  while ((cred = vault_fido_next(&slot)) != NULL) {
+    len += 2 + (uint16_t)strlen(cred->rp_id) + 32;
+    count++;
+  }
+  if (!vk_protocol_begin(VK_MSG_FIDO_LIST_RES, packet->id, len))
+    return;
+  for (slot = 0; count > 0; count--) {
+    cred = vault_fido_next(&slot);
+    uint8_t rplen = (uint8_t)strlen(cred->rp_id), idlen = 32;
+    vk_protocol_write(&rplen, 1);
+    vk_protocol_write((const uint8_t *)cred->rp_id, rplen);
+    vk_protocol_write(&idlen, 1);
+    vk_protocol_write(cred->credential_id, idlen);
+  }
+  vk_protocol_end();
+}
+
+static void vk_main_on_fido_del(const vk_packet_t *packet) {
+  if (vk_main_job_busy(packet, VK_MSG_FIDO_DEL_RES))
+    return;
+  bool success =
+      packet->payload_len == 32 && vault_fido_delete(packet->payload);
+  vk_main_send_status(VK_MSG_FIDO_DEL_RES, packet->id, success ? "OK" : "FAIL");
+}
+
+static void vk_main_on_fido_pin_status(const vk_packet_t *packet) {
+  uint8_t status = vault_fido_has_pin() ? 1 : 0;
+  vk_main_send(VK_MSG_FIDO_PIN_STATUS_RES, packet->id, &status, 1);
+}
+
+static void vk_main_on_fido_set_pin(const vk_packet_t *packet) {
+  if (vk_main_job_busy(packet, VK_MSG_FIDO_SET_PIN_RES))
+    return;
+  bool success =
+      packet->payload_len == 32 && vault_fido_set_pin(packet->payload);
+  vk_main_send_status(VK_MSG_FIDO_SET_PIN_RES, packet->id,
+                      success ? "OK" : "FAIL");
+}
+
+static void vk_main_on_arena_stats(const vk_packet_t *packet) {
+  // [Size:4][Count:1] then per type seen [Source:1][Type:1][Peak:2]
+  uint32_t size = VK_REQ_ARENA_BYTES;
+  uint8_t count = 0;
+  for (int source = 0; source < VK_ARENA_SOURCES; source++) {
+    for (int type = 0; type < 256; type++) {
+      if (vk_arena_peak(source, (uint8_t)type) &&
+          count < UINT8_MAX)
+        count++;
+    }
+  }
+  if (!vk_protocol_begin(VK_MSG_ARENA_STATS_RES, packet->id, 5 + 4 * count))
+    return;
+  vk_protocol_write((const uint8_t *)&size, 4);
+  vk_protocol_write(&count, 1);
+  for (int source = 0; source < VK_ARENA_SOURCES && count; source++) {
+    for (int type = 0; type < 256 && count; type++) {
+      uint16_t peak = vk_arena_peak(source, (uint8_t)type);
+      if (!peak)
+        continue;
+      uint8_t entry[4] = {(uint8_t)source, (uint8_t)type};
+      memcpy(&entry[2], &peak, 2);
+      vk_protocol_write(entry, sizeof(entry));
+      count--;
     }
   }
+  vk_protocol_end();
+}
+
+typedef void (*vk_main_handler_t)(const vk_packet_t *packet);
+
+// Indexed by message type; a type without a handler gets VK_MSG_ERROR so a
+// pipelining host does not wait on it
+static const vk_main_handler_t vk_main_handlers[256] = {
+    [VK_MSG_INFO_REQ] = vk_main_on_info,
+    [VK_MSG_VAULT_UNLOCK_REQ] = vk_main_on_vault_unlock,
+    [VK_MSG_AUTH_REQ] = vk_main_on_auth,
+    [VK_MSG_VAULT_SETUP_REQ] = vk_main_on_vault_setup,
+    [VK_MSG_VAULT_ADD_REQ] = vk_main_on_vault_add,
+    [VK_MSG_VAULT_GET_REQ] = vk_main_on_vault_get,
+    [VK_MSG_VAULT_DEL_REQ] = vk_main_on_vault_del,
+    [VK_MSG_VAULT_LIST_REQ] = vk_main_on_vault_list,
+    [VK_MSG_VAULT_GET_MULTI_REQ] = vk_main_on_vault_get_multi,
+    [VK_MSG_GET_SECURITY_REQ] = vk_main_on_get_security,
+    [VK_MSG_TOTP_REQ] = vk_main_on_totp,
+    [VK_MSG_TOTP_ADD_REQ] = vk_main_on_totp_add,
+    [VK_MSG_TOTP_BATCH_REQ] = vk_main_on_totp_batch,
+    [VK_MSG_LOCK_REQ] = vk_main_on_lock,
+    [VK_MSG_CANCEL_REQ] = vk_main_on_cancel,
+    [VK_MSG_FIDO_LIST_REQ] = vk_main_on_fido_list,
+    [VK_MSG_FIDO_DEL_REQ] = vk_main_on_fido_del,
+    [VK_MSG_FIDO_PIN_STATUS_REQ] = vk_main_on_fido_pin_status,
+    [VK_MSG_FIDO_SET_PIN_REQ] = vk_main_on_fido_set_pin,
+    [VK_MSG_ARENA_STATS_REQ] = vk_main_on_arena_stats,
+};
+
+// Handles queued requests in the order they arrived, each tagged with its
+// id, so the host can keep several in flight. Device-mode unlock and setup
+// answer when their job finishes, after requests that came later. A request
+// is only taken once the last reply has left the outbox; until then it
+// waits in the ring, and the host's writes stall once that fills.
+static void vk_main_cdc_task(void) {
+  vk_packet_t packet;
+  // The ring may have been full when the last data came in
+  vk_main_cdc_receive();
+  while (vk_protocol_tx_space() == VK_PROTO_TX_RING &&
+         vk_protocol_rx_next(&packet)) {
+    vault_update_activity();
+    vk_main_handler_t handle = vk_main_handlers[packet.type];
+    if (handle)
+      handle(&packet);
+    else
+      vk_main_send_status(VK_MSG_ERROR, packet.id, "UNSUPPORTED");
+    vk_arena_release(VK_ARENA_CDC, (uint8_t)packet.type);
+  }
+  vk_main_cdc_flush();
 }
 
 // Invoked when cdc when line state changed e.g connected/disconnected
@@ -342,12 +657,10 @@ void tud_hid_set_report_cb(uint8_t itf, uint8_t report_id,
   (void)report_id;
   (void)report_type;
 
-  // Handle FIDO HID packets
-  // FIDO packets are 64 bytes
-  if (bufsize == 64) {
-    vault_update_activity();
-    vk_fido_handle_report(buffer);
-  }
+  // FIDO packets are 64 bytes. Only queued here; vk_fido_task handles
+  // them from the main loop.
+  if (bufsize == 64)
+    vk_fido_receive(buffer);
 }
 
 int main(void) {
@@ -365,8 +678,15 @@ int main(void) {
   sleep_ms(500);           // Verify boot delay
   ws2812_put_rgb(0, 0, 0); // Off
 
+  vk_protocol_init();
+  vk_protocol_set_sink(vk_main_cdc_sink);
+  vk_protocol_set_wait(vk_main_cdc_wait);
   tusb_init();
-  vault_init();
+  // No device secret in OTP (or no KDF calibration) leaves the vault refusing
+  // to unlock or set up; say so instead of failing every attempt silently.
+  // The same goes for a TRNG that fails its start-up health test.
+  bool trng_ok = vk_crypto_trng_check();
+  vault_fault = !vault_init() || !trng_ok;
 
   // GP21 Button
   gpio_init(PIN_BUTTON);
@@ -378,6 +698,10 @@ int main(void) {
 
   while (1) {
     tud_task(); // tinyusb device task
+    vk_job_task(board_millis());  // One slice of any running crypto job
+    vk_main_cdc_task();           // Queued requests, then replies out
+    vk_fido_task(board_millis()); // Same for FIDO HID reports
+    vk_pool_task();               // Otherwise, precompute keys while idle
     led_task();
     vault_check_autolock();
 
@@ -3,15 +3,11 @@
 #include "hardware/flash.h"
 #include "hardware/sync.h"
 #include "pico/stdlib.h"
-#include "tusb.h"
 #include "vk_crypto.h"
 #include "vk_fido.h"
+#include "vk_totp.h"
 #include <string.h>
 
-// Define flash offset for the vault (last 64KB of 2MB flash for compatibility)
-// Many Zero boards only have 2MB or 4MB. 16MB was too aggressive and likely crashed the board.
-#define FLASH_TARGET_OFFSET (1024 * 1024 * 2 - 65536)
-
 typedef struct {
   security_state_t security;
   vault_entry_t entries[MAX_ENTRIES];
@@ -19,44 +15,111 @@ typedef struct {
 } vault_storage_t;
 
 static vault_storage_t vault_data;
+static bool vault_ready = false; // Device secret provisioned and locked
 static uint8_t session_key[32];
 static bool session_active = false;
 static uint32_t last_activity_ms = 0;
 static uint32_t autolock_timeout_ms = 300000; // 5 minutes default
 
+// HMAC midstates of TOTP entries, by slot: computed on first use and kept
+// until the entry changes or the vault locks
+static vk_totp_key_t totp_keys[MAX_ENTRIES];
+static bool totp_key_valid[MAX_ENTRIES];
+
+static void vault_totp_forget(int slot) {
+  vk_crypto_zeroize(&totp_keys[slot], sizeof(totp_keys[slot]));
+  totp_key_valid[slot] = false;
+}
+
 #define VAULT_STORAGE_SIZE sizeof(vault_data)
 #define VAULT_ERASE_SIZE                                                       \
   ((VAULT_STORAGE_SIZE / FLASH_SECTOR_SIZE + 1) * FLASH_SECTOR_SIZE)
 
+_Static_assert(VAULT_ERASE_SIZE <= VAULT_FLASH_SIZE,
+               "vault image outgrew its flash region");
+
+// Core 1 only runs while an Argon2 slice is being filled (argon2.c) and the
+// slice returns before the main loop gets here, so disabling interrupts on
+// core 0 is enough to keep both cores off the flash during erase/program.
+// Requests that end up here are still refused while a job is pending
+// (main.c, vk_fido.c) so what the job is about to store is not rewritten
+// under it.
 static void vault_sync_to_flash(void) {
   const uint8_t *flash_target_contents =
-      (const uint8_t *)(XIP_BASE + FLASH_TARGET_OFFSET);
+      (const uint8_t *)(XIP_BASE + VAULT_FLASH_OFFSET);
 
   if (memcmp(&vault_data, flash_target_contents, VAULT_STORAGE_SIZE) == 0) {
     return;
   }
 
   uint32_t ints = save_and_disable_interrupts();
-  flash_range_erase(FLASH_TARGET_OFFSET, VAULT_ERASE_SIZE);
-  flash_range_program(FLASH_TARGET_OFFSET, (const uint8_t *)&vault_data,
+  flash_range_erase(VAULT_FLASH_OFFSET, VAULT_ERASE_SIZE);
+  flash_range_program(VAULT_FLASH_OFFSET, (const uint8_t *)&vault_data,
                       VAULT_STORAGE_SIZE);
   restore_interrupts(ints);
 }
 
 static void vault_load_from_flash(void) {
   const uint8_t *flash_target_contents =
-      (const uint8_t *)(XIP_BASE + FLASH_TARGET_OFFSET);
+      (const uint8_t *)(XIP_BASE + VAULT_FLASH_OFFSET);
   memcpy(&vault_data, flash_target_contents, VAULT_STORAGE_SIZE);
 }
 
+// KDF calibration runs Argon2 probes for up to a second or so, so it is a
+// main-loop job like unlock. The parameters and salt are stored when it
+// finishes; until then setup is refused.
+static struct {
+  vk_job_t job;
+  vk_kdf_calibration_t cal;
+  vk_kdf_params_t params;
+} calibration;
+
+static vk_job_status_t vault_calibrate_step(vk_job_t *job) {
+  return vk_crypto_kdf_calibrate_step(&calibration.cal, &job->percent);
+}
+
+static void vault_calibrate_finish(vk_job_t *job, vk_job_status_t status) {
+  (void)job;
+  if (status == VK_JOB_DONE) {
+    vault_data.security.kdf = calibration.params;
+    vault_sync_to_flash();
+  } else {
+    vk_crypto_kdf_calibrate_abort(&calibration.cal);
+  }
+  vk_crypto_zeroize(&calibration, sizeof(calibration));
+}
+
+// False if it could not start: no entropy for the salt, or another job
+static bool vault_calibrate_start(void) {
+  if (vk_job_busy() ||
+      !vk_crypto_kdf_calibrate_start(&calibration.cal, VK_KDF_TARGET_MS,
+                                     &calibration.params))
+    return false;
+  calibration.job.step = vault_calibrate_step;
+  calibration.job.finish = vault_calibrate_finish;
+  if (!vk_job_start(&calibration.job, board_millis())) {
+    vk_crypto_kdf_calibrate_abort(&calibration.cal);
+    return false;
+  }
+  return true;
+}
+
 bool vault_init(void) {
   vault_load_from_flash();
 
+  bool ok = true;
   if (vault_data.security.magic != SECURITY_STATE_MAGIC) {
-    vault_format();
+    ok = vault_format();
+  } else if (vault_data.security.kdf.m_cost == 0) {
+    // Written before KDF calibration existed, or its calibration never
+    // finished
+    ok = vault_calibrate_start();
   }
 
-  return true;
+  // Needed by every unlock; burns OTP once on a fresh chip. Without it the
+  // vault refuses to unlock or set up.
+  vault_ready = vk_crypto_device_secret_init();
+  return vault_ready && ok;
 }
 
 void vault_set_session_key(const uint8_t *key) {
@@ -75,15 +138,44 @@ void vault_lock(void) {
   if (session_active) {
     vk_crypto_zeroize(session_key, 32);
     session_active = false;
+    vk_crypto_zeroize(totp_keys, sizeof(totp_keys));
+    memset(totp_key_valid, 0, sizeof(totp_key_valid));
     vk_fido_reset_session();
   }
 }
 
-bool vault_unlock(const char *pin) {
-  // Placeholder: Secure unlock implementation required
-  // Validate PIN against stored hash (Argon2)
-  (void)pin;
-  return false;
+// Shared tail of both unlock modes: device-bound step, canary check and
+// the retry counter
+static bool vault_unlock_with_prekey(const uint8_t prekey[32]) {
+  if (!vault_ready || !vault_is_setup() || vault_is_locked())
+    return false;
+
+  // Charge the attempt before checking it, so cutting power mid-check
+  // cannot skip the counter
+  vault_data.security.fail_count++;
+  vault_sync_to_flash();
+
+  uint8_t key[32];
+  bool success = vk_crypto_device_bind(prekey, key) && vault_verify_pin(key);
+  if (success) {
+    vault_set_session_key(key);
+  } else {
+    vault_data.security.fail_count--;
+  }
+  vk_crypto_zeroize(key, sizeof(key));
+
+  vault_report_auth_result(success);
+  return success;
+}
+
+bool vault_unlock_prekey(const uint8_t prekey[32]) {
+  if (vault_data.security.kdf_mode != VAULT_KDF_HOST)
+    return false;
+  return vault_unlock_with_prekey(prekey);
+}
+
+vault_kdf_mode_t vault_get_kdf_mode(void) {
+  return (vault_kdf_mode_t)vault_data.security.kdf_mode;
 }
 
 void vault_check_autolock(void) {
@@ -112,6 +204,131 @@ bool vault_verify_pin(const uint8_t *key) {
   return false;
 }
 
+bool vault_setup_canary(const uint8_t *key) {
+  uint8_t iv[12] = {0}; // Fresh key per setup, so a fixed IV is safe here
+  return vk_crypto_encrypt(key, (const uint8_t *)"VK_VALID_LOGIN!!", 16, iv,
+                           vault_data.security.canary_tag,
+                           vault_data.security.canary);
+}
+
+static bool vault_setup_with_prekey(const uint8_t prekey[32]) {
+  uint8_t key[32];
+  bool success = vk_crypto_device_bind(prekey, key) && vault_setup_canary(key);
+  if (success) {
+    vault_data.security.fail_count = 0;
+    vault_data.security.is_locked = false;
+    vault_sync_to_flash();
+    vault_set_session_key(key);
+  }
+  vk_crypto_zeroize(key, sizeof(key));
+  return success;
+}
+
+// Device-mode Argon2 runs as a job (see vault_unlock_start); this is its
+// state between main-loop slices
+typedef struct {
+  vk_job_t job;
+  vk_kdf_job_t kdf;
+  uint8_t prekey[32];
+  bool setup;
+  vault_done_fn done;
+  vault_progress_fn progress;
+  void *user;
+} vault_kdf_task_t;
+
+static vault_kdf_task_t kdf_task;
+
+static vk_job_status_t vault_kdf_step(vk_job_t *job) {
+  return vk_crypto_kdf_step(&kdf_task.kdf, &job->percent);
+}
+
+static void vault_kdf_notify(vk_job_t *job) {
+  if (kdf_task.progress)
+    kdf_task.progress(job->percent, kdf_task.user);
+}
+
+static void vault_kdf_finish(vk_job_t *job, vk_job_status_t status) {
+  (void)job;
+  bool success = false;
+  if (status != VK_JOB_DONE) {
+    vk_crypto_kdf_abort(&kdf_task.kdf);
+  } else if (kdf_task.setup) {
+    // Another setup may have completed while the KDF ran
+    if (!vault_is_setup()) {
+      vault_data.security.kdf_mode = VAULT_KDF_DEVICE;
+      success = vault_setup_with_prekey(kdf_task.prekey);
+    }
+  } else {
+    success = vault_unlock_with_prekey(kdf_task.prekey);
+  }
+
+  vault_done_fn done = kdf_task.done;
+  void *user = kdf_task.user;
+  vk_crypto_zeroize(&kdf_task, sizeof(kdf_task));
+  if (done)
+    done(success, user);
+}
+
+static bool vault_kdf_start(bool setup, const char *pin, vault_done_fn done,
+                            vault_progress_fn progress, void *user) {
+  if (!vault_ready || vk_job_busy())
+    return false;
+  if (!vk_crypto_kdf_start(&kdf_task.kdf, pin, &vault_data.security.kdf,
+                           kdf_task.prekey))
+    return false;
+
+  kdf_task.setup = setup;
+  kdf_task.done = done;
+  kdf_task.progress = progress;
+  kdf_task.user = user;
+  kdf_task.job.step = vault_kdf_step;
+  kdf_task.job.finish = vault_kdf_finish;
+  kdf_task.job.notify = vault_kdf_notify;
+  if (!vk_job_start(&kdf_task.job, board_millis())) {
+    vk_crypto_kdf_abort(&kdf_task.kdf);
+    vk_crypto_zeroize(&kdf_task, sizeof(kdf_task));
+    return false;
+  }
+  return true;
+}
+
+bool vault_unlock_start(const char *pin, vault_done_fn done,
+                        vault_progress_fn progress, void *user) {
+  if (vault_data.security.kdf_mode != VAULT_KDF_DEVICE || !vault_is_setup() ||
+      vault_is_locked())
+    return false;
+  return vault_kdf_start(false, pin, done, progress, user);
+}
+
+void vault_kdf_cancel(void) { vk_job_cancel(&kdf_task.job); }
+
+bool vault_setup_start(const char *pin, vault_done_fn done,
+                       vault_progress_fn progress, void *user) {
+  if (vault_is_setup())
+    return false;
+  if (vault_data.security.kdf.m_cost == 0) {
+    // Calibration failed; try again so a later setup can succeed
+    vault_calibrate_start();
+    return false;
+  }
+  return vault_kdf_start(true, pin, done, progress, user);
+}
+
+bool vault_setup_prekey(const vk_kdf_params_t *host_params,
+                        const uint8_t prekey[32]) {
+  // The device salt comes with calibration
+  if (!vault_ready || vault_is_setup() ||
+      vault_data.security.kdf.m_cost == 0 || host_params->m_cost == 0 ||
+      host_params->t_cost == 0 || host_params->lanes == 0)
+    return false;
+
+  vault_data.security.kdf_mode = VAULT_KDF_HOST;
+  vault_data.security.kdf.t_cost = host_params->t_cost;
+  vault_data.security.kdf.m_cost = host_params->m_cost;
+  vault_data.security.kdf.lanes = host_params->lanes;
+  return vault_setup_with_prekey(prekey);
+}
+
 bool vault_is_setup(void) {
   uint8_t zero[16] = {0};
   return memcmp(vault_data.security.canary, zero, 16) != 0;
@@ -121,16 +338,19 @@ bool vault_is_locked(void) { return vault_data.security.is_locked; }
 
 uint32_t vault_get_fail_count(void) { return vault_data.security.fail_count; }
 
+const vk_kdf_params_t *vault_get_kdf_params(void) {
+  return &vault_data.security.kdf;
+}
+
 void vault_report_auth_result(bool success) {
   if (success) {
     vault_data.security.fail_count = 0;
     vault_data.security.is_locked = false;
   } else {
     vault_data.security.fail_count++;
-    if (vault_data.security.fail_count >= 5) {
+    if (vault_data.security.fail_count >= VAULT_MAX_FAILS) {
       vault_data.security.is_locked = true;
-      vk_crypto_zeroize(session_key, sizeof(session_key));
-      session_active = false;
+      vault_lock();
     }
   }
   vault_sync_to_flash();
@@ -147,7 +367,16 @@ int vault_list(char names[][ENTRY_NAME_MAX], int max_count) {
   return count;
 }
 
-bool vault_set(const char *name, const uint8_t *secret, uint16_t len) {
+const char *vault_next_name(int *slot) {
+  for (; *slot < MAX_ENTRIES; (*slot)++) {
+    if (vault_data.entries[*slot].occupied)
+      return vault_data.entries[(*slot)++].name;
+  }
+  return NULL;
+}
+
+static bool vault_set_typed(const char *name, vault_entry_type_t type,
+                            const uint8_t *secret, uint16_t len) {
   if (len > ENTRY_SECRET_MAX)
     return false;
 
@@ -166,6 +395,7 @@ bool vault_set(const char *name, const uint8_t *secret, uint16_t len) {
   if (slot == -1)
     return false;
 
+  vault_totp_forget(slot);
   strncpy(vault_data.entries[slot].name, name, ENTRY_NAME_MAX);
 
   // Use Real Session Key
@@ -175,7 +405,8 @@ bool vault_set(const char *name, const uint8_t *secret, uint16_t len) {
 
   uint8_t iv[12];
   // Real random IV from TRNG
-  vk_crypto_get_random(iv, 12);
+  if (!vk_crypto_get_random(iv, 12))
+    return false;
   memcpy(vault_data.entries[slot].nonce, iv, 12);
 
   if (!vk_crypto_encrypt(master_key, secret, len, iv,
@@ -185,11 +416,38 @@ bool vault_set(const char *name, const uint8_t *secret, uint16_t len) {
   }
 
   vault_data.entries[slot].secret_len = len;
+  vault_data.entries[slot].type = (uint8_t)type;
   vault_data.entries[slot].occupied = true;
   vault_sync_to_flash();
   return true;
 }
 
+bool vault_set(const char *name, const uint8_t *secret, uint16_t len) {
+  return vault_set_typed(name, VAULT_ENTRY_SECRET, secret, len);
+}
+
+bool vault_totp_set(const char *name, const vault_totp_t *totp) {
+  uint8_t blob[ENTRY_SECRET_MAX];
+  vk_totp_key_t check;
+
+  if (totp->seed_len == 0 || totp->seed_len > VAULT_TOTP_SEED_MAX ||
+      !vk_totp_key_init(&check, (vk_totp_alg_t)totp->alg, totp->digits,
+                        totp->period, totp->seed, totp->seed_len)) {
+    vk_crypto_zeroize(&check, sizeof(check));
+    return false;
+  }
+  vk_crypto_zeroize(&check, sizeof(check));
+
+  blob[0] = totp->alg;
+  blob[1] = totp->digits;
+  blob[2] = (uint8_t)totp->period;
+  blob[3] = (uint8_t)(totp->period >> 8);
+  memcpy(&blob[4], totp->seed, totp->seed_len);
+  bool ok = vault_set_typed(name, VAULT_ENTRY_TOTP, blob, 4 + totp->seed_len);
+  vk_crypto_zeroize(blob, sizeof(blob));
+  return ok;
+}
+
 bool vault_get(const char *name, vault_entry_t *out_entry) {
   for (int i = 0; i < MAX_ENTRIES; i++) {
     if (vault_data.entries[i].occupied &&
@@ -224,11 +482,84 @@ bool vault_get_decrypted(const char *name, uint8_t *out_secret,
   return false;
 }
 
+// Midstates of a TOTP entry, decrypted and set up on first use
+static const vk_totp_key_t *vault_totp_key(int slot) {
+  const vault_entry_t *e = &vault_data.entries[slot];
+  const uint8_t *master_key = vault_get_session_key();
+  if (!master_key || e->type != VAULT_ENTRY_TOTP)
+    return NULL;
+
+  if (!totp_key_valid[slot]) {
+    uint8_t blob[ENTRY_SECRET_MAX];
+    bool ok = e->secret_len > 4 &&
+              vk_crypto_decrypt(master_key, e->encrypted_secret,
+                                e->secret_len, e->nonce, e->tag, blob) &&
+              vk_totp_key_init(&totp_keys[slot], (vk_totp_alg_t)blob[0],
+                               blob[1], (uint16_t)(blob[2] | blob[3] << 8),
+                               &blob[4], e->secret_len - 4);
+    vk_crypto_zeroize(blob, sizeof(blob));
+    if (!ok) {
+      vault_totp_forget(slot);
+      return NULL;
+    }
+    totp_key_valid[slot] = true;
+  }
+  return &totp_keys[slot];
+}
+
+static void vault_totp_fill(int slot, const vk_totp_key_t *k,
+                            uint64_t timestamp, vault_totp_code_t *out) {
+  memcpy(out->name, vault_data.entries[slot].name, ENTRY_NAME_MAX);
+  out->digits = k->digits;
+  out->period = k->period;
+  out->current = vk_totp_code(k, timestamp);
+  out->next = vk_totp_code(k, timestamp + k->period);
+}
+
+bool vault_totp_generate(const char *name, uint64_t timestamp,
+                         vault_totp_code_t *out) {
+  for (int i = 0; i < MAX_ENTRIES; i++) {
+    if (vault_data.entries[i].occupied &&
+        strcmp(vault_data.entries[i].name, name) == 0) {
+      const vk_totp_key_t *k = vault_totp_key(i);
+      if (!k)
+        return false;
+      vault_totp_fill(i, k, timestamp, out);
+      return true;
+    }
+  }
+  return false;
+}
+
+int vault_totp_batch(const char *prefix, uint64_t timestamp,
+                     vault_totp_code_t *out, int max) {
+  size_t prefix_len = strlen(prefix);
+  int count = 0;
+
+  if (!vault_has_session_key())
+    return 0;
+
+  for (int i = 0; i < MAX_ENTRIES; i++) {
+    const vault_entry_t *e = &vault_data.entries[i];
+    if (!e->occupied || e->type != VAULT_ENTRY_TOTP ||
+        strncmp(e->name, prefix, prefix_len) != 0)
+      continue;
+    const vk_totp_key_t *k = vault_totp_key(i);
+    if (!k)
+      continue;
+    if (count < max)
+      vault_totp_fill(i, k, timestamp, &out[count]);
+    count++;
+  }
+  return count;
+}
+
 bool vault_delete(const char *name) {
   for (int i = 0; i < MAX_ENTRIES; i++) {
     if (vault_data.entries[i].occupied &&
         strcmp(vault_data.entries[i].name, name) == 0) {
       vault_data.entries[i].occupied = false;
+      vault_totp_forget(i);
       vault_sync_to_flash();
       return true;
     }
@@ -236,14 +567,20 @@ bool vault_delete(const char *name) {
   return false;
 }
 
-void vault_format(void) {
+bool vault_format(void) {
   memset(&vault_data, 0, sizeof(vault_data));
+  vk_crypto_zeroize(totp_keys, sizeof(totp_keys));
+  memset(totp_key_valid, 0, sizeof(totp_key_valid));
   vault_data.security.magic = SECURITY_STATE_MAGIC;
 
   // Set up a default canary for the first "login" if needed,
   // but usually UI should do this on first set-pin.
   // For now, let's just sync the zeroed state.
   vault_sync_to_flash();
+
+  // Pick the strongest Argon2id parameters this device unlocks within the
+  // latency target; a fresh salt comes with them
+  return vault_calibrate_start();
 }
 
 bool vault_fido_add(const vk_fido_cred_t *cred) {
@@ -296,12 +633,21 @@ int vault_fido_list_all(vk_fido_cred_t *out_creds, int max_count) {
   return count;
 }
 
+const vk_fido_cred_t *vault_fido_next(int *slot) {
+  for (; *slot < MAX_FIDO_CREDS; (*slot)++) {
+    if (vault_data.fido_creds[*slot].occupied)
+      return &vault_data.fido_creds[(*slot)++];
+  }
+  return NULL;
+}
+
 bool vault_fido_delete(const uint8_t *cred_id) {
   for (int i = 0; i < MAX_FIDO_CREDS; i++) {
     if (vault_data.fido_creds[i].occupied &&
         memcmp(vault_data.fido_creds[i].credential_id, cred_id,
                FIDO_CREDID_MAX) == 0) {
       vault_data.fido_creds[i].occupied = false;
+      vk_fido_forget_key(cred_id);
       vault_sync_to_flash();
       return true;
     }
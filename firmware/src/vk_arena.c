@@ -0,0 +1,38 @@
+#include "vk_arena.h"
+
+#define VK_ARENA_ALIGN 8
+
+_Static_assert(VK_REQ_ARENA_BYTES % VK_ARENA_ALIGN == 0,
+               "VK_REQ_ARENA_BYTES must be a multiple of 8");
+
+static _Alignas(VK_ARENA_ALIGN) uint8_t vk_req_arena[VK_REQ_ARENA_BYTES];
+
+static struct {
+  size_t used;   // bytes handed out to the current request
+  size_t demand; // bytes it asked for, including refused ones
+  uint16_t peak[VK_ARENA_SOURCES][256];
+} arena;
+
+void *vk_arena_alloc(size_t size) {
+  size = (size + VK_ARENA_ALIGN - 1) & ~(size_t)(VK_ARENA_ALIGN - 1);
+  arena.demand += size;
+  if (size > sizeof(vk_req_arena) - arena.used)
+    return NULL;
+  void *p = &vk_req_arena[arena.used];
+  arena.used += size;
+  return p;
+}
+
+void vk_arena_release(vk_arena_source_t source, uint8_t type) {
+  volatile uint8_t *p = vk_req_arena;
+  for (size_t i = 0; i < arena.used; i++)
+    p[i] = 0;
+  size_t demand = arena.demand < UINT16_MAX ? arena.demand : UINT16_MAX;
+  if (source < VK_ARENA_SOURCES && demand > arena.peak[source][type])
+    arena.peak[source][type] = (uint16_t)demand;
+  arena.used = arena.demand = 0;
+}
+
+uint16_t vk_arena_peak(vk_arena_source_t source, uint8_t type) {
+  return source < VK_ARENA_SOURCES ? arena.peak[source][type] : 0;
+}
@@ -1,254 +0,0 @@
-#include "vk_argon2.h"
-#include <string.h>
-
-/* BLAKE2b Implementation */
-static const uint64_t blake2b_iv[8] = {
-    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
-    0xa54ff53a5f1d36f1ULL, 0x510e527fad682d1aULL, 0x9b05688c2b3e6c1fULL,
-    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
-
-typedef struct {
-  uint64_t h[8];
-  uint64_t t[2];
-  uint64_t f[2];
-  uint8_t buf[128];
-  size_t buflen;
-} blake2b_ctx;
-
-static inline uint64_t rotr64(uint64_t x, int n) {
-  return (x >> n) | (x << (64 - n));
-}
-
-static void blake2b_compress(blake2b_ctx *ctx, bool last) {
-  uint64_t v[16];
-  uint64_t m[16];
-  static const uint8_t sigma[12][16] = {
-      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-      {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
-      {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
-      {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
-      {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
-      {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
-      {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
-      {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
-      {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
-      {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
-      {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
-      {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
-
-  for (int i = 0; i < 8; i++)
-    v[i] = ctx->h[i];
-  for (int i = 0; i < 8; i++)
-    v[i + 8] = blake2b_iv[i];
-
-  v[12] ^= ctx->t[0];
-  v[13] ^= ctx->t[1];
-  if (last)
-    v[14] ^= 0xFFFFFFFFFFFFFFFFULL;
-
-  for (int i = 0; i < 16; i++) {
-    m[i] = ((uint64_t *)ctx->buf)[i];
-  }
-
-#define G(a, b, c, d, x, y)                                                    \
-  do {                                                                         \
-    a = a + b + x;                                                             \
-    d = rotr64(d ^ a, 32);                                                     \
-    c = c + d;                                                                 \
-    b = rotr64(b ^ c, 24);                                                     \
-    a = a + b + y;                                                             \
-    d = rotr64(d ^ a, 16);                                                     \
-    c = c + d;                                                                 \
-    b = rotr64(b ^ c, 63);                                                     \
-  } while (0)
-
-  for (int r = 0; r < 12; r++) {
-    G(v[0], v[4], v[8], v[12], m[sigma[r][0]], m[sigma[r][1]]);
-    G(v[1], v[5], v[9], v[13], m[sigma[r][2]], m[sigma[r][3]]);
-    G(v[2], v[6], v[10], v[14], m[sigma[r][4]], m[sigma[r][5]]);
-    G(v[3], v[7], v[11], v[15], m[sigma[r][6]], m[sigma[r][7]]);
-    G(v[0], v[5], v[10], v[15], m[sigma[r][8]], m[sigma[r][9]]);
-    G(v[1], v[6], v[11], v[12], m[sigma[r][10]], m[sigma[r][11]]);
-    G(v[2], v[7], v[8], v[13], m[sigma[r][12]], m[sigma[r][13]]);
-    G(v[3], v[4], v[9], v[14], m[sigma[r][14]], m[sigma[r][15]]);
-  }
-
-  for (int i = 0; i < 8; i++)
-    ctx->h[i] ^= v[i] ^ v[i + 8];
-}
-
-static void blake2b_init(blake2b_ctx *ctx, size_t outlen) {
-  memset(ctx, 0, sizeof(*ctx));
-  for (int i = 0; i < 8; i++)
-    ctx->h[i] = blake2b_iv[i];
-  ctx->h[0] ^= 0x01010000 ^ outlen;
-}
-
-static void blake2b_update(blake2b_ctx *ctx, const void *in, size_t inlen) {
-  const uint8_t *p = (const uint8_t *)in;
-  while (inlen > 0) {
-    size_t left = ctx->buflen;
-    size_t fill = 128 - left;
-    if (inlen > fill) {
-      memcpy(ctx->buf + left, p, fill);
-      ctx->t[0] += 128;
-      if (ctx->t[0] < 128)
-        ctx->t[1]++;
-      blake2b_compress(ctx, false);
-      p += fill;
-      inlen -= fill;
-      ctx->buflen = 0;
-    } else {
-      memcpy(ctx->buf + left, p, inlen);
-      ctx->buflen += inlen;
-      inlen = 0;
-    }
-  }
-}
-
-static void blake2b_final(blake2b_ctx *ctx, void *out, size_t outlen) {
-  ctx->t[0] += ctx->buflen;
-  if (ctx->t[0] < ctx->buflen)
-    ctx->t[1]++;
-  blake2b_compress(ctx, true);
-  memcpy(out, ctx->h, outlen);
-}
-
-/* Argon2 core types */
-#define ARGON2_BLOCK_SIZE 1024
-#define ARGON2_QWORDS_IN_BLOCK (ARGON2_BLOCK_SIZE / 8)
-
-typedef struct {
-  uint64_t v[ARGON2_QWORDS_IN_BLOCK];
-} argon2_block;
-
-static inline uint64_t fBlaMka(uint64_t x, uint64_t y) {
-  const uint64_t m = 0xFFFFFFFFULL;
-  const uint64_t xy = (x & m) * (y & m);
-  return x + y + 2 * xy;
-}
-
-static void argon2_fill_block(const argon2_block *prev, const argon2_block *ref,
-                              argon2_block *next, bool with_xor) {
-  argon2_block blockR, block_tmp;
-  memcpy(&blockR, ref, sizeof(argon2_block));
-  for (int i = 0; i < ARGON2_QWORDS_IN_BLOCK; i++)
-    blockR.v[i] ^= prev->v[i];
-  memcpy(&block_tmp, &blockR, sizeof(argon2_block));
-
-  if (with_xor) {
-    for (int i = 0; i < ARGON2_QWORDS_IN_BLOCK; i++)
-      block_tmp.v[i] ^= next->v[i];
-  }
-
-#define G2(a, b, c, d)                                                         \
-  do {                                                                         \
-    a = fBlaMka(a, b);                                                         \
-    d = rotr64(d ^ a, 32);                                                     \
-    c = fBlaMka(c, d);                                                         \
-    b = rotr64(b ^ c, 24);                                                     \
-    a = fBlaMka(a, b);                                                         \
-    d = rotr64(d ^ a, 16);                                                     \
-    c = fBlaMka(c, d);                                                         \
-    b = rotr64(b ^ c, 63);                                                     \
-  } while (0)
-
-  // Columns
-  for (int i = 0; i < 8; i++) {
-    uint64_t *v = &blockR.v[16 * i];
-    G2(v[0], v[4], v[8], v[12]);
-    G2(v[1], v[5], v[9], v[13]);
-    G2(v[2], v[6], v[10], v[14]);
-    G2(v[3], v[7], v[11], v[15]);
-    G2(v[0], v[5], v[10], v[15]);
-    G2(v[1], v[6], v[11], v[12]);
-    G2(v[2], v[7], v[8], v[13]);
-    G2(v[3], v[4], v[9], v[14]);
-  }
-  // Rows
-  for (int i = 0; i < 8; i++) {
-    uint64_t *v = blockR.v;
-    G2(v[2 * i], v[2 * i + 1], v[2 * i + 16], v[2 * i + 17]);
-    G2(v[2 * i + 32], v[2 * i + 33], v[2 * i + 48], v[2 * i + 49]);
-    G2(v[2 * i + 64], v[2 * i + 65], v[2 * i + 80], v[2 * i + 81]);
-    G2(v[2 * i + 96], v[2 * i + 97], v[2 * i + 112], v[2 * i + 113]);
-    // Diagonal-like permutation as per spec
-    // Wait, the row pass is slightly different. Re-tracing ref.c
-  }
-
-  // Final XOR
-  for (int i = 0; i < ARGON2_QWORDS_IN_BLOCK; i++)
-    next->v[i] = block_tmp.v[i] ^ blockR.v[i];
-}
-
-bool vk_argon2id(const char *pwd, uint32_t pwdlen, const uint8_t *salt,
-                 uint32_t saltlen, uint32_t t_cost, uint32_t m_cost,
-                 uint8_t *out_key) {
-  if (m_cost < 8)
-    return false; // Argon2 requires at least 8 blocks for 4 lanes
-
-  // For simplicity on hardware, we assume 1 lane (parallelism = 1)
-  uint32_t lanes = 1;
-  uint32_t heads = 1; // threads
-
-  // Initial Hash (H0)
-  blake2b_ctx blake_ctx;
-  uint8_t h0[64];
-  uint32_t outlen = 32;
-
-  blake2b_init(&blake_ctx, 64);
-  uint32_t val;
-  val = lanes;
-  blake2b_update(&blake_ctx, &val, 4);
-  val = outlen;
-  blake2b_update(&blake_ctx, &val, 4);
-  val = m_cost;
-  blake2b_update(&blake_ctx, &val, 4);
-  val = t_cost;
-  blake2b_update(&blake_ctx, &val, 4);
-  val = 0x13;
-  blake2b_update(&blake_ctx, &val, 4); // Version 1.3
-  val = 2;
-  blake2b_update(&blake_ctx, &val, 4); // Type Argon2id
-
-  val = pwdlen;
-  blake2b_update(&blake_ctx, &val, 4);
-  blake2b_update(&blake_ctx, pwd, pwdlen);
-  val = saltlen;
-  blake2b_update(&blake_ctx, &val, 4);
-  blake2b_update(&blake_ctx, salt, saltlen);
-
-  // Clear optional fields
-  val = 0;
-  blake2b_update(&blake_ctx, &val, 4); // secret
-  val = 0;
-  blake2b_update(&blake_ctx, &val, 4); // ad
-
-  blake2b_final(&blake_ctx, h0, 64);
-
-  // Allocate memory block (1024 bytes each)
-  // RP2350 has 520KB. m_cost KiB is fine.
-  argon2_block *memory = (argon2_block *)malloc(m_cost * sizeof(argon2_block));
-  if (!memory)
-    return false;
-
-  // Initialize blocks 0 and 1
-  for (uint32_t i = 0; i < 2; i++) {
-    uint8_t block_init[72];
-    memcpy(block_init, h0, 64);
-    uint32_t zero = 0;
-    memcpy(block_init + 64, &zero, 4);
-    memcpy(block_init + 68, &i, 4);
-
-    uint8_t long_hash[1024];
-    // Custom Blake2b-long would go here, simplified:
-    blake2b(long_hash, 1024, block_init, 72, NULL,
-            0); // Need blake2b for large out
-    // Re-implementing simplified Argon2 initialization...
-  }
-
-  // This is getting complex for a "lite" implementation.
-  // I will use a more robust reference-based approach but simplified.
-  free(memory);
-  return false;
-}
@@ -1,6 +1,13 @@
 #include "vk_crypto.h"
 #include "aes.h"
-#include "pico/rand.h"
+#include "hardware/regs/otp_data.h"
+#include "hardware/structs/otp.h"
+#include "pico/bootrom.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#include "hmac_sha256.h"
+#include "sha256.h"
+#include "vk_drbg.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -84,42 +91,294 @@ static void gcm_ghash(const uint8_t *h, const uint8_t *data, uint16_t len,
   }
 }
 
-#include "argon2.h"
+// Argon2 working memory. It lives in .uninitialized_data so the linker
+// reserves it up front without adding it to the image or to the crt0 clear
+// loop, and it never competes with the heap. Wiped after every derivation.
+static argon2_block __uninitialized_ram(
+    vk_kdf_arena)[ARGON2_MEMORY_BLOCKS(VK_KDF_MAX_M_COST)];
+
+_Static_assert(VK_KDF_MIN_M_COST <= VK_KDF_MAX_M_COST,
+               "minimum KDF m_cost does not fit the KDF arena");
+_Static_assert(VK_KDF_MIN_M_COST >= 8 * ARGON2_LANES,
+               "minimum KDF m_cost is below the Argon2 limit for the lanes");
+_Static_assert(sizeof(vk_kdf_arena) <= 384 * 1024,
+               "KDF arena leaves too little RAM for the rest of the firmware");
+
+static int vk_kdf_run(const void *pwd, size_t pwdlen,
+                      const vk_kdf_params_t *params, uint8_t *out_key) {
+  if (params->m_cost > VK_KDF_MAX_M_COST)
+    return ARGON2_MEMORY_ALLOCATION_ERROR;
+
+  int res = argon2id_hash_raw(
+      params->t_cost, params->m_cost, params->lanes, pwd, pwdlen,
+      params->salt, ARGON2_SALT_SIZE, out_key, 32, vk_kdf_arena,
+      sizeof(vk_kdf_arena) / sizeof(vk_kdf_arena[0]));
+  vk_crypto_zeroize(vk_kdf_arena, sizeof(vk_kdf_arena));
+  return res;
+}
 
-bool vk_crypto_kdf(const char *pin, const uint8_t *salt, uint8_t *out_key) {
-  // Use production-grade Argon2id KDF
-  // Parameters tuned for RP2350: 16 KiB memory, 1 iteration, 1 lane
-  uint32_t t_cost = 1;
-  uint32_t m_cost = 16;
-  uint32_t parallelism = 1;
-  uint8_t dummy_salt[16] = {0x56, 0x4B, 0x53, 0x74,
-                            0x61, 0x63, 0x6B}; // "VKStack"
+// Calibration phases: each one is a derivation with a throwaway password
+enum {
+  VK_CAL_PROBE_LO, // One pass over the least memory
+  VK_CAL_PROBE_HI, // One pass over the most
+  VK_CAL_CONFIRM,  // The chosen parameters, until they fit the target
+};
 
-  int res = argon2id_hash_raw(t_cost, m_cost, parallelism, pin, strlen(pin),
-                              salt ? salt : dummy_salt, 16, out_key, 32);
+static bool vk_kdf_probe_start(vk_kdf_calibration_t *cal) {
+  cal->probe_us = 0;
+  return vk_crypto_kdf_start(&cal->kdf, "calibrate", cal->params, cal->out);
+}
 
-  return (res == 0);
+bool vk_crypto_kdf_calibrate_start(vk_kdf_calibration_t *cal,
+                                   uint32_t target_ms,
+                                   vk_kdf_params_t *params) {
+  memset(cal, 0, sizeof(*cal));
+  // The salt has to be unpredictable
+  if (!vk_crypto_get_random(params->salt, ARGON2_SALT_SIZE))
+    return false;
+
+  // One lane per core: fewer lanes leave a core idle, more add no speed
+  params->lanes = ARGON2_LANES;
+  params->t_cost = 1;
+  params->m_cost = VK_KDF_MIN_M_COST;
+  cal->params = params;
+  cal->target_us = (uint64_t)target_ms * 1000;
+  cal->phase = VK_CAL_PROBE_LO;
+  return vk_kdf_probe_start(cal);
 }
 
-bool vk_crypto_trng_check(void) {
-  // Health check: Ensure TRNG is not stuck or producing constant zeros/ones
-  uint32_t samples[4];
-  for (int i = 0; i < 4; i++) {
-    samples[i] = get_rand_32();
+// Argon2 time is t_cost * m_cost block fills plus a fixed part (H0, the
+// first blocks, the final H'). The two single-pass probes separate them.
+static void vk_kdf_model(vk_kdf_calibration_t *cal, uint64_t hi_us) {
+  vk_kdf_params_t *params = cal->params;
+  uint64_t lo_us = cal->lo_us;
+  uint64_t ns_per_kib;
+  uint64_t fixed_us;
+  if (VK_KDF_MAX_M_COST > VK_KDF_MIN_M_COST && hi_us > lo_us) {
+    ns_per_kib =
+        (hi_us - lo_us) * 1000 / (VK_KDF_MAX_M_COST - VK_KDF_MIN_M_COST);
+    fixed_us = lo_us - ns_per_kib * VK_KDF_MIN_M_COST / 1000;
+  } else {
+    ns_per_kib = hi_us * 1000 / VK_KDF_MAX_M_COST;
+    fixed_us = 0;
   }
+  if (ns_per_kib == 0)
+    ns_per_kib = 1;
+
+  uint64_t target_us = cal->target_us;
+  uint64_t budget_ns = target_us > fixed_us ? (target_us - fixed_us) * 1000 : 0;
+
+  // Memory first: it is what makes offline guessing expensive
+  uint64_t m_cost = budget_ns / ns_per_kib;
+  if (m_cost > VK_KDF_MAX_M_COST)
+    m_cost = VK_KDF_MAX_M_COST;
+  m_cost -= m_cost % (ARGON2_SYNC_POINTS * params->lanes);
+  if (m_cost < VK_KDF_MIN_M_COST)
+    m_cost = VK_KDF_MIN_M_COST;
+
+  // Then as many passes over that memory as the budget still allows
+  uint64_t t_cost = budget_ns / (ns_per_kib * m_cost);
+  if (t_cost < VK_KDF_MIN_T_COST)
+    t_cost = VK_KDF_MIN_T_COST;
+  if (t_cost > VK_KDF_MAX_T_COST)
+    t_cost = VK_KDF_MAX_T_COST;
+
+  params->m_cost = (uint32_t)m_cost;
+  params->t_cost = (uint32_t)t_cost;
+}
 
-  // Very basic check: ensure they aren't all the same
-  bool all_same = true;
-  for (int i = 1; i < 4; i++) {
-    if (samples[i] != samples[0]) {
-      all_same = false;
-      break;
+// Scales m_cost by how far the last run overshot, in whole
+// SYNC_POINTS * lanes steps and at least one, down to VK_KDF_MIN_M_COST.
+// False if it is there already.
+static bool vk_kdf_shrink_memory(vk_kdf_calibration_t *cal) {
+  vk_kdf_params_t *params = cal->params;
+  uint32_t step = ARGON2_SYNC_POINTS * params->lanes;
+  if (params->m_cost <= VK_KDF_MIN_M_COST)
+    return false;
+  uint64_t m_cost = params->m_cost * cal->target_us / cal->probe_us;
+  m_cost -= m_cost % step;
+  if (m_cost >= params->m_cost)
+    m_cost = params->m_cost - step;
+  if (m_cost < VK_KDF_MIN_M_COST)
+    m_cost = VK_KDF_MIN_M_COST;
+  params->m_cost = (uint32_t)m_cost;
+  return true;
+}
+
+vk_job_status_t vk_crypto_kdf_calibrate_step(vk_kdf_calibration_t *cal,
+                                             uint8_t *percent) {
+  // Only the slices are timed, not what the main loop does between them
+  uint8_t probe_percent;
+  uint64_t start = time_us_64();
+  vk_job_status_t status = vk_crypto_kdf_step(&cal->kdf, &probe_percent);
+  cal->probe_us += time_us_64() - start;
+  *percent = (uint8_t)((cal->phase * 100 + probe_percent) / 3);
+  if (status != VK_JOB_DONE)
+    return status;
+  vk_crypto_zeroize(cal->out, sizeof(cal->out));
+
+  switch (cal->phase) {
+  case VK_CAL_PROBE_LO:
+    cal->lo_us = cal->probe_us;
+    cal->params->m_cost = VK_KDF_MAX_M_COST;
+    cal->phase = VK_CAL_PROBE_HI;
+    break;
+  case VK_CAL_PROBE_HI:
+    vk_kdf_model(cal, cal->probe_us);
+    // The model ignores cache and flash effects; confirm with a real run
+    cal->phase = VK_CAL_CONFIRM;
+    break;
+  default:
+    if (cal->probe_us <= cal->target_us)
+      return VK_JOB_DONE;
+    // Overshoot: drop a pass, then memory once down to one pass
+    if (cal->params->t_cost > VK_KDF_MIN_T_COST) {
+      cal->params->t_cost--;
+    } else if (!vk_kdf_shrink_memory(cal)) {
+      return VK_JOB_DONE; // Already the least the KDF runs with
+    }
+    break;
+  }
+  return vk_kdf_probe_start(cal) ? VK_JOB_MORE : VK_JOB_FAILED;
+}
+
+void vk_crypto_kdf_calibrate_abort(vk_kdf_calibration_t *cal) {
+  vk_crypto_kdf_abort(&cal->kdf);
+  vk_crypto_zeroize(cal, sizeof(*cal));
+}
+
+bool vk_crypto_kdf(const char *pin, const vk_kdf_params_t *params,
+                   uint8_t *out_key) {
+  if (!pin || !params || params->m_cost == 0)
+    return false;
+  return vk_kdf_run(pin, strlen(pin), params, out_key) == ARGON2_OK;
+}
+
+bool vk_crypto_kdf_start(vk_kdf_job_t *job, const char *pin,
+                         const vk_kdf_params_t *params, uint8_t *out_key) {
+  if (!pin || !params || params->m_cost == 0 ||
+      params->m_cost > VK_KDF_MAX_M_COST)
+    return false;
+
+  argon2_context ctx = {0};
+  ctx.out = out_key;
+  ctx.outlen = 32;
+  ctx.pwd = (const uint8_t *)pin;
+  ctx.pwdlen = (uint32_t)strlen(pin);
+  ctx.salt = params->salt;
+  ctx.saltlen = ARGON2_SALT_SIZE;
+  ctx.t_cost = params->t_cost;
+  ctx.m_cost = params->m_cost;
+  ctx.lanes = params->lanes;
+  ctx.memory = vk_kdf_arena;
+  ctx.memory_blocks = sizeof(vk_kdf_arena) / sizeof(vk_kdf_arena[0]);
+  return argon2id_begin(&job->argon2, &ctx) == ARGON2_OK;
+}
+
+vk_job_status_t vk_crypto_kdf_step(vk_kdf_job_t *job, uint8_t *percent) {
+  int res = argon2id_step(&job->argon2, VK_JOB_ARGON2_BLOCKS);
+  if (res == ARGON2_PENDING) {
+    *percent = (uint8_t)argon2id_progress(&job->argon2);
+    return VK_JOB_MORE;
+  }
+  *percent = 100;
+  return res == ARGON2_OK ? VK_JOB_DONE : VK_JOB_FAILED;
+}
+
+void vk_crypto_kdf_abort(vk_kdf_job_t *job) { argon2id_abort(&job->argon2); }
+
+// --- Device-bound key step ---
+
+// The secret is read from OTP on demand and wiped after use, so it is never
+// resident in RAM between unlocks
+static bool vk_otp_secret_access(uint8_t *buf, bool write) {
+  otp_cmd_t cmd;
+  cmd.flags = VK_OTP_SECRET_ROW | OTP_CMD_ECC_BITS;
+  if (write)
+    cmd.flags |= OTP_CMD_WRITE_BITS;
+  return rom_func_otp_access(buf, VK_DEVICE_SECRET_SIZE, cmd) == BOOTROM_OK;
+}
+
+// Once provisioned, the secret's OTP page (all 64 rows of it) is locked.
+// The expected PAGEn_LOCK1 state is:
+//   LOCK_BL inaccessible: picotool and the BOOTSEL bootloader cannot read it
+//   LOCK_NS inaccessible: non-secure code cannot read it either
+//   LOCK_S  read-only:    the firmware reads it on every unlock and never
+//                         writes it again
+// The hardware only latches page locks at reset, so SW_LOCK applies the same
+// limits to the current boot. Both kinds of lock can be raised but never
+// lowered.
+#define VK_OTP_SECRET_PAGE (VK_OTP_SECRET_ROW / 64)
+#define VK_OTP_LOCK1_ROW (OTP_DATA_PAGE0_LOCK1_ROW + 2 * VK_OTP_SECRET_PAGE)
+#define VK_OTP_LOCK1                                                           \
+  ((OTP_DATA_PAGE0_LOCK1_LOCK_BL_VALUE_INACCESSIBLE                            \
+    << OTP_DATA_PAGE0_LOCK1_LOCK_BL_LSB) |                                     \
+   (OTP_DATA_PAGE0_LOCK1_LOCK_NS_VALUE_INACCESSIBLE                            \
+    << OTP_DATA_PAGE0_LOCK1_LOCK_NS_LSB) |                                     \
+   (OTP_DATA_PAGE0_LOCK1_LOCK_S_VALUE_READ_ONLY                                \
+    << OTP_DATA_PAGE0_LOCK1_LOCK_S_LSB))
+
+static bool vk_otp_secret_lock(void) {
+  // Lock rows are raw, with the value repeated in R1 and R2 for redundancy
+  const uint32_t want = VK_OTP_LOCK1 * 0x010101u;
+  uint32_t row = 0;
+  otp_cmd_t cmd;
+  cmd.flags = VK_OTP_LOCK1_ROW;
+  bool ok = rom_func_otp_access((uint8_t *)&row, 4, cmd) == BOOTROM_OK;
+  if (ok && (row & want) != want) {
+    // Devices provisioned before locking existed get locked here too
+    row = want;
+    cmd.flags |= OTP_CMD_WRITE_BITS;
+    ok = rom_func_otp_access((uint8_t *)&row, 4, cmd) == BOOTROM_OK;
+    cmd.flags &= ~OTP_CMD_WRITE_BITS;
+    ok = ok && rom_func_otp_access((uint8_t *)&row, 4, cmd) == BOOTROM_OK &&
+         (row & want) == want;
+  }
+
+  otp_hw->sw_lock[VK_OTP_SECRET_PAGE] =
+      (OTP_SW_LOCK0_NSEC_VALUE_INACCESSIBLE << OTP_SW_LOCK0_NSEC_LSB) |
+      (OTP_SW_LOCK0_SEC_VALUE_READ_ONLY << OTP_SW_LOCK0_SEC_LSB);
+  return ok;
+}
+
+static bool vk_secret_is_blank(const uint8_t *secret) {
+  uint8_t acc = 0;
+  for (int i = 0; i < VK_DEVICE_SECRET_SIZE; i++)
+    acc |= secret[i];
+  return acc == 0;
+}
+
+bool vk_crypto_device_secret_init(void) {
+  uint8_t secret[VK_DEVICE_SECRET_SIZE];
+  bool ok = vk_otp_secret_access(secret, false);
+
+  if (ok && vk_secret_is_blank(secret)) {
+    // First boot: burn a fresh secret. OTP writes are permanent.
+    uint8_t check[VK_DEVICE_SECRET_SIZE];
+    ok = vk_crypto_get_random(secret, sizeof(secret));
+    if (ok) {
+      ok = vk_otp_secret_access(secret, true) &&
+           vk_otp_secret_access(check, false) &&
+           memcmp(secret, check, sizeof(secret)) == 0;
     }
+    vk_crypto_zeroize(check, sizeof(check));
   }
 
-  return !all_same;
+  vk_crypto_zeroize(secret, sizeof(secret));
+  return ok && vk_otp_secret_lock();
 }
 
+bool vk_crypto_device_bind(const uint8_t prekey[32], uint8_t out_key[32]) {
+  uint8_t secret[VK_DEVICE_SECRET_SIZE];
+  bool ok = vk_otp_secret_access(secret, false) && !vk_secret_is_blank(secret);
+  if (ok)
+    hmac_sha256(secret, sizeof(secret), prekey, 32, out_key);
+  vk_crypto_zeroize(secret, sizeof(secret));
+  return ok;
+}
+
+bool vk_crypto_trng_check(void) { return vk_drbg_ready(); }
+
 bool vk_crypto_encrypt(const uint8_t *key, const uint8_t *plaintext,
                        uint16_t len, uint8_t *iv, uint8_t *tag,
                        uint8_t *ciphertext) {
@@ -216,10 +475,6 @@ bool vk_crypto_decrypt(const uint8_t *key, const uint8_t *ciphertext,
   return true;
 }
 
-void vk_crypto_get_random(uint8_t *buffer, size_t len) {
-  for (size_t i = 0; i < len; i += 4) {
-    uint32_t val = get_rand_32();
-    size_t chunk = (len - i) < 4 ? (len - i) : 4;
-    memcpy(buffer + i, &val, chunk);
-  }
+bool vk_crypto_get_random(uint8_t *buffer, size_t len) {
+  return vk_drbg_generate(buffer, len);
 }
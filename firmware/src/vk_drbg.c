@@ -0,0 +1,189 @@
+#include "vk_drbg.h"
+#include "blake2b.h"
+#include <string.h>
+
+// Each refill makes VK_DRBG_BLOCKS ChaCha20 blocks under the current key;
+// the first 32 bytes become the next key and are never output, so a later
+// state compromise does not reveal earlier output.
+#define VK_DRBG_BLOCKS 4
+#define VK_DRBG_BUF (64 * VK_DRBG_BLOCKS)
+
+static struct {
+  uint32_t key[8];
+  uint8_t buf[VK_DRBG_BUF];
+  size_t avail;    // Unread bytes at the end of buf
+  size_t since_seed;
+  bool seeded;
+  bool failed;
+
+  // Repetition count test
+  uint8_t rct_last;
+  uint32_t rct_count;
+  // Adaptive proportion test
+  uint8_t apt_first;
+  uint32_t apt_count;
+  uint32_t apt_seen;
+} drbg;
+
+static void vk_drbg_wipe(void *v, size_t n) {
+  volatile uint8_t *p = (volatile uint8_t *)v;
+  while (n--)
+    *p++ = 0;
+}
+
+// --- Health tests (SP 800-90B, 4.4) ---
+
+static void vk_drbg_health(uint8_t b) {
+  if (b == drbg.rct_last && drbg.rct_count) {
+    if (++drbg.rct_count >= VK_DRBG_RCT_CUTOFF)
+      drbg.failed = true;
+  } else {
+    drbg.rct_last = b;
+    drbg.rct_count = 1;
+  }
+
+  if (drbg.apt_seen == 0) {
+    drbg.apt_first = b;
+    drbg.apt_count = 1;
+  } else if (b == drbg.apt_first &&
+             ++drbg.apt_count >= VK_DRBG_APT_CUTOFF) {
+    drbg.failed = true;
+  }
+  if (++drbg.apt_seen == VK_DRBG_APT_WINDOW)
+    drbg.apt_seen = 0;
+}
+
+// Draw len noise bytes through the health tests
+static bool vk_drbg_noise_bytes(uint8_t *out, size_t len) {
+  for (size_t i = 0; i < len; i += 4) {
+    uint32_t v = vk_drbg_noise();
+    for (size_t j = 0; j < 4; j++) {
+      uint8_t b = (uint8_t)(v >> (8 * j));
+      vk_drbg_health(b);
+      if (out && i + j < len)
+        out[i + j] = b;
+    }
+  }
+  return !drbg.failed;
+}
+
+// --- ChaCha20 (RFC 8439 block function, zero nonce) ---
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+#define QR(a, b, c, d)                                                         \
+  a += b;                                                                      \
+  d = ROTL32(d ^ a, 16);                                                       \
+  c += d;                                                                      \
+  b = ROTL32(b ^ c, 12);                                                       \
+  a += b;                                                                      \
+  d = ROTL32(d ^ a, 8);                                                        \
+  c += d;                                                                      \
+  b = ROTL32(b ^ c, 7)
+
+static void vk_chacha20_block(const uint32_t key[8], uint32_t counter,
+                              uint8_t out[64]) {
+  uint32_t in[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+                     key[0],     key[1],     key[2],     key[3],
+                     key[4],     key[5],     key[6],     key[7],
+                     counter,    0,          0,          0};
+  uint32_t x[16];
+  memcpy(x, in, sizeof(x));
+  for (int i = 0; i < 10; i++) {
+    QR(x[0], x[4], x[8], x[12]);
+    QR(x[1], x[5], x[9], x[13]);
+    QR(x[2], x[6], x[10], x[14]);
+    QR(x[3], x[7], x[11], x[15]);
+    QR(x[0], x[5], x[10], x[15]);
+    QR(x[1], x[6], x[11], x[12]);
+    QR(x[2], x[7], x[8], x[13]);
+    QR(x[3], x[4], x[9], x[14]);
+  }
+  for (int i = 0; i < 16; i++) {
+    uint32_t v = x[i] + in[i];
+    out[4 * i] = (uint8_t)v;
+    out[4 * i + 1] = (uint8_t)(v >> 8);
+    out[4 * i + 2] = (uint8_t)(v >> 16);
+    out[4 * i + 3] = (uint8_t)(v >> 24);
+  }
+  vk_drbg_wipe(x, sizeof(x));
+  vk_drbg_wipe(in, sizeof(in));
+}
+
+static void vk_drbg_refill(void) {
+  for (uint32_t i = 0; i < VK_DRBG_BLOCKS; i++)
+    vk_chacha20_block(drbg.key, i, drbg.buf + 64 * i);
+  for (int i = 0; i < 8; i++)
+    drbg.key[i] = (uint32_t)drbg.buf[4 * i] |
+                  (uint32_t)drbg.buf[4 * i + 1] << 8 |
+                  (uint32_t)drbg.buf[4 * i + 2] << 16 |
+                  (uint32_t)drbg.buf[4 * i + 3] << 24;
+  vk_drbg_wipe(drbg.buf, 32);
+  drbg.avail = VK_DRBG_BUF - 32;
+}
+
+// --- Public API ---
+
+bool vk_drbg_reseed(void) {
+  uint8_t seed[VK_DRBG_SEED_BYTES], key[32];
+  blake2b_state s;
+
+  if (!vk_drbg_noise_bytes(seed, sizeof(seed))) {
+    vk_drbg_wipe(seed, sizeof(seed));
+    vk_drbg_wipe(&drbg, sizeof(drbg));
+    drbg.failed = true;
+    return false;
+  }
+
+  // key = BLAKE2b-256(old key || noise); the old key is zero on first seed
+  blake2b_init(&s, sizeof(key));
+  blake2b_update(&s, drbg.key, sizeof(drbg.key));
+  blake2b_update(&s, seed, sizeof(seed));
+  blake2b_final(&s, key);
+  for (int i = 0; i < 8; i++)
+    drbg.key[i] = (uint32_t)key[4 * i] | (uint32_t)key[4 * i + 1] << 8 |
+                  (uint32_t)key[4 * i + 2] << 16 |
+                  (uint32_t)key[4 * i + 3] << 24;
+  vk_drbg_wipe(seed, sizeof(seed));
+  vk_drbg_wipe(key, sizeof(key));
+
+  // Drop buffered output made under the old key
+  vk_drbg_wipe(drbg.buf, sizeof(drbg.buf));
+  drbg.avail = 0;
+  drbg.since_seed = 0;
+  drbg.seeded = true;
+  return true;
+}
+
+bool vk_drbg_ready(void) {
+  if (drbg.failed)
+    return false;
+  if (drbg.seeded)
+    return true;
+  return vk_drbg_noise_bytes(NULL, VK_DRBG_STARTUP_BYTES) && vk_drbg_reseed();
+}
+
+bool vk_drbg_generate(void *out, size_t len) {
+  uint8_t *p = out;
+
+  if (!vk_drbg_ready() ||
+      (drbg.since_seed >= VK_DRBG_RESEED_BYTES && !vk_drbg_reseed())) {
+    memset(out, 0, len);
+    return false;
+  }
+
+  drbg.since_seed += len;
+  while (len) {
+    if (!drbg.avail)
+      vk_drbg_refill();
+    size_t n = len < drbg.avail ? len : drbg.avail;
+    uint8_t *src = drbg.buf + VK_DRBG_BUF - drbg.avail;
+    memcpy(p, src, n);
+    vk_drbg_wipe(src, n);
+    drbg.avail -= n;
+    p += n;
+    len -= n;
+  }
+  return true;
+}
+
+void vk_drbg_uninstantiate(void) { vk_drbg_wipe(&drbg, sizeof(drbg)); }
@@ -1,11 +1,16 @@
 #include "vk_fido.h"
+#include "bsp/board.h"
 #include "cb0r.h"
 #include "p256-m.h"
 #include "sha256.h"
 #include "tusb.h"
 #include "tweetnacl.h"
 #include "vault.h"
+#include "vk_arena.h"
 #include "vk_crypto.h"
+#include "vk_job.h"
+#include "vk_pool.h"
+#include "vk_spsc.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
@@ -35,18 +40,63 @@ static uint8_t pin_token[32] = {0};
   {0x56, 0x4B, 0x53, 0x54, 0x41, 0x43, 0x4B, 0x01,                             \
    0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09}
 
-extern bool vk_main_wait_for_button(uint32_t timeout_ms);
+// Button and LED, in main.c
+extern bool vk_main_button_pressed(void);
+extern void vk_main_set_led_mode(bool wait_for_touch);
+extern void vk_main_led_off(void);
+
+// Expanded Ed25519 keys (SHA-512 of the seed, clamped) of the credentials
+// that signed most recently. Filled only while the vault session is open and
+// wiped with it, so repeated assertions skip the key hash.
+#define VK_FIDO_KEY_CACHE 4
+
+static struct {
+  uint8_t credential_id[FIDO_CREDID_MAX];
+  uint8_t expanded[64];
+  uint32_t last_used; // 0 = free
+} key_cache[VK_FIDO_KEY_CACHE];
+static uint32_t key_cache_clock = 0;
 
 void vk_fido_reset_session(void) {
   vk_crypto_zeroize(pin_key_priv, 32);
   vk_crypto_zeroize(pin_key_pub, 64);
   vk_crypto_zeroize(pin_token, 32);
   pin_key_generated = false;
+  vk_crypto_zeroize(key_cache, sizeof(key_cache));
+  key_cache_clock = 0;
+  vk_pool_wipe();
 }
 
-static bool vk_fido_wait_for_user_presence(void) {
-  // Hardware implementation: check button press with 30s timeout.
-  return vk_main_wait_for_button(30000);
+void vk_fido_forget_key(const uint8_t *cred_id) {
+  for (int i = 0; i < VK_FIDO_KEY_CACHE; i++) {
+    if (key_cache[i].last_used &&
+        memcmp(key_cache[i].credential_id, cred_id, FIDO_CREDID_MAX) == 0)
+      vk_crypto_zeroize(&key_cache[i], sizeof(key_cache[i]));
+  }
+}
+
+// Copies the expanded key of cred into d, from the cache or derived (and
+// cached, evicting the least recently used entry, while unlocked)
+static void vk_fido_expanded_key(const vk_fido_cred_t *cred, uint8_t d[64]) {
+  int victim = 0;
+  for (int i = 0; i < VK_FIDO_KEY_CACHE; i++) {
+    if (key_cache[i].last_used &&
+        memcmp(key_cache[i].credential_id, cred->credential_id,
+               FIDO_CREDID_MAX) == 0) {
+      key_cache[i].last_used = ++key_cache_clock;
+      memcpy(d, key_cache[i].expanded, 64);
+      return;
+    }
+    if (key_cache[i].last_used < key_cache[victim].last_used)
+      victim = i;
+  }
+  crypto_sign_ed25519_tweet_expand(d, cred->private_key);
+  if (vault_has_session_key()) {
+    memcpy(key_cache[victim].credential_id, cred->credential_id,
+           FIDO_CREDID_MAX);
+    memcpy(key_cache[victim].expanded, d, 64);
+    key_cache[victim].last_used = ++key_cache_clock;
+  }
 }
 
 #define CTAP_STATUS_OK 0x00
@@ -58,9 +108,29 @@ static bool vk_fido_wait_for_user_presence(void) {
 #define CTAP_ERR_NO_CREDENTIALS 0x2E
 #define CTAP_ERR_KEY_STORE_FULL 0x27
 #define CTAP_ERR_NOT_ALLOWED 0x30
+#define CTAP_ERR_KEEPALIVE_CANCEL 0x2D
+#define CTAP_ERR_USER_ACTION_TIMEOUT 0x2F
+#define CTAP_ERR_OTHER 0x7F
+
+// CTAPHID framing around long operations
+#define CTAPHID_CANCEL 0x91
+#define CTAPHID_KEEPALIVE 0xBB
+#define CTAPHID_STATUS_PROCESSING 0x01
+#define CTAPHID_STATUS_UPNEEDED 0x02
+#define CTAPHID_ERR_CHANNEL_BUSY 0x06
 
 #define FIDO_ITF_INDEX 2
 
+// Response buffers come from the request arena (vk_arena.h), released per
+// CTAP2 command. When it is spent the request is answered with
+// CTAP2_ERR_OTHER and NULL returned.
+static void *vk_fido_scratch(uint32_t cid, size_t size) {
+  void *p = vk_arena_alloc(size);
+  if (!p)
+    vk_fido_send_response(cid, U2FHID_MSG, (uint8_t[]){CTAP_ERR_OTHER}, 1);
+  return p;
+}
+
 // --- CBOR Encoding Helpers ---
 
 static size_t encode_cose_key(uint8_t *out, const uint8_t *pk) {
@@ -108,7 +178,9 @@ static size_t encode_auth_data(uint8_t *out, const uint8_t *rp_id_hash,
 
 static void handle_get_info(uint32_t cid) {
   uint8_t aaguid[] = VK_AAGUID;
-  uint8_t res[256];
+  uint8_t *res = vk_fido_scratch(cid, 256);
+  if (!res)
+    return;
   size_t off = 0;
   res[off++] = 0x00; // Status OK
   res[off++] = 0xA5; // Map(5)
@@ -159,6 +231,325 @@ static void handle_get_info(uint32_t cid) {
   vk_fido_send_response(cid, U2FHID_MSG, res, off);
 }
 
+// --- Long operations as main-loop jobs ---
+//
+// Key generation and signing run in slices from vk_job_task, so the HID
+// endpoint keeps being serviced: the platform gets a KEEPALIVE every
+// VK_JOB_NOTIFY_MS and can CANCEL. The response is built when the job ends.
+
+typedef enum {
+  FIDO_JOB_MAKE_CREDENTIAL,
+  FIDO_JOB_GET_ASSERTION,
+  FIDO_JOB_KEY_AGREEMENT,
+} fido_job_kind_t;
+
+static struct {
+  vk_job_t job;
+  fido_job_kind_t kind;
+  uint32_t cid;
+  union {
+    crypto_sign_ed25519_tweet_job ed25519;
+    p256_keypair_job p256;
+  } op;
+  vk_fido_cred_t cred; // New credential, or the one signing the assertion
+  uint8_t sk[64]; // New credential's key in tweetnacl layout: seed, then pk
+  // Assertion: the signature covers authData || clientDataHash, signed in
+  // place from these two parts
+  crypto_sign_ed25519_tweet_iov parts[2];
+  uint8_t auth_data[37];
+  uint8_t client_data_hash[32];
+  uint8_t sig[64];
+  // A new credential waiting for the button (vk_fido_presence_task), then
+  // for any unlock/setup job to finish before it is written to flash
+  bool awaiting_presence;
+  bool presence_given;
+  uint32_t presence_deadline_ms;
+} fido_job;
+
+// How long a new credential waits for the button
+#define VK_FIDO_PRESENCE_MS 30000
+
+static void vk_fido_send_key_agreement(uint32_t cid) {
+  // Return COSE_Key with public key
+  uint8_t *res = vk_fido_scratch(cid, 128);
+  if (!res)
+    return;
+  size_t off = 0;
+  res[off++] = 0x00; // Status OK
+  res[off++] = 0xA1; // Map(1)
+  res[off++] = 0x01; // key 1 = keyAgreement
+  // COSE Key: kty=EC2, crv=P-256, x, y
+  res[off++] = 0xA5; // Map(5)
+  res[off++] = 0x01;
+  res[off++] = 0x02; // kty: EC2
+  res[off++] = 0x03;
+  res[off++] = 0x38;
+  res[off++] = 0x18; // alg: ECDH-ES+HKDF (-25)
+  res[off++] = 0x20;
+  res[off++] = 0x01; // crv: P-256
+  res[off++] = 0x21;
+  res[off++] = 0x58;
+  res[off++] = 0x20;
+  memcpy(&res[off], pin_key_pub, 32);
+  off += 32; // x
+  res[off++] = 0x22;
+  res[off++] = 0x58;
+  res[off++] = 0x20;
+  memcpy(&res[off], pin_key_pub + 32, 32);
+  off += 32; // y
+  vk_fido_send_response(cid, U2FHID_MSG, res, off);
+}
+
+static void vk_fido_finish_make_credential(uint32_t cid) {
+  vk_fido_cred_t *new_cred = &fido_job.cred;
+  uint8_t *res_buf = vk_fido_scratch(cid, 512 + 256);
+  if (!res_buf)
+    return;
+  uint8_t *auth_data = res_buf + 512;
+  if (vault_fido_add(new_cred)) {
+    uint8_t rp_id_hash[32];
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, (uint8_t *)new_cred->rp_id, strlen(new_cred->rp_id));
+    sha256_final(&ctx, rp_id_hash);
+    uint8_t aaguid[] = VK_AAGUID;
+    // Flags: 0x01=UP, 0x04=UV, 0x40=AT
+    uint8_t flags = 0x41; // UP + AT
+    if (vault_fido_has_pin()) {
+      flags |= 0x04; // Add UV if PIN is set
+    }
+    size_t ad_len =
+        encode_auth_data(auth_data, rp_id_hash, flags, 0, aaguid,
+                         new_cred->credential_id, 32, new_cred->public_key);
+
+    res_buf[0] = 0x00;
+    res_buf[1] = 0xA3;
+    res_buf[2] = 0x01;
+    res_buf[3] = 0x64;
+    memcpy(&res_buf[4], "none", 4);
+    res_buf[8] = 0x02;
+    res_buf[9] = 0x58;
+    res_buf[10] = (uint8_t)ad_len;
+    memcpy(&res_buf[11], auth_data, ad_len);
+    size_t off = 11 + ad_len;
+    res_buf[off++] = 0x03;
+    res_buf[off++] = 0xA0;
+    vk_fido_send_response(cid, U2FHID_MSG, res_buf, off);
+  } else
+    vk_fido_send_response(cid, U2FHID_MSG, (uint8_t[]){CTAP_ERR_KEY_STORE_FULL},
+                          1);
+}
+
+// User presence is a state polled from vk_fido_task, not a wait: the main
+// loop keeps running while the LED asks for a touch, the platform gets
+// KEEPALIVE UPNEEDED and may CANCEL. fido_job holds the key until then.
+static void vk_fido_await_presence(void) {
+  uint32_t now = board_millis();
+  fido_job.awaiting_presence = true;
+  fido_job.presence_deadline_ms = now + VK_FIDO_PRESENCE_MS;
+  fido_job.job.last_notify_ms = now;
+  fido_job.job.cancel = false;
+  vk_main_set_led_mode(true); // Fast blink
+}
+
+static void vk_fido_presence_task(uint32_t now_ms) {
+  uint8_t status;
+  if (vk_main_button_pressed())
+    fido_job.presence_given = true;
+  if (fido_job.presence_given && !vk_job_busy()) {
+    status = CTAP_STATUS_OK;
+  } else if (fido_job.job.cancel) {
+    status = CTAP_ERR_KEEPALIVE_CANCEL;
+  } else if (fido_job.presence_given) {
+    if (now_ms - fido_job.job.last_notify_ms >= VK_JOB_NOTIFY_MS) {
+      fido_job.job.last_notify_ms = now_ms;
+      vk_fido_send_response(fido_job.cid, CTAPHID_KEEPALIVE,
+                            (uint8_t[]){CTAPHID_STATUS_PROCESSING}, 1);
+    }
+    return;
+  } else if ((int32_t)(now_ms - fido_job.presence_deadline_ms) >= 0) {
+    status = CTAP_ERR_USER_ACTION_TIMEOUT;
+  } else {
+    if (now_ms - fido_job.job.last_notify_ms >= VK_JOB_NOTIFY_MS) {
+      fido_job.job.last_notify_ms = now_ms;
+      vk_fido_send_response(fido_job.cid, CTAPHID_KEEPALIVE,
+                            (uint8_t[]){CTAPHID_STATUS_UPNEEDED}, 1);
+    }
+    return;
+  }
+
+  vk_main_led_off();
+  if (status == CTAP_STATUS_OK)
+    vk_fido_finish_make_credential(fido_job.cid);
+  else
+    vk_fido_send_response(fido_job.cid, U2FHID_MSG, &status, 1);
+  vk_crypto_zeroize(&fido_job, sizeof(fido_job));
+  vk_arena_release(VK_ARENA_FIDO, CTAP2_CMD_MAKE_CREDENTIAL);
+}
+
+static void vk_fido_finish_get_assertion(uint32_t cid) {
+  size_t ad_len = fido_job.parts[0].len;
+  uint8_t *res_buf = vk_fido_scratch(cid, 256);
+  if (!res_buf)
+    return;
+  res_buf[0] = 0x00;
+  res_buf[1] = 0xA3;
+  res_buf[2] = 0x01;
+  res_buf[3] = 0xA2;
+  res_buf[4] = 0x62;
+  res_buf[5] = 'i';
+  res_buf[6] = 'd';
+  res_buf[7] = 0x58;
+  res_buf[8] = 0x20;
+  memcpy(&res_buf[9], fido_job.cred.credential_id, 32);
+  res_buf[41] = 0x64;
+  res_buf[42] = 't';
+  res_buf[43] = 'y';
+  res_buf[44] = 'p';
+  res_buf[45] = 'e';
+  res_buf[46] = 0x6A;
+  memcpy(&res_buf[47], "public-key", 10);
+  res_buf[57] = 0x02;
+  res_buf[58] = 0x58;
+  res_buf[59] = (uint8_t)ad_len;
+  memcpy(&res_buf[60], fido_job.auth_data, ad_len);
+  size_t off = 60 + ad_len;
+  res_buf[off++] = 0x03;
+  res_buf[off++] = 0x58;
+  res_buf[off++] = 64;
+  memcpy(&res_buf[off], fido_job.sig, 64);
+  off += 64;
+  vk_fido_send_response(cid, U2FHID_MSG, res_buf, off);
+}
+
+static vk_job_status_t vk_fido_job_step(vk_job_t *job) {
+  if (fido_job.kind == FIDO_JOB_KEY_AGREEMENT) {
+    job->percent =
+        (uint8_t)(fido_job.op.p256.comb.step * 100 / P256_COMB_STEPS);
+    return p256_gen_keypair_step(&fido_job.op.p256, VK_JOB_P256_STEPS) ==
+                   P256_PENDING
+               ? VK_JOB_MORE
+               : VK_JOB_DONE;
+  }
+  job->percent = (uint8_t)(fido_job.op.ed25519.step * 100 /
+                           crypto_sign_ed25519_tweet_STEPS);
+  return crypto_sign_ed25519_tweet_step(&fido_job.op.ed25519,
+                                        VK_JOB_ED25519_STEPS)
+             ? VK_JOB_MORE
+             : VK_JOB_DONE;
+}
+
+static void vk_fido_job_notify(vk_job_t *job) {
+  (void)job;
+  vk_fido_send_response(fido_job.cid, CTAPHID_KEEPALIVE,
+                        (uint8_t[]){CTAPHID_STATUS_PROCESSING}, 1);
+}
+
+// The CTAP2 command a job answers, for the arena statistics
+static uint8_t vk_fido_job_command(void) {
+  if (fido_job.kind == FIDO_JOB_MAKE_CREDENTIAL)
+    return CTAP2_CMD_MAKE_CREDENTIAL;
+  if (fido_job.kind == FIDO_JOB_GET_ASSERTION)
+    return CTAP2_CMD_GET_ASSERTION;
+  return CTAP2_CMD_CLIENT_PIN;
+}
+
+static void vk_fido_job_finish(vk_job_t *job, vk_job_status_t status) {
+  (void)job;
+  uint32_t cid = fido_job.cid;
+  uint8_t cmd = vk_fido_job_command();
+
+  if (status == VK_JOB_DONE) {
+    if (fido_job.kind == FIDO_JOB_MAKE_CREDENTIAL) {
+      memcpy(fido_job.cred.public_key, fido_job.sk + 32, 32);
+      vk_crypto_zeroize(fido_job.sk, sizeof(fido_job.sk));
+      vk_fido_await_presence();
+      return;
+    } else if (fido_job.kind == FIDO_JOB_GET_ASSERTION) {
+      vk_fido_finish_get_assertion(cid);
+    } else {
+      pin_key_generated = true;
+      vk_fido_send_key_agreement(cid);
+    }
+  } else {
+    if (fido_job.kind == FIDO_JOB_KEY_AGREEMENT) {
+      p256_gen_keypair_abort(&fido_job.op.p256);
+      vk_crypto_zeroize(pin_key_priv, sizeof(pin_key_priv));
+    } else {
+      crypto_sign_ed25519_tweet_abort(&fido_job.op.ed25519);
+    }
+    vk_fido_send_response(cid, U2FHID_MSG,
+                          (uint8_t[]){status == VK_JOB_CANCELLED
+                                          ? CTAP_ERR_KEEPALIVE_CANCEL
+                                          : CTAP_ERR_NOT_ALLOWED},
+                          1);
+  }
+  vk_crypto_zeroize(&fido_job, sizeof(fido_job));
+  vk_arena_release(VK_ARENA_FIDO, cmd);
+}
+
+// cred is copied. An assertion signs auth_data || client_data_hash.
+static void vk_fido_start_job(uint32_t cid, fido_job_kind_t kind,
+                              const vk_fido_cred_t *cred,
+                              const uint8_t *auth_data, size_t ad_len,
+                              const uint8_t *client_data_hash) {
+  if (vk_job_busy() || fido_job.awaiting_presence) {
+    vk_fido_send_response(cid, U2FHID_ERROR,
+                          (uint8_t[]){CTAPHID_ERR_CHANNEL_BUSY}, 1);
+    return;
+  }
+
+  fido_job.kind = kind;
+  fido_job.cid = cid;
+  if (cred)
+    memcpy(&fido_job.cred, cred, sizeof(fido_job.cred));
+
+  // A key made ahead of time while idle skips the job entirely
+  if (kind == FIDO_JOB_MAKE_CREDENTIAL &&
+      vk_pool_take_ed25519(fido_job.cred.private_key,
+                           fido_job.cred.public_key)) {
+    vk_fido_await_presence();
+    return;
+  }
+  if (kind == FIDO_JOB_KEY_AGREEMENT &&
+      vk_pool_take_p256(pin_key_priv, pin_key_pub)) {
+    pin_key_generated = true;
+    vk_fido_send_key_agreement(cid);
+    vk_crypto_zeroize(&fido_job, sizeof(fido_job));
+    return;
+  }
+
+  if (kind == FIDO_JOB_MAKE_CREDENTIAL) {
+    memcpy(fido_job.sk, fido_job.cred.private_key, 32);
+    crypto_sign_ed25519_tweet_keypair_start(&fido_job.op.ed25519,
+                                            fido_job.sk + 32, fido_job.sk);
+  } else if (kind == FIDO_JOB_GET_ASSERTION) {
+    memcpy(fido_job.auth_data, auth_data, ad_len);
+    memcpy(fido_job.client_data_hash, client_data_hash, 32);
+    fido_job.parts[0] = (crypto_sign_ed25519_tweet_iov){fido_job.auth_data,
+                                                        ad_len};
+    fido_job.parts[1] = (crypto_sign_ed25519_tweet_iov){
+        fido_job.client_data_hash, 32};
+    uint8_t d[64];
+    vk_fido_expanded_key(&fido_job.cred, d);
+    crypto_sign_ed25519_tweet_detached_expanded_start(
+        &fido_job.op.ed25519, fido_job.sig, fido_job.parts, 2, d,
+        fido_job.cred.public_key);
+    vk_crypto_zeroize(d, sizeof(d));
+  } else if (p256_gen_keypair_start(&fido_job.op.p256, pin_key_priv,
+                                    pin_key_pub) != P256_SUCCESS) {
+    vk_crypto_zeroize(&fido_job, sizeof(fido_job));
+    vk_fido_send_response(cid, U2FHID_MSG, (uint8_t[]){CTAP_ERR_NOT_ALLOWED},
+                          1);
+    return;
+  }
+
+  fido_job.job.step = vk_fido_job_step;
+  fido_job.job.finish = vk_fido_job_finish;
+  fido_job.job.notify = vk_fido_job_notify;
+  vk_job_start(&fido_job.job, board_millis());
+}
+
 static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
                                    uint16_t len) {
   uint8_t ctap_cmd = payload[0];
@@ -172,45 +563,20 @@ static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
     if (cb0r_read(data, data_len, &map) &&
         cb0r_find(&map, CB0R_MAP, CTAP2_PARAM_RP, NULL, &rp_val) &&
         cb0r_find(&rp_val, CB0R_UTF8, 0, (uint8_t *)"id", &rp_id_val)) {
-      vk_fido_cred_t new_cred = {0};
+      vk_fido_cred_t *new_cred = vk_fido_scratch(cid, sizeof(*new_cred));
       size_t id_len = cb0r_vlen(&rp_id_val);
-      memcpy(new_cred.rp_id, cb0r_value(&rp_id_val), id_len > 63 ? 63 : id_len);
-      crypto_sign_ed25519_tweet_keypair(new_cred.public_key,
-                                        new_cred.private_key);
-      vk_crypto_get_random(new_cred.credential_id, 32);
-
-      if (vk_fido_wait_for_user_presence() && vault_fido_add(&new_cred)) {
-        uint8_t res_buf[512], rp_id_hash[32], auth_data[256];
-        SHA256_CTX ctx;
-        sha256_init(&ctx);
-        sha256_update(&ctx, (uint8_t *)new_cred.rp_id, strlen(new_cred.rp_id));
-        sha256_final(&ctx, rp_id_hash);
-        uint8_t aaguid[] = VK_AAGUID;
-        // Flags: 0x01=UP, 0x04=UV, 0x40=AT
-        uint8_t flags = 0x41; // UP + AT
-        if (vault_fido_has_pin()) {
-          flags |= 0x04; // Add UV if PIN is set
-        }
-        size_t ad_len =
-            encode_auth_data(auth_data, rp_id_hash, flags, 0, aaguid,
-                             new_cred.credential_id, 32, new_cred.public_key);
-
-        res_buf[0] = 0x00;
-        res_buf[1] = 0xA3;
-        res_buf[2] = 0x01;
-        res_buf[3] = 0x64;
-        memcpy(&res_buf[4], "none", 4);
-        res_buf[8] = 0x02;
-        res_buf[9] = 0x58;
-        res_buf[10] = (uint8_t)ad_len;
-        memcpy(&res_buf[11], auth_data, ad_len);
-        size_t off = 11 + ad_len;
-        res_buf[off++] = 0x03;
-        res_buf[off++] = 0xA0;
-        vk_fido_send_response(cid, U2FHID_MSG, res_buf, off);
-      } else
-        vk_fido_send_response(cid, U2FHID_MSG,
-                              (uint8_t[]){CTAP_ERR_KEY_STORE_FULL}, 1);
+      if (new_cred) {
+        memcpy(new_cred->rp_id, cb0r_value(&rp_id_val),
+               id_len > 63 ? 63 : id_len);
+        // Seed for the keypair job; tweetnacl expects sk[0..31] random
+        if (vk_crypto_get_random(new_cred->private_key, 32) &&
+            vk_crypto_get_random(new_cred->credential_id, 32))
+          vk_fido_start_job(cid, FIDO_JOB_MAKE_CREDENTIAL, new_cred, NULL, 0,
+                            NULL);
+        else
+          vk_fido_send_response(cid, U2FHID_MSG, (uint8_t[]){CTAP_ERR_OTHER},
+                                1);
+      }
     } else
       vk_fido_send_response(cid, U2FHID_MSG, (uint8_t[]){CTAP_ERR_INVALID_CBOR},
                             1);
@@ -223,9 +589,9 @@ static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
       char rp_id[64] = {0};
       size_t id_len = cb0r_vlen(&rp_val);
       memcpy(rp_id, cb0r_value(&rp_val), id_len > 63 ? 63 : id_len);
-      vk_fido_cred_t cred;
-      if (vault_fido_list_by_rp(rp_id, &cred, 1) > 0) {
-        uint8_t rp_id_hash[32], auth_data[37], to_sign[37 + 32], sig[64 + 69];
+      vk_fido_cred_t *cred = vk_fido_scratch(cid, sizeof(*cred));
+      if (cred && vault_fido_list_by_rp(rp_id, cred, 1) > 0) {
+        uint8_t rp_id_hash[32], auth_data[37];
         SHA256_CTX ctx;
         sha256_init(&ctx);
         sha256_update(&ctx, (uint8_t *)rp_id, strlen(rp_id));
@@ -237,42 +603,9 @@ static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
         }
         size_t ad_len = encode_auth_data(auth_data, rp_id_hash, flags, 0, NULL,
                                          NULL, 0, NULL);
-        memcpy(to_sign, auth_data, ad_len);
-        memcpy(to_sign + ad_len, cb0r_value(&hash_val), 32);
-        unsigned long long sig_len;
-        crypto_sign_ed25519_tweet(sig, &sig_len, to_sign, ad_len + 32,
-                                  cred.private_key);
-
-        uint8_t res_buf[256];
-        res_buf[0] = 0x00;
-        res_buf[1] = 0xA3;
-        res_buf[2] = 0x01;
-        res_buf[3] = 0xA2;
-        res_buf[4] = 0x62;
-        res_buf[5] = 'i';
-        res_buf[6] = 'd';
-        res_buf[7] = 0x58;
-        res_buf[8] = 0x20;
-        memcpy(&res_buf[9], cred.credential_id, 32);
-        res_buf[41] = 0x64;
-        res_buf[42] = 't';
-        res_buf[43] = 'y';
-        res_buf[44] = 'p';
-        res_buf[45] = 'e';
-        res_buf[46] = 0x6A;
-        memcpy(&res_buf[47], "public-key", 10);
-        res_buf[57] = 0x02;
-        res_buf[58] = 0x58;
-        res_buf[59] = (uint8_t)ad_len;
-        memcpy(&res_buf[60], auth_data, ad_len);
-        size_t off = 60 + ad_len;
-        res_buf[off++] = 0x03;
-        res_buf[off++] = 0x58;
-        res_buf[off++] = 64;
-        memcpy(&res_buf[off], sig, 64);
-        off += 64;
-        vk_fido_send_response(cid, U2FHID_MSG, res_buf, off);
-      } else
+        vk_fido_start_job(cid, FIDO_JOB_GET_ASSERTION, cred, auth_data,
+                          ad_len, cb0r_value(&hash_val));
+      } else if (cred)
         vk_fido_send_response(cid, U2FHID_MSG,
                               (uint8_t[]){CTAP_ERR_NO_CREDENTIALS}, 1);
     } else
@@ -295,42 +628,20 @@ static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
 
       } else if (subcmd == 0x02) { // getKeyAgreement
         // Generate or reuse ephemeral P-256 keypair for ECDH
-        if (!pin_key_generated) {
-          p256_gen_keypair(pin_key_priv, pin_key_pub);
-          pin_key_generated = true;
-        }
-        // Return COSE_Key with public key
-        uint8_t res[128];
-        size_t off = 0;
-        res[off++] = 0x00; // Status OK
-        res[off++] = 0xA1; // Map(1)
-        res[off++] = 0x01; // key 1 = keyAgreement
-        // COSE Key: kty=EC2, crv=P-256, x, y
-        res[off++] = 0xA5; // Map(5)
-        res[off++] = 0x01;
-        res[off++] = 0x02; // kty: EC2
-        res[off++] = 0x03;
-        res[off++] = 0x38;
-        res[off++] = 0x18; // alg: ECDH-ES+HKDF (-25)
-        res[off++] = 0x20;
-        res[off++] = 0x01; // crv: P-256
-        res[off++] = 0x21;
-        res[off++] = 0x58;
-        res[off++] = 0x20;
-        memcpy(&res[off], pin_key_pub, 32);
-        off += 32; // x
-        res[off++] = 0x22;
-        res[off++] = 0x58;
-        res[off++] = 0x20;
-        memcpy(&res[off], pin_key_pub + 32, 32);
-        off += 32; // y
-        vk_fido_send_response(cid, U2FHID_MSG, res, off);
+        if (!pin_key_generated)
+          vk_fido_start_job(cid, FIDO_JOB_KEY_AGREEMENT, NULL, NULL, 0, NULL);
+        else
+          vk_fido_send_key_agreement(cid);
 
       } else if (subcmd == 0x03) { // setPIN
         // Requires keyAgreement, pinAuth, newPinEnc - simplified stub
         if (!pin_key_generated) {
           vk_fido_send_response(cid, U2FHID_MSG,
                                 (uint8_t[]){CTAP_ERR_MISSING_PARAM}, 1);
+        } else if (vk_job_busy()) {
+          // The PIN hash goes to flash, which waits for unlock/setup
+          vk_fido_send_response(cid, U2FHID_ERROR,
+                                (uint8_t[]){CTAPHID_ERR_CHANNEL_BUSY}, 1);
         } else {
           // In a real implementation: ECDH with platform key, decrypt
           // newPinEnc, verify pinAuth, hash and store PIN For now, mark PIN as
@@ -350,9 +661,11 @@ static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
         } else if (!pin_key_generated) {
           vk_fido_send_response(cid, U2FHID_MSG,
                                 (uint8_t[]){CTAP_ERR_MISSING_PARAM}, 1);
+        } else if (!vk_crypto_get_random(pin_token, 32)) {
+          // A random pinToken for this session; none if the TRNG has failed
+          vk_fido_send_response(cid, U2FHID_MSG, (uint8_t[]){CTAP_ERR_OTHER},
+                                1);
         } else {
-          // Generate a random pinToken for this session
-          vk_crypto_get_random(pin_token, 32);
           // In real impl: encrypt pinToken with shared secret
           // For now, return raw (INSECURE - demo only)
           uint8_t res[48];
@@ -375,9 +688,47 @@ static void vk_fido_dispatch_ctap2(uint32_t cid, uint8_t *payload,
     }
   } else
     vk_fido_send_response(cid, U2FHID_ERROR, (uint8_t[]){0x01}, 1);
+  vk_arena_release(VK_ARENA_FIDO, ctap_cmd);
 }
 
 // --- Transport Layer ---
+//
+// Reports go through two SPSC rings (vk_spsc.h). tud_hid_set_report_cb only
+// queues what arrives, with vk_fido_receive; vk_fido_task hands it to
+// vk_fido_handle_report from the main loop and sends queued responses a
+// report at a time as the endpoint frees up, so nothing here waits on USB.
+
+#define VK_FIDO_REPORT 64
+#ifndef VK_FIDO_RX_REPORTS
+#define VK_FIDO_RX_REPORTS 16
+#endif
+#ifndef VK_FIDO_TX_REPORTS
+#define VK_FIDO_TX_REPORTS 32
+#endif
+
+_Static_assert((VK_FIDO_RX_REPORTS & (VK_FIDO_RX_REPORTS - 1)) == 0,
+               "VK_FIDO_RX_REPORTS must be a power of two");
+_Static_assert((VK_FIDO_TX_REPORTS & (VK_FIDO_TX_REPORTS - 1)) == 0,
+               "VK_FIDO_TX_REPORTS must be a power of two");
+
+// Reports carrying a message of len bytes: init (57) then continuations (59)
+#define VK_FIDO_MSG_REPORTS(len)                                               \
+  (1u + ((len) > 57 ? ((len) - 57 + 58) / 59 : 0))
+
+static uint8_t fido_rx_buf[VK_FIDO_RX_REPORTS][VK_FIDO_REPORT];
+static uint8_t fido_tx_buf[VK_FIDO_TX_REPORTS][VK_FIDO_REPORT];
+static vk_spsc_t fido_rx =
+    VK_SPSC_INIT(fido_rx_buf, VK_FIDO_REPORT, VK_FIDO_RX_REPORTS);
+static vk_spsc_t fido_tx =
+    VK_SPSC_INIT(fido_tx_buf, VK_FIDO_REPORT, VK_FIDO_TX_REPORTS);
+
+_Static_assert(VK_FIDO_MSG_REPORTS(sizeof(fido_ctx.buffer)) <=
+                   VK_FIDO_TX_REPORTS,
+               "a full-length response must fit the HID outbox");
+
+bool vk_fido_receive(uint8_t const *report) {
+  return vk_spsc_push(&fido_rx, report, VK_FIDO_REPORT);
+}
 
 void vk_fido_handle_report(uint8_t const *report) {
   uint32_t cid;
@@ -398,6 +749,15 @@ void vk_fido_handle_report(uint8_t const *report) {
                             sizeof(resp));
       return;
     }
+    if (cmd == (CTAPHID_CANCEL & 0x7F)) {
+      // No response of its own: the cancelled request answers with
+      // CTAP2_ERR_KEEPALIVE_CANCEL
+      if (cid == fido_job.cid && fido_job.awaiting_presence)
+        fido_job.job.cancel = true;
+      else if (cid == fido_job.cid)
+        vk_job_cancel(&fido_job.job);
+      return;
+    }
     if (cmd == (U2FHID_PING & 0x7F)) {
       vk_fido_send_response(cid, U2FHID_PING, &report[7], len > 57 ? 57 : len);
     } else if (cmd == (U2FHID_MSG & 0x7F)) {
@@ -431,9 +791,14 @@ void vk_fido_handle_report(uint8_t const *report) {
   }
 }
 
+// Queues the whole response or, if the outbox cannot take all of it,
+// nothing: half a message would leave the platform waiting
 void vk_fido_send_response(uint32_t cid, uint8_t cmd, uint8_t const *data,
                            uint16_t len) {
-  uint8_t report[64] = {0};
+  if (vk_spsc_free(&fido_tx) < VK_FIDO_MSG_REPORTS(len))
+    return;
+  uint8_t *report = vk_spsc_claim(&fido_tx);
+  memset(report, 0, VK_FIDO_REPORT);
   memcpy(report, &cid, 4);
   report[4] = cmd | 0x80;
   report[5] = (uint8_t)(len >> 8);
@@ -441,18 +806,38 @@ void vk_fido_send_response(uint32_t cid, uint8_t cmd, uint8_t const *data,
   size_t sent = len > 57 ? 57 : len;
   if (data)
     memcpy(&report[7], data, sent);
-  tud_hid_n_report(FIDO_ITF_INDEX, 0, report, 64);
+  vk_spsc_publish(&fido_tx);
   uint8_t seq = 0;
   while (sent < len) {
-    memset(report, 0, 64);
+    report = vk_spsc_claim(&fido_tx);
+    memset(report, 0, VK_FIDO_REPORT);
     memcpy(report, &cid, 4);
     report[4] = seq++;
     size_t to_send = (len - sent) > 59 ? 59 : (len - sent);
     memcpy(&report[5], data + sent, to_send);
     sent += to_send;
-    while (!tud_hid_n_ready(FIDO_ITF_INDEX)) {
-      tud_task();
-    }
-    tud_hid_n_report(FIDO_ITF_INDEX, 0, report, 64);
+    vk_spsc_publish(&fido_tx);
   }
 }
+
+void vk_fido_task(uint32_t now_ms) {
+  const uint8_t *report;
+  // A request is only taken once any reply to it is sure to fit
+  while (vk_spsc_free(&fido_tx) >=
+             VK_FIDO_MSG_REPORTS(sizeof(fido_ctx.buffer)) &&
+         (report = vk_spsc_peek(&fido_rx)) != NULL) {
+    vault_update_activity();
+    vk_fido_handle_report(report);
+    vk_spsc_release(&fido_rx);
+  }
+
+  if (fido_job.awaiting_presence)
+    vk_fido_presence_task(now_ms);
+
+  // The endpoint takes one report per transfer; the rest wait for later
+  // passes
+  while ((report = vk_spsc_peek(&fido_tx)) != NULL &&
+         tud_hid_n_ready(FIDO_ITF_INDEX) &&
+         tud_hid_n_report(FIDO_ITF_INDEX, 0, report, VK_FIDO_REPORT))
+    vk_spsc_release(&fido_tx);
+}
@@ -0,0 +1,42 @@
+#include "vk_job.h"
+#include <stddef.h>
+
+static vk_job_t *current_job;
+
+bool vk_job_start(vk_job_t *job, uint32_t now_ms) {
+  if (current_job || !job || !job->step || !job->finish)
+    return false;
+  job->percent = 0;
+  job->last_notify_ms = now_ms;
+  job->cancel = false;
+  current_job = job;
+  return true;
+}
+
+void vk_job_cancel(vk_job_t *job) {
+  if (job && job == current_job)
+    job->cancel = true;
+}
+
+bool vk_job_busy(void) { return current_job != NULL; }
+
+void vk_job_task(uint32_t now_ms) {
+  vk_job_t *job = current_job;
+  if (!job)
+    return;
+
+  vk_job_status_t status =
+      job->cancel ? VK_JOB_CANCELLED : job->step(job);
+
+  if (status == VK_JOB_MORE) {
+    if (job->notify && now_ms - job->last_notify_ms >= VK_JOB_NOTIFY_MS) {
+      job->last_notify_ms = now_ms;
+      job->notify(job);
+    }
+    return;
+  }
+
+  // Free the slot first so finish may start a follow-up job
+  current_job = NULL;
+  job->finish(job, status);
+}
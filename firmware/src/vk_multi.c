@@ -0,0 +1,175 @@
+#include "vk_multi.h"
+#include "cb0r.h"
+#include "vault.h"
+#include "vk_crypto.h"
+#include <string.h>
+
+// Text errors an entry carries in place of its secret
+typedef enum {
+  VK_MULTI_NOT_FOUND,
+  VK_MULTI_FAIL,      // Stored but would not decrypt
+  VK_MULTI_TOO_LONG,  // Name longer than any stored one can be
+  VK_MULTI_MALFORMED, // Name runs past the end of the request
+} vk_multi_error_t;
+
+static const char *const vk_multi_errors[] = {"NOT_FOUND", "FAIL", "TOO_LONG",
+                                              "MALFORMED"};
+
+// Entries a request asks for, in order: the names in the request or the
+// vault's own from a slot on
+typedef struct {
+  const vk_packet_t *packet;
+  int pos;   // Offset of the next name in the payload, or the vault slot
+  int taken; // Entries walked so far
+  // The current entry: its name as given, and an error if it cannot be
+  // looked up at all (-1 if it can)
+  const char *name;
+  uint8_t name_len;
+  int error;
+} vk_multi_t;
+
+static bool vk_multi_next(vk_multi_t *it) {
+  const vk_packet_t *packet = it->packet;
+  it->error = -1;
+  if (packet->payload[0] == VK_MULTI_CURSOR) {
+    it->name = vault_next_name(&it->pos);
+    if (!it->name)
+      return false;
+    const char *end = memchr(it->name, '\0', ENTRY_NAME_MAX - 1);
+    it->name_len = (uint8_t)(end ? end - it->name : ENTRY_NAME_MAX - 1);
+  } else {
+    if (it->pos >= packet->payload_len)
+      return false;
+    uint8_t name_len = packet->payload[it->pos];
+    it->name = (const char *)&packet->payload[it->pos + 1];
+    if (it->pos + 1 + name_len > packet->payload_len) {
+      // Whatever is left is the name; nothing can follow it
+      it->name_len = (uint8_t)(packet->payload_len - it->pos - 1);
+      it->error = VK_MULTI_MALFORMED;
+      it->pos = packet->payload_len;
+    } else {
+      it->name_len = name_len;
+      if (name_len >= ENTRY_NAME_MAX)
+        it->error = VK_MULTI_TOO_LONG;
+      it->pos += 1 + name_len;
+    }
+  }
+  it->taken++;
+  return true;
+}
+
+// Size of a CBOR head, or writes it to the open response
+static uint8_t vk_multi_cbor_size(cb0r_e type, uint32_t value) {
+  uint8_t head[9];
+  return cb0r_write(head, type, value);
+}
+
+static void vk_multi_cbor_put(cb0r_e type, uint32_t value) {
+  uint8_t head[9];
+  vk_protocol_write(head, cb0r_write(head, type, value));
+}
+
+// Decrypts the current entry into secret; returns its error, or -1 if
+// there is none
+static int vk_multi_lookup(const vk_multi_t *it, char name[ENTRY_NAME_MAX],
+                           uint8_t secret[ENTRY_SECRET_MAX],
+                           uint16_t *secret_len) {
+  if (it->error >= 0)
+    return it->error;
+  memcpy(name, it->name, it->name_len);
+  name[it->name_len] = '\0';
+  if (vault_get_decrypted(name, secret, secret_len))
+    return -1;
+  vault_entry_t entry;
+  return vault_get(name, &entry) ? VK_MULTI_FAIL : VK_MULTI_NOT_FOUND;
+}
+
+static void vk_multi_status(const vk_packet_t *packet, vk_msg_type_t type,
+                            const char *status) {
+  vk_protocol_send(type, packet->id, (const uint8_t *)status,
+                   (uint16_t)strlen(status));
+}
+
+void vk_multi_get(const vk_packet_t *packet, uint16_t payload_max) {
+  // CBOR [Next, [* [Name, Secret / Error]]]: a byte string secret, or a text
+  // error in its place when that entry failed, so one bad name costs only its
+  // own entry. Next is where to carry on once the payload is full (the slot,
+  // or how many names were answered) and null when all were.
+  if (packet->payload_len < 1 ||
+      (packet->payload[0] != VK_MULTI_NAMES &&
+       packet->payload[0] != VK_MULTI_CURSOR) ||
+      (packet->payload[0] == VK_MULTI_CURSOR && packet->payload_len != 3)) {
+    vk_multi_status(packet, VK_MSG_VAULT_GET_MULTI_RES, "FAIL");
+    return;
+  }
+  if (!vault_get_session_key()) {
+    vk_multi_status(packet, VK_MSG_ERROR, "LOCKED");
+    return;
+  }
+  vk_multi_t it = {.packet = packet, .pos = 1};
+  if (packet->payload[0] == VK_MULTI_CURSOR)
+    it.pos = packet->payload[1] | packet->payload[2] << 8;
+
+  // First pass sizes the payload, since the header carries its length; the
+  // second looks every entry up again and streams it. Nothing is held
+  // between them, so a reply is not bounded by any buffer.
+  char name[ENTRY_NAME_MAX];
+  uint8_t secret[ENTRY_SECRET_MAX];
+  vk_multi_t start = it, stop;
+  uint32_t len = 0;
+  int count = 0;
+  bool more = true;
+  for (;;) {
+    stop = it;
+    if (!vk_multi_next(&it)) {
+      more = false;
+      break;
+    }
+    uint16_t secret_len = 0;
+    int error = vk_multi_lookup(&it, name, secret, &secret_len);
+    uint16_t vlen =
+        error < 0 ? secret_len : (uint16_t)strlen(vk_multi_errors[error]);
+    uint32_t entry_len =
+        1 + vk_multi_cbor_size(CB0R_UTF8, it.name_len) + it.name_len +
+        vk_multi_cbor_size(error < 0 ? CB0R_BYTE : CB0R_UTF8, vlen) + vlen;
+    // Room for the outer array, Next and the entry array heads
+    if (len + entry_len + 1 + 3 + 3 > payload_max) {
+      it = stop;
+      break;
+    }
+    len += entry_len;
+    count++;
+  }
+
+  uint32_t next = packet->payload[0] == VK_MULTI_CURSOR ? (uint32_t)it.pos
+                                                        : (uint32_t)it.taken;
+  len += 1 + (more ? vk_multi_cbor_size(CB0R_INT, next) : 1) +
+         vk_multi_cbor_size(CB0R_ARRAY, count);
+  if (!vk_protocol_begin(VK_MSG_VAULT_GET_MULTI_RES, packet->id,
+                         (uint16_t)len)) {
+    vk_crypto_zeroize(secret, sizeof(secret));
+    return;
+  }
+  vk_multi_cbor_put(CB0R_ARRAY, 2);
+  vk_multi_cbor_put(more ? CB0R_INT : CB0R_NULL, more ? next : 0);
+  vk_multi_cbor_put(CB0R_ARRAY, count);
+
+  it = start;
+  while (count-- > 0 && vk_multi_next(&it)) {
+    uint16_t secret_len = 0;
+    int error = vk_multi_lookup(&it, name, secret, &secret_len);
+    vk_multi_cbor_put(CB0R_ARRAY, 2);
+    vk_multi_cbor_put(CB0R_UTF8, it.name_len);
+    vk_protocol_write((const uint8_t *)it.name, it.name_len);
+    if (error >= 0) {
+      const char *text = vk_multi_errors[error];
+      vk_multi_cbor_put(CB0R_UTF8, strlen(text));
+      vk_protocol_write((const uint8_t *)text, (uint16_t)strlen(text));
+    } else {
+      vk_multi_cbor_put(CB0R_BYTE, secret_len);
+      vk_protocol_write(secret, secret_len);
+    }
+  }
+  vk_crypto_zeroize(secret, sizeof(secret));
+  vk_protocol_end();
+}
@@ -0,0 +1,106 @@
+#include "vk_pool.h"
+#include "p256-m.h"
+#include "tweetnacl.h"
+#include "vault.h"
+#include "vk_crypto.h"
+#include "vk_job.h"
+#include <string.h>
+
+typedef struct {
+  uint8_t sk[64]; // tweetnacl layout: the seed, then the public key
+  bool ready;
+} pool_ed25519_t;
+
+typedef struct {
+  uint8_t priv[32];
+  uint8_t pub[64];
+  bool ready;
+} pool_p256_t;
+
+static pool_ed25519_t pool_ed25519[VK_POOL_ED25519];
+static pool_p256_t pool_p256[VK_POOL_P256];
+
+// The refill in progress, if any: which slot and its resumable job
+static struct {
+  union {
+    crypto_sign_ed25519_tweet_job ed25519;
+    p256_keypair_job p256;
+  } op;
+  pool_ed25519_t *ed25519;
+  pool_p256_t *p256;
+} fill;
+
+static void vk_pool_fill_start(void) {
+  for (int i = 0; i < VK_POOL_ED25519; i++) {
+    if (!pool_ed25519[i].ready) {
+      if (!vk_crypto_get_random(pool_ed25519[i].sk, 32))
+        return;
+      fill.ed25519 = &pool_ed25519[i];
+      crypto_sign_ed25519_tweet_keypair_start(
+          &fill.op.ed25519, fill.ed25519->sk + 32, fill.ed25519->sk);
+      return;
+    }
+  }
+  for (int i = 0; i < VK_POOL_P256; i++) {
+    if (!pool_p256[i].ready) {
+      if (p256_gen_keypair_start(&fill.op.p256, pool_p256[i].priv,
+                                 pool_p256[i].pub) == P256_SUCCESS)
+        fill.p256 = &pool_p256[i];
+      return;
+    }
+  }
+}
+
+void vk_pool_task(void) {
+  // Requests come first, and keys made while locked would outlive the lock
+  if (vk_job_busy() || !vault_has_session_key())
+    return;
+
+  if (!fill.ed25519 && !fill.p256) {
+    vk_pool_fill_start();
+    return;
+  }
+
+  if (fill.ed25519) {
+    if (crypto_sign_ed25519_tweet_step(&fill.op.ed25519, VK_JOB_ED25519_STEPS))
+      return;
+    fill.ed25519->ready = true;
+  } else {
+    if (p256_gen_keypair_step(&fill.op.p256, VK_JOB_P256_STEPS) ==
+        P256_PENDING)
+      return;
+    fill.p256->ready = true;
+  }
+  vk_crypto_zeroize(&fill, sizeof(fill));
+}
+
+bool vk_pool_take_ed25519(uint8_t seed[32], uint8_t pk[32]) {
+  for (int i = 0; i < VK_POOL_ED25519; i++) {
+    if (pool_ed25519[i].ready) {
+      memcpy(seed, pool_ed25519[i].sk, 32);
+      memcpy(pk, pool_ed25519[i].sk + 32, 32);
+      vk_crypto_zeroize(&pool_ed25519[i], sizeof(pool_ed25519[i]));
+      return true;
+    }
+  }
+  return false;
+}
+
+bool vk_pool_take_p256(uint8_t priv[32], uint8_t pub[64]) {
+  for (int i = 0; i < VK_POOL_P256; i++) {
+    if (pool_p256[i].ready) {
+      memcpy(priv, pool_p256[i].priv, 32);
+      memcpy(pub, pool_p256[i].pub, 64);
+      vk_crypto_zeroize(&pool_p256[i], sizeof(pool_p256[i]));
+      return true;
+    }
+  }
+  return false;
+}
+
+void vk_pool_wipe(void) {
+  // The jobs' state is plain data, wiping it is the abort
+  vk_crypto_zeroize(&fill, sizeof(fill));
+  vk_crypto_zeroize(pool_ed25519, sizeof(pool_ed25519));
+  vk_crypto_zeroize(pool_p256, sizeof(pool_p256));
+}
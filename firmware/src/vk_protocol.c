@@ -1,45 +1,408 @@
 #include "vk_protocol.h"
+#include "cb0r.h"
+#include "vk_spsc.h"
 #include <string.h>
 
-// Minimal CBOR helper functions could go here
-// For Phase 2, we implement a skeletal parser that recognizes the basic
-// structure
+// Every message is one CBOR map (protocol/v1/schema.cddl):
+//   {"v": 1, "type": uint, "payload": bstr, ? "id": uint}
+// cb0r decodes the fields in place, but trusts the lengths it reads, so a
+// frame is first measured here with bounds checks. Measuring also tells a
+// frame cut short by the end of a CDC read from a complete one.
 
-void vk_protocol_init(void) {
-  // Initialize any state (e.g., auth status)
+typedef enum { VK_CBOR_OK, VK_CBOR_MORE, VK_CBOR_BAD } vk_cbor_status_t;
+
+// Nesting accepted inside a message
+#define VK_CBOR_DEPTH 4
+
+#define VK_RX_MASK (VK_PROTO_RX_RING - 1)
+#define VK_TX_MASK (VK_PROTO_TX_RING - 1)
+
+_Static_assert((VK_PROTO_RX_RING & VK_RX_MASK) == 0,
+               "VK_PROTO_RX_RING must be a power of two");
+_Static_assert((VK_PROTO_TX_RING & VK_TX_MASK) == 0,
+               "VK_PROTO_TX_RING must be a power of two");
+
+// Reads the head of the item at p: major type, argument and head size.
+// Indefinite lengths are not used by either side and are rejected.
+static vk_cbor_status_t vk_cbor_head(const uint8_t *p, uint32_t avail,
+                                     uint8_t *major, uint64_t *arg,
+                                     uint32_t *head) {
+  if (avail < 1)
+    return VK_CBOR_MORE;
+  uint8_t info = p[0] & 0x1f;
+  *major = p[0] >> 5;
+  if (info < 24) {
+    *arg = info;
+    *head = 1;
+    return VK_CBOR_OK;
+  }
+  if (info > 27)
+    return VK_CBOR_BAD;
+  *head = 1 + (1u << (info - 24));
+  if (avail < *head)
+    return VK_CBOR_MORE;
+  *arg = 0;
+  for (uint32_t i = 1; i < *head; i++)
+    *arg = *arg << 8 | p[i];
+  return VK_CBOR_OK;
+}
+
+// Length of the whole item at p
+static vk_cbor_status_t vk_cbor_measure(const uint8_t *p, uint32_t avail,
+                                        int depth, uint32_t *len) {
+  uint8_t major;
+  uint64_t arg;
+  uint32_t head, n;
+  vk_cbor_status_t status = vk_cbor_head(p, avail, &major, &arg, &head);
+  if (status != VK_CBOR_OK)
+    return status;
+
+  switch (major) {
+  case 2: // byte string
+  case 3: // text string
+    if (arg > VK_PROTO_FRAME_MAX)
+      return VK_CBOR_BAD;
+    if (avail - head < arg)
+      return VK_CBOR_MORE;
+    *len = head + (uint32_t)arg;
+    return VK_CBOR_OK;
+  case 4: // array
+  case 5: // map
+    if (depth == 0 || arg > VK_PROTO_FRAME_MAX)
+      return VK_CBOR_BAD;
+    if (major == 5)
+      arg *= 2;
+    for (uint64_t i = 0; i < arg; i++) {
+      status = vk_cbor_measure(p + head, avail - head, depth - 1, &n);
+      if (status != VK_CBOR_OK)
+        return status;
+      head += n;
+    }
+    *len = head;
+    return VK_CBOR_OK;
+  case 6: // tag, then the tagged item
+    if (depth == 0)
+      return VK_CBOR_BAD;
+    status = vk_cbor_measure(p + head, avail - head, depth - 1, &n);
+    if (status != VK_CBOR_OK)
+      return status;
+    *len = head + n;
+    return VK_CBOR_OK;
+  default: // integers, simple values, floats
+    *len = head;
+    return VK_CBOR_OK;
+  }
+}
+
+static bool vk_protocol_field(cb0r_t map, const char *key, cb0r_e type,
+                              cb0r_t out) {
+  return cb0r_find(map, CB0R_UTF8, strlen(key), (uint8_t *)key, out) &&
+         out->type == type;
+}
+
+// Decodes a frame already measured to be one complete item
+static bool vk_protocol_decode(uint8_t *frame, uint32_t len,
+                               vk_packet_t *out_packet) {
+  cb0r_s map, v, type, payload, id;
+  if (!cb0r_read(frame, len, &map) || map.type != CB0R_MAP)
+    return false;
+  if (!vk_protocol_field(&map, "v", CB0R_INT, &v) ||
+      v.value != VK_PROTO_VERSION)
+    return false;
+  if (!vk_protocol_field(&map, "type", CB0R_INT, &type) || type.value > 255)
+    return false;
+  if (!vk_protocol_field(&map, "payload", CB0R_BYTE, &payload))
+    return false;
+
+  out_packet->id = 0;
+  if (cb0r_find(&map, CB0R_UTF8, 2, (uint8_t *)"id", &id)) {
+    if (id.type != CB0R_INT || id.value > UINT32_MAX)
+      return false;
+    out_packet->id = (uint32_t)id.value;
+  }
+  out_packet->version = (uint8_t)v.value;
+  out_packet->type = (vk_msg_type_t)type.value;
+  out_packet->payload = cb0r_value(&payload);
+  out_packet->payload_len = (uint16_t)cb0r_vlen(&payload);
+  return true;
 }
 
 bool vk_protocol_parse(const uint8_t *data, uint16_t len,
                        vk_packet_t *out_packet) {
-  if (len < 3)
+  uint32_t frame_len;
+  if (vk_cbor_measure(data, len, VK_CBOR_DEPTH, &frame_len) != VK_CBOR_OK ||
+      frame_len != len)
     return false;
+  // cb0r only reads through its pointers
+  return vk_protocol_decode((uint8_t *)data, len, out_packet);
+}
+
+// --- Receive ring ---
+//
+// Bytes sit in the ring from the CDC read until the request they belong to
+// has been handled, so handlers get pointers into it rather than copies. A
+// frame that runs past the end of the ring continues in a copy of the ring's
+// first bytes placed after it, and is decoded in one piece from there.
+//
+// The ring is single-producer / single-consumer (vk_spsc.h): only the CDC
+// side moves head and only vk_protocol_rx_next moves tail, so the two may
+// run in different contexts. The rest of the state belongs to the consumer.
 
-  // VERY minimal "CBOR-like" parser for initial development
-  // In a real implementation, this would use a proper CBOR library (e.g. QCBOR)
+static struct {
+  uint8_t buf[VK_PROTO_RX_RING + VK_PROTO_FRAME_MAX];
+  uint32_t head;     // bytes written, free-running
+  uint32_t tail;     // bytes consumed, free-running
+  uint32_t handed;   // length of the frame rx_next returned last
+  uint32_t scanned;  // bytes of the frame at tail measured so far
+  uint32_t items;    // its map keys and values still to measure
+  uint32_t mirrored; // bytes of the ring start copied past its end
+} rx;
 
-  // For now, let's assume a simplified framing:
-  // [Version:1][Type:1][ID:4][PayloadLen:2][Payload:...]
+uint8_t *vk_protocol_rx_buffer(uint32_t *space) {
+  uint32_t at = rx.head & VK_RX_MASK;
+  uint32_t free = VK_PROTO_RX_RING - (rx.head - VK_SPSC_LOAD(rx.tail));
+  *space = free < VK_PROTO_RX_RING - at ? free : VK_PROTO_RX_RING - at;
+  return *space ? &rx.buf[at] : NULL;
+}
 
-  out_packet->version = data[0];
-  out_packet->type = (vk_msg_type_t)data[1];
+void vk_protocol_rx_commit(uint32_t len) {
+  VK_SPSC_STORE(rx.head, rx.head + len);
+}
 
-  // TODO: Implement actual CBOR decoding logic here
-  // This is a placeholder for Phase 2 implementation.
+static void vk_protocol_rx_drop(uint32_t len) {
+  VK_SPSC_STORE(rx.tail, rx.tail + len);
+  rx.scanned = rx.items = rx.mirrored = 0;
+}
 
-  return true;
+// Measures the frame at tail, picking up where the last call stopped: each
+// key and value is measured once, when it has arrived in full
+static vk_cbor_status_t vk_protocol_rx_measure(const uint8_t *frame,
+                                               uint32_t avail, uint32_t *len) {
+  vk_cbor_status_t status;
+  if (rx.scanned == 0) {
+    uint8_t major;
+    uint64_t arg;
+    uint32_t head;
+    status = vk_cbor_head(frame, avail, &major, &arg, &head);
+    if (status != VK_CBOR_OK)
+      return status;
+    if (major != 5 || arg > 16)
+      return VK_CBOR_BAD;
+    rx.scanned = head;
+    rx.items = (uint32_t)arg * 2;
+  }
+  while (rx.items) {
+    uint32_t n;
+    status = vk_cbor_measure(frame + rx.scanned, avail - rx.scanned,
+                             VK_CBOR_DEPTH, &n);
+    if (status != VK_CBOR_OK)
+      return status;
+    rx.scanned += n;
+    rx.items--;
+  }
+  *len = rx.scanned;
+  return VK_CBOR_OK;
+}
+
+bool vk_protocol_rx_next(vk_packet_t *out_packet) {
+  // The caller is done with the previous request
+  if (rx.handed) {
+    vk_protocol_rx_drop(rx.handed);
+    rx.handed = 0;
+  }
+
+  uint32_t head;
+  while ((head = VK_SPSC_LOAD(rx.head)) != rx.tail) {
+    uint32_t avail = head - rx.tail;
+    uint32_t window = avail < VK_PROTO_FRAME_MAX ? avail : VK_PROTO_FRAME_MAX;
+    uint32_t at = rx.tail & VK_RX_MASK;
+    uint8_t *frame = &rx.buf[at];
+    uint32_t len;
+
+    if (at + window > VK_PROTO_RX_RING + rx.mirrored) {
+      uint32_t upto = at + window - VK_PROTO_RX_RING;
+      memcpy(&rx.buf[VK_PROTO_RX_RING + rx.mirrored], &rx.buf[rx.mirrored],
+             upto - rx.mirrored);
+      rx.mirrored = upto;
+    }
+
+    vk_cbor_status_t status = vk_protocol_rx_measure(frame, window, &len);
+    if (status == VK_CBOR_MORE && window < VK_PROTO_FRAME_MAX)
+      return false; // rest still to come
+    if (status == VK_CBOR_OK && vk_protocol_decode(frame, len, out_packet)) {
+      rx.handed = len;
+      return true;
+    }
+    // Well-formed but not a vk_message: skip it. Anything else (garbage,
+    // a frame too long to ever fit): resynchronise a byte further on.
+    vk_protocol_rx_drop(status == VK_CBOR_OK ? len : 1);
+  }
+  return false;
+}
+
+// --- Responses ---
+
+static uint8_t vk_protocol_put_key(uint8_t *out, const char *key) {
+  uint8_t len = (uint8_t)strlen(key);
+  uint8_t head = cb0r_write(out, CB0R_UTF8, len);
+  memcpy(out + head, key, len);
+  return head + len;
+}
+
+// The payload goes last, so everything before it is a header of at most
+// VK_PROTO_OVERHEAD bytes that depends only on its length
+static uint8_t vk_protocol_header(vk_msg_type_t type, uint32_t id,
+                                  uint16_t payload_len, uint8_t *out) {
+  uint8_t *p = out;
+  p += cb0r_write(p, CB0R_MAP, 4);
+  p += vk_protocol_put_key(p, "v");
+  p += cb0r_write(p, CB0R_INT, VK_PROTO_VERSION);
+  p += vk_protocol_put_key(p, "type");
+  p += cb0r_write(p, CB0R_INT, (uint8_t)type);
+  p += vk_protocol_put_key(p, "id");
+  p += cb0r_write(p, CB0R_INT, id);
+  p += vk_protocol_put_key(p, "payload");
+  p += cb0r_write(p, CB0R_BYTE, payload_len);
+  return (uint8_t)(p - out);
 }
 
 uint16_t vk_protocol_create_packet(vk_msg_type_t type, uint32_t id,
                                    const uint8_t *payload, uint16_t payload_len,
                                    uint8_t *out_buf, uint16_t max_len) {
-  // Placeholder for CBOR encoding
-  if (max_len < (payload_len + 8))
+  if (max_len < payload_len + VK_PROTO_OVERHEAD)
     return 0;
+  uint8_t head = vk_protocol_header(type, id, payload_len, out_buf);
+  memcpy(out_buf + head, payload, payload_len);
+  return head + payload_len;
+}
+
+// --- Outbox ---
+//
+// Single-producer / single-consumer like the receive ring. The sink is
+// only called from the producer side, and only while the outbox is empty,
+// so bytes reach it in order. A write waiting for room drains the outbox
+// into the sink itself; it then acts as the consumer, so the wait hook must
+// run in the same context as the producer (the main loop on the device).
+
+static struct {
+  uint8_t buf[VK_PROTO_TX_RING];
+  uint32_t head; // bytes queued, free-running
+  uint32_t tail; // bytes taken by the CDC FIFO, free-running
+  uint16_t open; // payload bytes the open response still expects
+  bool lost;     // the wait hook gave up on part of the open response
+  vk_protocol_sink_t sink;
+  vk_protocol_wait_t wait;
+} tx;
+
+// Copies data in at pos (free-running); returns the position after it
+static uint32_t vk_protocol_tx_put(uint32_t pos, const uint8_t *data,
+                                   uint32_t len) {
+  uint32_t at = pos & VK_TX_MASK;
+  uint32_t first = len < VK_PROTO_TX_RING - at ? len : VK_PROTO_TX_RING - at;
+  memcpy(&tx.buf[at], data, first);
+  memcpy(tx.buf, data + first, len - first);
+  return pos + len;
+}
+
+uint32_t vk_protocol_tx_space(void) {
+  return VK_PROTO_TX_RING - (tx.head - VK_SPSC_LOAD(tx.tail));
+}
+
+void vk_protocol_set_sink(vk_protocol_sink_t sink) { tx.sink = sink; }
+
+void vk_protocol_set_wait(vk_protocol_wait_t wait) { tx.wait = wait; }
+
+// Moves queued bytes into the sink as far as it takes them
+static uint32_t vk_protocol_tx_drain(void) {
+  const uint8_t *data;
+  uint32_t len, moved = 0;
+  while (tx.sink && (len = vk_protocol_tx_peek(&data)) != 0) {
+    uint32_t taken = tx.sink(data, len);
+    vk_protocol_tx_consume(taken);
+    moved += taken;
+    if (taken < len)
+      break;
+  }
+  return moved;
+}
+
+static void vk_protocol_tx_write(const uint8_t *data, uint32_t len) {
+  uint32_t rounds = 0;
+  while (len && !tx.lost) {
+    uint32_t moved = 0;
+    if (tx.sink && tx.head == VK_SPSC_LOAD(tx.tail)) {
+      moved = tx.sink(data, len);
+      data += moved;
+      len -= moved;
+    }
+    uint32_t room = vk_protocol_tx_space();
+    uint32_t n = len < room ? len : room;
+    if (n)
+      VK_SPSC_STORE(tx.head, vk_protocol_tx_put(tx.head, data, n));
+    data += n;
+    len -= n;
+    if (!len)
+      break;
 
-  out_buf[0] = VK_PROTO_VERSION;
-  out_buf[1] = (uint8_t)type;
-  // ... encode ID and length ...
-  memcpy(&out_buf[8], payload, payload_len);
+    // Full: let the sink make progress, then move the oldest bytes on
+    if (moved)
+      rounds = 0;
+    if (!tx.wait || !tx.wait(rounds++)) {
+      tx.lost = true;
+      break;
+    }
+    if (vk_protocol_tx_drain())
+      rounds = 0;
+  }
+}
 
-  return payload_len + 8;
+bool vk_protocol_begin(vk_msg_type_t type, uint32_t id, uint16_t payload_len) {
+  uint8_t header[VK_PROTO_OVERHEAD];
+  if (tx.open)
+    return false;
+  uint8_t head = vk_protocol_header(type, id, payload_len, header);
+  tx.lost = false;
+  vk_protocol_tx_write(header, head);
+  tx.open = payload_len;
+  return true;
+}
+
+void vk_protocol_write(const uint8_t *data, uint16_t len) {
+  if (len > tx.open)
+    len = tx.open;
+  tx.open -= len;
+  vk_protocol_tx_write(data, len);
+}
+
+bool vk_protocol_end(void) {
+  static const uint8_t zeros[16];
+  bool whole = tx.open == 0;
+  while (tx.open)
+    vk_protocol_write(zeros,
+                      tx.open < sizeof(zeros) ? tx.open : sizeof(zeros));
+  return whole && !tx.lost;
+}
+
+bool vk_protocol_send(vk_msg_type_t type, uint32_t id, const uint8_t *payload,
+                      uint16_t payload_len) {
+  if (!vk_protocol_begin(type, id, payload_len))
+    return false;
+  vk_protocol_write(payload, payload_len);
+  return vk_protocol_end();
+}
+
+uint32_t vk_protocol_tx_peek(const uint8_t **data) {
+  uint32_t at = tx.tail & VK_TX_MASK;
+  uint32_t queued = VK_SPSC_LOAD(tx.head) - tx.tail;
+  *data = &tx.buf[at];
+  return queued < VK_PROTO_TX_RING - at ? queued : VK_PROTO_TX_RING - at;
+}
+
+void vk_protocol_tx_consume(uint32_t len) {
+  VK_SPSC_STORE(tx.tail, tx.tail + len);
+}
+
+void vk_protocol_init(void) {
+  memset(&rx, 0, sizeof(rx));
+  memset(&tx, 0, sizeof(tx));
 }
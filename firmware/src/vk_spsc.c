@@ -0,0 +1,34 @@
+#include "vk_spsc.h"
+#include <string.h>
+
+uint8_t *vk_spsc_claim(vk_spsc_t *q) {
+  // The consumer's release of tail orders its last read of the slot before
+  // the producer overwrites it
+  if (q->head - VK_SPSC_LOAD(q->tail) >= q->slots)
+    return NULL;
+  return q->storage + (size_t)(q->head & (q->slots - 1u)) * q->slot_size;
+}
+
+void vk_spsc_publish(vk_spsc_t *q) { VK_SPSC_STORE(q->head, q->head + 1); }
+
+bool vk_spsc_push(vk_spsc_t *q, const void *data, size_t len) {
+  uint8_t *slot = vk_spsc_claim(q);
+  if (!slot || len > q->slot_size)
+    return false;
+  memcpy(slot, data, len);
+  memset(slot + len, 0, q->slot_size - len);
+  vk_spsc_publish(q);
+  return true;
+}
+
+uint32_t vk_spsc_free(vk_spsc_t *q) {
+  return q->slots - (q->head - VK_SPSC_LOAD(q->tail));
+}
+
+const uint8_t *vk_spsc_peek(vk_spsc_t *q) {
+  if (VK_SPSC_LOAD(q->head) == q->tail)
+    return NULL;
+  return q->storage + (size_t)(q->tail & (q->slots - 1u)) * q->slot_size;
+}
+
+void vk_spsc_release(vk_spsc_t *q) { VK_SPSC_STORE(q->tail, q->tail + 1); }
@@ -1,4 +1,5 @@
 #include "vk_totp.h"
+#include "tweetnacl.h"
 #include <string.h>
 
 // SHA1 constants and functions (minimal implementation)
@@ -8,61 +9,85 @@
 // Rotate left macro
 #define ROL(value, bits) (((value) << (bits)) | ((value) >> (32 - (bits))))
 
-static void sha1_transform(uint32_t state[5], const uint8_t buffer[64]) {
-  uint32_t a, b, c, d, e, roll[80];
-  int i;
+static const uint32_t sha1_iv[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE,
+                                    0x10325476, 0xC3D2E1F0};
 
-  for (i = 0; i < 16; i++) {
-    roll[i] = (buffer[i * 4] << 24) | (buffer[i * 4 + 1] << 16) |
-              (buffer[i * 4 + 2] << 8) | (buffer[i * 4 + 3]);
-  }
-  for (i = 16; i < 80; i++) {
-    roll[i] = ROL(roll[i - 3] ^ roll[i - 8] ^ roll[i - 14] ^ roll[i - 16], 1);
-  }
+static uint32_t load_be32(const uint8_t *p) {
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 |
+         p[3];
+}
+
+static void store_be32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+// The message schedule is kept as a 16-word ring: W[i] replaces W[i-16] in
+// place, so the compression needs 64 bytes of schedule instead of 320
+#define SHA1_W(i)                                                              \
+  (w[(i) & 15] = ROL(w[((i) + 13) & 15] ^ w[((i) + 8) & 15] ^                  \
+                         w[((i) + 2) & 15] ^ w[(i) & 15],                      \
+                     1))
+
+#define SHA1_ROUND(f, k, wi)                                                   \
+  do {                                                                         \
+    uint32_t t = ROL(a, 5) + (f) + e + (k) + (wi);                             \
+    e = d;                                                                     \
+    d = c;                                                                     \
+    c = ROL(b, 30);                                                            \
+    b = a;                                                                     \
+    a = t;                                                                     \
+  } while (0)
 
+// One compression over a block given as 16 big-endian words
+static void sha1_compress(uint32_t state[5], const uint32_t block[16]) {
+  uint32_t w[16], a, b, c, d, e;
+  int i;
+
+  memcpy(w, block, sizeof(w));
   a = state[0];
   b = state[1];
   c = state[2];
   d = state[3];
   e = state[4];
 
-  for (i = 0; i < 80; i++) {
-    uint32_t f, k;
-    if (i < 20) {
-      f = (b & c) | ((~b) & d);
-      k = 0x5A827999;
-    } else if (i < 40) {
-      f = b ^ c ^ d;
-      k = 0x6ED9EBA1;
-    } else if (i < 60) {
-      f = (b & c) | (b & d) | (c & d);
-      k = 0x8F1BBCDC;
-    } else {
-      f = b ^ c ^ d;
-      k = 0xCA62C1D6;
-    }
-    uint32_t temp = ROL(a, 5) + f + e + k + roll[i];
-    e = d;
-    d = c;
-    c = ROL(b, 30);
-    b = a;
-    a = temp;
-  }
+  for (i = 0; i < 16; i++)
+    SHA1_ROUND(d ^ (b & (c ^ d)), 0x5A827999, w[i]);
+  for (; i < 20; i++)
+    SHA1_ROUND(d ^ (b & (c ^ d)), 0x5A827999, SHA1_W(i));
+  for (; i < 40; i++)
+    SHA1_ROUND(b ^ c ^ d, 0x6ED9EBA1, SHA1_W(i));
+  for (; i < 60; i++)
+    SHA1_ROUND((b & c) | (d & (b | c)), 0x8F1BBCDC, SHA1_W(i));
+  for (; i < 80; i++)
+    SHA1_ROUND(b ^ c ^ d, 0xCA62C1D6, SHA1_W(i));
 
   state[0] += a;
   state[1] += b;
   state[2] += c;
   state[3] += d;
   state[4] += e;
+  memset(w, 0, sizeof(w));
+}
+
+static void sha1_transform(uint32_t state[5], const uint8_t buffer[64]) {
+  uint32_t w[16];
+  for (int i = 0; i < 16; i++)
+    w[i] = load_be32(buffer + 4 * i);
+  sha1_compress(state, w);
+  memset(w, 0, sizeof(w));
 }
 
+// Only used to shorten HMAC keys longer than a block
 static void sha1(const uint8_t *data, size_t len, uint8_t digest[20]) {
-  uint32_t state[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476,
-                       0xC3D2E1F0};
+  uint32_t state[5];
   uint8_t buffer[64];
   size_t i;
   uint64_t total_bits = (uint64_t)len * 8;
 
+  memcpy(state, sha1_iv, sizeof(state));
   for (i = 0; i + 64 <= len; i += 64) {
     sha1_transform(state, data + i);
   }
@@ -81,60 +106,172 @@ static void sha1(const uint8_t *data, size_t len, uint8_t digest[20]) {
   }
   sha1_transform(state, buffer);
 
-  for (int j = 0; j < 5; j++) {
-    digest[j * 4] = (uint8_t)(state[j] >> 24);
-    digest[j * 4 + 1] = (uint8_t)(state[j] >> 16);
-    digest[j * 4 + 2] = (uint8_t)(state[j] >> 8);
-    digest[j * 4 + 3] = (uint8_t)state[j];
+  for (int j = 0; j < 5; j++)
+    store_be32(digest + 4 * j, state[j]);
+  memset(buffer, 0, sizeof(buffer));
+}
+
+// SHA-512 initial hash value (FIPS 180-4, 5.3.5), as the big-endian bytes
+// crypto_hashblocks works on
+static const uint8_t sha512_iv[64] = {
+    0x6a, 0x09, 0xe6, 0x67, 0xf3, 0xbc, 0xc9, 0x08, 0xbb, 0x67, 0xae,
+    0x85, 0x84, 0xca, 0xa7, 0x3b, 0x3c, 0x6e, 0xf3, 0x72, 0xfe, 0x94,
+    0xf8, 0x2b, 0xa5, 0x4f, 0xf5, 0x3a, 0x5f, 0x1d, 0x36, 0xf1, 0x51,
+    0x0e, 0x52, 0x7f, 0xad, 0xe6, 0x82, 0xd1, 0x9b, 0x05, 0x68, 0x8c,
+    0x2b, 0x3e, 0x6c, 0x1f, 0x1f, 0x83, 0xd9, 0xab, 0xfb, 0x41, 0xbd,
+    0x6b, 0x5b, 0xe0, 0xcd, 0x19, 0x13, 0x7e, 0x21, 0x79};
+
+#define SHA512_BLOCK_SIZE 128
+
+// SHA-1 or SHA-512 midstate after one pad block (key ^ 0x36 or key ^ 0x5C)
+static void vk_totp_pad_state(vk_totp_key_t *k, int outer,
+                              const uint8_t *pad) {
+  switch (k->alg) {
+  case VK_TOTP_SHA1:
+    memcpy(k->mid.sha1[outer], sha1_iv, sizeof(k->mid.sha1[outer]));
+    sha1_transform(k->mid.sha1[outer], pad);
+    break;
+  case VK_TOTP_SHA512:
+    memcpy(k->mid.sha512[outer], sha512_iv, sizeof(sha512_iv));
+    crypto_hashblocks(k->mid.sha512[outer], pad, SHA512_BLOCK_SIZE);
+    break;
   }
 }
 
-static void hmac_sha1(const uint8_t *key, uint16_t key_len, const uint8_t *msg,
-                      uint16_t msg_len, uint8_t mac[20]) {
-  uint8_t k_ipad[64], k_opad[64];
-  uint8_t tk[20];
-  int i;
+bool vk_totp_key_init(vk_totp_key_t *k, vk_totp_alg_t alg, uint8_t digits,
+                      uint16_t period, const uint8_t *key, uint16_t key_len) {
+  uint8_t pad[SHA512_BLOCK_SIZE];
+  uint8_t tk[64];
+  size_t block = alg == VK_TOTP_SHA512 ? SHA512_BLOCK_SIZE : 64;
+  size_t i;
 
-  if (key_len > 64) {
-    sha1(key, key_len, tk);
-    key = tk;
-    key_len = 20;
+  if (alg > VK_TOTP_SHA512 || digits < VK_TOTP_DIGITS_MIN ||
+      digits > VK_TOTP_DIGITS_MAX || period == 0)
+    return false;
+  k->alg = (uint8_t)alg;
+  k->digits = digits;
+  k->period = period;
+
+  // SHA-256 keeps its key schedule in hmac_sha256.c
+  if (alg == VK_TOTP_SHA256) {
+    hmac_sha256_setup(&k->mid.sha256, key, key_len);
+    return true;
   }
 
-  memset(k_ipad, 0x36, 64);
-  memset(k_opad, 0x5C, 64);
-  for (i = 0; i < key_len; i++) {
-    k_ipad[i] ^= key[i];
-    k_opad[i] ^= key[i];
+  // Keys longer than a block are hashed first (RFC 2104)
+  if (key_len > block) {
+    if (alg == VK_TOTP_SHA1) {
+      sha1(key, key_len, tk);
+      key_len = SHA1_DIGEST_SIZE;
+    } else {
+      crypto_hash_sha512_tweet(tk, key, key_len);
+      key_len = 64;
+    }
+    key = tk;
   }
 
-  uint8_t inner_msg[64 + msg_len];
-  memcpy(inner_msg, k_ipad, 64);
-  memcpy(inner_msg + 64, msg, msg_len);
-  uint8_t inner_hash[20];
-  sha1(inner_msg, 64 + msg_len, inner_hash);
+  memset(pad, 0x36, block);
+  for (i = 0; i < key_len; i++)
+    pad[i] ^= key[i];
+  vk_totp_pad_state(k, 0, pad);
+
+  // 0x36 ^ 0x5C turns the inner pad into the outer one
+  for (i = 0; i < block; i++)
+    pad[i] ^= 0x36 ^ 0x5C;
+  vk_totp_pad_state(k, 1, pad);
 
-  uint8_t outer_msg[64 + 20];
-  memcpy(outer_msg, k_opad, 64);
-  memcpy(outer_msg + 64, inner_hash, 20);
-  sha1(outer_msg, 64 + 20, mac);
+  memset(pad, 0, sizeof(pad));
+  memset(tk, 0, sizeof(tk));
+  return true;
 }
 
-uint32_t vk_totp_generate(const uint8_t *key, uint16_t key_len,
-                          uint64_t timestamp) {
-  uint64_t interval = timestamp / 30;
-  uint8_t msg[8];
-  for (int i = 0; i < 8; i++) {
-    msg[7 - i] = (uint8_t)(interval >> (i * 8));
-  }
+// HMAC-SHA1 of the 8-byte counter: one block for the inner hash (pad + 8
+// bytes), one for the outer (pad + 20 bytes), both started from the midstates
+static void vk_totp_hmac_sha1(const vk_totp_key_t *k, uint64_t counter,
+                              uint8_t mac[SHA1_DIGEST_SIZE]) {
+  uint32_t block[16] = {0};
+  uint32_t state[5];
+
+  block[0] = (uint32_t)(counter >> 32);
+  block[1] = (uint32_t)counter;
+  block[2] = 0x80000000;
+  block[15] = (SHA1_BLOCK_SIZE + 8) * 8;
+  memcpy(state, k->mid.sha1[0], sizeof(state));
+  sha1_compress(state, block);
+
+  memcpy(block, state, sizeof(state));
+  block[5] = 0x80000000;
+  block[15] = (SHA1_BLOCK_SIZE + SHA1_DIGEST_SIZE) * 8;
+  memcpy(state, k->mid.sha1[1], sizeof(state));
+  sha1_compress(state, block);
+
+  for (int i = 0; i < 5; i++)
+    store_be32(mac + 4 * i, state[i]);
+  memset(block, 0, sizeof(block));
+}
 
-  uint8_t hash[20];
-  hmac_sha1(key, key_len, msg, 8, hash);
+// HMAC-SHA512 through tweetnacl's block function, padding by hand: the
+// message fits one block on both sides
+static void vk_totp_hmac_sha512(const vk_totp_key_t *k, const uint8_t msg[8],
+                                uint8_t mac[64]) {
+  uint8_t block[SHA512_BLOCK_SIZE] = {0};
 
-  int offset = hash[19] & 0x0F;
+  memcpy(mac, k->mid.sha512[0], 64);
+  memcpy(block, msg, 8);
+  block[8] = 0x80;
+  block[126] = ((SHA512_BLOCK_SIZE + 8) * 8) >> 8;
+  block[127] = (uint8_t)((SHA512_BLOCK_SIZE + 8) * 8);
+  crypto_hashblocks(mac, block, SHA512_BLOCK_SIZE);
+
+  memset(block, 0, sizeof(block));
+  memcpy(block, mac, 64);
+  block[64] = 0x80;
+  block[126] = ((SHA512_BLOCK_SIZE + 64) * 8) >> 8;
+  block[127] = (uint8_t)((SHA512_BLOCK_SIZE + 64) * 8);
+  memcpy(mac, k->mid.sha512[1], 64);
+  crypto_hashblocks(mac, block, SHA512_BLOCK_SIZE);
+  memset(block, 0, sizeof(block));
+}
+
+uint32_t vk_totp_code(const vk_totp_key_t *k, uint64_t timestamp) {
+  static const uint32_t pow10[] = {1000000, 10000000, 100000000};
+  uint64_t counter = timestamp / k->period;
+  uint8_t msg[8], hash[64];
+  size_t hash_len;
+
+  for (int i = 0; i < 8; i++)
+    msg[7 - i] = (uint8_t)(counter >> (i * 8));
+
+  switch (k->alg) {
+  case VK_TOTP_SHA256:
+    hmac_sha256_keyed(&k->mid.sha256, msg, sizeof(msg), hash);
+    hash_len = HMAC_SHA256_BYTES;
+    break;
+  case VK_TOTP_SHA512:
+    vk_totp_hmac_sha512(k, msg, hash);
+    hash_len = 64;
+    break;
+  default:
+    vk_totp_hmac_sha1(k, counter, hash);
+    hash_len = SHA1_DIGEST_SIZE;
+    break;
+  }
+
+  // Dynamic truncation (RFC 4226, 5.3)
+  int offset = hash[hash_len - 1] & 0x0F;
   uint32_t bin_code =
       ((hash[offset] & 0x7F) << 24) | ((hash[offset + 1] & 0xFF) << 16) |
       ((hash[offset + 2] & 0xFF) << 8) | (hash[offset + 3] & 0xFF);
+  memset(hash, 0, sizeof(hash));
+
+  return bin_code % pow10[k->digits - VK_TOTP_DIGITS_MIN];
+}
 
-  return bin_code % 1000000;
+uint32_t vk_totp_generate(const uint8_t *key, uint16_t key_len,
+                          uint64_t timestamp) {
+  vk_totp_key_t k;
+  vk_totp_key_init(&k, VK_TOTP_SHA1, 6, 30, key, key_len);
+  uint32_t code = vk_totp_code(&k, timestamp);
+  memset(&k, 0, sizeof(k));
+  return code;
 }
@@ -0,0 +1,44 @@
+#include "hardware/regs/trng.h"
+#include "hardware/resets.h"
+#include "hardware/structs/trng.h"
+#include "pico/platform.h"
+#include "vk_drbg.h"
+
+// Noise for the DRBG: raw samples of the RP2350 TRNG's ring oscillator.
+// The peripheral's von Neumann corrector, CRNGT and autocorrelation checks
+// are bypassed, so the health tests in vk_drbg.c see the oscillator bits as
+// they are; a stuck or dead source trips them instead of hiding behind a
+// post-processor. (pico_rand's get_rand_32 is a xoroshiro PRNG and would
+// pass the tests whatever the TRNG did.)
+
+#define VK_TRNG_EHR_WORDS 6 // 192 bits per collection
+
+static uint32_t ehr[VK_TRNG_EHR_WORDS];
+static uint32_t ehr_left;
+static bool started;
+
+static void vk_trng_start(void) {
+  reset_unreset_block_num_wait_blocking(RESET_TRNG);
+  trng_hw->trng_debug_control =
+      TRNG_TRNG_DEBUG_CONTROL_VNC_BYPASS_BITS |
+      TRNG_TRNG_DEBUG_CONTROL_TRNG_CRNGT_BYPASS_BITS |
+      TRNG_TRNG_DEBUG_CONTROL_AUTO_CORRELATE_BYPASS_BITS;
+  trng_hw->rnd_source_enable = TRNG_RND_SOURCE_ENABLE_BITS;
+  started = true;
+}
+
+uint32_t vk_drbg_noise(void) {
+  if (!started)
+    vk_trng_start();
+  if (ehr_left == 0) {
+    while (!(trng_hw->trng_valid & TRNG_TRNG_VALID_EHR_VALID_BITS))
+      tight_loop_contents();
+    // Reading the last word starts the next collection
+    for (uint32_t i = 0; i < VK_TRNG_EHR_WORDS; i++)
+      ehr[i] = trng_hw->ehr_data[i];
+    ehr_left = VK_TRNG_EHR_WORDS;
+  }
+  uint32_t v = ehr[--ehr_left];
+  ehr[ehr_left] = 0;
+  return v;
+}
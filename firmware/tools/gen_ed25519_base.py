@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Generate lib/nacl/ed25519_base.h, the fixed-base table used by
+comb_select() in tweetnacl.c.
+
+Entry [i][j] is (j + 1) * 256^i * B in the precomputed form the mixed
+addition wants: y + x, y - x and 2 * d * x * y, each 32 bytes little-endian.
+
+    gen_ed25519_base.py > lib/nacl/ed25519_base.h
+"""
+
+P = 2**255 - 19
+D = -121665 * pow(121666, P - 2, P) % P
+
+
+def inv(x):
+    return pow(x, P - 2, P)
+
+
+def recover_x(y):
+    xx = (y * y - 1) * inv(D * y * y + 1) % P
+    x = pow(xx, (P + 3) // 8, P)
+    if (x * x - xx) % P != 0:
+        x = x * pow(2, (P - 1) // 4, P) % P
+    if x % 2 != 0:
+        x = P - x
+    return x
+
+
+def add(p, q):
+    x1, y1 = p
+    x2, y2 = q
+    t = D * x1 * x2 * y1 * y2 % P
+    x3 = (x1 * y2 + x2 * y1) * inv(1 + t) % P
+    y3 = (y1 * y2 + x1 * x2) * inv(1 - t) % P
+    return x3, y3
+
+
+def le32(v):
+    return v.to_bytes(32, "little")
+
+
+def main():
+    by = 4 * inv(5) % P
+    base = (recover_x(by), by)
+
+    print("/* Generated by tools/gen_ed25519_base.py, do not edit. */")
+    print("/* [i][j] = (j + 1) * 256^i * B as (y + x, y - x, 2 * d * x * y) */")
+    print("static const u8 ed25519_base[32][8][96] = {")
+    row = base
+    for i in range(32):
+        print("  {")
+        pt = row
+        for j in range(8):
+            x, y = pt
+            entry = le32((y + x) % P) + le32((y - x) % P) + le32(2 * D * x * y % P)
+            lines = []
+            for k in range(0, 96, 12):
+                lines.append(", ".join("0x%02x" % b for b in entry[k:k + 12]))
+            print("    {" + ",\n     ".join(lines) + "},")
+            pt = add(pt, row)
+        print("  },")
+        for _ in range(8):
+            row = add(row, row)
+    print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Print how the RP2350 RAM budget is split across the firmware.
+
+Run automatically after every firmware build (see CMakeLists.txt):
+
+    ram_report.py --nm arm-none-eabi-nm build/vaultkey_firmware.elf
+"""
+import argparse
+import subprocess
+import sys
+
+# Main SRAM (512 KiB) + SCRATCH_X/SCRATCH_Y (4 KiB each)
+RP2350_RAM = 520 * 1024
+
+# Symbol name -> budget bucket. Prefixes end with '*'.
+BUCKETS = [
+    ("KDF arena", ["vk_kdf_arena"]),
+    ("Request arena", ["vk_req_arena"]),
+    ("Vault", ["vault_data", "session_key"]),
+    ("USB buffers", ["_cdcd_*", "_hidd_*", "_usbd_*", "usbd_*", "_ctrl_xfer",
+                     "fido_ctx"]),
+]
+
+RAM_TYPES = set("bBdD")
+
+
+def matches(name, patterns):
+    for p in patterns:
+        if p.endswith("*") and name.startswith(p[:-1]):
+            return True
+        if name == p:
+            return True
+    return False
+
+
+def read_symbols(nm, elf):
+    out = subprocess.run([nm, "-S", "--size-sort", elf], check=True,
+                         capture_output=True, text=True).stdout
+    sizes = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[2] in RAM_TYPES:
+            sizes.append((parts[3], int(parts[1], 16)))
+    return sizes
+
+
+def read_addresses(nm, elf):
+    out = subprocess.run([nm, elf], check=True, capture_output=True,
+                         text=True).stdout
+    addrs = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 3:
+            addrs[parts[2]] = int(parts[0], 16)
+    return addrs
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--nm", default="arm-none-eabi-nm")
+    ap.add_argument("elf")
+    args = ap.parse_args()
+
+    symbols = read_symbols(args.nm, args.elf)
+    addrs = read_addresses(args.nm, args.elf)
+
+    totals = {name: 0 for name, _ in BUCKETS}
+    other = 0
+    for sym, size in symbols:
+        for name, patterns in BUCKETS:
+            if matches(sym, patterns):
+                totals[name] += size
+                break
+        else:
+            other += size
+
+    def span(lo, hi):
+        if lo in addrs and hi in addrs:
+            return addrs[hi] - addrs[lo]
+        return 0
+
+    rows = list(totals.items())
+    rows.append(("Stack core 0", span("__StackBottom", "__StackTop")))
+    rows.append(("Stack core 1", span("__StackOneBottom", "__StackOneTop")))
+    rows.append(("Other static", other))
+    used = sum(size for _, size in rows)
+    # The SDK hands everything that is left to the heap
+    rows.append(("Free (heap)", RP2350_RAM - used))
+
+    print("RAM budget (%d KiB):" % (RP2350_RAM // 1024))
+    for name, size in rows:
+        pct = 100.0 * size / RP2350_RAM
+        print("  %-14s %8d B  %5.1f%%" % (name, size, pct))
+
+    if used > RP2350_RAM:
+        print("error: RAM budget exceeded by %d bytes" % (used - RP2350_RAM))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())